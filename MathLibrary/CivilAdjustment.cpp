@@ -0,0 +1,992 @@
+#include "CivilAdjustment.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <algorithm>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+static const size_t
+	NO_INDEX = SIZE_MAX;
+
+static const uint32_t
+	NO_COLUMN = UINT32_MAX;
+
+// Stations below which the dissection stops splitting.
+static const size_t
+	LEAF_STATIONS = 32;
+
+// Smallest pivot of the factorization, relative to the diagonal of the normal equations.
+static const double
+	MIN_PIVOT = 1e-12;
+
+/*
+ * SurveyNetwork.
+ */
+
+size_t
+SurveyNetwork::addStation(const Point2D &approx, bool fixed)
+{
+	m_aStations.push_back(approx);
+	m_aFixed.push_back(fixed);
+
+	return m_aStations.size() - 1;
+}
+
+void
+SurveyNetwork::checkStation(size_t station) const
+{
+	if (station >= m_aStations.size())
+		RAISE(EAdjustment, naInvalidStation);
+}
+
+size_t
+SurveyNetwork::addObservation(ObservationTypeEnum type, size_t s0, size_t s1, size_t s2, double value, double sigma)
+{
+	checkStation(s0);
+	checkStation(s1);
+	checkStation(s2);
+
+	if (!isfinite(value) || !(sigma > 0) || !isfinite(sigma))
+		RAISE(EAdjustment, naInvalidObservation);
+
+	m_aObservations.push_back({type, {s0, s1, s2}, value, sigma});
+
+	return m_aObservations.size() - 1;
+}
+
+size_t
+SurveyNetwork::addDistance(size_t from, size_t to, double distance, double sigma)
+{
+	if (from == to)
+		RAISE(EAdjustment, naSameStation);
+
+	return addObservation(otDistance, from, to, from, distance, sigma);
+}
+
+size_t
+SurveyNetwork::addAzimuth(size_t from, size_t to, const Angle &azimuth, double sigma)
+{
+	if (from == to)
+		RAISE(EAdjustment, naSameStation);
+
+	return addObservation(otAzimuth, from, to, from, azimuth, sigma);
+}
+
+size_t
+SurveyNetwork::addAngle(size_t at, size_t from, size_t to, const Angle &angle, double sigma)
+{
+	if (at == from || at == to || from == to)
+		RAISE(EAdjustment, naSameStation);
+
+	return addObservation(otAngle, at, from, to, angle, sigma);
+}
+
+size_t
+SurveyNetwork::addCoordinate(size_t station, const Point2D &pnt, double sigmaX, double sigmaY)
+{
+	// Both are checked before the first goes in.
+	if (!isfinite(pnt.y) || !(sigmaY > 0) || !isfinite(sigmaY))
+		RAISE(EAdjustment, naInvalidObservation);
+
+	size_t
+		intIndex = addObservation(otCoordinateX, station, station, station, pnt.x, sigmaX);
+
+	addObservation(otCoordinateY, station, station, station, pnt.y, sigmaY);
+
+	return intIndex;
+}
+
+/*
+ * Observation equations.
+ */
+
+// Observation linearized at the current coordinates: the misclosure is observed - computed and the
+// coefficients are the partial derivatives by the x and y of each station.
+struct Linearization
+{
+public:
+
+	int
+		count;
+	size_t
+		stations[3];
+	double
+		coefs[3][2],
+		misclosure,
+		weight;
+
+}; /* Linearization */
+
+// Wraps an angle to [-pi, pi].
+static double
+wrapAngle(double ang)
+{
+	return ang - 2 * M_PI * round(ang / (2 * M_PI));
+}
+
+// Azimuth from "from" to "to", with its partial derivatives by the coordinates of "to" (those by the
+// coordinates of "from" are their opposites).
+static double
+azimuth(const Point2D &from, const Point2D &to, double &ax, double &ay)
+{
+	double
+		dx = to.x - from.x,
+		dy = to.y - from.y,
+		d2 = dx * dx + dy * dy;
+
+	if (!(d2 > 0))
+		RAISE(EAdjustment, naSingular);
+
+	ax = dy / d2;
+	ay = -dx / d2;
+
+	return atan2(dx, dy);
+}
+
+static void
+linearize(const SurveyNetwork::ObservationRecord &obs, const std::vector<Point2D> &coords, Linearization &lin)
+{
+	const size_t
+		*s = obs.stations;
+	double
+		dblComputed;
+
+	lin.weight = 1 / (obs.sigma * obs.sigma);
+
+	switch (obs.type)
+	{
+		case SurveyNetwork::otDistance:
+		{
+			double
+				dx = coords[s[1]].x - coords[s[0]].x,
+				dy = coords[s[1]].y - coords[s[0]].y;
+
+			dblComputed = sqrt(dx * dx + dy * dy);
+
+			if (!(dblComputed > 0))
+				RAISE(EAdjustment, naSingular);
+
+			lin.count = 2;
+			lin.coefs[1][0] = dx / dblComputed;
+			lin.coefs[1][1] = dy / dblComputed;
+			lin.coefs[0][0] = -lin.coefs[1][0];
+			lin.coefs[0][1] = -lin.coefs[1][1];
+			lin.misclosure = obs.value - dblComputed;
+			break;
+		}
+		case SurveyNetwork::otAzimuth:
+			dblComputed = azimuth(coords[s[0]], coords[s[1]], lin.coefs[1][0], lin.coefs[1][1]);
+			lin.count = 2;
+			lin.coefs[0][0] = -lin.coefs[1][0];
+			lin.coefs[0][1] = -lin.coefs[1][1];
+			lin.misclosure = wrapAngle(obs.value - dblComputed);
+			break;
+		case SurveyNetwork::otAngle:
+		{
+			double
+				bx, by, fx, fy;
+
+			dblComputed = azimuth(coords[s[0]], coords[s[2]], fx, fy) - azimuth(coords[s[0]], coords[s[1]], bx, by);
+			lin.count = 3;
+			lin.coefs[1][0] = -bx;
+			lin.coefs[1][1] = -by;
+			lin.coefs[2][0] = fx;
+			lin.coefs[2][1] = fy;
+			lin.coefs[0][0] = bx - fx;
+			lin.coefs[0][1] = by - fy;
+			lin.misclosure = wrapAngle(obs.value - dblComputed);
+			break;
+		}
+		default:
+		{
+			int
+				c = obs.type == SurveyNetwork::otCoordinateY;
+
+			lin.count = 1;
+			lin.coefs[0][c] = 1;
+			lin.coefs[0][1 - c] = 0;
+			lin.misclosure = obs.value - (c ? coords[s[0]].y : coords[s[0]].x);
+			break;
+		}
+	}
+
+	for (int i = 0; i < 3; i++)
+		lin.stations[i] = s[i];
+}
+
+/*
+ * Ordering.
+ */
+
+// Nested dissection of the free stations. Every node of the tree owns a range of columns (2 per station):
+// a leaf all of its stations, an inner node its separator, numbered after both children. Nodes of the same
+// level share no column of the factor, so they can be factored at the same time.
+struct Dissection
+{
+public:
+
+	// Of each station, NO_INDEX when fixed.
+	std::vector<size_t>
+		ranks;
+	// Of each rank.
+	std::vector<size_t>
+		stations;
+	std::vector<std::pair<size_t, size_t>>
+		nodes;
+	// Nodes by depth, the root alone on level 0.
+	std::vector<std::vector<size_t>>
+		levels;
+
+}; /* Dissection */
+
+// Splits [first, last) at the median of the longer side of its box. The stations of the lower half tied
+// to the upper one form the separator; "aMark" holds the token of the upper half while it is found.
+static void
+dissect(const std::vector<Point2D> &pnts, const std::vector<size_t> &adjStart, const std::vector<size_t> &adj,
+	size_t *first, size_t *last, size_t depth, std::vector<size_t> &aMark, size_t &intToken, Dissection &dis)
+{
+	if ((size_t) (last - first) > LEAF_STATIONS)
+	{
+		double
+			dblMinX = INFINITY,
+			dblMaxX = -INFINITY,
+			dblMinY = INFINITY,
+			dblMaxY = -INFINITY;
+
+		for (size_t *p = first; p < last; p++)
+		{
+			dblMinX = std::min(dblMinX, pnts[*p].x);
+			dblMaxX = std::max(dblMaxX, pnts[*p].x);
+			dblMinY = std::min(dblMinY, pnts[*p].y);
+			dblMaxY = std::max(dblMaxY, pnts[*p].y);
+		}
+
+		bool
+			blnX = dblMaxX - dblMinX >= dblMaxY - dblMinY;
+		size_t
+			*middle = first + (last - first) / 2,
+			intToken0 = ++intToken;
+
+		std::nth_element(first, middle, last, [&](size_t a, size_t b) {
+			double
+				ca = blnX ? pnts[a].x : pnts[a].y,
+				cb = blnX ? pnts[b].x : pnts[b].y;
+
+			return ca < cb || (ca == cb && a < b);
+		});
+
+		for (size_t *p = middle; p < last; p++)
+			aMark[*p] = intToken0;
+
+		size_t
+			*separator = std::stable_partition(first, middle, [&](size_t s) {
+				for (size_t k = adjStart[s]; k < adjStart[s + 1]; k++)
+					if (aMark[adj[k]] == intToken0)
+						return false;
+
+				return true;
+			});
+
+		dissect(pnts, adjStart, adj, first, separator, depth + 1, aMark, intToken, dis);
+		dissect(pnts, adjStart, adj, middle, last, depth + 1, aMark, intToken, dis);
+		first = separator;
+		last = middle;
+	}
+
+	size_t
+		intFirst = dis.stations.size();
+
+	for (size_t *p = first; p < last; p++)
+	{
+		dis.ranks[*p] = dis.stations.size();
+		dis.stations.push_back(*p);
+	}
+
+	if (dis.levels.size() <= depth)
+		dis.levels.resize(depth + 1);
+
+	dis.levels[depth].push_back(dis.nodes.size());
+	dis.nodes.push_back(std::make_pair(2 * intFirst, 2 * dis.stations.size()));
+}
+
+// Calls fn(nodes, count) over pieces of every level of the dissection, deepest level first when "upward"
+// and root first otherwise. Each piece gets its own call so that it can have its own work arrays.
+template <typename Fn>
+static void
+forEachLevel(const Dissection &dis, bool upward, bool parallel, const Fn &fn)
+{
+	for (size_t l = 0; l < dis.levels.size(); l++)
+	{
+		const std::vector<size_t>
+			&aLevel = dis.levels[upward ? dis.levels.size() - 1 - l : l];
+
+		if (parallel)
+			parallelFor(0, aLevel.size(), 1, [&](size_t first, size_t last) {
+				fn(aLevel.data() + first, last - first);
+			});
+		else
+			fn(aLevel.data(), aLevel.size());
+	}
+}
+
+/*
+ * SparseCholesky.
+ */
+
+// Lower triangle of a symmetric matrix by columns, the diagonal first in every column and the other rows
+// in increasing order.
+struct SparseLower
+{
+public:
+
+	std::vector<size_t>
+		colStart;
+	std::vector<uint32_t>
+		rows;
+	std::vector<double>
+		values;
+
+}; /* SparseLower */
+
+// Cholesky factor L L^T of a SparseLower, left-looking by columns over the subtrees of a dissection.
+// The matrix is made of 2 x 2 blocks, one row and column pair per station, and so is the pattern of the
+// factor: below row 2s + 1 columns 2s and 2s + 1 have the same rows, and a column with row 2s has row 2s + 1
+// next. Both columns of a station are computed together, reading the columns they depend on once.
+struct SparseCholesky
+{
+public:
+
+	SparseLower
+		factor;
+
+	void analyze(const SparseLower &mat, const Dissection &dis, bool parallel);
+	void decompose(const SparseLower &mat, const Dissection &dis, bool parallel);
+	void solve(std::vector<double> &x) const;
+	void selectedInverse(const Dissection &dis, bool parallel, std::vector<double> &inv) const;
+
+private:
+
+	// Off-diagonal entries of the even rows of the factor: their columns and positions.
+	std::vector<size_t>
+		m_aRowStart,
+		m_aRowPositions;
+	std::vector<uint32_t>
+		m_aRowColumns;
+
+}; /* SparseCholesky */
+
+void
+SparseCholesky::analyze(const SparseLower &mat, const Dissection &dis, bool parallel)
+{
+	size_t
+		n = mat.colStart.size() - 1;
+
+	// Elimination tree (Liu), which needs the matrix by rows.
+	std::vector<size_t>
+		aRowStart(n + 1, 0);
+
+	for (size_t q = 0; q < mat.rows.size(); q++)
+		aRowStart[mat.rows[q] + 1]++;
+
+	for (size_t i = 0; i < n; i++)
+		aRowStart[i + 1] += aRowStart[i];
+
+	std::vector<size_t>
+		aCursor(aRowStart.begin(), aRowStart.end() - 1);
+	std::vector<uint32_t>
+		aRowColumns(mat.rows.size());
+
+	for (size_t j = 0; j < n; j++)
+		for (size_t q = mat.colStart[j]; q < mat.colStart[j + 1]; q++)
+			aRowColumns[aCursor[mat.rows[q]]++] = (uint32_t) j;
+
+	std::vector<size_t>
+		aParent(n, NO_INDEX),
+		aAncestor(n, NO_INDEX);
+
+	for (size_t k = 0; k < n; k++)
+		for (size_t q = aRowStart[k]; q < aRowStart[k + 1]; q++)
+			for (size_t i = aRowColumns[q], intNext; i != NO_INDEX && i < k; i = intNext)
+			{
+				intNext = aAncestor[i];
+				aAncestor[i] = k;
+
+				if (intNext == NO_INDEX)
+					aParent[i] = k;
+			}
+
+	std::vector<size_t>
+		aChildStart(n + 1, 0),
+		aChildren(n);
+
+	for (size_t j = 0; j < n; j++)
+		if (aParent[j] != NO_INDEX)
+			aChildStart[aParent[j] + 1]++;
+
+	for (size_t j = 0; j < n; j++)
+		aChildStart[j + 1] += aChildStart[j];
+
+	aCursor.assign(aChildStart.begin(), aChildStart.end() - 1);
+
+	for (size_t j = 0; j < n; j++)
+		if (aParent[j] != NO_INDEX)
+			aChildren[aCursor[aParent[j]]++] = j;
+
+	// The pattern of a column is its own below the diagonal joined to those of its children.
+	std::vector<std::vector<uint32_t>>
+		aPatterns(n);
+
+	forEachLevel(dis, true, parallel, [&](const size_t *nodes, size_t count) {
+		std::vector<uint32_t>
+			aMark(n, NO_COLUMN);
+
+		for (size_t k = 0; k < count; k++)
+			for (size_t j = dis.nodes[nodes[k]].first; j < dis.nodes[nodes[k]].second; j++)
+			{
+				std::vector<uint32_t>
+					&aPattern = aPatterns[j];
+
+				for (size_t q = mat.colStart[j] + 1; q < mat.colStart[j + 1]; q++)
+				{
+					aMark[mat.rows[q]] = (uint32_t) j;
+					aPattern.push_back(mat.rows[q]);
+				}
+
+				for (size_t c = aChildStart[j]; c < aChildStart[j + 1]; c++)
+					for (uint32_t i : aPatterns[aChildren[c]])
+						if (i > j && aMark[i] != j)
+						{
+							aMark[i] = (uint32_t) j;
+							aPattern.push_back(i);
+						}
+
+				std::sort(aPattern.begin(), aPattern.end());
+			}
+	});
+
+	factor.colStart.assign(n + 1, 0);
+
+	for (size_t j = 0; j < n; j++)
+		factor.colStart[j + 1] = factor.colStart[j] + 1 + aPatterns[j].size();
+
+	factor.rows.resize(factor.colStart[n]);
+	factor.values.resize(factor.colStart[n]);
+	m_aRowStart.assign(n / 2 + 1, 0);
+
+	for (size_t j = 0; j < n; j++)
+	{
+		factor.rows[factor.colStart[j]] = (uint32_t) j;
+		std::copy(aPatterns[j].begin(), aPatterns[j].end(), factor.rows.begin() + factor.colStart[j] + 1);
+
+		for (uint32_t i : aPatterns[j])
+			if (i % 2 == 0)
+				m_aRowStart[i / 2 + 1]++;
+
+		std::vector<uint32_t>().swap(aPatterns[j]);
+	}
+
+	for (size_t i = 0; i < n / 2; i++)
+		m_aRowStart[i + 1] += m_aRowStart[i];
+
+	m_aRowColumns.resize(m_aRowStart[n / 2]);
+	m_aRowPositions.resize(m_aRowStart[n / 2]);
+	aCursor.assign(m_aRowStart.begin(), m_aRowStart.end() - 1);
+
+	for (size_t j = 0; j < n; j++)
+		for (size_t q = factor.colStart[j] + 1; q < factor.colStart[j + 1]; q++)
+			if (factor.rows[q] % 2 == 0)
+			{
+				size_t
+					p = aCursor[factor.rows[q] / 2]++;
+
+				m_aRowColumns[p] = (uint32_t) j;
+				m_aRowPositions[p] = q;
+			}
+}
+
+// Takes the square root of the pivot of column j, which x holds (at x[2i + c] for row i) from row j down,
+// and divides the rest of the column by it, clearing x.
+static void
+finishColumn(SparseLower &factor, size_t j, double diagonal, double *x, size_t c)
+{
+	double
+		dblPivot = x[2 * j + c];
+
+	if (!(dblPivot > MIN_PIVOT * diagonal))
+		RAISE(EAdjustment, naSingular);
+
+	double
+		dblDiagonal = sqrt(dblPivot);
+
+	factor.values[factor.colStart[j]] = dblDiagonal;
+	x[2 * j + c] = 0;
+
+	for (size_t q = factor.colStart[j] + 1; q < factor.colStart[j + 1]; q++)
+	{
+		factor.values[q] = x[2 * factor.rows[q] + c] / dblDiagonal;
+		x[2 * factor.rows[q] + c] = 0;
+	}
+}
+
+void
+SparseCholesky::decompose(const SparseLower &mat, const Dissection &dis, bool parallel)
+{
+	size_t
+		n = mat.colStart.size() - 1;
+
+	forEachLevel(dis, true, parallel, [&](const size_t *nodes, size_t count) {
+		// Columns 2s and 2s + 1 side by side.
+		std::vector<double>
+			x(2 * n, 0);
+
+		for (size_t k = 0; k < count; k++)
+			for (size_t j = dis.nodes[nodes[k]].first; j < dis.nodes[nodes[k]].second; j += 2)
+			{
+				for (size_t c = 0; c < 2; c++)
+					for (size_t q = mat.colStart[j + c]; q < mat.colStart[j + c + 1]; q++)
+						x[2 * mat.rows[q] + c] = mat.values[q];
+
+				// Less the columns to the left with a nonzero on rows j and j + 1, from those rows down.
+				for (size_t r = m_aRowStart[j / 2]; r < m_aRowStart[j / 2 + 1]; r++)
+				{
+					size_t
+						p = m_aRowPositions[r],
+						intEnd = factor.colStart[m_aRowColumns[r] + 1];
+					double
+						l0 = factor.values[p],
+						l1 = factor.values[p + 1];
+
+					x[2 * j] -= l0 * l0;
+
+					for (size_t q = p + 1; q < intEnd; q++)
+					{
+						double
+							v = factor.values[q];
+
+						x[2 * factor.rows[q]] -= l0 * v;
+						x[2 * factor.rows[q] + 1] -= l1 * v;
+					}
+				}
+
+				finishColumn(factor, j, mat.values[mat.colStart[j]], x.data(), 0);
+
+				// Column j + 1 also takes column j, just finished.
+				double
+					l = factor.values[factor.colStart[j] + 1];
+
+				for (size_t q = factor.colStart[j] + 1; q < factor.colStart[j + 1]; q++)
+					x[2 * factor.rows[q] + 1] -= l * factor.values[q];
+
+				finishColumn(factor, j + 1, mat.values[mat.colStart[j + 1]], x.data(), 1);
+			}
+	});
+}
+
+void
+SparseCholesky::solve(std::vector<double> &x) const
+{
+	size_t
+		n = factor.colStart.size() - 1;
+
+	for (size_t j = 0; j < n; j++)
+	{
+		x[j] /= factor.values[factor.colStart[j]];
+
+		for (size_t q = factor.colStart[j] + 1; q < factor.colStart[j + 1]; q++)
+			x[factor.rows[q]] -= factor.values[q] * x[j];
+	}
+
+	for (size_t j = n; j-- > 0;)
+	{
+		for (size_t q = factor.colStart[j] + 1; q < factor.colStart[j + 1]; q++)
+			x[j] -= factor.values[q] * x[factor.rows[q]];
+
+		x[j] /= factor.values[factor.colStart[j]];
+	}
+}
+
+// Entries of the inverse on the pattern of the factor (Takahashi et al.): with Z the inverse, for i > j
+// Z(i, j) = -sum(k > j) L(k, j) Z(i, k) / L(j, j) and Z(j, j) = (1 / L(j, j) - sum(i > j) L(i, j) Z(i, j)) /
+// L(j, j), the sums running over the pattern of column j. Columns only need those to their right, so the
+// tree is walked from the root.
+void
+SparseCholesky::selectedInverse(const Dissection &dis, bool parallel, std::vector<double> &inv) const
+{
+	inv.assign(factor.values.size(), 0);
+
+	forEachLevel(dis, false, parallel, [&](const size_t *nodes, size_t count) {
+		std::vector<double>
+			aSum0,
+			aSum1;
+
+		for (size_t k = 0; k < count; k++)
+			for (size_t j = dis.nodes[nodes[k]].second; j > dis.nodes[nodes[k]].first; j -= 2)
+			{
+				// Column j0 has row j1 and then the rows of column j1.
+				size_t
+					j0 = j - 2,
+					j1 = j - 1,
+					q0 = factor.colStart[j0] + 2,
+					q1 = factor.colStart[j1] + 1,
+					m = factor.colStart[j1 + 1] - q1;
+				const uint32_t
+					*pRows = factor.rows.data() + q1;
+				const double
+					*pValues0 = factor.values.data() + q0,
+					*pValues1 = factor.values.data() + q1;
+
+				aSum0.assign(m, 0);
+				aSum1.assign(m, 0);
+
+				// Every row of the pattern below the row of position b is also in the pattern of the column
+				// of that row, so one walk down that column gives both Z(i, k) and Z(k, i) for all of them.
+				for (size_t b = 0; b < m; b++)
+				{
+					size_t
+						intColumn = pRows[b],
+						q = factor.colStart[intColumn] + 1;
+					double
+						z = inv[factor.colStart[intColumn]];
+
+					aSum0[b] += pValues0[b] * z;
+					aSum1[b] += pValues1[b] * z;
+
+					for (size_t a = b + 1; a < m; a++)
+					{
+						while (factor.rows[q] != pRows[a])
+							q++;
+
+						z = inv[q];
+						aSum0[a] += pValues0[b] * z;
+						aSum0[b] += pValues0[a] * z;
+						aSum1[a] += pValues1[b] * z;
+						aSum1[b] += pValues1[a] * z;
+					}
+				}
+
+				double
+					dblDiagonal = factor.values[q1 - 1],
+					dblSum = 0;
+
+				for (size_t a = 0; a < m; a++)
+				{
+					inv[q1 + a] = -aSum1[a] / dblDiagonal;
+					dblSum += pValues1[a] * inv[q1 + a];
+				}
+
+				inv[q1 - 1] = (1 / dblDiagonal - dblSum) / dblDiagonal;
+
+				// Column j0 also sums over row j1.
+				double
+					l = factor.values[q0 - 1],
+					dblSum01 = l * inv[q1 - 1];
+
+				dblDiagonal = factor.values[q0 - 2];
+				dblSum = 0;
+
+				for (size_t a = 0; a < m; a++)
+				{
+					dblSum01 += pValues0[a] * inv[q1 + a];
+					inv[q0 + a] = -(aSum0[a] + l * inv[q1 + a]) / dblDiagonal;
+					dblSum += pValues0[a] * inv[q0 + a];
+				}
+
+				inv[q0 - 1] = -dblSum01 / dblDiagonal;
+				dblSum += l * inv[q0 - 1];
+				inv[q0 - 2] = (1 / dblDiagonal - dblSum) / dblDiagonal;
+			}
+	});
+}
+
+/*
+ * Adjustment.
+ */
+
+static int
+stationCount(SurveyNetwork::ObservationTypeEnum type)
+{
+	return type == SurveyNetwork::otAngle ? 3 : type == SurveyNetwork::otDistance || type == SurveyNetwork::otAzimuth ? 2 : 1;
+}
+
+NetworkAdjustment
+SurveyNetwork::adjust(const AdjustmentOptions &options) const
+{
+	size_t
+		intStations = m_aStations.size(),
+		intObservations = m_aObservations.size();
+	NetworkAdjustment
+		res;
+
+	res.coordinates = m_aStations;
+
+	// Observations of each free station, then the free stations each one is tied to.
+	std::vector<size_t>
+		aIncStart(intStations + 1, 0),
+		aInc,
+		aAdjStart(intStations + 1, 0),
+		aAdj,
+		aMark(intStations, NO_INDEX);
+
+	for (const ObservationRecord &obs : m_aObservations)
+		for (int i = 0; i < stationCount(obs.type); i++)
+			if (!m_aFixed[obs.stations[i]])
+				aIncStart[obs.stations[i] + 1]++;
+
+	for (size_t s = 0; s < intStations; s++)
+		aIncStart[s + 1] += aIncStart[s];
+
+	aInc.resize(aIncStart[intStations]);
+
+	{
+		std::vector<size_t>
+			aCursor(aIncStart.begin(), aIncStart.end() - 1);
+
+		for (size_t o = 0; o < intObservations; o++)
+			for (int i = 0; i < stationCount(m_aObservations[o].type); i++)
+				if (!m_aFixed[m_aObservations[o].stations[i]])
+					aInc[aCursor[m_aObservations[o].stations[i]]++] = o;
+	}
+
+	std::vector<size_t>
+		aFree;
+
+	for (size_t s = 0; s < intStations; s++)
+	{
+		if (!m_aFixed[s])
+		{
+			aFree.push_back(s);
+			aMark[s] = s;
+
+			for (size_t k = aIncStart[s]; k < aIncStart[s + 1]; k++)
+			{
+				const ObservationRecord
+					&obs = m_aObservations[aInc[k]];
+
+				for (int i = 0; i < stationCount(obs.type); i++)
+				{
+					size_t
+						t = obs.stations[i];
+
+					if (!m_aFixed[t] && aMark[t] != s)
+					{
+						aMark[t] = s;
+						aAdj.push_back(t);
+					}
+				}
+			}
+		}
+
+		aAdjStart[s + 1] = aAdj.size();
+	}
+
+	Dissection
+		dis;
+	size_t
+		intToken = 0,
+		intFree = aFree.size(),
+		n = 2 * intFree;
+
+	dis.ranks.assign(intStations, NO_INDEX);
+	aMark.assign(intStations, 0);
+	dissect(m_aStations, aAdjStart, aAdj, aFree.data(), aFree.data() + intFree, 0, aMark, intToken, dis);
+
+	// Normal equations: column 2r holds rows 2r and 2r + 1 and column 2r + 1 row 2r + 1, then both take the
+	// two rows of every station of higher rank tied to the station of rank r.
+	std::vector<size_t>
+		aUpperStart(intFree + 1, 0),
+		aUpper;
+
+	for (size_t r = 0; r < intFree; r++)
+	{
+		size_t
+			s = dis.stations[r];
+
+		for (size_t k = aAdjStart[s]; k < aAdjStart[s + 1]; k++)
+			if (dis.ranks[aAdj[k]] > r)
+				aUpper.push_back(dis.ranks[aAdj[k]]);
+
+		std::sort(aUpper.begin() + aUpperStart[r], aUpper.end());
+		aUpperStart[r + 1] = aUpper.size();
+	}
+
+	SparseLower
+		mat;
+
+	mat.colStart.assign(n + 1, 0);
+
+	for (size_t r = 0; r < intFree; r++)
+	{
+		size_t
+			intUpper = aUpperStart[r + 1] - aUpperStart[r];
+
+		mat.colStart[2 * r + 1] = mat.colStart[2 * r] + 2 + 2 * intUpper;
+		mat.colStart[2 * r + 2] = mat.colStart[2 * r + 1] + 1 + 2 * intUpper;
+	}
+
+	mat.rows.resize(mat.colStart[n]);
+	mat.values.resize(mat.colStart[n]);
+
+	for (size_t r = 0; r < intFree; r++)
+		for (size_t c = 0; c < 2; c++)
+		{
+			uint32_t
+				*pRow = mat.rows.data() + mat.colStart[2 * r + c];
+
+			for (size_t d = c; d < 2; d++)
+				*pRow++ = (uint32_t) (2 * r + d);
+
+			for (size_t k = aUpperStart[r]; k < aUpperStart[r + 1]; k++)
+			{
+				*pRow++ = (uint32_t) (2 * aUpper[k]);
+				*pRow++ = (uint32_t) (2 * aUpper[k] + 1);
+			}
+		}
+
+	SparseCholesky
+		chol;
+	std::vector<double>
+		b(n);
+
+	if (n > 0)
+		chol.analyze(mat, dis, options.parallel);
+
+	// Every station adds the observations it takes part in to its own two columns (rows of its rank and
+	// above), so that the stations can be done in parallel without sharing an entry.
+	auto assemble = [&](size_t first, size_t last) {
+		Linearization
+			lin;
+
+		for (size_t r = first; r < last; r++)
+		{
+			size_t
+				s = dis.stations[r];
+
+			std::fill(mat.values.begin() + mat.colStart[2 * r], mat.values.begin() + mat.colStart[2 * r + 2], 0.0);
+			b[2 * r] = b[2 * r + 1] = 0;
+
+			for (size_t k = aIncStart[s]; k < aIncStart[s + 1]; k++)
+			{
+				linearize(m_aObservations[aInc[k]], res.coordinates, lin);
+
+				int
+					a = 0;
+
+				while (lin.stations[a] != s)
+					a++;
+
+				for (int c = 0; c < 2; c++)
+					b[2 * r + c] += lin.weight * lin.coefs[a][c] * lin.misclosure;
+
+				for (int e = 0; e < lin.count; e++)
+				{
+					// Offset of row 2t in column 2r; column 2r + 1 starts a row lower.
+					size_t
+						t = dis.ranks[lin.stations[e]],
+						intOffset = 0;
+
+					if (t == NO_INDEX || t < r)
+						continue;
+
+					if (t > r)
+						intOffset = 2 * (std::lower_bound(aUpper.begin() + aUpperStart[r], aUpper.begin() + aUpperStart[r + 1], t) -
+							(aUpper.begin() + aUpperStart[r])) + 2;
+
+					for (int c = 0; c < 2; c++)
+						for (int d = t == r ? c : 0; d < 2; d++)
+							mat.values[mat.colStart[2 * r + c] + intOffset - c + d] +=
+								lin.weight * lin.coefs[a][c] * lin.coefs[e][d];
+				}
+			}
+		}
+	};
+
+	res.converged = n == 0;
+
+	while (!res.converged && res.iterations < std::max(options.maxIterations, 1))
+	{
+		if (options.parallel)
+			parallelFor(0, intFree, 256, assemble);
+		else
+			assemble(0, intFree);
+
+		chol.decompose(mat, dis, options.parallel);
+		chol.solve(b);
+
+		double
+			dblMove = 0;
+
+		for (size_t r = 0; r < intFree; r++)
+		{
+			Point2D
+				&pnt = res.coordinates[dis.stations[r]];
+
+			pnt.x += b[2 * r];
+			pnt.y += b[2 * r + 1];
+			dblMove = std::max(dblMove, std::max(fabs(b[2 * r]), fabs(b[2 * r + 1])));
+		}
+
+		res.iterations++;
+		res.converged = dblMove <= options.tolerance;
+	}
+
+	double
+		dblSum = 0;
+	Linearization
+		lin;
+
+	res.residuals.resize(intObservations);
+
+	for (size_t o = 0; o < intObservations; o++)
+	{
+		linearize(m_aObservations[o], res.coordinates, lin);
+		res.residuals[o] = -lin.misclosure;
+		dblSum += lin.weight * lin.misclosure * lin.misclosure;
+	}
+
+	res.redundancy = (long long) intObservations - (long long) n;
+	res.sigma0 = res.redundancy > 0 ? sqrt(dblSum / res.redundancy) : 0;
+
+	if (options.ellipses)
+	{
+		std::vector<double>
+			aInverse;
+		double
+			dblVariance = options.aPosteriori && res.redundancy > 0 ? res.sigma0 * res.sigma0 : 1;
+
+		res.ellipses.resize(intStations);
+
+		if (n > 0)
+			chol.selectedInverse(dis, options.parallel, aInverse);
+
+		for (size_t r = 0; r < intFree; r++)
+		{
+			// Cofactors of the station, from the inverse of the last normal equations.
+			double
+				qxx = dblVariance * aInverse[chol.factor.colStart[2 * r]],
+				qxy = dblVariance * aInverse[chol.factor.colStart[2 * r] + 1],
+				qyy = dblVariance * aInverse[chol.factor.colStart[2 * r + 1]],
+				dblMean = (qxx + qyy) / 2,
+				dblRadius = hypot((qxx - qyy) / 2, qxy);
+			ErrorEllipse
+				&ell = res.ellipses[dis.stations[r]];
+
+			ell.major = sqrt(dblMean + dblRadius);
+			ell.minor = sqrt(std::max(dblMean - dblRadius, 0.0));
+			// The major axis makes 0.5 atan2(2 qxy, qxx - qyy) with +x, in [-pi / 2, pi / 2].
+			double
+				dblAzimuth = M_PI / 2 - 0.5 * atan2(2 * qxy, qxx - qyy);
+
+			ell.azimuth = dblAzimuth >= M_PI ? dblAzimuth - M_PI : dblAzimuth;
+		}
+	}
+
+	return res;
+}
+
+} // namespace CIVIL::MATH::GA2D
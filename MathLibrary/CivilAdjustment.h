@@ -0,0 +1,204 @@
+/***
+ * CivilAdjustment.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_ADJUSTMENT
+#define __CIVIL_ADJUSTMENT
+
+#include <vector>
+
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilAngle.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(naInvalidStation);
+	DECLARE_ERROR_CODE(naSameStation);
+	DECLARE_ERROR_CODE(naInvalidObservation);
+	DECLARE_ERROR_CODE(naSingular);
+
+	BEGIN_DECLARE_ERROR(EAdjustment)
+		DECLARE_ERROR(naInvalidStation, "Station index out of range")
+		DECLARE_ERROR(naSameStation, "An observation joins a station to itself")
+		DECLARE_ERROR(naInvalidObservation, "Observations need finite values and positive, finite standard deviations")
+		DECLARE_ERROR(naSingular, "The network is not determined (missing datum or stations without enough observations)")
+	END_DECLARE_ERROR;
+
+	// ErrorEllipse;
+	//
+	// Standard error ellipse of a station: semi-axes in the units of the coordinates and the azimuth of
+	// ---- the major axis, clockwise from north (+y) in [0, pi).
+	struct ErrorEllipse
+	{
+	public:
+
+		double
+			major = 0,
+			minor = 0;
+		Angle
+			azimuth;
+
+	}; /* ErrorEllipse */
+
+	struct AdjustmentOptions
+	{
+	public:
+
+		int
+			maxIterations = 10;
+		// Iterations stop once no coordinate moves more than this.
+		double
+			tolerance = 1e-6;
+		// Scales the covariances by the a posteriori variance of unit weight (when there is redundancy);
+		// otherwise the ellipses follow from the standard deviations given with the observations.
+		bool
+			aPosteriori = true,
+			ellipses = true,
+			parallel = true;
+
+	}; /* AdjustmentOptions */
+
+	// NetworkAdjustment;
+	//
+	// Result of SurveyNetwork::adjust. "residuals" follow the observations (adjusted - observed; meters or
+	// ---- radians) and "ellipses" the stations, fixed stations getting a null one; "sigma0" is the a
+	//      posteriori standard deviation of unit weight, 0 without redundancy.
+	struct NetworkAdjustment
+	{
+	public:
+
+		std::vector<Point2D>
+			coordinates;
+		std::vector<ErrorEllipse>
+			ellipses;
+		std::vector<double>
+			residuals;
+		double
+			sigma0 = 0;
+		long long
+			redundancy = 0;
+		int
+			iterations = 0;
+		bool
+			converged = false;
+
+	}; /* NetworkAdjustment */
+
+	// SurveyNetwork;
+	//
+	// Horizontal control network adjusted by least squares (Gauss-Newton on the observation equations).
+	// ---- Stations hold approximate coordinates, x east and y north; fixed ones are not moved and carry
+	//      the datum, otherwise coordinate observations must do it. Azimuths are clockwise from north and
+	//      angles clockwise from the direction "from" to the direction "to", seen from "at". Every add
+	//      method returns the index of its observation in NetworkAdjustment::residuals; a coordinate
+	//      observation takes two, x then y.
+	//
+	//      The normal equations are kept sparse. Stations are ordered by geometric nested dissection (the
+	//      network is split at the median of its longer side, the stations tied across the cut being
+	//      numbered last), which bounds the fill of the Cholesky factor and splits it in independent
+	//      subtrees. Forming the equations, the symbolic and numeric factorizations and the covariances of
+	//      the ellipses (the inverse on the pattern of the factor, after Takahashi) run over those subtrees
+	//      on the shared pool, level by level, when "parallel".
+	struct SurveyNetwork
+	{
+	public:
+
+		enum ObservationTypeEnum
+		{
+			otDistance,
+			otAzimuth,
+			otAngle,
+			otCoordinateX,
+			otCoordinateY
+		};
+
+		struct ObservationRecord
+		{
+		public:
+
+			ObservationTypeEnum
+				type;
+			// at / from / to; unused ones repeat the first.
+			size_t
+				stations[3];
+			double
+				value,
+				sigma;
+
+		}; /* ObservationRecord */
+
+		size_t addStation(const Point2D &approx, bool fixed = false);
+
+		size_t getStationCount() const
+		{
+			return m_aStations.size();
+		}
+		const Point2D &getStation(size_t station) const
+		{
+			return m_aStations[station];
+		}
+		bool isFixed(size_t station) const
+		{
+			return m_aFixed[station] != 0;
+		}
+		size_t getObservationCount() const
+		{
+			return m_aObservations.size();
+		}
+		const ObservationRecord &getObservation(size_t index) const
+		{
+			return m_aObservations[index];
+		}
+
+		size_t addDistance(size_t from, size_t to, double distance, double sigma);
+		size_t addAzimuth(size_t from, size_t to, const Angle &azimuth, double sigma);
+		size_t addAngle(size_t at, size_t from, size_t to, const Angle &angle, double sigma);
+		size_t addCoordinate(size_t station, const Point2D &pnt, double sigmaX, double sigmaY);
+
+		// adjust;
+		//
+		// Raises EAdjustment with naSingular when the normal equations are not positive definite.
+		// ----
+		NetworkAdjustment adjust(const AdjustmentOptions &options = AdjustmentOptions()) const;
+
+	private:
+
+		std::vector<Point2D>
+			m_aStations;
+		std::vector<char>
+			m_aFixed;
+		std::vector<ObservationRecord>
+			m_aObservations;
+
+		void checkStation(size_t station) const;
+		size_t addObservation(ObservationTypeEnum type, size_t s0, size_t s1, size_t s2, double value, double sigma);
+
+	}; /* SurveyNetwork */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_ADJUSTMENT
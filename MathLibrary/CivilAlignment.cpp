@@ -0,0 +1,693 @@
+#include "CivilAlignment.h"
+
+#include <math.h>
+#include <algorithm>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+// Points per piece of the batch queries.
+static const size_t
+	ALIGNMENT_GRAIN = 1 << 12;
+
+// Largest turn between two samples of an element.
+static const double
+	SAMPLE_ANGLE = 0.05;
+
+/*
+ * Fresnel integrals.
+ */
+
+// cos and sin of pi x^2 / 2. x^2 is split in two exact parts and reduced modulo 4, the period, before
+// multiplying by pi / 2, so the angle keeps its precision for large x.
+static void
+halfPiSquare(double x, double &c, double &s)
+{
+	double
+		dblHigh = x * x,
+		dblLow = fma(x, x, -dblHigh),
+		dblAngle = M_PI_2 * (fmod(dblHigh, 4.0) + dblLow);
+
+	c = cos(dblAngle);
+	s = sin(dblAngle);
+}
+
+void
+fresnel(double x, double &c, double &s)
+{
+	double
+		ax = fabs(x);
+
+	if (ax <= 1.5)
+	{
+		// C + S: the terms (pi x^2 / 2)^k x / (k! (2k + 1)) go to C for even k and to S for odd k, with
+		// alternating signs in each.
+		double
+			t = M_PI_2 * ax * ax,
+			dblTerm = ax;
+
+		c = ax;
+		s = 0;
+
+		for (int k = 1; k < 64; k++)
+		{
+			dblTerm *= t / k;
+
+			double
+				v = dblTerm / (2 * k + 1);
+
+			switch (k & 3)
+			{
+				case 0: c += v; break;
+				case 1: s += v; break;
+				case 2: c -= v; break;
+				default: s -= v; break;
+			}
+
+			if (v < 1e-17 * ax)
+				break;
+		}
+	}
+	else if (ax < 6)
+	{
+		// Continued fraction of erfc (modified Lentz), C + iS = (1 + i) / 2 * (1 - e^(i pi x^2 / 2) h), with
+		// the complex arithmetic written out.
+		double
+			br = 1,
+			bi = -M_PI * ax * ax,
+			dblNorm = br * br + bi * bi,
+			dr = br / dblNorm,
+			di = -bi / dblNorm,
+			cr = 1e300,
+			ci = 0,
+			hr = dr,
+			hi = di;
+
+		for (int k = 1; k < 200; k++)
+		{
+			double
+				a = -(2.0 * k - 1) * (2.0 * k);
+
+			br += 4;
+
+			// d = 1 / (a d + b), cc = b + a / cc.
+			double
+				xr = a * dr + br,
+				xi = a * di + bi;
+
+			dblNorm = xr * xr + xi * xi;
+			dr = xr / dblNorm;
+			di = -xi / dblNorm;
+			dblNorm = cr * cr + ci * ci;
+			cr = br + a * cr / dblNorm;
+			ci = bi - a * ci / dblNorm;
+
+			double
+				delr = cr * dr - ci * di,
+				deli = cr * di + ci * dr,
+				t = hr * delr - hi * deli;
+
+			hi = hr * deli + hi * delr;
+			hr = t;
+
+			if (fabs(delr - 1) + fabs(deli) < 1e-16)
+				break;
+		}
+
+		double
+			dblCos, dblSin;
+
+		halfPiSquare(ax, dblCos, dblSin);
+
+		// h * (x - ix), then e^(i pi x^2 / 2) h.
+		double
+			t = ax * (hr + hi);
+
+		hi = ax * (hi - hr);
+		hr = t;
+		t = dblCos * hr - dblSin * hi;
+		hi = dblCos * hi + dblSin * hr;
+		hr = t;
+
+		c = 0.5 * (1 - hr) + 0.5 * hi;
+		s = 0.5 * (1 - hr) - 0.5 * hi;
+	}
+	else
+	{
+		// Asymptotic expansions of the auxiliary functions, C = 1/2 + f sin - g cos, S = 1/2 - f cos - g sin:
+		// f ~ 1 / (pi x) sum (-1)^m 1.3...(4m - 1) / z^2m, g ~ 1 / (pi^2 x^3) sum (-1)^m 1.3...(4m + 1) / z^2m,
+		// z = pi x^2. From x = 6 on the terms fall below 1e-17 before they start growing.
+		double
+			z = M_PI * ax * ax,
+			z2 = z * z,
+			f = 1,
+			g = 1,
+			dblTermF = 1,
+			dblTermG = 1;
+
+		for (int m = 1; m < 16; m++)
+		{
+			dblTermF *= -(4.0 * m - 3) * (4.0 * m - 1) / z2;
+			dblTermG *= -(4.0 * m - 1) * (4.0 * m + 1) / z2;
+			f += dblTermF;
+			g += dblTermG;
+
+			if (fabs(dblTermG) < 1e-17)
+				break;
+		}
+
+		f /= M_PI * ax;
+		g /= M_PI * z * ax;
+
+		double
+			dblCos, dblSin;
+
+		halfPiSquare(ax, dblCos, dblSin);
+		c = 0.5 + f * dblSin - g * dblCos;
+		s = 0.5 - f * dblCos - g * dblSin;
+	}
+
+	if (x < 0)
+	{
+		c = -c;
+		s = -s;
+	}
+}
+
+/*
+ * AlignmentElement.
+ */
+
+// 8 point Gauss-Legendre rule on [-1, 1], used for the spirals that are not on the Fresnel path.
+static const double
+	GAUSS_NODES[4] = {0.1834346424956498, 0.5255324099163290, 0.7966664774136267, 0.9602898564975363},
+	GAUSS_WEIGHTS[4] = {0.3626837833783620, 0.3137066458778873, 0.2223810344533745, 0.1012285362903763};
+
+Point2D
+AlignmentElement::pointAt(double s) const
+{
+	if (startCurvature == endCurvature)
+	{
+		// Chord of the arc (or the tangent) in the mean direction.
+		double
+			dblHalf = startCurvature * s / 2,
+			dblChord = fabs(dblHalf) < 1e-9 ? s : s * sin(dblHalf) / dblHalf,
+			dblAngle = direction + dblHalf;
+
+		return start + Point2D(cos(dblAngle), sin(dblAngle)) * dblChord;
+	}
+
+	if (m_blnFresnel)
+	{
+		double
+			c, sn;
+
+		fresnel(m_dblU0 + s / m_dblScale, c, sn);
+		c -= m_dblC0;
+		sn = m_dblSign * (sn - m_dblS0);
+
+		return start + Point2D(m_dblCos * c - m_dblSin * sn, m_dblSin * c + m_dblCos * sn) * m_dblScale;
+	}
+
+	double
+		dblSweep = std::max(fabs(startCurvature), fabs(curvatureAt(s))) * s;
+	int
+		intPanels = (int) ceil(dblSweep / 0.5);
+
+	if (intPanels < 1)
+		intPanels = 1;
+
+	double
+		h = s / intPanels,
+		x = 0,
+		y = 0;
+
+	for (int i = 0; i < intPanels; i++)
+	{
+		double
+			dblMid = (i + 0.5) * h;
+
+		for (int k = 0; k < 4; k++)
+			for (int intSide = -1; intSide <= 1; intSide += 2)
+			{
+				double
+					dblAngle = directionAt(dblMid + intSide * GAUSS_NODES[k] * h / 2);
+
+				x += GAUSS_WEIGHTS[k] * cos(dblAngle);
+				y += GAUSS_WEIGHTS[k] * sin(dblAngle);
+			}
+	}
+
+	return start + Point2D(x, y) * (h / 2);
+}
+
+/*
+ * Alignment.
+ */
+
+Alignment::Alignment(const Point2D &start, const Angle &direction, double startStation) :
+	m_aStations{startStation},
+	m_pntEnd(start),
+	m_dblEndDirection(direction)
+{}
+
+static double
+radiusCurvature(double radius)
+{
+	return isinf(radius) ? 0 : 1 / radius;
+}
+
+void
+Alignment::addTangent(double length)
+{
+	addElement(aeTangent, length, 0, 0);
+}
+
+void
+Alignment::addArc(double length, double radius)
+{
+	if (radius == 0 || !isfinite(radius))
+		RAISE(EAlignment, alInvalidRadius);
+
+	addElement(aeArc, length, 1 / radius, 1 / radius);
+}
+
+void
+Alignment::addSpiral(double length, double startRadius, double endRadius)
+{
+	if (startRadius == 0 || endRadius == 0 || isnan(startRadius) || isnan(endRadius))
+		RAISE(EAlignment, alInvalidRadius);
+
+	addElement(aeSpiral, length, radiusCurvature(startRadius), radiusCurvature(endRadius));
+}
+
+void
+Alignment::addElement(AlignmentElementEnum type, double length, double startCurvature, double endCurvature)
+{
+	if (!(length > 0) || !isfinite(length))
+		RAISE(EAlignment, alInvalidLength);
+
+	AlignmentElement
+		elm;
+
+	elm.type = type;
+	elm.station = m_aStations.back();
+	elm.length = length;
+	elm.start = m_pntEnd;
+	elm.direction = m_dblEndDirection;
+	elm.startCurvature = startCurvature;
+	elm.endCurvature = endCurvature;
+
+	if (startCurvature != endCurvature)
+	{
+		// The clothoid of rate c = dk/ds has its inflection at s = -k0 / c and turns c t^2 / 2 in the
+		// distance t from there; with t = scale * u, scale = sqrt(pi / |c|), that is pi u^2 / 2.
+		double
+			dblRate = (endCurvature - startCurvature) / length,
+			dblFromInflection = startCurvature / dblRate,
+			dblTurn = std::max(startCurvature * startCurvature, endCurvature * endCurvature) / (2 * fabs(dblRate)),
+			dblInflection = elm.direction - dblRate * dblFromInflection * dblFromInflection / 2;
+
+		elm.m_blnFresnel = dblTurn <= 1024;
+		elm.m_dblScale = sqrt(M_PI / fabs(dblRate));
+		elm.m_dblSign = dblRate > 0 ? 1 : -1;
+		elm.m_dblU0 = dblFromInflection / elm.m_dblScale;
+		elm.m_dblCos = cos(dblInflection);
+		elm.m_dblSin = sin(dblInflection);
+
+		fresnel(elm.m_dblU0, elm.m_dblC0, elm.m_dblS0);
+	}
+
+	// Samples close enough for the chords to seed the projections.
+	double
+		dblMaxCurvature = std::max(fabs(startCurvature), fabs(endCurvature));
+	size_t
+		n = (size_t) ceil(dblMaxCurvature * length / SAMPLE_ANGLE) + 1;
+
+	if (n < 2)
+		n = 2;
+	if (type == aeSpiral && n < 5)
+		n = 5;
+
+	elm.m_intFirstSample = m_aSamples.size();
+	elm.m_intSampleCount = n;
+
+	Rectangle2D
+		rctBox(INFINITY, INFINITY, -INFINITY, -INFINITY);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		Point2D
+			pnt = i == 0 ? elm.start : elm.pointAt(length * i / (n - 1));
+
+		m_aSamples.push_back(pnt);
+		rctBox.left = std::min(rctBox.left, pnt.x);
+		rctBox.bottom = std::min(rctBox.bottom, pnt.y);
+		rctBox.right = std::max(rctBox.right, pnt.x);
+		rctBox.top = std::max(rctBox.top, pnt.y);
+	}
+
+	// The curve strays from a chord of length h by at most h^2 k / 8.
+	double
+		h = length / (n - 1),
+		dblMargin = h * h * dblMaxCurvature / 8 * 1.01;
+
+	rctBox.left -= dblMargin;
+	rctBox.bottom -= dblMargin;
+	rctBox.right += dblMargin;
+	rctBox.top += dblMargin;
+
+	m_pntEnd = elm.pointAt(length);
+	m_dblEndDirection = elm.directionAt(length);
+	m_dblEndCurvature = endCurvature;
+	m_aElements.push_back(elm);
+	m_aStations.push_back(elm.station + length);
+
+	// The tree doubles when full, so building it costs O(n) amortized.
+	size_t
+		intIndex = m_aElements.size() - 1;
+
+	if (intIndex >= m_intLeaves)
+	{
+		std::vector<Rectangle2D>
+			aLeaves(m_aBoxes.begin() + m_intLeaves, m_aBoxes.end());
+
+		m_intLeaves = m_intLeaves == 0 ? 1 : 2 * m_intLeaves;
+		aLeaves.resize(m_intLeaves, Rectangle2D(INFINITY, INFINITY, -INFINITY, -INFINITY));
+		m_aBoxes.assign(m_intLeaves, Rectangle2D(INFINITY, INFINITY, -INFINITY, -INFINITY));
+		m_aBoxes.insert(m_aBoxes.end(), aLeaves.begin(), aLeaves.end());
+		m_aBoxes[m_intLeaves + intIndex] = rctBox;
+		buildTree();
+	}
+	else
+	{
+		m_aBoxes[m_intLeaves + intIndex] = rctBox;
+
+		for (size_t i = (m_intLeaves + intIndex) / 2; i > 0; i /= 2)
+		{
+			Rectangle2D
+				&rct = m_aBoxes[i];
+
+			rct.left = std::min(rct.left, rctBox.left);
+			rct.bottom = std::min(rct.bottom, rctBox.bottom);
+			rct.right = std::max(rct.right, rctBox.right);
+			rct.top = std::max(rct.top, rctBox.top);
+		}
+	}
+}
+
+void
+Alignment::buildTree()
+{
+	for (size_t i = m_intLeaves - 1; i > 0; i--)
+	{
+		const Rectangle2D
+			&rct1 = m_aBoxes[2 * i],
+			&rct2 = m_aBoxes[2 * i + 1];
+
+		m_aBoxes[i] = Rectangle2D(std::min(rct1.left, rct2.left), std::min(rct1.bottom, rct2.bottom),
+			std::max(rct1.right, rct2.right), std::max(rct1.top, rct2.top));
+	}
+}
+
+size_t
+Alignment::elementAt(double station) const
+{
+	if (!(station >= m_aStations.front() && station <= m_aStations.back()) || m_aElements.empty())
+		RAISE(EAlignment, alStationOutOfRange);
+
+	return std::upper_bound(m_aStations.begin() + 1, m_aStations.end() - 1, station) - m_aStations.begin() - 1;
+}
+
+Point2D
+Alignment::pointAt(double station) const
+{
+	size_t
+		e = elementAt(station);
+
+	return m_aElements[e].pointAt(station - m_aStations[e]);
+}
+
+Point2D
+Alignment::pointAt(double station, double offset) const
+{
+	size_t
+		e = elementAt(station);
+	double
+		s = station - m_aStations[e],
+		dblAngle = m_aElements[e].directionAt(s);
+
+	return m_aElements[e].pointAt(s) + Point2D(-sin(dblAngle), cos(dblAngle)) * offset;
+}
+
+Angle
+Alignment::directionAt(double station) const
+{
+	size_t
+		e = elementAt(station);
+
+	return m_aElements[e].directionAt(station - m_aStations[e]);
+}
+
+double
+Alignment::curvatureAt(double station) const
+{
+	size_t
+		e = elementAt(station);
+
+	return m_aElements[e].curvatureAt(station - m_aStations[e]);
+}
+
+double
+Alignment::projectElement(size_t index, const Point2D &pnt) const
+{
+	const AlignmentElement
+		&elm = m_aElements[index];
+	double
+		k = elm.startCurvature,
+		dblLength = elm.length;
+
+	if (k == elm.endCurvature)
+	{
+		Point2D
+			dir(cos(elm.direction), sin(elm.direction)),
+			v = pnt - elm.start;
+
+		if (k == 0)
+			return std::clamp(v.x * dir.x + v.y * dir.y, 0.0, dblLength);
+
+		// The angle turned around the center, taken in the turn of the arc centered on its middle.
+		Point2D
+			pntCenter = elm.start + Point2D(-dir.y, dir.x) / k,
+			v0 = elm.start - pntCenter,
+			vq = pnt - pntCenter;
+		double
+			dblMid = k * dblLength / 2,
+			dblAngle = atan2(v0.vectorProduct(vq), v0.x * vq.x + v0.y * vq.y);
+
+		dblAngle = dblMid + remainder(dblAngle - dblMid, 2 * M_PI);
+
+		return std::clamp(dblAngle / k, 0.0, dblLength);
+	}
+
+	// Spirals: the nearest chord of the samples, then Newton on (P(s) - pnt) . T(s) = 0 whose derivative is
+	// 1 + k(s) (P(s) - pnt) . N(s).
+	const Point2D
+		*pSamples = m_aSamples.data() + elm.m_intFirstSample;
+	size_t
+		n = elm.m_intSampleCount;
+	double
+		h = dblLength / (n - 1),
+		dblBest = INFINITY,
+		s = 0;
+
+	for (size_t i = 0; i + 1 < n; i++)
+	{
+		Point2D
+			d = pSamples[i + 1] - pSamples[i],
+			v = pnt - pSamples[i];
+		double
+			dblLen2 = d.x * d.x + d.y * d.y,
+			t = dblLen2 > 0 ? std::clamp((v.x * d.x + v.y * d.y) / dblLen2, 0.0, 1.0) : 0;
+		Point2D
+			w = v - d * t;
+		double
+			dblDist2 = w.x * w.x + w.y * w.y;
+
+		if (dblDist2 < dblBest)
+		{
+			dblBest = dblDist2;
+			s = (i + t) * h;
+		}
+	}
+
+	double
+		dblLow = std::max(s - h, 0.0),
+		dblHigh = std::min(s + h, dblLength);
+
+	for (int i = 0; i < 16; i++)
+	{
+		Point2D
+			v = elm.pointAt(s) - pnt;
+		double
+			dblAngle = elm.directionAt(s),
+			c = cos(dblAngle),
+			sn = sin(dblAngle),
+			f = v.x * c + v.y * sn,
+			df = 1 + elm.curvatureAt(s) * (v.y * c - v.x * sn);
+
+		if (!(df > 0))
+			break;
+
+		double
+			dblNext = std::clamp(s - f / df, dblLow, dblHigh);
+
+		if (fabs(dblNext - s) <= 1e-12 * (1 + dblLength))
+		{
+			s = dblNext;
+			break;
+		}
+
+		s = dblNext;
+	}
+
+	return s;
+}
+
+bool
+Alignment::project(const Point2D &pnt, StationOffset &res) const
+{
+	size_t
+		hint = 0;
+
+	return project(pnt, res, hint);
+}
+
+bool
+Alignment::project(const Point2D &pnt, StationOffset &res, size_t &hint) const
+{
+	size_t
+		n = m_aElements.size();
+
+	if (n == 0)
+		RAISE(EAlignment, alEmpty);
+
+	if (hint >= n)
+		hint = 0;
+
+	size_t
+		intBest = hint;
+	double
+		dblBestS = projectElement(hint, pnt),
+		dblBest = (m_aElements[hint].pointAt(dblBestS) - pnt).dist();
+
+	// Depth first through the boxes, the nearer child first; the stack holds at most one sibling per level.
+	size_t
+		aStack[2 * sizeof(size_t) * CHAR_BIT],
+		intTop = 0;
+
+	aStack[intTop++] = 1;
+
+	while (intTop > 0)
+	{
+		size_t
+			intNode = aStack[--intTop];
+		const Rectangle2D
+			&rct = m_aBoxes[intNode];
+		double
+			dx = std::max(std::max(rct.left - pnt.x, pnt.x - rct.right), 0.0),
+			dy = std::max(std::max(rct.bottom - pnt.y, pnt.y - rct.top), 0.0);
+
+		if (dx * dx + dy * dy >= dblBest * dblBest)
+			continue;
+
+		if (intNode >= m_intLeaves)
+		{
+			size_t
+				e = intNode - m_intLeaves;
+
+			if (e == intBest)
+				continue;
+
+			double
+				s = projectElement(e, pnt),
+				dblDist = (m_aElements[e].pointAt(s) - pnt).dist();
+
+			if (dblDist < dblBest)
+			{
+				dblBest = dblDist;
+				dblBestS = s;
+				intBest = e;
+			}
+
+			continue;
+		}
+
+		const Rectangle2D
+			&rct1 = m_aBoxes[2 * intNode],
+			&rct2 = m_aBoxes[2 * intNode + 1];
+		double
+			d1 = std::max(std::max(rct1.left - pnt.x, pnt.x - rct1.right), 0.0) +
+				std::max(std::max(rct1.bottom - pnt.y, pnt.y - rct1.top), 0.0),
+			d2 = std::max(std::max(rct2.left - pnt.x, pnt.x - rct2.right), 0.0) +
+				std::max(std::max(rct2.bottom - pnt.y, pnt.y - rct2.top), 0.0);
+
+		aStack[intTop++] = d1 <= d2 ? 2 * intNode + 1 : 2 * intNode;
+		aStack[intTop++] = d1 <= d2 ? 2 * intNode : 2 * intNode + 1;
+	}
+
+	hint = intBest;
+
+	const AlignmentElement
+		&elm = m_aElements[intBest];
+	double
+		dblAngle = elm.directionAt(dblBestS);
+	Point2D
+		v = pnt - elm.pointAt(dblBestS);
+	double
+		dblAlong = v.x * cos(dblAngle) + v.y * sin(dblAngle);
+
+	res.station = m_aStations[intBest] + dblBestS;
+	res.offset = v.y * cos(dblAngle) - v.x * sin(dblAngle);
+
+	// Beyond the ends, along the tangent lines there.
+	if ((intBest == 0 && dblBestS == 0 && dblAlong < 0) || (intBest == n - 1 && dblBestS == elm.length && dblAlong > 0))
+	{
+		res.station += dblAlong;
+
+		return false;
+	}
+
+	return true;
+}
+
+void
+Alignment::pointsAt(const std::vector<double> &stations, PointBuffer &pnts) const
+{
+	pnts.resize(stations.size());
+
+	parallelFor(0, stations.size(), ALIGNMENT_GRAIN, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			pnts.setItem(i, pointAt(stations[i]));
+	});
+}
+
+void
+Alignment::projectBatch(const PointBuffer &pnts, std::vector<StationOffset> &res) const
+{
+	res.resize(pnts.size());
+
+	parallelFor(0, pnts.size(), ALIGNMENT_GRAIN, [&](size_t first, size_t last) {
+		size_t
+			hint = 0;
+
+		for (size_t i = first; i < last; i++)
+			project(pnts.getItem(i), res[i], hint);
+	});
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,263 @@
+/***
+ * CivilAlignment.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_ALIGNMENT
+#define __CIVIL_ALIGNMENT
+
+#include <limits>
+#include <vector>
+
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilBuffer2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(alInvalidLength);
+	DECLARE_ERROR_CODE(alInvalidRadius);
+	DECLARE_ERROR_CODE(alStationOutOfRange);
+	DECLARE_ERROR_CODE(alEmpty);
+
+	BEGIN_DECLARE_ERROR(EAlignment)
+		DECLARE_ERROR(alInvalidLength, "The length of an element must be positive")
+		DECLARE_ERROR(alInvalidRadius, "The radius of an arc must be nonzero and finite")
+		DECLARE_ERROR(alStationOutOfRange, "Station outside the alignment")
+		DECLARE_ERROR(alEmpty, "The alignment has no elements")
+	END_DECLARE_ERROR;
+
+	// fresnel;
+	//
+	// Fresnel integrals C(x) = integral of cos(pi t^2 / 2) and S(x) = integral of sin(pi t^2 / 2) from 0 to x:
+	// ---- power series up to |x| = 1.5, a continued fraction up to 6 and asymptotic expansions beyond; the
+	//      absolute error is a few units of 1e-15.
+	void fresnel(double x, double &c, double &s);
+
+	enum AlignmentElementEnum
+	{
+		aeTangent,
+		aeArc,
+		aeSpiral
+	};
+
+	// AlignmentElement;
+	//
+	// One element of an alignment. The curvature varies linearly along it, from "startCurvature" to
+	// ---- "endCurvature": constant zero on tangents, constant on arcs and linear on spirals (clothoids).
+	//      Curvatures are positive when turning left (counterclockwise) and directions are measured
+	//      counterclockwise from the X axis, in radians.
+	struct AlignmentElement
+	{
+	public:
+
+		AlignmentElementEnum
+			type = aeTangent;
+		double
+			station = 0,
+			length = 0;
+		Point2D
+			start;
+		double
+			direction = 0,
+			startCurvature = 0,
+			endCurvature = 0;
+
+		double curvatureAt(double s) const
+		{
+			return startCurvature + (endCurvature - startCurvature) * s / length;
+		}
+		double directionAt(double s) const
+		{
+			return direction + (startCurvature + (endCurvature - startCurvature) * s / (2 * length)) * s;
+		}
+
+		// pointAt;
+		//
+		// Point at the distance "s" from the start of the element, 0 <= s <= length.
+		// ----
+		Point2D pointAt(double s) const;
+
+	private:
+
+		friend struct Alignment;
+
+		// Frame of the clothoid of a spiral: its points are start + scale * R(theta) * (C(u) - C(u0),
+		// sign * (S(u) - S(u0))) with u = u0 + s / scale. Spirals whose inflection point is too far
+		// away for the Fresnel integrals to keep their precision are integrated numerically instead.
+		bool
+			m_blnFresnel = false;
+		double
+			m_dblScale = 0,
+			m_dblSign = 0,
+			m_dblU0 = 0,
+			m_dblC0 = 0,
+			m_dblS0 = 0,
+			m_dblCos = 1,
+			m_dblSin = 0;
+		// Samples used to seed the projections and to bound the element, see Alignment.
+		size_t
+			m_intFirstSample = 0,
+			m_intSampleCount = 0;
+
+	}; /* AlignmentElement */
+
+	// StationOffset;
+	//
+	// Position relative to an alignment: the station of the nearest point on it and the distance from
+	// ---- there, positive on the left.
+	struct StationOffset
+	{
+	public:
+
+		double
+			station = 0,
+			offset = 0;
+
+	}; /* StationOffset */
+
+	// Alignment;
+	//
+	// Horizontal alignment made of tangents, circular arcs and spirals laid one after another, each one
+	// ---- starting where the previous one ends and in its direction.
+	//
+	//      A station is found in O(log n) by bisection of the cumulative stations. Projections walk a tree of
+	//      bounding boxes over consecutive elements, starting with the element of the previous point, so
+	//      points that follow the alignment cost about one element each.
+	struct Alignment
+	{
+	public:
+
+		// Radius of the tangent end of a spiral.
+		static constexpr double
+			STRAIGHT = std::numeric_limits<double>::infinity();
+
+		Alignment(const Point2D &start = NULL_POINT, const Angle &direction = 0, double startStation = 0);
+
+	private:
+
+		std::vector<AlignmentElement>
+			m_aElements;
+		// Start station of every element and the end station.
+		std::vector<double>
+			m_aStations;
+		Point2D
+			m_pntEnd;
+		double
+			m_dblEndDirection,
+			m_dblEndCurvature = 0;
+		std::vector<Point2D>
+			m_aSamples;
+		// Implicit binary tree of boxes over the elements: node i has children 2i and 2i + 1 and the
+		// leaves start at m_intLeaves.
+		size_t
+			m_intLeaves = 0;
+		std::vector<Rectangle2D>
+			m_aBoxes;
+
+		void addElement(AlignmentElementEnum type, double length, double startCurvature, double endCurvature);
+		void buildTree();
+		// Distance along element "index" of the point nearest to "pnt".
+		double projectElement(size_t index, const Point2D &pnt) const;
+
+	public:
+
+		size_t getElementCount() const
+		{
+			return m_aElements.size();
+		}
+		const AlignmentElement &getElement(size_t index) const
+		{
+			return m_aElements[index];
+		}
+
+		double getStartStation() const
+		{
+			return m_aStations.front();
+		}
+		double getEndStation() const
+		{
+			return m_aStations.back();
+		}
+		double getLength() const
+		{
+			return getEndStation() - getStartStation();
+		}
+		Point2D getEndPoint() const
+		{
+			return m_pntEnd;
+		}
+		Angle getEndDirection() const
+		{
+			return m_dblEndDirection;
+		}
+		double getEndCurvature() const
+		{
+			return m_dblEndCurvature;
+		}
+
+		// Builders.
+		//
+		// Append an element at the end. Radii are positive for curves to the left. Raise EAlignment for
+		// lengths that are not positive and for arcs of zero or infinite radius. A spiral goes from
+		// "startRadius" to "endRadius", either of which may be STRAIGHT.
+		void addTangent(double length);
+		void addArc(double length, double radius);
+		void addSpiral(double length, double startRadius, double endRadius);
+
+		// elementAt;
+		//
+		// Index of the element that holds "station"; a station between two elements belongs to the second.
+		// ---- Raises EAlignment outside the alignment.
+		size_t elementAt(double station) const;
+
+		// Geometry at a station. Raise EAlignment outside the alignment.
+		Point2D pointAt(double station) const;
+		Point2D pointAt(double station, double offset) const;
+		Angle directionAt(double station) const;
+		double curvatureAt(double station) const;
+
+		// project;
+		//
+		// Station and offset of "pnt". Points whose nearest point on the alignment is one of its ends are
+		// ---- projected on the tangent line there, so their stations fall outside the alignment; false is
+		//      returned for them. The second form starts from element "hint" and leaves in it the element
+		//      found. Raises EAlignment when the alignment is empty.
+		bool project(const Point2D &pnt, StationOffset &res) const;
+		bool project(const Point2D &pnt, StationOffset &res, size_t &hint) const;
+
+		// Batch queries.
+		//
+		// Points at the given stations, and stations and offsets of the points of a buffer, as above. The
+		// work is split in pieces that run on the shared pool; each piece starts every projection from the
+		// element of its previous point, so points ordered along the alignment are the fastest.
+		void pointsAt(const std::vector<double> &stations, PointBuffer &pnts) const;
+		void projectBatch(const PointBuffer &pnts, std::vector<StationOffset> &res) const;
+
+	}; /* Alignment */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_ALIGNMENT
@@ -1,4 +1,5 @@
 #include "CivilAngle.h"
+#include "CivilAngleIO.h"
 
 #include <math.h>
 #include <iostream>
@@ -17,89 +18,54 @@ namespace GA2D
  * ---------------------------------------------------------------------------------------------------------------------------------------------------
  */
 
-const Angle
-	Angle::ANGLE_45 = Angle(0, 45, 0, 0),
-	Angle::ANGLE_90 = Angle(0, 90, 0, 0),
-	Angle::ANGLE_180 = Angle(0, 180, 0, 0),
-	Angle::ANGLE_360 = Angle(1, 0, 0, 0);
-regex
-	Angle::m_diag = regex("^(-?[0-9]+)(?:([0-5]?[0-9])')?(?:([0-5]?[0-9])\")?$", regex_constants::optimize);
-short int
-	Angle::m_turnsValid = 0,
-	Angle::m_degreesValid = 0,
-	Angle::m_minutesValid = 0,
-	Angle::m_secondsValid = 0;
-
-void
-Angle::calcRadians()
-{
-	m_dblRadians = m_degrees + ((double) m_minutes / 60) + ((double) m_seconds / 3600);
-	m_dblRadians = M_PI * m_dblRadians / 180;
-	m_dblRadians += m_turns * M_PI * 2;
-}
+// A millionth of an arc second, added before each truncation so that an angle built from whole degrees,
+// minutes and seconds gets the same components back despite the rounding of the radians.
+static const double
+	DMS_TOLERANCE = 1e-6;
 
-void
-Angle::calcDegrees()
+Angle::Components
+Angle::calcDegrees() const
 {
+	Components
+		dms;
 	double
 		dblDecimal = 180 * (m_dblRadians / M_PI);
 	
-	m_turns = (short int) floor(abs(dblDecimal) / 360);
+	dms.turns = (short int) floor((abs(dblDecimal) + DMS_TOLERANCE / 3600) / 360);
 
 	if (dblDecimal < 0)
-		dblDecimal += (m_turns * 360);
+		dblDecimal += (dms.turns * 360);
 	else
-		dblDecimal -= (m_turns * 360);
+		dblDecimal -= (dms.turns * 360);
 
 	double
-		dblMinute;
+		dblSeconds;
+
+	dms.degrees = (short int) floor(dblDecimal + DMS_TOLERANCE / 3600);
+	dblSeconds = abs(dblDecimal - dms.degrees) * 3600 + DMS_TOLERANCE;
+	dms.minutes = (signed char) floor(dblSeconds / 60);
+	dms.seconds = (signed char) floor(dblSeconds - dms.minutes * 60);
 
-	m_degrees = (short int) floor(dblDecimal);
-	dblMinute = abs((dblDecimal - m_degrees) * 60);
-	m_minutes = (short int) floor(dblMinute);
-	m_seconds = (short int) floor((dblMinute - m_minutes) * 60);
+	return dms;
+}
+
+string
+Angle::format(AngleUnitEnum unit) const
+{
+	char
+		chr[64],
+		*end = formatAngle(chr, chr + sizeof(chr), *this, unit, (unit == auDegrees || unit == auBearing) ? 0 : 6);
+
+	return end ? string(chr, end) : string();
 }
 
 bool
 Angle::validateString(const string &str)
 {
-	std::cmatch
-		m;
-
-	if (regex_match(str.c_str(), m, m_diag))
-	{
-		short int
-			intDeg;
-		std::cmatch::iterator
-			it = m.end();
-
-		m_turnsValid = 0;
-		m_degreesValid = 0;
-		m_minutesValid = 0;
-		m_secondsValid = 0;
-
-		it--;
-		if (it->matched)
-			m_secondsValid = atoi(it->str().c_str());
-		it--;
-		if (it->matched)
-			m_minutesValid = atoi(it->str().c_str());
-		it--;
-		if (it->matched)
-		{
-			intDeg = atoi(it->str().c_str());
-			m_turnsValid = (short int)floor(abs(intDeg) / 360);
-
-			if (m_turnsValid > 0)
-				m_degreesValid = intDeg - m_turnsValid * 360;
-			else
-				m_degreesValid = intDeg + m_turnsValid * 360;
-		}
-
-		return true;
-	}
-	else
-		return false;
+	Angle
+		ang;
+
+	return parseAngle(str.data(), str.data() + str.size(), ang) == apOk;
 }
 
 } // namespace GA2D
@@ -10,7 +10,6 @@
 #include <math.h>
 #include <string>
 #include <limits.h>
-#include <regex>
 
 #include "..\UtilsLibrary\CivilError.h"
 #include "..\UtilsLibrary\CivilRange.h"
@@ -34,182 +33,223 @@ namespace CIVIL::MATH::GA2D
 	enum AngleUnitEnum
 	{
 		auRadians,
-		auDegrees
+		auDegrees,
+		auDecimalDegrees,
+		auGons,
+		auBearing
 	};
 
 	struct Angle
 	{
 	public:
 
-		Angle() = default;
-		Angle(double ang) :
-			m_dblRadians(ang)
-		{
-			calcDegrees();
-		}
-		Angle(TurnsType turns, DegreesType deg, MinutesType min, SecondsType sec) :
+		constexpr Angle() = default;
+		constexpr Angle(double ang) :
+			m_dblRadians(ang),
+			m_blnDMSValid(false)
+		{}
+		constexpr Angle(TurnsType turns, DegreesType deg, MinutesType min, SecondsType sec) :
+			m_dblRadians(toRadians(turns, deg, min, sec)),
 			m_turns(turns),
 			m_degrees(deg),
-			m_minutes(min),
-			m_seconds(sec)
-		{
-			calcRadians();
-		}
+			m_minutes((signed char) min),
+			m_seconds((signed char) sec),
+			m_blnDMSValid(true)
+		{}
 
 	private:
 
+		// Only the radians are kept up to date by arithmetic, so arithmetic and comparisons never touch the
+		// degrees/minutes/seconds. Those are stored only when the angle is built from them or changed through
+		// a setter (m_blnDMSValid); otherwise every getter derives them from the radians. Const members never
+		// write, so one Angle may be read from any number of threads and a constexpr Angle may be copied during
+		// constant evaluation. The components fill what would otherwise be padding: an Angle is 16 bytes.
 		double
 			m_dblRadians = 0;
 		short int
 			m_turns = 0,
-			m_degrees = 0,
+			m_degrees = 0;
+		signed char
 			m_minutes = 0,
 			m_seconds = 0;
+		bool
+			m_blnDMSValid = true;
+
+		struct Components
+		{
+		public:
+
+			short int
+				turns,
+				degrees;
+			signed char
+				minutes,
+				seconds;
+
+		}; /* Components */
 
-		void calcRadians();
-		void calcDegrees();
+		static constexpr double toRadians(short int turns, short int deg, short int min, short int sec)
+		{
+			return M_PI * (deg + ((double) min / 60) + ((double) sec / 3600)) / 180 + turns * M_PI * 2;
+		}
+
+		Components calcDegrees() const;
+
+		Components getComponents() const
+		{
+			return m_blnDMSValid ? Components{ m_turns, m_degrees, m_minutes, m_seconds } : calcDegrees();
+		}
+		void setComponents(const Components &dms)
+		{
+			m_turns = dms.turns;
+			m_degrees = dms.degrees;
+			m_minutes = dms.minutes;
+			m_seconds = dms.seconds;
+			m_blnDMSValid = true;
+			m_dblRadians = toRadians(m_turns, m_degrees, m_minutes, m_seconds);
+		}
 
 	public:
 
 		TurnsType getTurns() const
 		{
-			return m_turns;
+			return getComponents().turns;
 		}
 		void setTurns(const TurnsType &value)
 		{
-			if (m_turns == value) return;
+			Components
+				dms = getComponents();
+
+			if (dms.turns == value) return;
 
-			m_turns = value;
-			calcRadians();
+			dms.turns = value;
+			setComponents(dms);
 		}
 		DegreesType getDegrees() const
 		{
-			return m_degrees;
+			return getComponents().degrees;
 		}
 		void setDegrees(const DegreesType &value)
 		{
-			if (m_degrees == value) return;
+			Components
+				dms = getComponents();
 
-			m_degrees = value;
-			calcRadians();
+			if (dms.degrees == value) return;
+
+			dms.degrees = value;
+			setComponents(dms);
 		}
 		MinutesType getMinutes() const
 		{
-			return m_minutes;
+			return getComponents().minutes;
 		}
 		void setMinutes(const MinutesType &value)
 		{
-			if (m_minutes == value) return;
+			Components
+				dms = getComponents();
+
+			if (dms.minutes == value) return;
 
-			m_minutes = value;
-			calcRadians();
+			dms.minutes = (signed char) value;
+			setComponents(dms);
 		}
 		SecondsType getSeconds() const
 		{
-			return m_seconds;
+			return getComponents().seconds;
 		}
 		void setSeconds(const SecondsType &value)
 		{
-			if (m_seconds == value) return;
-
-			m_seconds = value;
-			calcRadians();
-		}
-
-		string format(AngleUnitEnum unit) const
-		{
-			char
-				chr[100];
+			Components
+				dms = getComponents();
 
-			switch (unit)
-			{
-			case auDegrees:
-				sprintf_s(chr, "%d%d'%d\"", m_degrees + (m_degrees > 0 ? 1 : -1) * m_turns * 360, m_minutes, m_seconds);
-				break;
-			case auRadians:
-				sprintf_s(chr, "%f", m_dblRadians);
-				break;
-			}
+			if (dms.seconds == value) return;
 
-			return string(chr);
+			dms.seconds = (signed char) value;
+			setComponents(dms);
 		}
 
-		operator double() const
+		// format;
+		//
+		// Text form of the angle in the given unit; see formatAngle (CivilAngleIO.h) for the allocation-free
+		// ---- version used by reports.
+		string format(AngleUnitEnum unit) const;
+
+		constexpr operator double() const
 		{
 			return m_dblRadians;
 		}
 
-		friend Angle operator+(const Angle &ang1, const Angle &ang2)
+		friend constexpr Angle operator+(const Angle &ang1, const Angle &ang2)
 		{
 			return Angle(ang1.m_dblRadians + ang2.m_dblRadians);
 		}
-		friend Angle operator+(const Angle &ang1, double ang2)
+		friend constexpr Angle operator+(const Angle &ang1, double ang2)
 		{
 			return Angle(ang1.m_dblRadians + ang2);
 		}
-		friend Angle operator+(double ang1, const Angle &ang2)
+		friend constexpr Angle operator+(double ang1, const Angle &ang2)
 		{
 			return Angle(ang1 + ang2.m_dblRadians);
 		}
-		Angle &operator+=(const Angle &ang)
+		constexpr Angle &operator+=(const Angle &ang)
 		{
 			*this = *this + ang;
 
 			return *this;
 		}
-		Angle &operator+=(double ang)
+		constexpr Angle &operator+=(double ang)
 		{
 			*this = *this + ang;
 
 			return *this;
 		}
 
-		friend Angle operator-(const Angle &ang1, const Angle &ang2)
+		friend constexpr Angle operator-(const Angle &ang1, const Angle &ang2)
 		{
 			return Angle(ang1.m_dblRadians - ang2.m_dblRadians);
 		}
-		friend Angle operator-(const Angle &ang1, double ang2)
+		friend constexpr Angle operator-(const Angle &ang1, double ang2)
 		{
 			return Angle(ang1.m_dblRadians - ang2);
 		}
-		friend Angle operator-(double ang1, const Angle &ang2)
+		friend constexpr Angle operator-(double ang1, const Angle &ang2)
 		{
 			return Angle(ang1 - ang2.m_dblRadians);
 		}
-		Angle &operator-=(const Angle &ang)
+		constexpr Angle &operator-=(const Angle &ang)
 		{
 			*this = *this - ang;
 
 			return *this;
 		}
-		Angle &operator-=(double ang)
+		constexpr Angle &operator-=(double ang)
 		{
 			*this = *this - ang;
 
 			return *this;
 		}
 
-		bool operator==(const Angle &ang) const
+		constexpr bool operator==(const Angle &ang) const
 		{
 			return m_dblRadians == ang.m_dblRadians;
 		}
-		bool operator!=(const Angle &ang) const
+		constexpr bool operator!=(const Angle &ang) const
 		{
 			return m_dblRadians != ang.m_dblRadians;
 		}
-		bool operator>(const Angle &ang) const
+		constexpr bool operator>(const Angle &ang) const
 		{
 			return m_dblRadians > ang.m_dblRadians;
 		}
-		bool operator>=(const Angle &ang) const
+		constexpr bool operator>=(const Angle &ang) const
 		{
 			return m_dblRadians >= ang.m_dblRadians;
 		}
-		bool operator<(const Angle &ang) const
+		constexpr bool operator<(const Angle &ang) const
 		{
 			return m_dblRadians < ang.m_dblRadians;
 		}
-		bool operator<=(const Angle &ang) const
+		constexpr bool operator<=(const Angle &ang) const
 		{
 			return m_dblRadians <= ang.m_dblRadians;
 		}
@@ -220,22 +260,20 @@ namespace CIVIL::MATH::GA2D
 			ANGLE_180,
 			ANGLE_360;
 
-	private:
-
-		static regex
-			m_diag;
-		static short int
-			m_turnsValid,
-			m_degreesValid,
-			m_minutesValid,
-			m_secondsValid;
-
-	public:
-
+		// validateString;
+		//
+		// Checks whether the string holds an angle in any of the forms accepted by parseAngle (CivilAngleIO.h).
+		// ----
 		static bool validateString(const string &str);
 
 	}; /* Angle */
 
+	inline constexpr Angle
+		Angle::ANGLE_45 = Angle(0, 45, 0, 0),
+		Angle::ANGLE_90 = Angle(0, 90, 0, 0),
+		Angle::ANGLE_180 = Angle(0, 180, 0, 0),
+		Angle::ANGLE_360 = Angle(1, 0, 0, 0);
+
 } // namespace CIVIL::MATH::GA2D
 
 #endif // ifndef __CIVIL_ANGLE
\ No newline at end of file
@@ -0,0 +1,585 @@
+/***
+ * CivilAngleIO.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "CivilAngleIO.h"
+
+#include <charconv>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+/*
+ * Parser.
+ */
+
+static inline bool
+isBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline const char *
+skipBlanks(const char *p, const char *last)
+{
+	while (p < last && isBlank(*p))
+		p++;
+
+	return p;
+}
+
+static inline char
+lower(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+}
+
+// Checks whether [p, last) starts with "word" (lower case), ignoring case.
+static inline bool
+startsWith(const char *p, const char *last, const char *word)
+{
+	for (; *word; p++, word++)
+		if (p >= last || lower(*p) != *word)
+			return false;
+
+	return true;
+}
+
+// Length of the degree mark at p, or 0:  and  in Latin-1 (0xBA, 0xB0), in UTF-8 (0xC2 0xBA, 0xC2 0xB0),
+// or the letter d.
+static inline int
+degreeMark(const char *p, const char *last)
+{
+	unsigned char
+		c = (unsigned char) *p;
+
+	if (c == 0xBA || c == 0xB0 || c == 'd' || c == 'D')
+		return 1;
+
+	if (c == 0xC2 && p + 1 < last && ((unsigned char) p[1] == 0xBA || (unsigned char) p[1] == 0xB0))
+		return 2;
+
+	return 0;
+}
+
+// Reads an unsigned decimal number. "decimals" tells whether it had a fractional part.
+static inline AngleParseEnum
+readNumber(const char *&p, const char *last, double &value, bool &decimals)
+{
+	if (p >= last || !((*p >= '0' && *p <= '9') || *p == '.'))
+		return apInvalidNumber;
+
+	std::from_chars_result
+		res = std::from_chars(p, last, value, std::chars_format::fixed);
+
+	if (res.ec != std::errc())
+		return apInvalidNumber;
+
+	decimals = false;
+	for (const char *q = p; q < res.ptr; q++)
+		if (*q == '.')
+			decimals = true;
+
+	p = res.ptr;
+
+	return apOk;
+}
+
+// Reads the magnitude, in degrees, of a degrees/minutes/seconds value that starts with a number which has
+// already been read into "deg".
+static AngleParseEnum
+readDMS(const char *&p, const char *last, double deg, bool decimals, double &res)
+{
+	int
+		intMark = degreeMark(p, last);
+
+	res = deg;
+
+	if (!intMark)
+		return apOk;
+
+	p = skipBlanks(p + intMark, last);
+
+	double
+		dblMinutes = 0,
+		dblSeconds = 0;
+
+	// Minutes.
+	if (p < last && ((*p >= '0' && *p <= '9') || *p == '.'))
+	{
+		const char
+			*q = p;
+		bool
+			blnDec;
+
+		if (decimals)
+			return apInvalidNumber;
+
+		if (readNumber(q, last, dblMinutes, blnDec) != apOk)
+			return apInvalidNumber;
+
+		q = skipBlanks(q, last);
+
+		if (q < last && *q == '\'' && !(q + 1 < last && q[1] == '\''))
+		{
+			p = skipBlanks(q + 1, last);
+			decimals = blnDec;
+
+			if (dblMinutes >= 60)
+				return apOutOfRange;
+		}
+		else
+			dblMinutes = 0;
+	}
+
+	// Seconds, marked by " or ''.
+	if (p < last && ((*p >= '0' && *p <= '9') || *p == '.'))
+	{
+		bool
+			blnDec;
+
+		if (decimals)
+			return apInvalidNumber;
+
+		if (readNumber(p, last, dblSeconds, blnDec) != apOk)
+			return apInvalidNumber;
+
+		p = skipBlanks(p, last);
+
+		if (p < last && *p == '"')
+			p++;
+		else if (p + 1 < last && p[0] == '\'' && p[1] == '\'')
+			p += 2;
+		else
+			return apInvalidUnit;
+
+		if (dblSeconds >= 60)
+			return apOutOfRange;
+	}
+
+	res = deg + dblMinutes / 60 + dblSeconds / 3600;
+
+	return apOk;
+}
+
+AngleParseEnum
+parseAngle(const char *first, const char *last, Angle &ang)
+{
+	const char
+		*p = skipBlanks(first, last);
+
+	while (last > p && isBlank(last[-1]))
+		last--;
+
+	if (p >= last)
+		return apEmpty;
+
+	double
+		dblValue;
+	bool
+		blnDec;
+	AngleParseEnum
+		res;
+
+	// Quadrant bearing: N|S value E|W.
+	char
+		chrNS = lower(*p);
+
+	if (chrNS == 'n' || chrNS == 's')
+	{
+		char
+			chrEW = lower(last[-1]);
+
+		if (chrEW != 'e' && chrEW != 'w')
+			return apInvalidUnit;
+
+		last--;
+		while (last > p && isBlank(last[-1]))
+			last--;
+
+		p = skipBlanks(p + 1, last);
+
+		if ((res = readNumber(p, last, dblValue, blnDec)) != apOk)
+			return res;
+
+		if ((res = readDMS(p, last, dblValue, blnDec, dblValue)) != apOk)
+			return res;
+
+		if (p != last)
+			return apTrailingChars;
+
+		if (dblValue > 90)
+			return apOutOfRange;
+
+		if (chrNS == 'n')
+			dblValue = chrEW == 'e' ? dblValue : 360 - dblValue;
+		else
+			dblValue = chrEW == 'e' ? 180 - dblValue : 180 + dblValue;
+
+		ang = Angle(dblValue * M_PI / 180);
+
+		return apOk;
+	}
+
+	bool
+		blnNegative = false;
+
+	if (*p == '-' || *p == '+')
+	{
+		blnNegative = *p == '-';
+		p = skipBlanks(p + 1, last);
+	}
+
+	if ((res = readNumber(p, last, dblValue, blnDec)) != apOk)
+		return res;
+
+	p = skipBlanks(p, last);
+
+	double
+		dblRadians;
+
+	if (startsWith(p, last, "rad"))
+	{
+		dblRadians = dblValue;
+		p += startsWith(p, last, "radians") ? 7 : 3;
+	}
+	else if (p < last && lower(*p) == 'g')
+	{
+		if (startsWith(p, last, "grad"))
+			p += 4;
+		else if (startsWith(p, last, "gon"))
+			p += 3;
+		else
+			p++;
+
+		dblRadians = dblValue * M_PI / 200;
+	}
+	else
+	{
+		if ((res = readDMS(p, last, dblValue, blnDec, dblValue)) != apOk)
+			return res;
+
+		dblRadians = dblValue * M_PI / 180;
+	}
+
+	if (skipBlanks(p, last) != last)
+		return apTrailingChars;
+
+	ang = Angle(blnNegative ? -dblRadians : dblRadians);
+
+	return apOk;
+}
+
+/*
+ * Formatters.
+ */
+
+// Mark written after the degrees, the same as Angle::format always used.
+static const char
+	DEGREE_MARK = '\xBA';
+
+static const double
+	POW10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+static inline char *
+writeChar(char *p, char *last, char c)
+{
+	if (!p || p >= last)
+		return nullptr;
+
+	*p = c;
+
+	return p + 1;
+}
+
+// Writes an unsigned integer, left-padded with zeros up to "width" digits.
+static inline char *
+writeUInt(char *p, char *last, unsigned long long value, int width)
+{
+	if (!p)
+		return nullptr;
+
+	char
+		tmp[24];
+	std::to_chars_result
+		res = std::to_chars(tmp, tmp + sizeof(tmp), value);
+	int
+		intLen = (int) (res.ptr - tmp),
+		intPad = width > intLen ? width - intLen : 0;
+
+	if (last - p < intPad + intLen)
+		return nullptr;
+
+	for (int i = 0; i < intPad; i++)
+		*p++ = '0';
+	for (int i = 0; i < intLen; i++)
+		*p++ = tmp[i];
+
+	return p;
+}
+
+static inline char *
+writeFixed(char *p, char *last, double value, int decimals)
+{
+	if (!p)
+		return nullptr;
+
+	std::to_chars_result
+		res = std::to_chars(p, last, value, std::chars_format::fixed, decimals);
+
+	return res.ec == std::errc() ? res.ptr : nullptr;
+}
+
+static inline int
+clampDecimals(int decimals)
+{
+	return decimals < 0 ? 0 : (decimals > 9 ? 9 : decimals);
+}
+
+// Writes a non-negative number of degrees as DMM'SS.ss". The value is rounded once, as an integer count
+// of the last decimal of the seconds, so the carry into minutes and degrees is exact.
+static char *
+writeDMS(char *p, char *last, double degrees, int decimals)
+{
+	decimals = clampDecimals(decimals);
+
+	unsigned long long
+		intScale = (unsigned long long) POW10[decimals],
+		intTotal = (unsigned long long) llround(degrees * 3600 * POW10[decimals]),
+		intFrac = intTotal % intScale;
+
+	intTotal /= intScale;
+
+	p = writeUInt(p, last, intTotal / 3600, 0);
+	p = writeChar(p, last, DEGREE_MARK);
+	p = writeUInt(p, last, intTotal / 60 % 60, 2);
+	p = writeChar(p, last, '\'');
+	p = writeUInt(p, last, intTotal % 60, 2);
+	if (decimals > 0)
+	{
+		p = writeChar(p, last, '.');
+		p = writeUInt(p, last, intFrac, decimals);
+	}
+
+	return writeChar(p, last, '"');
+}
+
+char *
+formatDMS(char *first, char *last, const Angle &ang, int decimals)
+{
+	double
+		dblDegrees = (double) ang * 180 / M_PI;
+
+	if (dblDegrees < 0)
+	{
+		first = writeChar(first, last, '-');
+		dblDegrees = -dblDegrees;
+	}
+
+	return writeDMS(first, last, dblDegrees, decimals);
+}
+
+char *
+formatDecimalDegrees(char *first, char *last, const Angle &ang, int decimals)
+{
+	return writeFixed(first, last, (double) ang * 180 / M_PI, clampDecimals(decimals));
+}
+
+char *
+formatRadians(char *first, char *last, const Angle &ang, int decimals)
+{
+	return writeFixed(first, last, (double) ang, clampDecimals(decimals));
+}
+
+char *
+formatGons(char *first, char *last, const Angle &ang, int decimals)
+{
+	return writeChar(writeFixed(first, last, (double) ang * 200 / M_PI, clampDecimals(decimals)), last, 'g');
+}
+
+char *
+formatBearing(char *first, char *last, const Angle &azimuth, int decimals)
+{
+	double
+		dblAz = fmod((double) azimuth * 180 / M_PI, 360);
+	char
+		chrNS = 'N',
+		chrEW = 'E';
+
+	if (dblAz < 0)
+		dblAz += 360;
+
+	if (dblAz > 270)
+	{
+		dblAz = 360 - dblAz;
+		chrEW = 'W';
+	}
+	else if (dblAz > 180)
+	{
+		dblAz -= 180;
+		chrNS = 'S';
+		chrEW = 'W';
+	}
+	else if (dblAz > 90)
+	{
+		dblAz = 180 - dblAz;
+		chrNS = 'S';
+	}
+
+	first = writeChar(first, last, chrNS);
+	first = writeDMS(first, last, dblAz, decimals);
+
+	return writeChar(first, last, chrEW);
+}
+
+char *
+formatAngle(char *first, char *last, const Angle &ang, AngleUnitEnum unit, int decimals)
+{
+	switch (unit)
+	{
+	case auDegrees:
+		return formatDMS(first, last, ang, decimals);
+	case auDecimalDegrees:
+		return formatDecimalDegrees(first, last, ang, decimals);
+	case auGons:
+		return formatGons(first, last, ang, decimals);
+	case auBearing:
+		return formatBearing(first, last, ang, decimals);
+	default:
+		return formatRadians(first, last, ang, decimals);
+	}
+}
+
+/*
+ * Bulk parser.
+ */
+
+// Bytes below which a buffer is parsed in the calling thread only.
+static const size_t
+	PARALLEL_THRESHOLD = 1 << 16;
+
+// Counts the lines of [first, last); an unterminated line is counted only by the chunk that ends the buffer,
+// which is not the last chunk when a long last line pulled the bounds of several chunks onto the end.
+static size_t
+countLines(const char *first, const char *last, bool endsBuffer)
+{
+	size_t
+		n = 0;
+
+	for (const char *p = first; p < last; p++)
+		if (*p == '\n')
+			n++;
+
+	if (endsBuffer && first < last && last[-1] != '\n')
+		n++;
+
+	return n;
+}
+
+static void
+parseChunk(const char *first, const char *last, Angle *angles, AngleParseEnum *results)
+{
+	while (first < last)
+	{
+		const char
+			*eol = first;
+
+		while (eol < last && *eol != '\n')
+			eol++;
+
+		*results = parseAngle(first, eol, *angles);
+		if (*results != apOk)
+			*angles = Angle();
+
+		angles++;
+		results++;
+		first = eol + 1;
+	}
+}
+
+// Runs fn(0) .. fn(count - 1) on the shared pool.
+template <typename FnType> static void
+runChunks(unsigned int count, const FnType &fn)
+{
+	parallelFor(0, count, 1, [&fn](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			fn((unsigned int) i);
+	});
+}
+
+size_t
+parseAngleLines(const char *buffer, size_t size, std::vector<Angle> &angles, std::vector<AngleParseEnum> &results,
+	unsigned int threadCount)
+{
+	const char
+		*last = buffer + size;
+
+	if (threadCount == 0)
+		threadCount = sharedPool().getConcurrency();
+	if (threadCount == 0 || size < PARALLEL_THRESHOLD)
+		threadCount = 1;
+
+	// Chunk boundaries, each moved forward to the start of a line.
+	std::vector<const char *>
+		bounds(threadCount + 1);
+
+	bounds[0] = buffer;
+	bounds[threadCount] = last;
+	for (unsigned int i = 1; i < threadCount; i++)
+	{
+		const char
+			*p = buffer + size / threadCount * i;
+
+		if (p < bounds[i - 1])
+			p = bounds[i - 1];
+
+		while (p > buffer && p < last && p[-1] != '\n')
+			p++;
+
+		bounds[i] = p;
+	}
+
+	// Two passes: count the lines of every chunk to find where its results go, then parse.
+	std::vector<size_t>
+		offsets(threadCount + 1, 0);
+
+	runChunks(threadCount, [&](unsigned int i) {
+		offsets[i + 1] = countLines(bounds[i], bounds[i + 1], bounds[i + 1] == last);
+	});
+
+	for (unsigned int i = 0; i < threadCount; i++)
+		offsets[i + 1] += offsets[i];
+
+	angles.resize(offsets[threadCount]);
+	results.resize(offsets[threadCount]);
+
+	runChunks(threadCount, [&](unsigned int i) {
+		parseChunk(bounds[i], bounds[i + 1], angles.data() + offsets[i], results.data() + offsets[i]);
+	});
+
+	return offsets[threadCount];
+}
+
+} // namespace CIVIL::MATH::GA2D
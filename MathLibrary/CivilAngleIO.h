@@ -0,0 +1,100 @@
+/***
+ * CivilAngleIO.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_ANGLE_IO
+#define __CIVIL_ANGLE_IO
+
+#include <vector>
+
+#include "..\MathLibrary\CivilAngle.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	enum AngleParseEnum
+	{
+		apOk,
+		apEmpty,
+		apInvalidNumber,
+		apInvalidUnit,
+		apOutOfRange,
+		apTrailingChars
+	};
+
+	// parseAngle;
+	//
+	// Parses one angle from [first, last) without allocating and without shared state, so it may be called
+	// ---- from any number of threads. Leading and trailing blanks are ignored. Accepted forms:
+	//
+	//        -1230'15.5"   degrees, optional minutes and seconds; the degree mark may be  or  in Latin-1
+	//                       or UTF-8, or 'd'. Only the last component may have decimals.
+	//        45.5           decimal degrees, with or without the degree mark.
+	//        N4530'E       quadrant bearing, converted to the azimuth clockwise from north.
+	//        100.5g         gons (also "gon" and "grad").
+	//        1.2rad         radians.
+	//
+	//      "ang" is only written when apOk is returned.
+	AngleParseEnum parseAngle(const char *first, const char *last, Angle &ang);
+
+	// parseAngleLines;
+	//
+	// Parses a buffer holding one angle per line ('\n' or "\r\n" terminated). angles[i] and results[i]
+	// ---- receive the value and the status of line i; blank lines give apEmpty so that the indexes still
+	//      match the line numbers. The buffer is split in "threadCount" chunks at line boundaries (0 = one per
+	//      thread of the shared pool, see CivilThreadPool.h) that are parsed on the pool. Returns the number
+	//      of lines.
+	size_t parseAngleLines(const char *buffer, size_t size, std::vector<Angle> &angles, std::vector<AngleParseEnum> &results,
+		unsigned int threadCount = 0);
+
+	// Formatters.
+	//
+	// Each one writes into [first, last) in the manner of std::to_chars and returns the position past the
+	// last character written, or nullptr when the text does not fit. Nothing is allocated and no terminator
+	// is written. "decimals" is the number of decimals of the seconds for the DMS forms and of the value
+	// itself for the others; values are rounded, carrying into minutes and degrees when needed.
+
+	// formatDMS; -1230'15" (turns included in the degrees), same degree mark as Angle::format.
+	char *formatDMS(char *first, char *last, const Angle &ang, int decimals = 0);
+	// formatDecimalDegrees; -12.504167
+	char *formatDecimalDegrees(char *first, char *last, const Angle &ang, int decimals = 6);
+	// formatRadians; 1.570796
+	char *formatRadians(char *first, char *last, const Angle &ang, int decimals = 6);
+	// formatGons; 100.000000g
+	char *formatGons(char *first, char *last, const Angle &ang, int decimals = 6);
+	// formatBearing; the angle is taken as an azimuth clockwise from north and written as a quadrant
+	// bearing, N4530'00"E; the inverse of the bearing form of parseAngle.
+	char *formatBearing(char *first, char *last, const Angle &azimuth, int decimals = 0);
+
+	// formatAngle;
+	//
+	// Dispatches to the formatter of the given unit.
+	// ----
+	char *formatAngle(char *first, char *last, const Angle &ang, AngleUnitEnum unit, int decimals);
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_ANGLE_IO
@@ -0,0 +1,800 @@
+/***
+ * CivilBatch2D.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "CivilBatch2D.h"
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+// Items per task when a batch is split over the shared pool.
+static const size_t
+	BATCH_GRAIN = 1 << 14;
+
+/*
+ * Circle intersection.
+ */
+
+void
+interceptBatch(const Vector2D &vector, const CircleBuffer &circles, bool aparent, InterceptBuffer &res)
+{
+	size_t
+		n = circles.size();
+	double
+		px = vector.pnt1.x,
+		py = vector.pnt1.y,
+		dx = vector.pnt2.x - px,
+		dy = vector.pnt2.y - py;
+	const double
+		*cx = circles.x.data(),
+		*cy = circles.y.data(),
+		*cr = circles.radius.data();
+
+	res.resize(n);
+
+	unsigned char
+		*kind = res.kind.data();
+	double
+		*t1 = res.t1.data(),
+		*t2 = res.t2.data();
+
+	parallelFor(0, n, BATCH_GRAIN, [&](size_t first, size_t last) {
+		interceptCirclesKernel(px, py, dx, dy, cx + first, cy + first, cr + first, aparent, kind + first, t1 + first,
+			t2 + first, last - first);
+	});
+}
+
+void
+interceptBatch(const Circle2D &circle, const SegmentBuffer &vectors, bool aparent, InterceptBuffer &res)
+{
+	size_t
+		n = vectors.size();
+	double
+		cx = circle.center.x,
+		cy = circle.center.y,
+		r = circle.getRadius();
+	const double
+		*x1 = vectors.x1.data(),
+		*y1 = vectors.y1.data(),
+		*x2 = vectors.x2.data(),
+		*y2 = vectors.y2.data();
+
+	res.resize(n);
+
+	unsigned char
+		*kind = res.kind.data();
+	double
+		*t1 = res.t1.data(),
+		*t2 = res.t2.data();
+
+	parallelFor(0, n, BATCH_GRAIN, [&](size_t first, size_t last) {
+		interceptVectorsKernel(cx, cy, r, x1 + first, y1 + first, x2 + first, y2 + first, aparent, kind + first, t1 + first,
+			t2 + first, last - first);
+	});
+}
+
+// Nearest circle of one piece; index -1 when the piece has none.
+struct NearestHit
+{
+public:
+
+	long long
+		index;
+	double
+		t;
+
+}; /* NearestHit */
+
+long long
+nearestIntercept(const Vector2D &vector, const CircleBuffer &circles, double &t)
+{
+	double
+		px = vector.pnt1.x,
+		py = vector.pnt1.y,
+		dx = vector.pnt2.x - px,
+		dy = vector.pnt2.y - py;
+	const double
+		*cx = circles.x.data(),
+		*cy = circles.y.data(),
+		*cr = circles.radius.data();
+	auto
+		map = [&](size_t first, size_t last) {
+			NearestHit
+				hit;
+
+			hit.index = nearestInterceptKernel(px, py, dx, dy, cx + first, cy + first, cr + first, last - first, hit.t);
+
+			if (hit.index >= 0)
+				hit.index += (long long) first;
+
+			return hit;
+		};
+	// The earlier piece wins ties, so the result is the one of a single pass.
+	auto
+		combine = [](const NearestHit &hit1, const NearestHit &hit2) {
+			return hit2.index < 0 || (hit1.index >= 0 && hit1.t <= hit2.t) ? hit1 : hit2;
+		};
+	NearestHit
+		res = parallelReduce(0, circles.size(), BATCH_GRAIN, NearestHit{ -1, 1 }, map, combine);
+
+	t = res.t;
+
+	return res.index;
+}
+
+/*
+ * Point to segment distance.
+ */
+
+void
+offsetBatch(const SegmentRecord &seg, const PointBuffer &pnts, std::vector<double> &res)
+{
+	size_t
+		n = pnts.size();
+	double
+		ox = seg.origin.x,
+		oy = seg.origin.y,
+		nx = seg.normal.x,
+		ny = seg.normal.y;
+	const double
+		*px = pnts.x.data(),
+		*py = pnts.y.data();
+
+	res.resize(n);
+
+	double
+		*out = res.data();
+
+	for (size_t i = 0; i < n; i++)
+		out[i] = (px[i] - ox) * nx + (py[i] - oy) * ny;
+}
+
+void
+distSegmentBatch(const SegmentRecord &seg, const PointBuffer &pnts, std::vector<double> &res)
+{
+	size_t
+		n = pnts.size();
+	double
+		ox = seg.origin.x,
+		oy = seg.origin.y,
+		dx = seg.direction.x,
+		dy = seg.direction.y,
+		dblInv = seg.invLength2;
+	const double
+		*px = pnts.x.data(),
+		*py = pnts.y.data();
+
+	res.resize(n);
+
+	double
+		*out = res.data();
+
+	for (size_t i = 0; i < n; i++)
+	{
+		double
+			fx = px[i] - ox,
+			fy = py[i] - oy,
+			t = (fx * dx + fy * dy) * dblInv;
+
+		t = t < 0 ? 0 : (t > 1 ? 1 : t);
+		fx -= dx * t;
+		fy -= dy * t;
+
+		out[i] = sqrt(fx * fx + fy * fy);
+	}
+}
+
+/*
+ * Dispatched kernels.
+ */
+
+void
+transformBatch(const Matrix2D &mat, const PointBuffer &pnts, PointBuffer &res)
+{
+	size_t
+		n = pnts.size();
+
+	res.resize(n);
+
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+	double
+		*resX = res.x.data(),
+		*resY = res.y.data();
+
+	parallelFor(0, n, BATCH_GRAIN, [&](size_t first, size_t last) {
+		transformKernel(mat, x + first, y + first, resX + first, resY + first, last - first);
+	});
+}
+
+void
+projectiveBatch(const Matrix2D &mat, const PointBuffer &pnts, PointBuffer &res)
+{
+	size_t
+		n = pnts.size();
+
+	res.resize(n);
+
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+	double
+		*resX = res.x.data(),
+		*resY = res.y.data();
+
+	parallelFor(0, n, BATCH_GRAIN, [&](size_t first, size_t last) {
+		projectiveKernel(mat, x + first, y + first, resX + first, resY + first, last - first);
+	});
+}
+
+void
+distBatch(const PointBuffer &pnts, const Point2D &ref, std::vector<double> &res)
+{
+	size_t
+		n = pnts.size();
+
+	res.resize(n);
+
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+	double
+		*out = res.data();
+
+	parallelFor(0, n, BATCH_GRAIN, [&](size_t first, size_t last) {
+		distRefKernel(x + first, y + first, ref.x, ref.y, out + first, last - first);
+	});
+}
+
+void
+distBatch(const PointBuffer &from, const PointBuffer &to, std::vector<double> &res)
+{
+	size_t
+		n = from.size() < to.size() ? from.size() : to.size();
+
+	res.resize(n);
+
+	const double
+		*x1 = from.x.data(),
+		*y1 = from.y.data(),
+		*x2 = to.x.data(),
+		*y2 = to.y.data();
+	double
+		*out = res.data();
+
+	parallelFor(0, n, BATCH_GRAIN, [&](size_t first, size_t last) {
+		distKernel(x1 + first, y1 + first, x2 + first, y2 + first, out + first, last - first);
+	});
+}
+
+/*
+ * Polynomial atan2.
+ */
+
+// The argument is reduced to t = min(|x|, |y|) / max(|x|, |y|) and, above tan(pi / 8), shifted by pi / 4
+// through (t - 1) / (t + 1), which is folded into the same single division. atan(t) / t is then a
+// polynomial in t^2 on [0, tan^2(pi / 8)], fitted at Chebyshev nodes.
+
+static const double
+	ATAN_HIGH[8] = {
+		9.99999999999244715e-01, -3.33333332769224944e-01, 1.99999930535558146e-01, -1.42853865537521385e-01,
+		1.11034569089474636e-01, -8.99255290615091213e-02, 6.97419768659526540e-02, -3.76551060129140178e-02 },
+	ATAN_FAST[5] = {
+		9.99999981264611093e-01, -3.33327857719248444e-01, 1.99740824155076657e-01, -1.38484902122692072e-01,
+		7.97629180679455818e-02 };
+
+template <int N> static inline double
+atan2Kernel(double y, double x, const double (&c)[N])
+{
+	double
+		ax = abs(x),
+		ay = abs(y),
+		mn = ax < ay ? ax : ay,
+		mx = ax < ay ? ay : ax;
+	bool
+		blnShift = mn > 0.41421356237309504880 * mx;
+	double
+		num = blnShift ? mn - mx : mn,
+		den = blnShift ? mn + mx : mx,
+		t = num / (den != 0 ? den : 1),
+		u = t * t,
+		p = c[N - 1];
+
+	for (int k = N - 2; k >= 0; k--)
+		p = p * u + c[k];
+
+	double
+		a = (blnShift ? M_PI_4 : 0) + t * p;
+
+	a = ay > ax ? M_PI_2 - a : a;
+	a = x < 0 ? M_PI - a : a;
+
+	// The sign of y, -0 included, as atan2 does.
+	return copysign(a, y);
+}
+
+double
+fastAtan2(double y, double x, AccuracyEnum acc)
+{
+	switch (acc)
+	{
+	case acHigh:
+		return atan2Kernel(y, x, ATAN_HIGH);
+	case acFast:
+		return atan2Kernel(y, x, ATAN_FAST);
+	default:
+		return atan2(y, x);
+	}
+}
+
+template <int N> static void
+angleAxeXLoop(const double *dx, double ox, const double *dy, double oy, size_t n, const double (&c)[N], double *out)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		double
+			a = atan2Kernel(dy[i] - oy, dx[i] - ox, c);
+
+		out[i] = a < 0 ? a + 2 * M_PI : a;
+	}
+}
+
+void
+angleAxeXBatch(const PointBuffer &pnts, const Point2D &ref, AccuracyEnum acc, std::vector<double> &res)
+{
+	size_t
+		n = pnts.size();
+	const double
+		*px = pnts.x.data(),
+		*py = pnts.y.data();
+
+	res.resize(n);
+
+	double
+		*out = res.data();
+
+	switch (acc)
+	{
+	case acHigh:
+		angleAxeXLoop(px, ref.x, py, ref.y, n, ATAN_HIGH, out);
+		break;
+	case acFast:
+		angleAxeXLoop(px, ref.x, py, ref.y, n, ATAN_FAST, out);
+		break;
+	default:
+		for (size_t i = 0; i < n; i++)
+		{
+			double
+				a = atan2(py[i] - ref.y, px[i] - ref.x);
+
+			out[i] = a < 0 ? a + 2 * M_PI : a;
+		}
+	}
+}
+
+template <int N> static void
+angleAxeXPairLoop(const double *x1, const double *y1, const double *x2, const double *y2, size_t n, const double (&c)[N], double *out)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		double
+			a = atan2Kernel(y2[i] - y1[i], x2[i] - x1[i], c);
+
+		out[i] = a < 0 ? a + 2 * M_PI : a;
+	}
+}
+
+void
+angleAxeXBatch(const PointBuffer &from, const PointBuffer &to, AccuracyEnum acc, std::vector<double> &res)
+{
+	size_t
+		n = from.size() < to.size() ? from.size() : to.size();
+	const double
+		*x1 = from.x.data(),
+		*y1 = from.y.data(),
+		*x2 = to.x.data(),
+		*y2 = to.y.data();
+
+	res.resize(n);
+
+	double
+		*out = res.data();
+
+	switch (acc)
+	{
+	case acHigh:
+		angleAxeXPairLoop(x1, y1, x2, y2, n, ATAN_HIGH, out);
+		break;
+	case acFast:
+		angleAxeXPairLoop(x1, y1, x2, y2, n, ATAN_FAST, out);
+		break;
+	default:
+		for (size_t i = 0; i < n; i++)
+		{
+			double
+				a = atan2(y2[i] - y1[i], x2[i] - x1[i]);
+
+			out[i] = a < 0 ? a + 2 * M_PI : a;
+		}
+	}
+}
+
+/*
+ * Batch sincos.
+ */
+
+// Cody-Waite reduction by pi / 2 in three parts followed by the fdlibm kernels on [-pi / 4, pi / 4]; the
+// quadrant only swaps and negates the two results.
+
+static const double
+	SINCOS_LIMIT = 1e5,
+	PIO2_1 = 1.57079632673412561417e+00,
+	PIO2_2 = 6.07710050630396597660e-11,
+	PIO2_3 = 2.02226624871116645580e-21,
+	SIN_C[6] = {
+		-1.66666666666666324348e-01, 8.33333333332248946124e-03, -1.98412698298579493134e-04,
+		2.75573137070700676789e-06, -2.50507602534068634195e-08, 1.58969099521155010221e-10 },
+	COS_C[6] = {
+		4.16666666666666019037e-02, -1.38888888888741095749e-03, 2.48015872894767294178e-05,
+		-2.75573143513906633035e-07, 2.08757232129817482790e-09, -1.13596475577881948265e-11 };
+
+void
+sinCosBatch(const std::vector<double> &angles, std::vector<double> &sins, std::vector<double> &coss)
+{
+	size_t
+		n = angles.size();
+	const double
+		*a = angles.data();
+
+	sins.resize(n);
+	coss.resize(n);
+
+	double
+		*s = sins.data(),
+		*c = coss.data();
+	bool
+		blnLarge = false;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		double
+			x = a[i],
+			k = nearbyint(x * M_2_PI),
+			r = ((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3,
+			z = r * r,
+			dblSin = r + r * z * (SIN_C[0] + z * (SIN_C[1] + z * (SIN_C[2] + z * (SIN_C[3] + z * (SIN_C[4] + z * SIN_C[5]))))),
+			dblCos = 1 - 0.5 * z + z * z * (COS_C[0] + z * (COS_C[1] + z * (COS_C[2] + z * (COS_C[3] + z * (COS_C[4] + z * COS_C[5])))));
+		long long
+			q = (long long) k & 3;
+
+		s[i] = q == 0 ? dblSin : (q == 1 ? dblCos : (q == 2 ? -dblSin : -dblCos));
+		c[i] = q == 0 ? dblCos : (q == 1 ? -dblSin : (q == 2 ? -dblCos : dblSin));
+		blnLarge |= abs(x) > SINCOS_LIMIT;
+	}
+
+	if (!blnLarge)
+		return;
+
+	for (size_t i = 0; i < n; i++)
+		if (abs(a[i]) > SINCOS_LIMIT)
+		{
+			s[i] = sin(a[i]);
+			c[i] = cos(a[i]);
+		}
+}
+
+/*
+ * Rectangle batches.
+ */
+
+// Mask words per task; pieces start on a word boundary so no two tasks write the same word.
+static const size_t
+	MASK_GRAIN = BATCH_GRAIN / 64;
+
+// Index of the lowest set bit, by the de Bruijn sequence 0x03f79d71b4cb0a89.
+static const unsigned char
+	DE_BRUIJN_BIT[64] = {
+		0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4, 62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+		63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11, 46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+	};
+
+static inline unsigned int
+lowestBit(uint64_t bits)
+{
+	return DE_BRUIJN_BIT[((bits & (0 - bits)) * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+
+static inline unsigned int
+bitCount(uint64_t bits)
+{
+	bits -= (bits >> 1) & 0x5555555555555555ULL;
+	bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+	bits = (bits + (bits >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+
+	return (unsigned int) ((bits * 0x0101010101010101ULL) >> 56);
+}
+
+static void
+rectangleTestBatch(const RectangleBuffer &rects, const double lo[4], const double hi[4], std::vector<uint64_t> &mask)
+{
+	size_t
+		n = rects.size();
+
+	mask.resize((n + 63) / 64);
+
+	const double
+		*left = rects.left.data(),
+		*bottom = rects.bottom.data(),
+		*right = rects.right.data(),
+		*top = rects.top.data();
+	uint64_t
+		*out = mask.data();
+
+	parallelFor(0, mask.size(), MASK_GRAIN, [&](size_t first, size_t last) {
+		size_t
+			i = first * 64,
+			end = last * 64 < n ? last * 64 : n;
+
+		rectangleTestKernel(left + i, bottom + i, right + i, top + i, end - i, lo, hi, out + first);
+	});
+}
+
+void
+overlapsMask(const Rectangle2D &query, const RectangleBuffer &rects, std::vector<uint64_t> &mask)
+{
+	const double
+		lo[4] = { -INFINITY, -INFINITY, query.left, query.bottom },
+		hi[4] = { query.right, query.top, INFINITY, INFINITY };
+
+	rectangleTestBatch(rects, lo, hi, mask);
+}
+
+void
+overlapsIndexes(const Rectangle2D &query, const RectangleBuffer &rects, std::vector<size_t> &indexes)
+{
+	std::vector<uint64_t>
+		aMask;
+
+	overlapsMask(query, rects, aMask);
+	maskIndexes(aMask, indexes);
+}
+
+void
+containsMask(const Rectangle2D &query, const RectangleBuffer &rects, std::vector<uint64_t> &mask)
+{
+	const double
+		lo[4] = { query.left, query.bottom, -INFINITY, -INFINITY },
+		hi[4] = { INFINITY, INFINITY, query.right, query.top };
+
+	rectangleTestBatch(rects, lo, hi, mask);
+}
+
+void
+containsIndexes(const Rectangle2D &query, const RectangleBuffer &rects, std::vector<size_t> &indexes)
+{
+	std::vector<uint64_t>
+		aMask;
+
+	containsMask(query, rects, aMask);
+	maskIndexes(aMask, indexes);
+}
+
+void
+maskIndexes(const std::vector<uint64_t> &mask, std::vector<size_t> &indexes)
+{
+	size_t
+		words = mask.size(),
+		pieces = (words + MASK_GRAIN - 1) / MASK_GRAIN;
+	const uint64_t
+		*bits = mask.data();
+	std::vector<size_t>
+		aStart(pieces + 1, 0);
+
+	// Bits per piece first; their running sum is the first slot each piece writes in the second pass.
+	parallelFor(0, pieces, 1, [&](size_t first, size_t last) {
+		for (size_t p = first; p < last; p++)
+		{
+			size_t
+				count = 0,
+				end = (p + 1) * MASK_GRAIN < words ? (p + 1) * MASK_GRAIN : words;
+
+			for (size_t w = p * MASK_GRAIN; w < end; w++)
+				count += bitCount(bits[w]);
+
+			aStart[p + 1] = count;
+		}
+	});
+
+	for (size_t p = 0; p < pieces; p++)
+		aStart[p + 1] += aStart[p];
+
+	indexes.resize(aStart[pieces]);
+
+	size_t
+		*out = indexes.data();
+
+	parallelFor(0, pieces, 1, [&](size_t first, size_t last) {
+		for (size_t p = first; p < last; p++)
+		{
+			size_t
+				k = aStart[p],
+				end = (p + 1) * MASK_GRAIN < words ? (p + 1) * MASK_GRAIN : words;
+
+			for (size_t w = p * MASK_GRAIN; w < end; w++)
+				for (uint64_t b = bits[w]; b != 0; b &= b - 1)
+					out[k++] = w * 64 + lowestBit(b);
+		}
+	});
+}
+
+// Sides swapped to infinity, the identity of Rectangle2D::combine.
+static const Rectangle2D
+	NO_BOUNDS(INFINITY, INFINITY, -INFINITY, -INFINITY);
+
+static Rectangle2D
+finishBounds(const Rectangle2D &rect)
+{
+	return rect.left <= rect.right && rect.bottom <= rect.top ? rect : Rectangle2D();
+}
+
+static Rectangle2D
+boundsOfColumns(const double *x1, const double *y1, const double *x2, const double *y2, const double *r, size_t n)
+{
+	auto
+		map = [&](size_t first, size_t last) {
+			double
+				aBounds[4] = { INFINITY, INFINITY, -INFINITY, -INFINITY };
+
+			boundsKernel(x1 + first, y1 + first, x2 + first, y2 + first, r ? r + first : nullptr, last - first, aBounds);
+
+			return Rectangle2D(aBounds[0], aBounds[1], aBounds[2], aBounds[3]);
+		};
+
+	return finishBounds(parallelReduce(0, n, BATCH_GRAIN, NO_BOUNDS, map, Rectangle2D::combine));
+}
+
+// The arrays of structures go through the same reduction; "sides" gives the rectangle of one item.
+template <typename Item, typename Sides>
+static Rectangle2D
+boundsOfItems(const std::vector<Item> &items, const Sides &sides)
+{
+	const Item
+		*p = items.data();
+	auto
+		map = [&](size_t first, size_t last) {
+			Rectangle2D
+				res = NO_BOUNDS;
+
+			for (size_t i = first; i < last; i++)
+			{
+				Rectangle2D
+					rect = sides(p[i]);
+
+				if (isnan(rect.left) || isnan(rect.bottom) || isnan(rect.right) || isnan(rect.top))
+					continue;
+
+				if (rect.left < res.left)
+					res.left = rect.left;
+				if (rect.bottom < res.bottom)
+					res.bottom = rect.bottom;
+				if (rect.right > res.right)
+					res.right = rect.right;
+				if (rect.top > res.top)
+					res.top = rect.top;
+			}
+
+			return res;
+		};
+
+	return finishBounds(parallelReduce(0, items.size(), BATCH_GRAIN, NO_BOUNDS, map, Rectangle2D::combine));
+}
+
+Rectangle2D
+boundsOf(const PointBuffer &pnts)
+{
+	return boundsOfColumns(pnts.x.data(), pnts.y.data(), pnts.x.data(), pnts.y.data(), nullptr, pnts.size());
+}
+
+Rectangle2D
+boundsOf(const RectangleBuffer &rects)
+{
+	return boundsOfColumns(rects.left.data(), rects.bottom.data(), rects.right.data(), rects.top.data(), nullptr, rects.size());
+}
+
+Rectangle2D
+boundsOf(const CircleBuffer &circles)
+{
+	return boundsOfColumns(circles.x.data(), circles.y.data(), circles.x.data(), circles.y.data(), circles.radius.data(),
+		circles.size());
+}
+
+Rectangle2D
+boundsOf(const std::vector<Point2D> &pnts)
+{
+	return boundsOfItems(pnts, [](const Point2D &pnt) {
+		return Rectangle2D(pnt.x, pnt.y, pnt.x, pnt.y);
+	});
+}
+
+Rectangle2D
+boundsOf(const std::vector<Rectangle2D> &rects)
+{
+	return boundsOfItems(rects, [](const Rectangle2D &rect) {
+		return rect;
+	});
+}
+
+Rectangle2D
+boundsOf(const std::vector<Circle2D> &circles)
+{
+	return boundsOfItems(circles, [](const Circle2D &circle) {
+		return circle.boundsRect();
+	});
+}
+
+/*
+ * Liang-Barsky clipping.
+ */
+
+size_t
+clipBatch(const Rectangle2D &window, const SegmentBuffer &vectors, SegmentBuffer &res, std::vector<unsigned char> &visible)
+{
+	size_t
+		n = vectors.size();
+
+	res.resize(n);
+	visible.resize(n);
+
+	const double
+		*x1 = vectors.x1.data(),
+		*y1 = vectors.y1.data(),
+		*x2 = vectors.x2.data(),
+		*y2 = vectors.y2.data();
+	double
+		*resX1 = res.x1.data(),
+		*resY1 = res.y1.data(),
+		*resX2 = res.x2.data(),
+		*resY2 = res.y2.data();
+	unsigned char
+		*out = visible.data();
+
+	return parallelReduce(0, n, BATCH_GRAIN, (size_t) 0, [&](size_t first, size_t last) {
+		size_t
+			count = 0;
+
+		clipKernel(window, x1 + first, y1 + first, x2 + first, y2 + first, resX1 + first, resY1 + first, resX2 + first,
+			resY2 + first, out + first, last - first);
+
+		for (size_t i = first; i < last; i++)
+			count += out[i];
+
+		return count;
+	}, [](size_t a, size_t b) {
+		return a + b;
+	});
+}
+
+} // namespace CIVIL::MATH::GA2D
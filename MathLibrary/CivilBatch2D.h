@@ -0,0 +1,209 @@
+/***
+ * CivilBatch2D.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_BATCH_2D
+#define __CIVIL_BATCH_2D
+
+#include <vector>
+#include <stdint.h>
+
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilBuffer2D.h"
+#include "..\MathLibrary\CivilKernels2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// Results of a batch intersection. Item i holds the IntersectionEnum of the pair i and the parameters
+	// of the points found along the vector, P = pnt1 + t * (pnt2 - pnt1), with t1 <= t2. For iTangent and
+	// iOnePoint both parameters are equal; for iNone they are undefined.
+
+	struct InterceptBuffer
+	{
+	public:
+
+		InterceptBuffer() = default;
+		InterceptBuffer(size_t count) :
+			kind(count),
+			t1(count),
+			t2(count)
+		{}
+
+		std::vector<unsigned char>
+			kind;
+		std::vector<double>
+			t1, t2;
+
+		size_t size() const
+		{
+			return kind.size();
+		}
+		void resize(size_t count)
+		{
+			kind.resize(count);
+			t1.resize(count);
+			t2.resize(count);
+		}
+
+		IntersectionEnum getKind(size_t index) const
+		{
+			return (IntersectionEnum) kind[index];
+		}
+
+	}; /* InterceptBuffer */
+
+	// interceptBatch;
+	//
+	// Intersects one vector against every circle of the buffer, same rules as Circle2D::intercept. Runs
+	// ---- the variant of interceptCirclesKernel selected for the processor (CivilKernels2D.h) on the shared
+	//      pool, as do the two below with their kernels.
+	void interceptBatch(const Vector2D &vector, const CircleBuffer &circles, bool aparent, InterceptBuffer &res);
+
+	// interceptBatch;
+	//
+	// Intersects every vector of the buffer against one circle, same rules as Circle2D::intercept.
+	// ----
+	void interceptBatch(const Circle2D &circle, const SegmentBuffer &vectors, bool aparent, InterceptBuffer &res);
+
+	// nearestIntercept;
+	//
+	// Returns the index of the circle hit first when walking the vector from pnt1 to pnt2 (line-of-sight
+	// ---- test), or -1 when no circle is hit. "t" receives the parameter where the vector enters that
+	//      circle, 0 when pnt1 is already inside it.
+	long long nearestIntercept(const Vector2D &vector, const CircleBuffer &circles, double &t);
+
+	// offsetBatch;
+	//
+	// Signed distance from every point of the buffer to the supporting line of the segment, positive on
+	// ---- the left side, as SegmentRecord::offset.
+	void offsetBatch(const SegmentRecord &seg, const PointBuffer &pnts, std::vector<double> &res);
+
+	// distSegmentBatch;
+	//
+	// Distance from every point of the buffer to the nearest point of the segment, as
+	// ---- SegmentRecord::distSegment.
+	void distSegmentBatch(const SegmentRecord &seg, const PointBuffer &pnts, std::vector<double> &res);
+
+	// transformBatch;
+	//
+	// Applies the matrix to every point of the buffer, as Point2D::transform. "res" may be "pnts" itself.
+	// ---- Runs the SIMD variant selected for the processor (CivilKernels2D.h) on the shared pool, as do the
+	//      two below.
+	void transformBatch(const Matrix2D &mat, const PointBuffer &pnts, PointBuffer &res);
+
+	// projectiveBatch;
+	//
+	// Applies the matrix as a plane projective transform, dividing by the third homogeneous coordinate;
+	// ---- the same as transformBatch when the last row is (0, 0, 1). "res" may be "pnts" itself.
+	void projectiveBatch(const Matrix2D &mat, const PointBuffer &pnts, PointBuffer &res);
+
+	// distBatch;
+	//
+	// Distance from every point of the buffer to "ref", or between the points of the same index of two
+	// ---- buffers (as many as the shorter one holds).
+	void distBatch(const PointBuffer &pnts, const Point2D &ref, std::vector<double> &res);
+	void distBatch(const PointBuffer &from, const PointBuffer &to, std::vector<double> &res);
+
+	// Rectangle queries.
+	//
+	// Test every rectangle of the buffer against "query", sides included, on the shared pool with the SIMD
+	// variant of rectangleTestKernel selected for the processor. overlaps: the two have at least one point in
+	// common; contains: the rectangle lies within the query. The mask forms set bit i % 64 of mask[i / 64] for
+	// every rectangle i that passes, the index forms list those rectangles in increasing order.
+	void overlapsMask(const Rectangle2D &query, const RectangleBuffer &rects, std::vector<uint64_t> &mask);
+	void overlapsIndexes(const Rectangle2D &query, const RectangleBuffer &rects, std::vector<size_t> &indexes);
+	void containsMask(const Rectangle2D &query, const RectangleBuffer &rects, std::vector<uint64_t> &mask);
+	void containsIndexes(const Rectangle2D &query, const RectangleBuffer &rects, std::vector<size_t> &indexes);
+
+	// maskIndexes;
+	//
+	// Positions of the set bits of a mask laid out as above, in increasing order; for masks combined with
+	// ---- & and | before they are listed.
+	void maskIndexes(const std::vector<uint64_t> &mask, std::vector<size_t> &indexes);
+
+	// boundsOf;
+	//
+	// Smallest rectangle holding every item, the Rectangle2D::combine of all of them (circles through
+	// ---- Circle2D::boundsRect), reduced in parallel on the shared pool. Items with NaN coordinates are
+	//      skipped; Rectangle2D() when nothing is left.
+	Rectangle2D boundsOf(const PointBuffer &pnts);
+	Rectangle2D boundsOf(const RectangleBuffer &rects);
+	Rectangle2D boundsOf(const CircleBuffer &circles);
+	Rectangle2D boundsOf(const std::vector<Point2D> &pnts);
+	Rectangle2D boundsOf(const std::vector<Rectangle2D> &rects);
+	Rectangle2D boundsOf(const std::vector<Circle2D> &circles);
+
+	// clipBatch;
+	//
+	// Clips every vector of the buffer to the closed window (Liang-Barsky): res[i] is the part of vector i
+	// ---- inside it, same direction, and visible[i] = 1; when nothing is inside, res[i] is vector i as given
+	//      and visible[i] = 0. End points already inside come out unchanged. "res" may be "vectors" itself.
+	//      Returns the number of visible vectors.
+	size_t clipBatch(const Rectangle2D &window, const SegmentBuffer &vectors, SegmentBuffer &res,
+		std::vector<unsigned char> &visible);
+
+	// Accuracy tiers of the polynomial atan2 used by the angle kernels. The bounds below were measured
+	// against the libm atan2 over 4 million directions, including nearly axial ones:
+	//
+	//   acExact  libm atan2                                       -
+	//   acHigh   8-term polynomial, max 2.7e-13 rad   (5.6e-8")    bound 1e-12 rad
+	//   acFast   5-term polynomial, max 6.8e-9 rad    (1.4e-3")    bound 1e-7 rad
+	enum AccuracyEnum
+	{
+		acExact,
+		acHigh,
+		acFast
+	};
+
+	// fastAtan2;
+	//
+	// Same contract as atan2, result in [-pi, pi], with the accuracy of the selected tier.
+	// ----
+	double fastAtan2(double y, double x, AccuracyEnum acc);
+
+	// angleAxeXBatch;
+	//
+	// Angle from the X axis, in radians within [0, 2 pi), of every point of the buffer taken relative to
+	// ---- "ref"; the batch form of Point2D::angleAxeX.
+	void angleAxeXBatch(const PointBuffer &pnts, const Point2D &ref, AccuracyEnum acc, std::vector<double> &res);
+
+	// angleAxeXBatch;
+	//
+	// Angle from the X axis, in radians within [0, 2 pi), of every vector from[i] -> to[i].
+	// ----
+	void angleAxeXBatch(const PointBuffer &from, const PointBuffer &to, AccuracyEnum acc, std::vector<double> &res);
+
+	// sinCosBatch;
+	//
+	// Sine and cosine of every angle (radians) of the array, for building rotations in bulk. Angles up to
+	// ---- 1e5 rad in magnitude go through a branch-free polynomial kernel (error below 2 ulp of 1); larger
+	//      ones fall back to libm.
+	void sinCosBatch(const std::vector<double> &angles, std::vector<double> &sins, std::vector<double> &coss);
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_BATCH_2D
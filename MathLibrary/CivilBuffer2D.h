@@ -0,0 +1,275 @@
+/***
+ * CivilBuffer2D.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_BUFFER_2D
+#define __CIVIL_BUFFER_2D
+
+#include <vector>
+
+#include "..\MathLibrary\CivilGA2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// Structure-of-arrays containers used by the batch kernels. Each coordinate lives in its own contiguous
+	// column so that a kernel walks every column with unit stride.
+
+	struct PointBuffer
+	{
+	public:
+
+		PointBuffer() = default;
+		PointBuffer(size_t count) :
+			x(count),
+			y(count)
+		{}
+
+		std::vector<double>
+			x, y;
+
+		size_t size() const
+		{
+			return x.size();
+		}
+		void resize(size_t count)
+		{
+			x.resize(count);
+			y.resize(count);
+		}
+		void reserve(size_t count)
+		{
+			x.reserve(count);
+			y.reserve(count);
+		}
+		void clear()
+		{
+			x.clear();
+			y.clear();
+		}
+
+		Point2D getItem(size_t index) const
+		{
+			return Point2D(x[index], y[index]);
+		}
+		void setItem(size_t index, const Point2D &pnt)
+		{
+			x[index] = pnt.x;
+			y[index] = pnt.y;
+		}
+		void add(const Point2D &pnt)
+		{
+			x.push_back(pnt.x);
+			y.push_back(pnt.y);
+		}
+
+	}; /* PointBuffer */
+
+	struct SegmentBuffer
+	{
+	public:
+
+		SegmentBuffer() = default;
+		SegmentBuffer(size_t count) :
+			x1(count),
+			y1(count),
+			x2(count),
+			y2(count)
+		{}
+
+		std::vector<double>
+			x1, y1, x2, y2;
+
+		size_t size() const
+		{
+			return x1.size();
+		}
+		void resize(size_t count)
+		{
+			x1.resize(count);
+			y1.resize(count);
+			x2.resize(count);
+			y2.resize(count);
+		}
+		void reserve(size_t count)
+		{
+			x1.reserve(count);
+			y1.reserve(count);
+			x2.reserve(count);
+			y2.reserve(count);
+		}
+		void clear()
+		{
+			x1.clear();
+			y1.clear();
+			x2.clear();
+			y2.clear();
+		}
+
+		Vector2D getItem(size_t index) const
+		{
+			return Vector2D(x1[index], y1[index], x2[index], y2[index]);
+		}
+		void setItem(size_t index, const Vector2D &vtr)
+		{
+			x1[index] = vtr.pnt1.x;
+			y1[index] = vtr.pnt1.y;
+			x2[index] = vtr.pnt2.x;
+			y2[index] = vtr.pnt2.y;
+		}
+		void add(const Vector2D &vtr)
+		{
+			x1.push_back(vtr.pnt1.x);
+			y1.push_back(vtr.pnt1.y);
+			x2.push_back(vtr.pnt2.x);
+			y2.push_back(vtr.pnt2.y);
+		}
+
+	}; /* SegmentBuffer */
+
+	struct CircleBuffer
+	{
+	public:
+
+		CircleBuffer() = default;
+		CircleBuffer(size_t count) :
+			x(count),
+			y(count),
+			radius(count)
+		{}
+
+		std::vector<double>
+			x, y,
+			radius;
+
+		size_t size() const
+		{
+			return x.size();
+		}
+		void resize(size_t count)
+		{
+			x.resize(count);
+			y.resize(count);
+			radius.resize(count);
+		}
+		void reserve(size_t count)
+		{
+			x.reserve(count);
+			y.reserve(count);
+			radius.reserve(count);
+		}
+		void clear()
+		{
+			x.clear();
+			y.clear();
+			radius.clear();
+		}
+
+		Circle2D getItem(size_t index) const
+		{
+			return Circle2D(Point2D(x[index], y[index]), radius[index]);
+		}
+		void setItem(size_t index, const Circle2D &circ)
+		{
+			x[index] = circ.center.x;
+			y[index] = circ.center.y;
+			radius[index] = circ.getRadius();
+		}
+		void add(const Circle2D &circ)
+		{
+			x.push_back(circ.center.x);
+			y.push_back(circ.center.y);
+			radius.push_back(circ.getRadius());
+		}
+
+	}; /* CircleBuffer */
+
+	// Rectangles are expected normalized, left <= right and bottom <= top.
+	struct RectangleBuffer
+	{
+	public:
+
+		RectangleBuffer() = default;
+		RectangleBuffer(size_t count) :
+			left(count),
+			bottom(count),
+			right(count),
+			top(count)
+		{}
+
+		std::vector<double>
+			left, bottom, right, top;
+
+		size_t size() const
+		{
+			return left.size();
+		}
+		void resize(size_t count)
+		{
+			left.resize(count);
+			bottom.resize(count);
+			right.resize(count);
+			top.resize(count);
+		}
+		void reserve(size_t count)
+		{
+			left.reserve(count);
+			bottom.reserve(count);
+			right.reserve(count);
+			top.reserve(count);
+		}
+		void clear()
+		{
+			left.clear();
+			bottom.clear();
+			right.clear();
+			top.clear();
+		}
+
+		Rectangle2D getItem(size_t index) const
+		{
+			return Rectangle2D(left[index], bottom[index], right[index], top[index]);
+		}
+		void setItem(size_t index, const Rectangle2D &rect)
+		{
+			left[index] = rect.left;
+			bottom[index] = rect.bottom;
+			right[index] = rect.right;
+			top[index] = rect.top;
+		}
+		void add(const Rectangle2D &rect)
+		{
+			left.push_back(rect.left);
+			bottom.push_back(rect.bottom);
+			right.push_back(rect.right);
+			top.push_back(rect.top);
+		}
+
+	}; /* RectangleBuffer */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_BUFFER_2D
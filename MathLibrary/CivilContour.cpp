@@ -0,0 +1,487 @@
+#include "CivilContour.h"
+
+#include <stdint.h>
+#include <math.h>
+#include <algorithm>
+#include <unordered_map>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+// Cell rows per tile.
+static const size_t
+	CONTOUR_TILE = 32;
+
+/*
+ * Cells.
+ */
+
+// Segments of a cell by case, as pairs of cell edges (0 bottom, 1 right, 2 top, 3 left) from the entry to
+// the exit. The case has bit 1 for the bottom left corner above the level, then counterclockwise 2, 4, 8.
+// The two rows differ on the saddles: [0] keeps the corners above apart, [1] joins them through the center.
+static const signed char
+	CELL_CASES[2][16][4] = {
+		{
+			{-1, -1, -1, -1}, { 0,  3, -1, -1}, { 1,  0, -1, -1}, { 1,  3, -1, -1},
+			{ 2,  1, -1, -1}, { 0,  3,  2,  1}, { 2,  0, -1, -1}, { 2,  3, -1, -1},
+			{ 3,  2, -1, -1}, { 0,  2, -1, -1}, { 1,  0,  3,  2}, { 1,  2, -1, -1},
+			{ 3,  1, -1, -1}, { 0,  1, -1, -1}, { 3,  0, -1, -1}, {-1, -1, -1, -1}
+		},
+		{
+			{-1, -1, -1, -1}, { 0,  3, -1, -1}, { 1,  0, -1, -1}, { 1,  3, -1, -1},
+			{ 2,  1, -1, -1}, { 0,  1,  2,  3}, { 2,  0, -1, -1}, { 2,  3, -1, -1},
+			{ 3,  2, -1, -1}, { 0,  2, -1, -1}, { 1,  2,  3,  0}, { 1,  2, -1, -1},
+			{ 3,  1, -1, -1}, { 0,  1, -1, -1}, { 3,  0, -1, -1}, {-1, -1, -1, -1}
+		}
+	};
+
+// Grid edges are numbered 2 * (row * cols + col) for the one from the node eastwards and one more for the
+// one northwards, so that both cells along an edge give it the same number.
+static inline uint64_t
+cellEdge(size_t row, size_t col, size_t cols, int side)
+{
+	switch (side)
+	{
+		case 0:
+			return 2 * (row * cols + col);
+		case 1:
+			return 2 * (row * cols + col + 1) + 1;
+		case 2:
+			return 2 * ((row + 1) * cols + col);
+		default:
+			return 2 * (row * cols + col) + 1;
+	}
+}
+
+// Where the level crosses a grid edge. The same arithmetic from both sides gives the same point.
+static Point2D
+edgePoint(const ElevationGrid &grid, uint64_t edge, double level)
+{
+	size_t
+		cols = grid.getColCount(),
+		k = (size_t) (edge >> 1),
+		row = k / cols,
+		col = k % cols;
+	double
+		za = grid.getItem(row, col);
+
+	if ((edge & 1) == 0)
+	{
+		double
+			t = (level - za) / (grid.getItem(row, col + 1) - za);
+
+		return Point2D(grid.getX(col) + t * grid.getCellWidth(), grid.getY(row));
+	}
+
+	double
+		t = (level - za) / (grid.getItem(row + 1, col) - za);
+
+	return Point2D(grid.getX(col), grid.getY(row) + t * grid.getCellHeight());
+}
+
+struct CellSegment
+{
+public:
+
+	unsigned int
+		level;
+	uint64_t
+		from,
+		to;
+
+	bool operator<(const CellSegment &seg) const
+	{
+		return level != seg.level ? level < seg.level : from < seg.from;
+	}
+
+}; /* CellSegment */
+
+// The segments of the cells of rows [first, last) for the sorted "levels". Each cell finds the levels
+// between its lowest and highest corner by bisection, so a cell costs the same for one level or hundreds.
+static void
+tileSegments(const ElevationGrid &grid, const std::vector<double> &levels, size_t first, size_t last,
+	SaddleModeEnum mode, std::vector<CellSegment> &segs)
+{
+	size_t
+		cols = grid.getColCount();
+
+	for (size_t r = first; r < last; r++)
+	{
+		const double
+			*rowA = grid.getRow(r),
+			*rowB = grid.getRow(r + 1);
+
+		for (size_t c = 0; c + 1 < cols; c++)
+		{
+			double
+				z00 = rowA[c],
+				z10 = rowA[c + 1],
+				z11 = rowB[c + 1],
+				z01 = rowB[c];
+
+			if (isnan(z00) || isnan(z10) || isnan(z11) || isnan(z01))
+				continue;
+
+			double
+				dblLow = std::min(std::min(z00, z10), std::min(z11, z01)),
+				dblHigh = std::max(std::max(z00, z10), std::max(z11, z01));
+
+			if (dblLow == dblHigh)
+				continue;
+
+			// The levels in (low, high].
+			std::vector<double>::const_iterator
+				itFirst = std::upper_bound(levels.begin(), levels.end(), dblLow),
+				itLast = std::upper_bound(itFirst, levels.end(), dblHigh);
+
+			for (std::vector<double>::const_iterator it = itFirst; it != itLast; it++)
+			{
+				double
+					l = *it;
+				int
+					intCase = (z00 >= l) | (z10 >= l) << 1 | (z11 >= l) << 2 | (z01 >= l) << 3,
+					intCenter = mode == smCenter && (z00 + z10 + z11 + z01) / 4 >= l;
+				const signed char
+					*pSides = CELL_CASES[intCenter][intCase];
+
+				for (int k = 0; k < 4 && pSides[k] >= 0; k += 2)
+					segs.push_back({(unsigned int) (it - levels.begin()), cellEdge(r, c, cols, pSides[k]),
+						cellEdge(r, c, cols, pSides[k + 1])});
+			}
+		}
+	}
+}
+
+/*
+ * Stitching.
+ */
+
+struct ContourChain
+{
+public:
+
+	unsigned int
+		level;
+	uint64_t
+		first,
+		last;
+	std::vector<Point2D>
+		points;
+	bool
+		closed;
+
+}; /* ContourChain */
+
+// Joins the segments of a tile into chains, per level. Chains that close on themselves are marked; the
+// others end on the tile seams or on the border of the data.
+static void
+tileChains(const ElevationGrid &grid, const std::vector<double> &levels, std::vector<CellSegment> &segs,
+	std::vector<ContourChain> &chains)
+{
+	std::sort(segs.begin(), segs.end());
+
+	size_t
+		n = segs.size();
+	std::vector<size_t>
+		aNext(n, n);
+	std::vector<unsigned char>
+		aHasPrev(n, 0),
+		aDone(n, 0);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		CellSegment
+			key = {segs[i].level, segs[i].to, 0};
+		std::vector<CellSegment>::iterator
+			it = std::lower_bound(segs.begin(), segs.end(), key);
+
+		if (it != segs.end() && it->level == key.level && it->from == key.from)
+		{
+			aNext[i] = it - segs.begin();
+			aHasPrev[aNext[i]] = 1;
+		}
+	}
+
+	// Open chains first, from the segments nothing leads to; what is left are loops.
+	for (int intPass = 0; intPass < 2; intPass++)
+		for (size_t i = 0; i < n; i++)
+		{
+			if (aDone[i] || (intPass == 0 && aHasPrev[i]))
+				continue;
+
+			ContourChain
+				chn;
+			double
+				l = levels[segs[i].level];
+
+			chn.level = segs[i].level;
+			chn.first = segs[i].from;
+			chn.points.push_back(edgePoint(grid, segs[i].from, l));
+
+			size_t
+				j = i;
+
+			for (; j < n && !aDone[j]; j = aNext[j])
+			{
+				aDone[j] = 1;
+				chn.last = segs[j].to;
+				chn.points.push_back(edgePoint(grid, segs[j].to, l));
+			}
+
+			chn.closed = intPass == 1;
+
+			if (chn.closed)
+				chn.points.pop_back();
+
+			chains.push_back(std::move(chn));
+		}
+}
+
+// Open chains waiting for the rest of their line, indexed by both ends.
+struct ChainJoiner
+{
+public:
+
+	ChainJoiner(size_t levelCount) :
+		m_intLevels(levelCount)
+	{}
+
+private:
+
+	size_t
+		m_intLevels;
+	std::vector<ContourChain>
+		m_aChains;
+	std::vector<size_t>
+		m_aFree;
+	std::unordered_map<uint64_t, size_t>
+		m_aByFirst,
+		m_aByLast;
+
+	uint64_t keyOf(uint64_t edge, unsigned int level) const
+	{
+		return edge * m_intLevels + level;
+	}
+
+	void remove(size_t index)
+	{
+		ContourChain
+			&chn = m_aChains[index];
+
+		m_aByFirst.erase(keyOf(chn.first, chn.level));
+		m_aByLast.erase(keyOf(chn.last, chn.level));
+		chn.points.clear();
+		chn.points.shrink_to_fit();
+		m_aFree.push_back(index);
+	}
+
+public:
+
+	// Adds an open chain, joining it to the pending ones it meets; returns true and leaves the line in
+	// "chn" when that closes it.
+	bool add(ContourChain &chn)
+	{
+		std::unordered_map<uint64_t, size_t>::iterator
+			it;
+
+		while ((it = m_aByLast.find(keyOf(chn.first, chn.level))) != m_aByLast.end())
+		{
+			size_t
+				intPrev = it->second;
+			std::vector<Point2D>
+				aPoints = std::move(m_aChains[intPrev].points);
+
+			aPoints.insert(aPoints.end(), chn.points.begin() + 1, chn.points.end());
+			chn.points = std::move(aPoints);
+			chn.first = m_aChains[intPrev].first;
+			remove(intPrev);
+
+			if (chn.first == chn.last)
+				break;
+		}
+
+		while (chn.first != chn.last && (it = m_aByFirst.find(keyOf(chn.last, chn.level))) != m_aByFirst.end())
+		{
+			size_t
+				intNext = it->second;
+			const std::vector<Point2D>
+				&aPoints = m_aChains[intNext].points;
+
+			chn.points.insert(chn.points.end(), aPoints.begin() + 1, aPoints.end());
+			chn.last = m_aChains[intNext].last;
+			remove(intNext);
+		}
+
+		if (chn.first == chn.last)
+		{
+			chn.points.pop_back();
+			chn.closed = true;
+
+			return true;
+		}
+
+		size_t
+			intIndex = m_aChains.size();
+
+		if (!m_aFree.empty())
+		{
+			intIndex = m_aFree.back();
+			m_aFree.pop_back();
+			m_aChains[intIndex] = std::move(chn);
+		}
+		else
+			m_aChains.push_back(std::move(chn));
+
+		m_aByFirst[keyOf(m_aChains[intIndex].first, m_aChains[intIndex].level)] = intIndex;
+		m_aByLast[keyOf(m_aChains[intIndex].last, m_aChains[intIndex].level)] = intIndex;
+
+		return false;
+	}
+
+	// Hands over the pending chains that "isComplete" accepts.
+	template <typename Pred, typename Emit>
+	void flush(const Pred &isComplete, const Emit &emit)
+	{
+		for (size_t i = 0; i < m_aChains.size(); i++)
+		{
+			ContourChain
+				&chn = m_aChains[i];
+
+			if (chn.points.empty() || !isComplete(chn))
+				continue;
+
+			emit(chn);
+			remove(i);
+		}
+	}
+
+}; /* ChainJoiner */
+
+/*
+ * Contours.
+ */
+
+void
+contourSegments(const ElevationGrid &grid, double level, std::vector<Vector2D> &segments, const ContourOptions &options)
+{
+	segments.clear();
+
+	size_t
+		rows = grid.getRowCount();
+
+	if (rows < 2 || grid.getColCount() < 2 || isnan(level))
+		return;
+
+	std::vector<double>
+		aLevels {level};
+	size_t
+		intTiles = (rows - 1 + CONTOUR_TILE - 1) / CONTOUR_TILE;
+	std::vector<std::vector<CellSegment>>
+		aTiles(intTiles);
+
+	auto runTiles = [&](size_t first, size_t last) {
+		for (size_t t = first; t < last; t++)
+			tileSegments(grid, aLevels, t * CONTOUR_TILE, std::min(rows - 1, (t + 1) * CONTOUR_TILE), options.saddleMode,
+				aTiles[t]);
+	};
+
+	if (options.parallel)
+		parallelFor(0, intTiles, 1, runTiles);
+	else
+		runTiles(0, intTiles);
+
+	for (const std::vector<CellSegment> &aSegs : aTiles)
+		for (const CellSegment &seg : aSegs)
+			segments.push_back(Vector2D(edgePoint(grid, seg.from, level), edgePoint(grid, seg.to, level)));
+}
+
+void
+contourLines(const ElevationGrid &grid, const std::vector<double> &levels, const ContourCallback &callback,
+	const ContourOptions &options)
+{
+	size_t
+		rows = grid.getRowCount(),
+		cols = grid.getColCount();
+	std::vector<double>
+		aLevels;
+
+	for (double l : levels)
+		if (!isnan(l))
+			aLevels.push_back(l);
+
+	std::sort(aLevels.begin(), aLevels.end());
+	aLevels.erase(std::unique(aLevels.begin(), aLevels.end()), aLevels.end());
+
+	if (rows < 2 || cols < 2 || aLevels.empty())
+		return;
+
+	size_t
+		intTiles = (rows - 1 + CONTOUR_TILE - 1) / CONTOUR_TILE,
+		intWave = options.parallel ? 4 * sharedPool().getConcurrency() : 1;
+	ChainJoiner
+		jnr(aLevels.size());
+
+	auto emit = [&](const ContourChain &chn) {
+		callback(aLevels[chn.level], chn.points, chn.closed);
+	};
+
+	for (size_t intFirst = 0; intFirst < intTiles; intFirst += intWave)
+	{
+		size_t
+			intLast = std::min(intTiles, intFirst + intWave);
+		std::vector<std::vector<ContourChain>>
+			aChains(intLast - intFirst);
+
+		auto runTiles = [&](size_t first, size_t last) {
+			std::vector<CellSegment>
+				aSegs;
+
+			for (size_t t = first; t < last; t++)
+			{
+				aSegs.clear();
+				tileSegments(grid, aLevels, t * CONTOUR_TILE, std::min(rows - 1, (t + 1) * CONTOUR_TILE),
+					options.saddleMode, aSegs);
+				tileChains(grid, aLevels, aSegs, aChains[t - intFirst]);
+			}
+		};
+
+		if (options.parallel)
+			parallelFor(intFirst, intLast, 1, runTiles);
+		else
+			runTiles(intFirst, intLast);
+
+		for (std::vector<ContourChain> &aTile : aChains)
+			for (ContourChain &chn : aTile)
+				if (chn.closed || jnr.add(chn))
+					emit(chn);
+
+		// Lines with no end on the top edges of the band cannot grow any more.
+		size_t
+			intFrontier = std::min(rows - 1, intLast * CONTOUR_TILE);
+
+		auto onFrontier = [&](uint64_t edge) {
+			return intFrontier < rows - 1 && (edge & 1) == 0 && (edge >> 1) / cols == intFrontier;
+		};
+
+		jnr.flush([&](const ContourChain &chn) { return !onFrontier(chn.first) && !onFrontier(chn.last); }, emit);
+	}
+}
+
+std::vector<ContourLine>
+contourLines(const ElevationGrid &grid, const std::vector<double> &levels, const ContourOptions &options)
+{
+	std::vector<ContourLine>
+		aLines;
+
+	contourLines(grid, levels, [&](double level, const std::vector<Point2D> &points, bool closed) {
+		aLines.push_back({level, points, closed});
+	}, options);
+
+	return aLines;
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,105 @@
+/***
+ * CivilContour.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_CONTOUR
+#define __CIVIL_CONTOUR
+
+#include <functional>
+#include <vector>
+
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilElevationGrid.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// How the two crossings of a saddle cell (opposite corners above the level) are joined.
+	enum SaddleModeEnum
+	{
+		// Always keeps the corners above the level apart; cheap and consistent.
+		smSeparate,
+		// Joins them when the mean of the four corners is above the level.
+		smCenter
+	};
+
+	struct ContourOptions
+	{
+	public:
+
+		SaddleModeEnum
+			saddleMode = smCenter;
+		bool
+			parallel = true;
+
+	}; /* ContourOptions */
+
+	// ContourLine;
+	//
+	// One polyline of a contour level. Closed lines do not repeat the first point.
+	// ----
+	struct ContourLine
+	{
+	public:
+
+		double
+			level = 0;
+		std::vector<Point2D>
+			points;
+		bool
+			closed = false;
+
+	}; /* ContourLine */
+
+	typedef std::function<void(double level, const std::vector<Point2D> &points, bool closed)>
+		ContourCallback;
+
+	// Marching squares.
+	//
+	// Nodes equal to a level count as above it. Lines run with the higher ground on their left, so closed
+	// lines turn counterclockwise around hills and clockwise around pits.
+
+	// contourSegments;
+	//
+	// The raw segments of one level, cell by cell in row order, not stitched.
+	// ----
+	void contourSegments(const ElevationGrid &grid, double level, std::vector<Vector2D> &segments,
+		const ContourOptions &options = ContourOptions());
+
+	// contourLines;
+	//
+	// Stitched polylines for every level of "levels". The grid is processed in bands of tiles that run on
+	// ---- the shared pool, all the levels of a cell at once; lines are joined across the tile seams and handed
+	//      to "callback", on the calling thread, as soon as they are complete, so only the lines that cross
+	//      the current band are held in memory. The order of the calls is not specified.
+	void contourLines(const ElevationGrid &grid, const std::vector<double> &levels, const ContourCallback &callback,
+		const ContourOptions &options = ContourOptions());
+	std::vector<ContourLine> contourLines(const ElevationGrid &grid, const std::vector<double> &levels,
+		const ContourOptions &options = ContourOptions());
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_CONTOUR
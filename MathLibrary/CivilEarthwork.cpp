@@ -0,0 +1,356 @@
+#include "CivilEarthwork.h"
+
+#include <math.h>
+#include <algorithm>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+#if CIVIL_X86
+#include <immintrin.h>
+#endif // if CIVIL_X86
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+/*
+ * Cut and fill kernel.
+ */
+
+static void
+cutFillScalar(const double *d0, const double *d1, size_t count, double sums[2])
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			a = d0[i],
+			b = d0[i + 1],
+			c = d1[i + 1],
+			d = d1[i];
+
+		if (isnan(a + b + c + d))
+			continue;
+
+		double
+			dblPos = std::max(a, 0.0) + std::max(b, 0.0) + std::max(c, 0.0) + std::max(d, 0.0),
+			dblNeg = std::max(-a, 0.0) + std::max(-b, 0.0) + std::max(-c, 0.0) + std::max(-d, 0.0),
+			dblTotal = dblPos + dblNeg;
+
+		if (dblTotal > 0)
+		{
+			sums[0] += dblPos * dblPos / dblTotal;
+			sums[1] += dblNeg * dblNeg / dblTotal;
+		}
+	}
+}
+
+#if CIVIL_X86
+
+// Four cells per step; the cells with a NaN corner or nothing to move are masked out after the division.
+CIVIL_TARGET("avx2,fma") static void
+cutFillAVX2(const double *d0, const double *d1, size_t count, double sums[2])
+{
+	__m256d
+		zero = _mm256_setzero_pd(),
+		accFill = zero,
+		accCut = zero;
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			a = _mm256_loadu_pd(d0 + i),
+			b = _mm256_loadu_pd(d0 + i + 1),
+			c = _mm256_loadu_pd(d1 + i + 1),
+			d = _mm256_loadu_pd(d1 + i),
+			pos = _mm256_add_pd(_mm256_add_pd(_mm256_max_pd(a, zero), _mm256_max_pd(b, zero)),
+				_mm256_add_pd(_mm256_max_pd(c, zero), _mm256_max_pd(d, zero))),
+			// pos - (a + b + c + d) is the sum of the negative parts, and NaN when a corner is.
+			neg = _mm256_sub_pd(pos, _mm256_add_pd(_mm256_add_pd(a, b), _mm256_add_pd(c, d))),
+			total = _mm256_add_pd(pos, neg),
+			valid = _mm256_cmp_pd(total, zero, _CMP_GT_OQ);
+
+		accFill = _mm256_add_pd(accFill, _mm256_and_pd(valid, _mm256_div_pd(_mm256_mul_pd(pos, pos), total)));
+		accCut = _mm256_add_pd(accCut, _mm256_and_pd(valid, _mm256_div_pd(_mm256_mul_pd(neg, neg), total)));
+	}
+
+	double
+		lanes[4];
+
+	_mm256_storeu_pd(lanes, accFill);
+	sums[0] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	_mm256_storeu_pd(lanes, accCut);
+	sums[1] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+	cutFillScalar(d0 + i, d1 + i, count - i, sums);
+}
+
+Dispatch<CutFillKernel>
+	cutFillKernel(cutFillScalar, nullptr, cutFillAVX2);
+
+#else
+
+Dispatch<CutFillKernel>
+	cutFillKernel(cutFillScalar);
+
+#endif // if CIVIL_X86
+
+/*
+ * Samplers.
+ */
+
+SurfaceSampler
+tinSampler(const TinLocator &locator)
+{
+	return [&locator](const double *x, size_t count, double y, double *z) {
+		for (size_t i = 0; i < count; i++)
+			if (!locator.interpolate(x[i], y, z[i]))
+				z[i] = ElevationGrid::NO_DATA;
+	};
+}
+
+SurfaceSampler
+gridSampler(const ElevationGrid &grid)
+{
+	return [&grid](const double *x, size_t count, double y, double *z) {
+		size_t
+			rows = grid.getRowCount(),
+			cols = grid.getColCount();
+		double
+			v = (y - grid.getOrigin().y) / grid.getCellHeight();
+
+		if (rows < 2 || cols < 2 || !(v >= 0 && v <= rows - 1))
+		{
+			std::fill(z, z + count, ElevationGrid::NO_DATA);
+			return;
+		}
+
+		size_t
+			row = std::min((size_t) v, rows - 2);
+		const double
+			*rowA = grid.getRow(row),
+			*rowB = grid.getRow(row + 1);
+
+		v -= row;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			double
+				u = (x[i] - grid.getOrigin().x) / grid.getCellWidth();
+
+			if (!(u >= 0 && u <= cols - 1))
+			{
+				z[i] = ElevationGrid::NO_DATA;
+				continue;
+			}
+
+			size_t
+				col = std::min((size_t) u, cols - 2);
+
+			u -= col;
+
+			z[i] = (1 - v) * ((1 - u) * rowA[col] + u * rowA[col + 1]) + v * ((1 - u) * rowB[col] + u * rowB[col + 1]);
+		}
+	};
+}
+
+/*
+ * Earthwork.
+ */
+
+Earthwork::Earthwork(const Rectangle2D &bounds, double cellSize)
+{
+	double
+		dblWidth = bounds.getWidth(),
+		dblHeight = bounds.getHeight();
+
+	if (!(cellSize > 0) || !(dblWidth > 0) || !(dblHeight > 0))
+		RAISE(EEarthwork, ewInvalidGrid);
+
+	size_t
+		intCols = (size_t) ceil(dblWidth / cellSize),
+		intRows = (size_t) ceil(dblHeight / cellSize);
+
+	m_grdExisting = ElevationGrid(intRows + 1, intCols + 1, bounds.getBottomLeft(), dblWidth / intCols, dblHeight / intRows);
+	m_grdProposed = m_grdExisting;
+	m_intTileRows = (intRows + TILE - 1) / TILE;
+	m_intTileCols = (intCols + TILE - 1) / TILE;
+	m_aTiles.assign(m_intTileRows * m_intTileCols, EarthworkVolumes());
+	m_aDirty.assign(m_aTiles.size(), 0);
+}
+
+bool
+Earthwork::nodeRange(const Rectangle2D &region, size_t &row1, size_t &row2, size_t &col1, size_t &col2) const
+{
+	const ElevationGrid
+		&grd = m_grdExisting;
+	Point2D
+		pntOrigin = grd.getOrigin();
+	double
+		u1 = std::max(ceil((region.left - pntOrigin.x) / grd.getCellWidth()), 0.0),
+		u2 = std::min(floor((region.right - pntOrigin.x) / grd.getCellWidth()), grd.getColCount() - 1.0),
+		v1 = std::max(ceil((region.bottom - pntOrigin.y) / grd.getCellHeight()), 0.0),
+		v2 = std::min(floor((region.top - pntOrigin.y) / grd.getCellHeight()), grd.getRowCount() - 1.0);
+
+	if (!(u1 <= u2 && v1 <= v2))
+		return false;
+
+	col1 = (size_t) u1;
+	col2 = (size_t) u2 + 1;
+	row1 = (size_t) v1;
+	row2 = (size_t) v2 + 1;
+
+	return true;
+}
+
+void
+Earthwork::sampleNodes(EarthworkSurfaceEnum which, const SurfaceSampler &sampler, size_t row1, size_t row2,
+	size_t col1, size_t col2, bool parallel)
+{
+	ElevationGrid
+		&grd = surface(which);
+	std::vector<double>
+		aX(col2 - col1);
+
+	for (size_t c = col1; c < col2; c++)
+		aX[c - col1] = grd.getX(c);
+
+	auto sampleRows = [&](size_t first, size_t last) {
+		for (size_t r = first; r < last; r++)
+			sampler(aX.data(), aX.size(), grd.getY(r), grd.getRow(r) + col1);
+	};
+
+	if (parallel)
+		parallelFor(row1, row2, 1, sampleRows);
+	else
+		sampleRows(row1, row2);
+
+	markNodes(row1, row2, col1, col2);
+}
+
+void
+Earthwork::markNodes(size_t row1, size_t row2, size_t col1, size_t col2)
+{
+	// Node (r, c) is a corner of the cells (r - 1 .. r, c - 1 .. c).
+	size_t
+		intCellRows = m_grdExisting.getRowCount() - 1,
+		intCellCols = m_grdExisting.getColCount() - 1,
+		tr1 = (row1 > 0 ? row1 - 1 : 0) / TILE,
+		tr2 = std::min(row2 - 1, intCellRows - 1) / TILE,
+		tc1 = (col1 > 0 ? col1 - 1 : 0) / TILE,
+		tc2 = std::min(col2 - 1, intCellCols - 1) / TILE;
+
+	for (size_t tr = tr1; tr <= tr2; tr++)
+		for (size_t tc = tc1; tc <= tc2; tc++)
+			m_aDirty[tr * m_intTileCols + tc] = 1;
+}
+
+void
+Earthwork::sample(EarthworkSurfaceEnum which, const SurfaceSampler &sampler, bool parallel)
+{
+	sampleNodes(which, sampler, 0, m_grdExisting.getRowCount(), 0, m_grdExisting.getColCount(), parallel);
+}
+
+void
+Earthwork::sample(EarthworkSurfaceEnum which, const SurfaceSampler &sampler, const Rectangle2D &region, bool parallel)
+{
+	size_t
+		row1, row2, col1, col2;
+
+	if (nodeRange(region, row1, row2, col1, col2))
+		sampleNodes(which, sampler, row1, row2, col1, col2, parallel);
+}
+
+void
+Earthwork::invalidate(const Rectangle2D &region)
+{
+	size_t
+		row1, row2, col1, col2;
+
+	if (nodeRange(region, row1, row2, col1, col2))
+		markNodes(row1, row2, col1, col2);
+}
+
+EarthworkVolumes
+Earthwork::tileVolumes(size_t tileRow, size_t tileCol) const
+{
+	size_t
+		row1 = tileRow * TILE,
+		row2 = std::min(row1 + TILE, m_grdExisting.getRowCount() - 1),
+		col1 = tileCol * TILE,
+		col2 = std::min(col1 + TILE, m_grdExisting.getColCount() - 1),
+		n = col2 - col1;
+	std::vector<double>
+		aDiff(2 * (n + 1));
+	double
+		*pBelow = aDiff.data(),
+		*pAbove = pBelow + n + 1,
+		sums[2] = {0, 0};
+
+	auto differences = [&](size_t row, double *d) {
+		const double
+			*pExisting = m_grdExisting.getRow(row) + col1,
+			*pProposed = m_grdProposed.getRow(row) + col1;
+
+		for (size_t i = 0; i <= n; i++)
+			d[i] = pProposed[i] - pExisting[i];
+	};
+
+	differences(row1, pBelow);
+
+	for (size_t r = row1; r < row2; r++)
+	{
+		differences(r + 1, pAbove);
+		cutFillKernel(pBelow, pAbove, n, sums);
+		std::swap(pBelow, pAbove);
+	}
+
+	double
+		dblQuarter = m_grdExisting.getCellWidth() * m_grdExisting.getCellHeight() / 4;
+	EarthworkVolumes
+		res;
+
+	res.fill = sums[0] * dblQuarter;
+	res.cut = sums[1] * dblQuarter;
+
+	return res;
+}
+
+EarthworkVolumes
+Earthwork::volumes(bool parallel)
+{
+	std::vector<size_t>
+		aDirty;
+
+	for (size_t t = 0; t < m_aDirty.size(); t++)
+		if (m_aDirty[t])
+			aDirty.push_back(t);
+
+	auto runTiles = [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+		{
+			size_t
+				t = aDirty[i];
+
+			m_aTiles[t] = tileVolumes(t / m_intTileCols, t % m_intTileCols);
+			m_aDirty[t] = 0;
+		}
+	};
+
+	if (parallel)
+		parallelFor(0, aDirty.size(), 1, runTiles);
+	else
+		runTiles(0, aDirty.size());
+
+	EarthworkVolumes
+		res;
+
+	for (const EarthworkVolumes &vol : m_aTiles)
+		res += vol;
+
+	return res;
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,209 @@
+/***
+ * CivilEarthwork.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_EARTHWORK
+#define __CIVIL_EARTHWORK
+
+#include <functional>
+#include <vector>
+
+#include "..\UtilsLibrary\CivilDispatch.h"
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilElevationGrid.h"
+#include "..\MathLibrary\CivilTinLocator.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(ewInvalidGrid);
+
+	BEGIN_DECLARE_ERROR(EEarthwork)
+		DECLARE_ERROR(ewInvalidGrid, "The bounds are empty or the cell size is not positive")
+	END_DECLARE_ERROR;
+
+	// Volumes between an existing and a proposed surface: cut where the proposed one is below (material
+	// removed), fill where it is above.
+	struct EarthworkVolumes
+	{
+	public:
+
+		double
+			cut = 0,
+			fill = 0;
+
+		double net() const
+		{
+			return fill - cut;
+		}
+
+		EarthworkVolumes &operator+=(const EarthworkVolumes &vol)
+		{
+			cut += vol.cut;
+			fill += vol.fill;
+
+			return *this;
+		}
+
+	}; /* EarthworkVolumes */
+
+	// SurfaceSampler;
+	//
+	// Writes into z[i] the elevation of a surface at (x[i], y), 0 <= i < count, or NaN where it is not
+	// ---- defined. Called with one grid row at a time, from several threads at once.
+	typedef std::function<void(const double *x, size_t count, double y, double *z)>
+		SurfaceSampler;
+
+	// tinSampler;
+	//
+	// Linear interpolation on a TIN. The locator must outlive the sampler.
+	// ----
+	SurfaceSampler tinSampler(const TinLocator &locator);
+
+	// gridSampler;
+	//
+	// Bilinear interpolation on an elevation grid. The grid must outlive the sampler.
+	// ----
+	SurfaceSampler gridSampler(const ElevationGrid &grid);
+
+	enum EarthworkSurfaceEnum
+	{
+		esExisting,
+		esProposed
+	};
+
+	// Earthwork;
+	//
+	// Cut and fill between two surfaces sampled on a common grid over "bounds". The cell size is adjusted
+	// ---- down so that a whole number of cells covers the bounds exactly.
+	//
+	//      Each cell takes the differences d = proposed - existing at its four corners. When they all have
+	//      the same sign the volume is the mean depth times the cell area; in the cells the grade line crosses,
+	//      the usual grid method splits it as
+	//
+	//        fill = A / 4 * P^2 / (P + N),  cut = A / 4 * N^2 / (P + N)
+	//
+	//      with P the sum of the positive differences and N that of the negative ones, taken as positive.
+	//      Cells with a corner where either surface is undefined are left out.
+	//
+	//      The cells are grouped in square tiles whose totals are kept. Resampling or invalidating a region
+	//      marks the tiles it touches, and volumes() recomputes only those before adding up all the tiles
+	//      in a fixed order, so that an update gives the same bits as a full computation.
+	struct Earthwork
+	{
+	public:
+
+		// Cells per side of a tile.
+		static constexpr size_t
+			TILE = 64;
+
+		Earthwork(const Rectangle2D &bounds, double cellSize);
+
+	private:
+
+		ElevationGrid
+			m_grdExisting,
+			m_grdProposed;
+		size_t
+			m_intTileRows,
+			m_intTileCols;
+		std::vector<EarthworkVolumes>
+			m_aTiles;
+		std::vector<unsigned char>
+			m_aDirty;
+
+		ElevationGrid &surface(EarthworkSurfaceEnum which)
+		{
+			return which == esExisting ? m_grdExisting : m_grdProposed;
+		}
+
+		// Node ranges [row1, row2) x [col1, col2) inside "region"; false when there is none.
+		bool nodeRange(const Rectangle2D &region, size_t &row1, size_t &row2, size_t &col1, size_t &col2) const;
+		void sampleNodes(EarthworkSurfaceEnum which, const SurfaceSampler &sampler, size_t row1, size_t row2,
+			size_t col1, size_t col2, bool parallel);
+		void markNodes(size_t row1, size_t row2, size_t col1, size_t col2);
+		EarthworkVolumes tileVolumes(size_t tileRow, size_t tileCol) const;
+
+	public:
+
+		const ElevationGrid &getSurface(EarthworkSurfaceEnum which) const
+		{
+			return which == esExisting ? m_grdExisting : m_grdProposed;
+		}
+
+		// editSurface;
+		//
+		// Direct access to the nodes of a surface. Call invalidate() for the region changed.
+		// ----
+		ElevationGrid &editSurface(EarthworkSurfaceEnum which)
+		{
+			return surface(which);
+		}
+
+		Rectangle2D boundsRect() const
+		{
+			return m_grdExisting.boundsRect();
+		}
+		size_t getTileCount() const
+		{
+			return m_aTiles.size();
+		}
+
+		// sample;
+		//
+		// Samples a surface at the nodes of the grid, all of them or those inside "region", and marks the
+		// ---- cells around them for recomputation.
+		void sample(EarthworkSurfaceEnum which, const SurfaceSampler &sampler, bool parallel = true);
+		void sample(EarthworkSurfaceEnum which, const SurfaceSampler &sampler, const Rectangle2D &region,
+			bool parallel = true);
+
+		// invalidate;
+		//
+		// Marks the cells around the nodes inside "region" for recomputation.
+		// ----
+		void invalidate(const Rectangle2D &region);
+
+		// volumes;
+		//
+		// Totals over the grid, recomputing the marked tiles on the shared pool.
+		// ----
+		EarthworkVolumes volumes(bool parallel = true);
+
+	}; /* Earthwork */
+
+	// cutFillKernel;
+	//
+	// Sums P^2 / (P + N) into sums[0] and N^2 / (P + N) into sums[1] over the "count" cells between two rows
+	// ---- of differences, d0 below and d1 above, each with count + 1 values. Cells with a NaN corner or with
+	//      all four corners at zero add nothing.
+	typedef void (*CutFillKernel)(const double *d0, const double *d1, size_t count, double sums[2]);
+
+	extern Dispatch<CutFillKernel>
+		cutFillKernel;
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_EARTHWORK
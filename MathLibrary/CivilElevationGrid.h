@@ -0,0 +1,158 @@
+/***
+ * CivilElevationGrid.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_ELEVATION_GRID
+#define __CIVIL_ELEVATION_GRID
+
+#include <limits>
+#include <vector>
+
+#include "..\MathLibrary\CivilGA2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// ElevationGrid;
+	//
+	// Elevations sampled on a regular grid, stored row after row in one contiguous block so that the
+	// ---- kernels walk it with unit stride. Row 0 is at the origin and rows grow northwards (y), columns
+	//      eastwards (x). NO_DATA (NaN) marks the nodes without a value; cells touching one are skipped.
+	struct ElevationGrid
+	{
+	public:
+
+		static constexpr double
+			NO_DATA = std::numeric_limits<double>::quiet_NaN();
+
+		ElevationGrid() = default;
+		ElevationGrid(size_t rows, size_t cols, const Point2D &origin, double cellWidth, double cellHeight,
+			double value = NO_DATA) :
+			m_intRowCount(rows),
+			m_intColCount(cols),
+			m_aItems(rows * cols, value),
+			m_pntOrigin(origin),
+			m_dblCellWidth(cellWidth),
+			m_dblCellHeight(cellHeight)
+		{}
+
+	private:
+
+		size_t
+			m_intRowCount = 0,
+			m_intColCount = 0;
+		std::vector<double>
+			m_aItems;
+		Point2D
+			m_pntOrigin;
+		double
+			m_dblCellWidth = 1,
+			m_dblCellHeight = 1;
+
+	public:
+
+		size_t getRowCount() const
+		{
+			return m_intRowCount;
+		}
+		size_t getColCount() const
+		{
+			return m_intColCount;
+		}
+		// setDims; the contents are not kept.
+		void setDims(size_t rows, size_t cols, double value = NO_DATA)
+		{
+			m_intRowCount = rows;
+			m_intColCount = cols;
+			m_aItems.assign(rows * cols, value);
+		}
+
+		double getItem(size_t row, size_t col) const
+		{
+			return m_aItems[row * m_intColCount + col];
+		}
+		void setItem(size_t row, size_t col, double value)
+		{
+			m_aItems[row * m_intColCount + col] = value;
+		}
+
+		const double *getRow(size_t row) const
+		{
+			return m_aItems.data() + row * m_intColCount;
+		}
+		double *getRow(size_t row)
+		{
+			return m_aItems.data() + row * m_intColCount;
+		}
+
+		Point2D getOrigin() const
+		{
+			return m_pntOrigin;
+		}
+		void setOrigin(const Point2D &value)
+		{
+			m_pntOrigin = value;
+		}
+
+		double getCellWidth() const
+		{
+			return m_dblCellWidth;
+		}
+		double getCellHeight() const
+		{
+			return m_dblCellHeight;
+		}
+		void setCellSize(double width, double height)
+		{
+			m_dblCellWidth = width;
+			m_dblCellHeight = height;
+		}
+
+		double getX(size_t col) const
+		{
+			return m_pntOrigin.x + col * m_dblCellWidth;
+		}
+		double getY(size_t row) const
+		{
+			return m_pntOrigin.y + row * m_dblCellHeight;
+		}
+		Point2D getPoint(size_t row, size_t col) const
+		{
+			return Point2D(getX(col), getY(row));
+		}
+
+		// boundsRect; the rectangle covered by the nodes.
+		Rectangle2D boundsRect() const
+		{
+			return Rectangle2D(m_pntOrigin.x, m_pntOrigin.y,
+				getX(m_intColCount > 0 ? m_intColCount - 1 : 0), getY(m_intRowCount > 0 ? m_intRowCount - 1 : 0));
+		}
+
+	}; /* ElevationGrid */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_ELEVATION_GRID
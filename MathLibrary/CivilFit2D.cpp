@@ -0,0 +1,830 @@
+#include "CivilFit2D.h"
+
+#include <math.h>
+#include <algorithm>
+#include <array>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+#if CIVIL_X86
+#include <immintrin.h>
+#endif // if CIVIL_X86
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+// Points per piece of the parallel passes.
+static const size_t
+	FIT_GRAIN = 1 << 14;
+
+// Hypotheses scored per batch of RANSAC, between two checks of the number of iterations needed.
+static const size_t
+	RANSAC_BATCH = 64;
+
+/*
+ * Kernels.
+ */
+
+static void
+momentScalar(const double *x, const double *y, size_t count, double x0, double y0, double sums[12])
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			dx = x[i] - x0,
+			dy = y[i] - y0,
+			xx = dx * dx,
+			yy = dy * dy;
+
+		sums[0] += dx;
+		sums[1] += dy;
+		sums[2] += xx;
+		sums[3] += dx * dy;
+		sums[4] += yy;
+		sums[5] += xx * dx;
+		sums[6] += xx * dy;
+		sums[7] += dx * yy;
+		sums[8] += yy * dy;
+		sums[9] += xx * xx;
+		sums[10] += xx * yy;
+		sums[11] += yy * yy;
+	}
+}
+
+static void
+circleStepScalar(const double *x, const double *y, size_t count, double cx, double cy, double r, double sums[9])
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			dx = x[i] - cx,
+			dy = y[i] - cy,
+			d = sqrt(dx * dx + dy * dy),
+			u = d > 0 ? dx / d : 0,
+			v = d > 0 ? dy / d : 0,
+			e = d - r;
+
+		sums[0] += u * u;
+		sums[1] += u * v;
+		sums[2] += v * v;
+		sums[3] += u;
+		sums[4] += v;
+		sums[5] += u * e;
+		sums[6] += v * e;
+		sums[7] += e;
+		sums[8] += e * e;
+	}
+}
+
+#if CIVIL_X86
+
+CIVIL_TARGET("avx2,fma") static inline double
+horizontalSum(__m256d acc)
+{
+	double
+		lanes[4];
+
+	_mm256_storeu_pd(lanes, acc);
+
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+CIVIL_TARGET("avx2,fma") static void
+momentAVX2(const double *x, const double *y, size_t count, double x0, double y0, double sums[12])
+{
+	__m256d
+		ox = _mm256_set1_pd(x0),
+		oy = _mm256_set1_pd(y0),
+		acc[12];
+	size_t
+		i = 0;
+
+	for (int k = 0; k < 12; k++)
+		acc[k] = _mm256_setzero_pd();
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), ox),
+			dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), oy),
+			xx = _mm256_mul_pd(dx, dx),
+			yy = _mm256_mul_pd(dy, dy);
+
+		acc[0] = _mm256_add_pd(acc[0], dx);
+		acc[1] = _mm256_add_pd(acc[1], dy);
+		acc[2] = _mm256_add_pd(acc[2], xx);
+		acc[3] = _mm256_fmadd_pd(dx, dy, acc[3]);
+		acc[4] = _mm256_add_pd(acc[4], yy);
+		acc[5] = _mm256_fmadd_pd(xx, dx, acc[5]);
+		acc[6] = _mm256_fmadd_pd(xx, dy, acc[6]);
+		acc[7] = _mm256_fmadd_pd(dx, yy, acc[7]);
+		acc[8] = _mm256_fmadd_pd(yy, dy, acc[8]);
+		acc[9] = _mm256_fmadd_pd(xx, xx, acc[9]);
+		acc[10] = _mm256_fmadd_pd(xx, yy, acc[10]);
+		acc[11] = _mm256_fmadd_pd(yy, yy, acc[11]);
+	}
+
+	for (int k = 0; k < 12; k++)
+		sums[k] += horizontalSum(acc[k]);
+
+	momentScalar(x + i, y + i, count - i, x0, y0, sums);
+}
+
+CIVIL_TARGET("avx2,fma") static void
+circleStepAVX2(const double *x, const double *y, size_t count, double cx, double cy, double r, double sums[9])
+{
+	__m256d
+		ox = _mm256_set1_pd(cx),
+		oy = _mm256_set1_pd(cy),
+		radius = _mm256_set1_pd(r),
+		zero = _mm256_setzero_pd(),
+		acc[9];
+	size_t
+		i = 0;
+
+	for (int k = 0; k < 9; k++)
+		acc[k] = zero;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), ox),
+			dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), oy),
+			d = _mm256_sqrt_pd(_mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy))),
+			valid = _mm256_cmp_pd(d, zero, _CMP_GT_OQ),
+			u = _mm256_and_pd(valid, _mm256_div_pd(dx, d)),
+			v = _mm256_and_pd(valid, _mm256_div_pd(dy, d)),
+			e = _mm256_sub_pd(d, radius);
+
+		acc[0] = _mm256_fmadd_pd(u, u, acc[0]);
+		acc[1] = _mm256_fmadd_pd(u, v, acc[1]);
+		acc[2] = _mm256_fmadd_pd(v, v, acc[2]);
+		acc[3] = _mm256_add_pd(acc[3], u);
+		acc[4] = _mm256_add_pd(acc[4], v);
+		acc[5] = _mm256_fmadd_pd(u, e, acc[5]);
+		acc[6] = _mm256_fmadd_pd(v, e, acc[6]);
+		acc[7] = _mm256_add_pd(acc[7], e);
+		acc[8] = _mm256_fmadd_pd(e, e, acc[8]);
+	}
+
+	for (int k = 0; k < 9; k++)
+		sums[k] += horizontalSum(acc[k]);
+
+	circleStepScalar(x + i, y + i, count - i, cx, cy, r, sums);
+}
+
+Dispatch<MomentKernel>
+	momentKernel(momentScalar, nullptr, momentAVX2);
+Dispatch<CircleStepKernel>
+	circleStepKernel(circleStepScalar, nullptr, circleStepAVX2);
+
+#else
+
+Dispatch<MomentKernel>
+	momentKernel(momentScalar);
+Dispatch<CircleStepKernel>
+	circleStepKernel(circleStepScalar);
+
+#endif // if CIVIL_X86
+
+// Runs "kernel" over pieces of the points and adds up their sums, pairwise in piece order.
+template <size_t N, typename Kernel>
+static std::array<double, N>
+reduceSums(const PointBuffer &pnts, bool parallel, const Kernel &kernel)
+{
+	std::array<double, N>
+		aZero = {};
+
+	auto map = [&](size_t first, size_t last) {
+		std::array<double, N>
+			aSums = {};
+
+		kernel(pnts.x.data() + first, pnts.y.data() + first, last - first, aSums.data());
+
+		return aSums;
+	};
+	auto combine = [](const std::array<double, N> &a, const std::array<double, N> &b) {
+		std::array<double, N>
+			res;
+
+		for (size_t k = 0; k < N; k++)
+			res[k] = a[k] + b[k];
+
+		return res;
+	};
+
+	if (!parallel)
+		return map(0, pnts.size());
+
+	return parallelReduce(0, pnts.size(), FIT_GRAIN, aZero, map, combine);
+}
+
+/*
+ * Moments.
+ */
+
+PointMoments
+pointMoments(const PointBuffer &pnts, bool parallel)
+{
+	PointMoments
+		mom;
+	size_t
+		n = pnts.size();
+
+	if (n == 0)
+		return mom;
+
+	double
+		x0 = pnts.x[0],
+		y0 = pnts.y[0];
+	std::array<double, 12>
+		s = reduceSums<12>(pnts, parallel, [&](const double *x, const double *y, size_t count, double *sums) {
+			momentKernel(x, y, count, x0, y0, sums);
+		});
+
+	for (double &v : s)
+		v /= n;
+
+	// Raw means about the first point, moved to the centroid (a, b).
+	double
+		a = s[0],
+		b = s[1],
+		xx = s[2] - a * a,
+		xy = s[3] - a * b,
+		yy = s[4] - b * b,
+		xxx = s[5] - 3 * a * s[2] + 2 * a * a * a,
+		xxy = s[6] - 2 * a * s[3] - b * s[2] + 2 * a * a * b,
+		xyy = s[7] - 2 * b * s[3] - a * s[4] + 2 * a * b * b,
+		yyy = s[8] - 3 * b * s[4] + 2 * b * b * b,
+		xxxx = s[9] - 4 * a * s[5] + 6 * a * a * s[2] - 3 * a * a * a * a,
+		xxyy = s[10] - 2 * b * s[6] - 2 * a * s[7] + b * b * s[2] + a * a * s[4] + 4 * a * b * s[3] - 3 * a * a * b * b,
+		yyyy = s[11] - 4 * b * s[8] + 6 * b * b * s[4] - 3 * b * b * b * b;
+
+	mom.count = n;
+	mom.centroid = Point2D(x0 + a, y0 + b);
+	mom.xx = xx;
+	mom.xy = xy;
+	mom.yy = yy;
+	mom.xz = xxx + xyy;
+	mom.yz = xxy + yyy;
+	mom.zz = xxxx + 2 * xxyy + yyyy;
+
+	return mom;
+}
+
+/*
+ * Lines.
+ */
+
+Vector2D
+fitLine(const PointBuffer &pnts, bool parallel)
+{
+	if (pnts.size() < 2)
+		RAISE(EFit2D, feTooFewPoints);
+
+	PointMoments
+		mom = pointMoments(pnts, parallel);
+
+	if (!(mom.xx + mom.yy > 0))
+		RAISE(EFit2D, feDegenerate);
+
+	double
+		dblAngle = atan2(2 * mom.xy, mom.xx - mom.yy) / 2;
+	Point2D
+		dir(cos(dblAngle), sin(dblAngle)),
+		c = mom.centroid;
+
+	// The extent of the projections, in a second pass.
+	typedef std::pair<double, double> Extent;
+
+	auto map = [&](size_t first, size_t last) {
+		Extent
+			ext(INFINITY, -INFINITY);
+
+		for (size_t i = first; i < last; i++)
+		{
+			double
+				t = (pnts.x[i] - c.x) * dir.x + (pnts.y[i] - c.y) * dir.y;
+
+			ext.first = std::min(ext.first, t);
+			ext.second = std::max(ext.second, t);
+		}
+
+		return ext;
+	};
+	auto combine = [](const Extent &a, const Extent &b) {
+		return Extent(std::min(a.first, b.first), std::max(a.second, b.second));
+	};
+
+	Extent
+		ext = parallel ? parallelReduce(0, pnts.size(), FIT_GRAIN, Extent(INFINITY, -INFINITY), map, combine) :
+			map(0, pnts.size());
+
+	return Vector2D(c + dir * ext.first, c + dir * ext.second);
+}
+
+/*
+ * Circles.
+ */
+
+static void
+checkCircleMoments(const PointMoments &mom)
+{
+	if (mom.count < 3)
+		RAISE(EFit2D, feTooFewPoints);
+
+	// Collinear points leave the covariance matrix singular.
+	double
+		dblTrace = mom.xx + mom.yy;
+
+	if (!(mom.xx * mom.yy - mom.xy * mom.xy > 1e-12 * dblTrace * dblTrace))
+		RAISE(EFit2D, feDegenerate);
+}
+
+Circle2D
+fitCircleKasa(const PointMoments &mom)
+{
+	checkCircleMoments(mom);
+
+	// [xx xy; xy yy] (D, E) = -(xz, yz), F = -(xx + yy); center -(D, E) / 2, r^2 = (D^2 + E^2) / 4 - F.
+	double
+		dblDet = mom.xx * mom.yy - mom.xy * mom.xy,
+		a = (mom.xz * mom.yy - mom.yz * mom.xy) / dblDet / 2,
+		b = (mom.yz * mom.xx - mom.xz * mom.xy) / dblDet / 2;
+
+	return Circle2D(mom.centroid + Point2D(a, b), sqrt(a * a + b * b + mom.xx + mom.yy));
+}
+
+Circle2D
+fitCircleKasa(const PointBuffer &pnts, bool parallel)
+{
+	return fitCircleKasa(pointMoments(pnts, parallel));
+}
+
+Circle2D
+fitCirclePratt(const PointMoments &mom)
+{
+	checkCircleMoments(mom);
+
+	// Chernov's formulation: the smallest nonnegative root of A0 + A1 t + A2 t^2 + 4 t^4, by Newton from 0.
+	double
+		z = mom.xx + mom.yy,
+		dblCov = mom.xx * mom.yy - mom.xy * mom.xy,
+		a2 = 4 * dblCov - 3 * z * z - mom.zz,
+		a1 = mom.zz * z + 4 * dblCov * z - mom.xz * mom.xz - mom.yz * mom.yz - z * z * z,
+		a0 = mom.xz * mom.xz * mom.yy + mom.yz * mom.yz * mom.xx - mom.zz * dblCov - 2 * mom.xz * mom.yz * mom.xy + z * z * dblCov,
+		t = 0,
+		p = INFINITY;
+
+	for (int i = 0; i < 32; i++)
+	{
+		double
+			dblPrev = p;
+
+		p = a0 + t * (a1 + t * (a2 + 4 * t * t));
+
+		if (fabs(p) > fabs(dblPrev))
+		{
+			t = 0;
+			break;
+		}
+
+		double
+			dp = a1 + t * (2 * a2 + 16 * t * t),
+			dblNext = t - p / dp;
+
+		if (!isfinite(dblNext))
+			break;
+
+		if (fabs(dblNext - t) <= 1e-15 * fabs(dblNext))
+		{
+			t = dblNext;
+			break;
+		}
+
+		t = dblNext;
+	}
+
+	if (t < 0)
+		t = 0;
+
+	double
+		dblDet = t * t - t * z + dblCov,
+		a = (mom.xz * (mom.yy - t) - mom.yz * mom.xy) / dblDet / 2,
+		b = (mom.yz * (mom.xx - t) - mom.xz * mom.xy) / dblDet / 2;
+
+	return Circle2D(mom.centroid + Point2D(a, b), sqrt(a * a + b * b + z + 2 * t));
+}
+
+Circle2D
+fitCirclePratt(const PointBuffer &pnts, bool parallel)
+{
+	return fitCirclePratt(pointMoments(pnts, parallel));
+}
+
+// Solves the symmetric 3 x 3 system m x = rhs by Cramer's rule; false when singular.
+static bool
+solve3(const double m[3][3], const double rhs[3], double x[3])
+{
+	double
+		c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1],
+		c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2],
+		c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0],
+		dblDet = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+
+	if (!(fabs(dblDet) > 0) || !isfinite(dblDet))
+		return false;
+
+	x[0] = (rhs[0] * c00 + m[0][1] * (m[1][2] * rhs[2] - rhs[1] * m[2][2]) + m[0][2] * (rhs[1] * m[2][1] - m[1][1] * rhs[2])) / dblDet;
+	x[1] = (m[0][0] * (rhs[1] * m[2][2] - m[1][2] * rhs[2]) + rhs[0] * c01 + m[0][2] * (m[1][0] * rhs[2] - rhs[1] * m[2][0])) / dblDet;
+	x[2] = (m[0][0] * (m[1][1] * rhs[2] - rhs[1] * m[2][1]) + m[0][1] * (rhs[1] * m[2][0] - m[1][0] * rhs[2]) + rhs[0] * c02) / dblDet;
+
+	return true;
+}
+
+Circle2D
+fitCircleGeometric(const PointBuffer &pnts, const Circle2D &start, int maxIterations, bool parallel)
+{
+	size_t
+		n = pnts.size();
+
+	if (n < 3)
+		RAISE(EFit2D, feTooFewPoints);
+
+	auto stepSums = [&](double cx, double cy, double r) {
+		return reduceSums<9>(pnts, parallel, [&](const double *x, const double *y, size_t count, double *sums) {
+			circleStepKernel(x, y, count, cx, cy, r, sums);
+		});
+	};
+
+	double
+		cx = start.center.x,
+		cy = start.center.y,
+		r = start.getRadius(),
+		dblLambda = 1e-3;
+	std::array<double, 9>
+		s = stepSums(cx, cy, r);
+
+	// Levenberg-Marquardt with J = (-u, -v, -1) per point: (J'J + lambda diag(J'J)) step = -J'e.
+	for (int i = 0; i < maxIterations; i++)
+	{
+		double
+			m[3][3] = {
+				{s[0] * (1 + dblLambda), s[1], s[3]},
+				{s[1], s[2] * (1 + dblLambda), s[4]},
+				{s[3], s[4], n * (1 + dblLambda)}
+			},
+			rhs[3] = {s[5], s[6], s[7]},
+			dx[3];
+
+		if (!solve3(m, rhs, dx))
+			break;
+
+		std::array<double, 9>
+			aNext = stepSums(cx + dx[0], cy + dx[1], r + dx[2]);
+
+		if (aNext[8] <= s[8])
+		{
+			cx += dx[0];
+			cy += dx[1];
+			r += dx[2];
+			s = aNext;
+			dblLambda /= 10;
+
+			if (fabs(dx[0]) + fabs(dx[1]) + fabs(dx[2]) <= 1e-12 * (fabs(r) + 1))
+				break;
+		}
+		else
+		{
+			dblLambda *= 10;
+
+			if (dblLambda > 1e12)
+				break;
+		}
+	}
+
+	return Circle2D(Point2D(cx, cy), fabs(r));
+}
+
+Circle2D
+fitCircleGeometric(const PointBuffer &pnts, bool parallel)
+{
+	return fitCircleGeometric(pnts, fitCirclePratt(pnts, parallel), 50, parallel);
+}
+
+/*
+ * RANSAC.
+ */
+
+// Lines keep the unit normal (a, b) and c = a x + b y on the line; circles the center (a, b) and radius c.
+struct RansacModel
+{
+public:
+
+	double
+		a = 0,
+		b = 0,
+		c = 0;
+
+}; /* RansacModel */
+
+static inline uint64_t
+splitMix(uint64_t &state)
+{
+	uint64_t
+		z = (state += 0x9E3779B97F4A7C15ull);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+	return z ^ (z >> 31);
+}
+
+static bool
+lineModel(const Point2D *pnts, RansacModel &mdl)
+{
+	Point2D
+		d = pnts[1] - pnts[0];
+	double
+		dblLen = d.dist();
+
+	if (!(dblLen > 0))
+		return false;
+
+	mdl.a = -d.y / dblLen;
+	mdl.b = d.x / dblLen;
+	mdl.c = mdl.a * pnts[0].x + mdl.b * pnts[0].y;
+
+	return true;
+}
+
+static bool
+circleModel(const Point2D *pnts, RansacModel &mdl)
+{
+	Point2D
+		b = pnts[1] - pnts[0],
+		c = pnts[2] - pnts[0];
+	double
+		dblCross = b.vectorProduct(c),
+		b2 = b.x * b.x + b.y * b.y,
+		c2 = c.x * c.x + c.y * c.y;
+
+	if (!(fabs(dblCross) > 1e-12 * std::max(b2, c2)))
+		return false;
+
+	double
+		ux = (c.y * b2 - b.y * c2) / (2 * dblCross),
+		uy = (b.x * c2 - c.x * b2) / (2 * dblCross);
+
+	mdl.a = pnts[0].x + ux;
+	mdl.b = pnts[0].y + uy;
+	mdl.c = sqrt(ux * ux + uy * uy);
+
+	return true;
+}
+
+struct RansacFit
+{
+public:
+
+	size_t
+		sampleSize;
+	bool (*makeModel)(const Point2D *pnts, RansacModel &mdl);
+	bool circle;
+
+	bool isInlier(const RansacModel &mdl, double x, double y, double t) const
+	{
+		if (!circle)
+			return fabs(mdl.a * x + mdl.b * y - mdl.c) <= t;
+
+		double
+			dx = x - mdl.a,
+			dy = y - mdl.b,
+			d2 = dx * dx + dy * dy,
+			dblLow = std::max(mdl.c - t, 0.0),
+			dblHigh = mdl.c + t;
+
+		return d2 >= dblLow * dblLow && d2 <= dblHigh * dblHigh;
+	}
+
+}; /* RansacFit */
+
+static void
+ransacInliers(const PointBuffer &pnts, const RansacFit &fit, const RansacModel &mdl, double t, bool parallel,
+	std::vector<size_t> &inliers)
+{
+	std::vector<unsigned char>
+		aMask(pnts.size());
+
+	auto mark = [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			aMask[i] = fit.isInlier(mdl, pnts.x[i], pnts.y[i], t);
+	};
+
+	if (parallel)
+		parallelFor(0, pnts.size(), FIT_GRAIN, mark);
+	else
+		mark(0, pnts.size());
+
+	inliers.clear();
+
+	for (size_t i = 0; i < aMask.size(); i++)
+		if (aMask[i])
+			inliers.push_back(i);
+}
+
+static RansacModel
+ransac(const PointBuffer &pnts, const RansacOptions &options, const RansacFit &fit)
+{
+	size_t
+		n = pnts.size();
+
+	if (n < fit.sampleSize)
+		RAISE(EFit2D, feTooFewPoints);
+
+	// The points the hypotheses are scored on.
+	uint64_t
+		intState = options.seed;
+	PointBuffer
+		bufScore;
+
+	if (n <= options.scoreSample)
+		bufScore = pnts;
+	else
+	{
+		bufScore.resize(options.scoreSample);
+
+		for (size_t i = 0; i < options.scoreSample; i++)
+			bufScore.setItem(i, pnts.getItem(splitMix(intState) % n));
+	}
+
+	size_t
+		m = bufScore.size(),
+		intNeeded = options.maxIterations,
+		intDone = 0;
+	double
+		t = options.threshold;
+
+	// Best score and iteration; ties go to the earlier iteration.
+	typedef std::pair<size_t, size_t> Score;
+
+	Score
+		best(0, 0);
+
+	auto hypothesis = [&](size_t iteration, RansacModel &mdl) {
+		uint64_t
+			intSeed = options.seed ^ (0xD1B54A32D192ED03ull * (iteration + 1));
+		size_t
+			aIndexes[3];
+		Point2D
+			aPnts[3];
+
+		for (size_t k = 0; k < fit.sampleSize; k++)
+		{
+			bool
+				blnRepeated;
+
+			do
+			{
+				aIndexes[k] = splitMix(intSeed) % n;
+				blnRepeated = false;
+
+				for (size_t j = 0; j < k; j++)
+					blnRepeated |= aIndexes[j] == aIndexes[k];
+			}
+			while (blnRepeated);
+
+			aPnts[k] = pnts.getItem(aIndexes[k]);
+		}
+
+		return fit.makeModel(aPnts, mdl);
+	};
+	auto score = [&](size_t first, size_t last) {
+		Score
+			res(0, first);
+
+		for (size_t it = first; it < last; it++)
+		{
+			RansacModel
+				mdl;
+
+			if (!hypothesis(it, mdl))
+				continue;
+
+			size_t
+				intCount = 0;
+
+			for (size_t i = 0; i < m; i++)
+				intCount += fit.isInlier(mdl, bufScore.x[i], bufScore.y[i], t);
+
+			if (intCount > res.first)
+				res = Score(intCount, it);
+		}
+
+		return res;
+	};
+	auto better = [](const Score &a, const Score &b) {
+		return b.first > a.first ? b : a;
+	};
+
+	while (intDone < intNeeded)
+	{
+		size_t
+			intLast = std::min(intDone + RANSAC_BATCH, intNeeded);
+
+		best = better(best, options.parallel ? parallelReduce(intDone, intLast, 1, Score(0, intDone), score, better) :
+			score(intDone, intLast));
+		intDone = intLast;
+
+		// Iterations after which a sample of inliers only has been drawn with the requested confidence.
+		double
+			w = (double) best.first / m,
+			dblAll = pow(w, (double) fit.sampleSize);
+
+		if (dblAll >= 1)
+			break;
+
+		if (dblAll > 0)
+		{
+			double
+				dblIterations = log(1 - options.confidence) / log(1 - dblAll);
+
+			if (dblIterations < intNeeded)
+				intNeeded = std::max((size_t) ceil(dblIterations), intDone);
+		}
+	}
+
+	RansacModel
+		mdl;
+
+	if (best.first < fit.sampleSize || !hypothesis(best.second, mdl))
+		RAISE(EFit2D, feNoConsensus);
+
+	return mdl;
+}
+
+static PointBuffer
+gatherPoints(const PointBuffer &pnts, const std::vector<size_t> &indexes)
+{
+	PointBuffer
+		res(indexes.size());
+
+	for (size_t i = 0; i < indexes.size(); i++)
+		res.setItem(i, pnts.getItem(indexes[i]));
+
+	return res;
+}
+
+Vector2D
+ransacLine(const PointBuffer &pnts, const RansacOptions &options, std::vector<size_t> &inliers)
+{
+	RansacFit
+		fit = {2, lineModel, false};
+	RansacModel
+		mdl = ransac(pnts, options, fit);
+
+	ransacInliers(pnts, fit, mdl, options.threshold, options.parallel, inliers);
+
+	Vector2D
+		vtr = fitLine(gatherPoints(pnts, inliers), options.parallel);
+	Point2D
+		dir = vtr.pnt2 - vtr.pnt1;
+	double
+		dblLen = dir.dist();
+
+	if (dblLen > 0)
+	{
+		mdl.a = -dir.y / dblLen;
+		mdl.b = dir.x / dblLen;
+		mdl.c = mdl.a * vtr.pnt1.x + mdl.b * vtr.pnt1.y;
+		ransacInliers(pnts, fit, mdl, options.threshold, options.parallel, inliers);
+		vtr = fitLine(gatherPoints(pnts, inliers), options.parallel);
+	}
+
+	return vtr;
+}
+
+Circle2D
+ransacCircle(const PointBuffer &pnts, const RansacOptions &options, std::vector<size_t> &inliers)
+{
+	RansacFit
+		fit = {3, circleModel, true};
+	RansacModel
+		mdl = ransac(pnts, options, fit);
+
+	ransacInliers(pnts, fit, mdl, options.threshold, options.parallel, inliers);
+
+	Circle2D
+		cir = fitCircleGeometric(gatherPoints(pnts, inliers), Circle2D(Point2D(mdl.a, mdl.b), mdl.c), 50, options.parallel);
+
+	mdl.a = cir.center.x;
+	mdl.b = cir.center.y;
+	mdl.c = cir.getRadius();
+	ransacInliers(pnts, fit, mdl, options.threshold, options.parallel, inliers);
+
+	return cir;
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,161 @@
+/***
+ * CivilFit2D.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_FIT_2D
+#define __CIVIL_FIT_2D
+
+#include <stdint.h>
+#include <vector>
+
+#include "..\UtilsLibrary\CivilDispatch.h"
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilBuffer2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(feTooFewPoints);
+	DECLARE_ERROR_CODE(feDegenerate);
+	DECLARE_ERROR_CODE(feNoConsensus);
+
+	BEGIN_DECLARE_ERROR(EFit2D)
+		DECLARE_ERROR(feTooFewPoints, "Not enough points for the fit")
+		DECLARE_ERROR(feDegenerate, "The points do not define the shape (coincident or collinear)")
+		DECLARE_ERROR(feNoConsensus, "No model found with enough inliers")
+	END_DECLARE_ERROR;
+
+	// PointMoments;
+	//
+	// Means of a point set about its centroid: xx is the mean of (x - cx)^2 and so on, with z = (x - cx)^2 +
+	// ---- (y - cy)^2. They are all that the algebraic fits need.
+	struct PointMoments
+	{
+	public:
+
+		size_t
+			count = 0;
+		Point2D
+			centroid;
+		double
+			xx = 0,
+			xy = 0,
+			yy = 0,
+			xz = 0,
+			yz = 0,
+			zz = 0;
+
+	}; /* PointMoments */
+
+	// pointMoments;
+	//
+	// One pass over the points (vectorized, see momentKernel; in pieces on the shared pool when "parallel")
+	// ---- accumulating the power sums up to the fourth order about the first point, which are then moved to
+	//      the centroid.
+	PointMoments pointMoments(const PointBuffer &pnts, bool parallel = true);
+
+	// fitLine;
+	//
+	// Total least squares line: through the centroid along the main axis of the points, which minimizes the
+	// ---- sum of the squared perpendicular distances. The vector spans the projections of the points on the
+	//      line. Raises EFit2D for less than 2 points or when they all coincide.
+	Vector2D fitLine(const PointBuffer &pnts, bool parallel = true);
+
+	// Algebraic circle fits.
+	//
+	// Both minimize sum (z + D x + E y + F)^2 with z = x^2 + y^2, which needs only the moments. Kasa's fit
+	// takes it as it is, fast but biased towards small circles on short arcs; Pratt's divides it by D^2 + E^2
+	// - 4F, which removes most of the bias, and is solved by Newton's method on its characteristic polynomial.
+	// Raise EFit2D for less than 3 points or collinear ones.
+	Circle2D fitCircleKasa(const PointMoments &mom);
+	Circle2D fitCircleKasa(const PointBuffer &pnts, bool parallel = true);
+	Circle2D fitCirclePratt(const PointMoments &mom);
+	Circle2D fitCirclePratt(const PointBuffer &pnts, bool parallel = true);
+
+	// fitCircleGeometric;
+	//
+	// Circle minimizing the sum of the squared distances from the points, by Levenberg-Marquardt from
+	// ---- "start" (Pratt's fit when not given). Each iteration is one vectorized pass over the points (see
+	//      circleStepKernel).
+	Circle2D fitCircleGeometric(const PointBuffer &pnts, const Circle2D &start, int maxIterations = 50, bool parallel = true);
+	Circle2D fitCircleGeometric(const PointBuffer &pnts, bool parallel = true);
+
+	struct RansacOptions
+	{
+	public:
+
+		// Largest distance from the model of an inlier.
+		double
+			threshold = 0;
+		size_t
+			maxIterations = 1000,
+			// Points, taken at random, on which the hypotheses are scored.
+			scoreSample = 4096;
+		// Probability of having drawn at least one sample free of outliers when the iterations stop.
+		double
+			confidence = 0.99;
+		uint64_t
+			seed = 1;
+		bool
+			parallel = true;
+
+	}; /* RansacOptions */
+
+	// RANSAC.
+	//
+	// Draws minimal samples (2 points for lines, 3 for circles) and keeps the model with the most points
+	// within the threshold among "scoreSample" of them, stopping as soon as the number of iterations reaches
+	// what the best inlier ratio so far asks for. The hypotheses are scored in batches on the shared pool;
+	// the samples depend on the seed and the iteration only, so the result does not depend on the threads.
+	// The best model is refitted to all its inliers (fitLine, fitCircleGeometric) and "inliers" receives
+	// the indexes of the points within the threshold of the final one. Raise EFit2D with too few points or
+	// when no sample gives a model.
+	Vector2D ransacLine(const PointBuffer &pnts, const RansacOptions &options, std::vector<size_t> &inliers);
+	Circle2D ransacCircle(const PointBuffer &pnts, const RansacOptions &options, std::vector<size_t> &inliers);
+
+	// momentKernel;
+	//
+	// Power sums of (x - x0, y - y0) over "count" points, in the order x, y, xx, xy, yy, xxx, xxy, xyy, yyy,
+	// ---- xxxx, xxyy, yyyy.
+	typedef void (*MomentKernel)(const double *x, const double *y, size_t count, double x0, double y0, double sums[12]);
+
+	extern Dispatch<MomentKernel>
+		momentKernel;
+
+	// circleStepKernel;
+	//
+	// Sums for one Gauss-Newton step of the geometric circle fit about center (cx, cy) and radius r. With
+	// ---- d the distance of a point from the center, (u, v) = (x - cx, y - cy) / d and e = d - r they are,
+	//      in order: uu, uv, vv, u, v, ue, ve, e, ee. Points at the center count with u = v = 0.
+	typedef void (*CircleStepKernel)(const double *x, const double *y, size_t count, double cx, double cy, double r,
+		double sums[9]);
+
+	extern Dispatch<CircleStepKernel>
+		circleStepKernel;
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_FIT_2D
@@ -0,0 +1,106 @@
+/***
+ * CivilFixedAngle.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "CivilFixedAngle.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+/*
+ * FixedAngle.
+ */
+
+// Tables of sin/cos for the whole degrees of a turn and the whole seconds of a degree. They are built on
+// first use (a function-local static, so the initialization is thread-safe and independent of the order
+// of the static constructors).
+struct SinCosTables
+{
+	double
+		sinDeg[360], cosDeg[360],
+		sinSec[3600], cosSec[3600];
+
+	SinCosTables()
+	{
+		for (int i = 0; i < 360; i++)
+		{
+			sinDeg[i] = sin(i * M_PI / 180);
+			cosDeg[i] = cos(i * M_PI / 180);
+		}
+		for (int i = 0; i < 3600; i++)
+		{
+			sinSec[i] = sin(i * M_PI / 648000);
+			cosSec[i] = cos(i * M_PI / 648000);
+		}
+
+		// Exact values at the quadrant limits, so that 90 gives cos = 0 and not 6e-17.
+		sinDeg[0] = 0; cosDeg[0] = 1;
+		sinDeg[90] = 1; cosDeg[90] = 0;
+		sinDeg[180] = 0; cosDeg[180] = -1;
+		sinDeg[270] = -1; cosDeg[270] = 0;
+	}
+};
+
+static const SinCosTables &
+sinCosTables()
+{
+	static const SinCosTables
+		tables;
+
+	return tables;
+}
+
+void
+FixedAngle::sincos(double &s, double &c) const
+{
+	const SinCosTables
+		&tbl = sinCosTables();
+	long long
+		t = normalized().m_intTenths;
+	int
+		intDeg = (int) (t / TENTHS_PER_DEGREE),
+		intSec = (int) (t / TENTHS_PER_SECOND % 3600),
+		intTenths = (int) (t % TENTHS_PER_SECOND);
+	double
+		sd = tbl.sinDeg[intDeg],
+		cd = tbl.cosDeg[intDeg],
+		ss = tbl.sinSec[intSec],
+		cs = tbl.cosSec[intSec];
+
+	if (intTenths != 0)
+	{
+		double
+			r = intTenths * (M_PI / 6480000),
+			sr = r - r * r * r / 6,
+			cr = 1 - r * r / 2,
+			dblSin = ss * cr + cs * sr;
+
+		cs = cs * cr - ss * sr;
+		ss = dblSin;
+	}
+
+	s = sd * cs + cd * ss;
+	c = cd * cs - sd * ss;
+}
+
+} // namespace CIVIL::MATH::GA2D
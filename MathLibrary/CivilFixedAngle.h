@@ -0,0 +1,216 @@
+/***
+ * CivilFixedAngle.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_FIXED_ANGLE
+#define __CIVIL_FIXED_ANGLE
+
+#include "..\MathLibrary\CivilAngle.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// FixedAngle;
+	//
+	// Angle kept as a signed 64-bit count of tenths of an arc-second. Sums and differences of DMS bearings are
+	// ---- exact, so a traverse that adds thousands of them does not drift, and wrapping to a turn is an
+	//      integer remainder. Use Angle for everything that needs radians.
+	struct FixedAngle
+	{
+	public:
+
+		static const long long
+			TENTHS_PER_SECOND = 10,
+			TENTHS_PER_MINUTE = 600,
+			TENTHS_PER_DEGREE = 36000,
+			TENTHS_PER_TURN = 12960000;
+
+		FixedAngle() = default;
+		FixedAngle(const Angle &ang) :
+			m_intTenths(fromRadians((double) ang).m_intTenths)
+		{}
+
+	private:
+
+		long long
+			m_intTenths = 0;
+
+	public:
+
+		static FixedAngle fromTenths(long long tenths)
+		{
+			FixedAngle
+				ang;
+
+			ang.m_intTenths = tenths;
+
+			return ang;
+		}
+		// fromDMS;
+		//
+		// The sign of "deg" applies to the whole angle; use "negative" for angles between -1 and 0.
+		// ----
+		static FixedAngle fromDMS(long long deg, int min, int sec, int tenths = 0, bool negative = false)
+		{
+			bool
+				blnNeg = negative || deg < 0;
+			long long
+				intRes = (deg < 0 ? -deg : deg) * TENTHS_PER_DEGREE + min * TENTHS_PER_MINUTE + sec * TENTHS_PER_SECOND + tenths;
+
+			return fromTenths(blnNeg ? -intRes : intRes);
+		}
+		static FixedAngle fromSeconds(double seconds)
+		{
+			return fromTenths(llround(seconds * TENTHS_PER_SECOND));
+		}
+		static FixedAngle fromRadians(double radians)
+		{
+			return fromTenths(llround(radians * (TENTHS_PER_TURN / (2 * M_PI))));
+		}
+
+		long long getTenths() const
+		{
+			return m_intTenths;
+		}
+		double toRadians() const
+		{
+			return (double) m_intTenths * (2 * M_PI / TENTHS_PER_TURN);
+		}
+		double toDegrees() const
+		{
+			return (double) m_intTenths / TENTHS_PER_DEGREE;
+		}
+		Angle toAngle() const
+		{
+			return Angle(toRadians());
+		}
+
+		// decompose;
+		//
+		// Exact degrees/minutes/seconds/tenths of the magnitude; "negative" receives the sign.
+		// ----
+		void decompose(bool &negative, long long &deg, int &min, int &sec, int &tenths) const
+		{
+			long long
+				t = m_intTenths < 0 ? -m_intTenths : m_intTenths;
+
+			negative = m_intTenths < 0;
+			deg = t / TENTHS_PER_DEGREE;
+			min = (int) (t / TENTHS_PER_MINUTE % 60);
+			sec = (int) (t / TENTHS_PER_SECOND % 60);
+			tenths = (int) (t % TENTHS_PER_SECOND);
+		}
+
+		// normalized;
+		//
+		// Same direction wrapped into [0, 360) without branches: the remainder keeps the sign of the
+		// ---- dividend, and its sign bit, spread by the arithmetic shift, selects whether a turn is added.
+		FixedAngle normalized() const
+		{
+			long long
+				r = m_intTenths % TENTHS_PER_TURN;
+
+			return fromTenths(r + (TENTHS_PER_TURN & (r >> 63)));
+		}
+		// normalizedSigned;
+		//
+		// Same direction wrapped into [-180, 180).
+		// ----
+		FixedAngle normalizedSigned() const
+		{
+			return fromTenths((fromTenths(m_intTenths + TENTHS_PER_TURN / 2).normalized().m_intTenths) - TENTHS_PER_TURN / 2);
+		}
+
+		// sincos;
+		//
+		// Sine and cosine from two precomputed tables (whole degrees and whole seconds within a degree)
+		// ---- joined by the angle-addition formulas; the tenths left over are too small for anything but a
+		//      two-term series. Agrees with sin/cos of toRadians() within 2e-15.
+		void sincos(double &s, double &c) const;
+
+		friend FixedAngle operator+(const FixedAngle &ang1, const FixedAngle &ang2)
+		{
+			return fromTenths(ang1.m_intTenths + ang2.m_intTenths);
+		}
+		FixedAngle &operator+=(const FixedAngle &ang)
+		{
+			m_intTenths += ang.m_intTenths;
+
+			return *this;
+		}
+		friend FixedAngle operator-(const FixedAngle &ang1, const FixedAngle &ang2)
+		{
+			return fromTenths(ang1.m_intTenths - ang2.m_intTenths);
+		}
+		FixedAngle &operator-=(const FixedAngle &ang)
+		{
+			m_intTenths -= ang.m_intTenths;
+
+			return *this;
+		}
+		FixedAngle operator-() const
+		{
+			return fromTenths(-m_intTenths);
+		}
+		friend FixedAngle operator*(const FixedAngle &ang, long long factor)
+		{
+			return fromTenths(ang.m_intTenths * factor);
+		}
+		friend FixedAngle operator*(long long factor, const FixedAngle &ang)
+		{
+			return fromTenths(ang.m_intTenths * factor);
+		}
+
+		bool operator==(const FixedAngle &ang) const
+		{
+			return m_intTenths == ang.m_intTenths;
+		}
+		bool operator!=(const FixedAngle &ang) const
+		{
+			return m_intTenths != ang.m_intTenths;
+		}
+		bool operator>(const FixedAngle &ang) const
+		{
+			return m_intTenths > ang.m_intTenths;
+		}
+		bool operator>=(const FixedAngle &ang) const
+		{
+			return m_intTenths >= ang.m_intTenths;
+		}
+		bool operator<(const FixedAngle &ang) const
+		{
+			return m_intTenths < ang.m_intTenths;
+		}
+		bool operator<=(const FixedAngle &ang) const
+		{
+			return m_intTenths <= ang.m_intTenths;
+		}
+
+	}; /* FixedAngle */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_FIXED_ANGLE
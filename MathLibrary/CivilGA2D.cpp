@@ -31,10 +31,6 @@ namespace CIVIL::MATH::GA2D
  * Matrix2D.
  */
 
-const Matrix2D
-	Matrix2D::M_IDENTITY = { {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}} },
-	Matrix2D::M_NULL = { {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}} };
-
 Matrix2D
 Matrix2D::fromMatrix(const Matrix<double> &mat)
 {
@@ -92,27 +88,6 @@ Matrix2D::mirror(double x1, double y1, double x2, double y2)
 	return mat;
 }
 
-Matrix2D
-operator*(const Matrix2D &mat1, const Matrix2D &mat2)
-{
-	Matrix2D
-		res;
-
-	for (int i = 0; i < 3; i++)
-		for (int j = 0; j < 3; j++)
-		{
-			double
-				dblItem = 0;
-
-			for (int k = 0; k < 3; k++)
-				dblItem += mat1.items[i][k] * mat2.items[k][j];
-
-			res.items[i][j] = dblItem;
-		}
-
-	return res;
-}
-
 /*
  * Vector2D.
  */
@@ -120,23 +95,20 @@ operator*(const Matrix2D &mat1, const Matrix2D &mat2)
 double
 Vector2D::distPoint(const Point2D &pnt) const
 {
-	Point2D
-		p1 = pnt - pnt1,
-		p2 = pnt2 - pnt1;
+	double
+		dx = pnt2.x - pnt1.x,
+		dy = pnt2.y - pnt1.y;
 
-	return abs((p1.x * p2.y - p2.x * p1.y) / getModule());
+	return abs(((pnt.x - pnt1.x) * dy - dx * (pnt.y - pnt1.y)) / sqrt(dx * dx + dy * dy));
 }
 
 Vector2D
-Vector2D::perpendicular(const Point2D &ref, double module) const
+Vector2D::perpendicular(const Point2D &ref, double) const
 {
-	Matrix2D
-		mat = Matrix2D::translation(-ref.x, -ref.y) * Matrix2D::rotation(-(pnt2 - pnt1).angleAxeX());
-	Point2D
-		_ref = ref.transform(mat);
+	SegmentRecord
+		rec(*this);
 	Vector2D
-		vtr = transform(mat),
-		vtrRes = Vector2D(_ref.x, vtr.y1, _ref.x, _ref.y).transform(mat.reverse());
+		vtrRes(rec.pointAt(rec.project(ref)), ref);
 
 	if (getModule() > 0)
 		vtrRes.setModule(getModule());
@@ -144,6 +116,12 @@ Vector2D::perpendicular(const Point2D &ref, double module) const
 	return vtrRes;
 }
 
+Vector2D
+Vector2D::footVector(const Point2D &ref, double module) const
+{
+	return SegmentRecord(*this).perpendicular(ref, module);
+}
+
 bool
 Vector2D::intersection(const Vector2D &vtr, bool aparent, Point2D &pnt) const
 {
@@ -155,8 +133,8 @@ Vector2D::intersection(const Vector2D &vtr, bool aparent, Point2D &pnt) const
 		p2 = vtr.pnt2 - vtr.pnt1;
 
 	double
-		t = ((y1 - vtr.y1) * p1.x - (x1 - vtr.x1) * p1.y) / ((p1.x * p2.y) - (p1.y * p2.x)),
-		s = ((y1 - vtr.y1) * p2.x - (x1 - vtr.x1) * p2.y) / ((p1.x * p2.y) - (p1.y * p2.x));
+		t = ((pnt1.y - vtr.pnt1.y) * p1.x - (pnt1.x - vtr.pnt1.x) * p1.y) / ((p1.x * p2.y) - (p1.y * p2.x)),
+		s = ((pnt1.y - vtr.pnt1.y) * p2.x - (pnt1.x - vtr.pnt1.x) * p2.y) / ((p1.x * p2.y) - (p1.y * p2.x));
 
 	bool
 		blnRes = true;
@@ -172,6 +150,40 @@ Vector2D::intersection(const Vector2D &vtr, bool aparent, Point2D &pnt) const
 	return true;
 }
 
+/*
+ * SegmentRecord.
+ */
+
+SegmentRecord::SegmentRecord(const Vector2D &vtr) :
+	origin(vtr.pnt1.x, vtr.pnt1.y),
+	direction(vtr.pnt2.x - vtr.pnt1.x, vtr.pnt2.y - vtr.pnt1.y)
+{
+	double
+		dblLength2 = direction.x * direction.x + direction.y * direction.y;
+
+	if (dblLength2 > 0)
+	{
+		invLength2 = 1 / dblLength2;
+		invLength = sqrt(invLength2);
+		normal = Point2D(-direction.y * invLength, direction.x * invLength);
+	}
+}
+
+Vector2D
+SegmentRecord::perpendicular(const Point2D &ref, double module) const
+{
+	Point2D
+		foot = pointAt(project(ref));
+
+	if (module <= 0)
+		return Vector2D(foot, ref);
+
+	double
+		dblSide = offset(ref) < 0 ? -module : module;
+
+	return Vector2D(foot, Point2D(foot.x + normal.x * dblSide, foot.y + normal.y * dblSide));
+}
+
 /*
  * TCircle2D;
  * -----------------------------------------------------------------------------
@@ -210,8 +222,8 @@ Circle2D::Circle2D(const Point2D &pnt1, const Point2D &pnt2, const Point2D &pnt3
 		vtr3 = vtr1.moveTo(vtr1.midPoint()),
 		vtr4 = vtr2.moveTo(vtr2.midPoint());
 
-	vtr3 = vtr3.transform(Matrix2D::rotation(Angle::ANGLE_90, vtr3.x1, vtr3.y1));
-	vtr4 = vtr4.transform(Matrix2D::rotation(Angle::ANGLE_90, vtr4.x1, vtr4.y1));
+	vtr3 = vtr3.transform(Matrix2D::rotation(1, 0, vtr3.pnt1.x, vtr3.pnt1.y));
+	vtr4 = vtr4.transform(Matrix2D::rotation(1, 0, vtr4.pnt1.x, vtr4.pnt1.y));
 
 	if (vtr3.intersection(vtr4, true, center))
 		m_dblRadius = center.dist(pnt1);
@@ -273,13 +285,20 @@ double Circle2D::area() const
 
 double Circle2D::inertiaX(const Point2D &ref) const
 {
-	//raise Exception.Create('Revisar este cdigo para inserir suporte a ponto de referncia');
-	return M_PI * pow(m_dblRadius, 8) / 4;
+	double
+		dblR2 = m_dblRadius * m_dblRadius,
+		dy = center.y - ref.y;
+
+	return M_PI * dblR2 * dblR2 / 4 + area() * dy * dy;
 }
 
 double Circle2D::inertiaY(const Point2D &ref) const
 {
-	return inertiaX(ref);
+	double
+		dblR2 = m_dblRadius * m_dblRadius,
+		dx = center.x - ref.x;
+
+	return M_PI * dblR2 * dblR2 / 4 + area() * dx * dx;
 }
 
 bool Circle2D::teste(const Point2D &pnt1, const Point2D &pnt2)
@@ -295,67 +314,95 @@ bool Circle2D::teste(const Point2D &pnt1, const Point2D &pnt2)
 	if (dblDist1 < m_dblRadius && dblDist2 < m_dblRadius)
 		return false;
 
-	Vector2D
-		vtr(pnt1, pnt2),
-		vtrPerp = vtr.perpendicular(center);
+	SegmentRecord
+		rec(Vector2D(pnt1, pnt2));
 
-	return (vtrPerp.getModule() <= m_dblRadius) && vtr.innerLimits(vtrPerp.pnt2);
+	return (rec.distPoint(center) <= m_dblRadius) && rec.innerLimits(center);
 }
 
 bool Circle2D::intercept(const Rectangle2D &rect)
 {
-	if (teste(rect.bottomLeft, rect.getTopLeft()) || teste(rect.getTopLeft(), rect.topRight) || teste(rect.topRight, rect.getBottomRight()) ||
-		teste(rect.getBottomRight(), rect.bottomLeft))
+	if (teste(rect.getBottomLeft(), rect.getTopLeft()) || teste(rect.getTopLeft(), rect.getTopRight()) ||
+		teste(rect.getTopRight(), rect.getBottomRight()) || teste(rect.getBottomRight(), rect.getBottomLeft()))
 		return true;
 
 	return false;
 }
 
-	/*function TCircle2D.Intercept(Vector: TVector2D; out Res : TVector2D) : TIntersectionEnum;
-	var
-		dx, dy, dr, det, numDelta,
-		dblParte1, dblParte2, dblDivisor: Double;
-	begin
-		with Vector.Pnt2 - Vector.Pnt1 do
-		begin
-		dx : = X;
-dy: = Y;
-	end;
-
-dr: = Vector.Module;
-det: = Vector.X1 * Vector.Y2 - Vector.X2 * Vector.Y1;
-numDelta: = (Radius * Radius) * (dr * dr) - (det * det);
-
-	if numDelta < 0 then
-		begin
-		Result : = iNone;
-	Exit;
-	end
-	else if numDelta = 0 then
-		Result : = iTangent
-	else
-		Result : = iTwoPoints;
+IntersectionEnum Circle2D::intercept(const Vector2D &vector, Vector2D &res, bool aparent) const
+{
+	// The vector is written relative to the center, P(t) = f + t * d, and the roots of |P(t)|^2 = r^2
+	// are found with the cancellation-free form of the quadratic formula.
+	Point2D
+		d = vector.pnt2 - vector.pnt1,
+		f = vector.pnt1 - center;
+	double
+		a = d.x * d.x + d.y * d.y,
+		b = f.x * d.x + f.y * d.y,
+		c = f.x * f.x + f.y * f.y - m_dblRadius * m_dblRadius,
+		dblDelta = b * b - a * c;
+
+	if (a == 0 || dblDelta < 0)
+		return iNone;
+
+	if (dblDelta == 0)
+	{
+		double
+			t = -b / a;
+
+		if (!aparent && (t < 0 || t > 1))
+			return iNone;
+
+		res.pnt1 = vector.pnt1 + d * t;
+		res.pnt2 = res.pnt1;
+
+		return iTangent;
+	}
+
+	double
+		q = -(b + (b < 0 ? -sqrt(dblDelta) : sqrt(dblDelta))),
+		t1 = q / a,
+		t2 = c / q;
+
+	if (t1 > t2)
+		swap(t1, t2);
+
+	if (aparent)
+	{
+		res.pnt1 = vector.pnt1 + d * t1;
+		res.pnt2 = vector.pnt1 + d * t2;
+
+		return iTwoPoints;
+	}
+
+	bool
+		bln1 = (t1 >= 0) && (t1 <= 1),
+		bln2 = (t2 >= 0) && (t2 <= 1);
 
-dblParte1: = det * dy;
-dblParte2: = Sign(dy) * dx * Sqrt(numDelta);
-dblDivisor: = dr * dr;
+	if (bln1 && bln2)
+	{
+		res.pnt1 = vector.pnt1 + d * t1;
+		res.pnt2 = vector.pnt1 + d * t2;
 
-	with Res do
-		begin
-		Pnt1.X : = (dblParte1 + dblParte2) / dblDivisor;
-	Pnt2.X : = (dblParte1 - dblParte2) / dblDivisor;
+		return iTwoPoints;
+	}
 
-dblParte1: = -det * dx;
-dblParte2: = Abs(dy) * Sqrt(numDelta);
+	if (!bln1 && !bln2)
+		return iNone;
 
-	Pnt1.Y : = (dblParte1 + dblParte2) / dblDivisor;
-	Pnt2.Y : = (dblParte1 - dblParte2) / dblDivisor;
-	end;
-	end;
+	res.pnt1 = vector.pnt1 + d * (bln1 ? t1 : t2);
+	res.pnt2 = res.pnt1;
+
+	return iOnePoint;
+}
 
-	function TCircle2D.Contains(Pnt: TPoint2D) : Boolean;
-	begin
-		Result : = Center.DistPoint(Pnt) <= FRadius;
-	end;*/
+bool Circle2D::contains(const Point2D &pnt) const
+{
+	double
+		dx = pnt.x - center.x,
+		dy = pnt.y - center.y;
+
+	return dx * dx + dy * dy <= m_dblRadius * m_dblRadius;
+}
 
 } // namespace CIVIL::MATH::GA2D
\ No newline at end of file
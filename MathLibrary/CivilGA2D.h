@@ -31,6 +31,7 @@
 #include <math.h>
 #include <regex>
 #include <limits.h>
+#include <limits>
 
 #include "..\UtilsLibrary\CivilRange.h"
 #include "..\UtilsLibrary\CivilError.h"
@@ -51,14 +52,16 @@ namespace CIVIL::MATH::GA2D
 		DECLARE_ERROR(meInvalidMirrorArgs, "Invalid argument for mirror matrix")
 	END_DECLARE_ERROR;
 
+	// Matrix2D;
+	//
+	// Homogeneous 2D transform. It is an aggregate of literal type, so constant transforms and chains of
+	// ---- translation, rotation (from sine and cosine) and scale are composed at compile time.
 	struct Matrix2D
 	{
 	public:
 
-		Matrix2D() = default;
-
 		double
-			items[3][3];
+			items[3][3] = {};
 
 	private:
 
@@ -75,7 +78,7 @@ namespace CIVIL::MATH::GA2D
 			return fromMatrix( ((Matrix<double>) *this).reverse() );
 		}
 
-		static Matrix2D translation(double x, double y)
+		static constexpr Matrix2D translation(double x, double y)
 		{
 			Matrix2D
 				mat = M_IDENTITY;
@@ -88,40 +91,85 @@ namespace CIVIL::MATH::GA2D
 		static Matrix2D rotation(const Angle &ang)
 		{
 			double
-				dblSin = sin((double)ang),
-				dblCos = cos((double)ang);
+				dblAng = (double)ang;
+
+			return rotation(sin(dblAng), cos(dblAng));
+		}
+		static Matrix2D rotation(const Angle &ang, double xRef, double yRef)
+		{
+			double
+				dblAng = (double)ang;
+
+			return rotation(sin(dblAng), cos(dblAng), xRef, yRef);
+		}
+
+		// rotation;
+		//
+		// Rotation from a precomputed sine and cosine (see RotationCache and sinCosBatch).
+		// ----
+		static constexpr Matrix2D rotation(double sinAng, double cosAng)
+		{
 			Matrix2D
 				mat = M_IDENTITY;
 
-			mat.items[0][0] = dblCos;
-			mat.items[0][1] = -dblSin;
-			mat.items[1][0] = dblSin;
-			mat.items[1][1] = dblCos;
+			mat.items[0][0] = cosAng;
+			mat.items[0][1] = -sinAng;
+			mat.items[1][0] = sinAng;
+			mat.items[1][1] = cosAng;
 
 			return mat;
 		}
-		static Matrix2D rotation(const Angle &ang, double xRef, double yRef)
+		// rotation;
+		//
+		// Rotation about (xRef, yRef) from a precomputed sine and cosine. The product
+		// ---- translation(xRef, yRef) * rotation * translation(-xRef, -yRef) is written out, so no matrix is
+		//      multiplied.
+		static constexpr Matrix2D rotation(double sinAng, double cosAng, double xRef, double yRef)
 		{
-			return translation(xRef, yRef) * rotation(ang) * translation(-xRef, -yRef);
+			Matrix2D
+				mat = rotation(sinAng, cosAng);
+
+			mat.items[0][2] = xRef - cosAng * xRef + sinAng * yRef;
+			mat.items[1][2] = yRef - sinAng * xRef - cosAng * yRef;
+
+			return mat;
 		}
-		static Matrix2D scale(double xFactor, double yFactor)
+		static constexpr Matrix2D scale(double xFactor, double yFactor)
 		{
 			Matrix2D
 				mat = M_IDENTITY;
 
-			mat.items[1][1] = xFactor;
-			mat.items[2][2] = yFactor;
+			mat.items[0][0] = xFactor;
+			mat.items[1][1] = yFactor;
 
 			return mat;
 		}
-		static Matrix2D scale(double xFactor, double yFactor, double xRef, double yRef)
+		static constexpr Matrix2D scale(double xFactor, double yFactor, double xRef, double yRef)
 		{
 			return translation(xRef, yRef) * scale(xFactor, yFactor) * translation(-xRef, -yRef);
 		}
-		inline static Matrix2D mirror(double x1, double y1, double x2, double y2);
+		static Matrix2D mirror(double x1, double y1, double x2, double y2);
 
-		friend Matrix2D operator*(const Matrix2D &mat1, const Matrix2D &mat2);
-		Matrix2D &operator*=(const Matrix2D &mat)
+		friend constexpr Matrix2D operator*(const Matrix2D &mat1, const Matrix2D &mat2)
+		{
+			Matrix2D
+				res;
+
+			for (int i = 0; i < 3; i++)
+				for (int j = 0; j < 3; j++)
+				{
+					double
+						dblItem = 0;
+
+					for (int k = 0; k < 3; k++)
+						dblItem += mat1.items[i][k] * mat2.items[k][j];
+
+					res.items[i][j] = dblItem;
+				}
+
+			return res;
+		}
+		constexpr Matrix2D &operator*=(const Matrix2D &mat)
 		{
 			*this = *this * mat;
 
@@ -146,20 +194,24 @@ namespace CIVIL::MATH::GA2D
 
 	}; /* Matrix2D */
 
+	inline constexpr Matrix2D
+		Matrix2D::M_IDENTITY = { {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}} },
+		Matrix2D::M_NULL = { {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}} };
+
 	typedef Range<short int, 1, 4> Quadrant;
 
 	struct Point2D
 	{
 	public:
 
-		Point2D(double _x = 0, double _y = 0) :
+		constexpr Point2D(double _x = 0, double _y = 0) :
 			x(_x), y(_y)
 		{}
 
 		double
 			x, y;
 
-		Quadrant quadrant() const
+		constexpr Quadrant quadrant() const
 		{
 			if (y > 0)
 			{
@@ -199,150 +251,135 @@ namespace CIVIL::MATH::GA2D
 			return (double)sqrt(_x * _x + _y * _y);
 		}
 
-		Point2D transform(const Matrix2D &mat) const
+		constexpr Point2D transform(const Matrix2D &mat) const
 		{
-			Matrix2D
-				mPnt = Matrix2D::M_IDENTITY;
-
-			mPnt.items[0][2] = x;
-			mPnt.items[1][2] = y;
-
-			mPnt = mat * mPnt;
-
-			return *(new Point2D(mPnt.items[0][2], mPnt.items[1][2]));
+			return Point2D(mat.items[0][0] * x + mat.items[0][1] * y + mat.items[0][2],
+				mat.items[1][0] * x + mat.items[1][1] * y + mat.items[1][2]);
 		}
 
 		Angle angleAxeX() const
 		{
 			return angleAxeX(x, y);
 		}
+		// angleAxeX;
+		//
+		// Angle from the X axis to the point, counterclockwise, in [0, 2 pi). A null point gives 0.
+		// ----
 		static Angle angleAxeX(double x, double y)
 		{
 			double
-				dblDist = dist(x, y, 0, 0);
-			Angle
-				ang;
-
-			if (dblDist != 0)
-			{
-				ang = x / dblDist;
-
-				ang = acos((double)ang);
-
-				if (y < 0)
-					ang += Angle::ANGLE_180;
-			}
+				dblAng = atan2(y, x);
 
-			return ang;
+			return Angle(dblAng < 0 ? dblAng + 2 * M_PI : dblAng);
 		}
 		static Angle angleBetween(double x1, double y1, double x2, double y2, double xRef, double yRef)
 		{
 			return angleAxeX(x1 - xRef, y1 - yRef) - angleAxeX(x2 - xRef, y2 - yRef);
 		}
 
-		double vectorProduct(const Point2D &pnt) const
+		constexpr double vectorProduct(const Point2D &pnt) const
 		{
 			return x * pnt.y - pnt.x * y;
 		}
 
-		friend Point2D operator+(const Point2D &pnt1, const Point2D &pnt2)
+		friend constexpr Point2D operator+(const Point2D &pnt1, const Point2D &pnt2)
 		{
-			return *(new Point2D(pnt1.x + pnt2.x, pnt1.y + pnt2.y));
+			return Point2D(pnt1.x + pnt2.x, pnt1.y + pnt2.y);
 		}
-		friend Point2D operator+(const Point2D &pnt, double value)
+		friend constexpr Point2D operator+(const Point2D &pnt, double value)
 		{
-			return *(new Point2D(pnt.x + value, pnt.y + value));
+			return Point2D(pnt.x + value, pnt.y + value);
 		}
-		friend Point2D operator+(double value, const Point2D &pnt)
+		friend constexpr Point2D operator+(double value, const Point2D &pnt)
 		{
-			return operator+(value, pnt);
+			return Point2D(value + pnt.x, value + pnt.y);
 		}
 
-		Point2D &operator+=(const Point2D &pnt)
+		constexpr Point2D &operator+=(const Point2D &pnt)
 		{
 			*this = *this + pnt;
 
 			return *this;
 		}
-		Point2D &operator+=(double value)
+		constexpr Point2D &operator+=(double value)
 		{
 			*this = *this + value;
 
 			return *this;
 		}
 
-		friend Point2D operator-(const Point2D &pnt1, const Point2D &pnt2)
+		friend constexpr Point2D operator-(const Point2D &pnt1, const Point2D &pnt2)
 		{
-			return *(new Point2D(pnt1.x - pnt2.x, pnt1.y - pnt2.y));
+			return Point2D(pnt1.x - pnt2.x, pnt1.y - pnt2.y);
 		}
-		friend Point2D operator-(const Point2D &pnt, double value)
+		friend constexpr Point2D operator-(const Point2D &pnt, double value)
 		{
-			return *(new Point2D(pnt.x - value, pnt.y - value));
+			return Point2D(pnt.x - value, pnt.y - value);
 		}
-		friend Point2D operator-(double value, const Point2D &pnt)
+		friend constexpr Point2D operator-(double value, const Point2D &pnt)
 		{
-			return operator-(value, pnt);
+			return Point2D(value - pnt.x, value - pnt.y);
 		}
 
-		Point2D &operator-=(const Point2D &pnt)
+		constexpr Point2D &operator-=(const Point2D &pnt)
 		{
 			*this = *this - pnt;
 
 			return *this;
 		}
-		Point2D &operator-=(double value)
+		constexpr Point2D &operator-=(double value)
 		{
 			*this = *this - value;
 
 			return *this;
 		}
 
-		friend Point2D operator*(const Point2D &pnt1, const Point2D &pnt2)
+		friend constexpr Point2D operator*(const Point2D &pnt1, const Point2D &pnt2)
 		{
-			return *(new Point2D(pnt1.x * pnt2.x, pnt1.y * pnt2.y));
+			return Point2D(pnt1.x * pnt2.x, pnt1.y * pnt2.y);
 		}
-		friend Point2D operator*(const Point2D &pnt, double value)
+		friend constexpr Point2D operator*(const Point2D &pnt, double value)
 		{
-			return *(new Point2D(pnt.x * value, pnt.y * value));
+			return Point2D(pnt.x * value, pnt.y * value);
 		}
-		friend Point2D operator*(double value, const Point2D &pnt)
+		friend constexpr Point2D operator*(double value, const Point2D &pnt)
 		{
-			return operator*(pnt, value);
+			return Point2D(value * pnt.x, value * pnt.y);
 		}
 
-		Point2D &operator*=(const Point2D &pnt)
+		constexpr Point2D &operator*=(const Point2D &pnt)
 		{
 			*this = *this * pnt;
 
 			return *this;
 		}
-		Point2D &operator*=(double value)
+		constexpr Point2D &operator*=(double value)
 		{
 			*this = *this * value;
 
 			return *this;
 		}
 
-		friend Point2D operator/(const Point2D &pnt1, const Point2D &pnt2)
+		friend constexpr Point2D operator/(const Point2D &pnt1, const Point2D &pnt2)
 		{
-			return *(new Point2D(pnt1.x / pnt2.x, pnt1.y / pnt2.y));
+			return Point2D(pnt1.x / pnt2.x, pnt1.y / pnt2.y);
 		}
-		friend Point2D operator/(const Point2D &pnt, double value)
+		friend constexpr Point2D operator/(const Point2D &pnt, double value)
 		{
-			return *(new Point2D(pnt.x / value, pnt.y / value));
+			return Point2D(pnt.x / value, pnt.y / value);
 		}
-		friend Point2D operator/(double value, const Point2D &pnt)
+		friend constexpr Point2D operator/(double value, const Point2D &pnt)
 		{
-			return operator/(pnt, value);
+			return Point2D(value / pnt.x, value / pnt.y);
 		}
 
-		Point2D &operator/=(const Point2D &pnt)
+		constexpr Point2D &operator/=(const Point2D &pnt)
 		{
 			*this = *this / pnt;
 
 			return *this;
 		}
-		Point2D &operator/=(double value)
+		constexpr Point2D &operator/=(double value)
 		{
 			*this = *this / value;
 
@@ -351,8 +388,8 @@ namespace CIVIL::MATH::GA2D
 
 	}; /* Point2D */
 
-	const Point2D NULL_POINT = { 0, 0 };
-	const Point2D INVALID_POINT = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+	constexpr Point2D NULL_POINT = { 0, 0 };
+	constexpr Point2D INVALID_POINT = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
 
 	enum SideEnum
 	{
@@ -371,22 +408,56 @@ namespace CIVIL::MATH::GA2D
 	{
 	public:
 
-		Vector2D(double _x1 = 0, double _y1 = 0, double _x2 = 0, double _y2 = 0) :
-			x1(_x1),
-			y1(_y1),
-			x2(_x2),
-			y2(_y2)
+		constexpr Vector2D(double _x1 = 0, double _y1 = 0, double _x2 = 0, double _y2 = 0) :
+			pnt1(_x1, _y1),
+			pnt2(_x2, _y2)
 		{}
-		Vector2D(const Point2D &_pnt1, const Point2D &_pnt2) :
+		constexpr Vector2D(const Point2D &_pnt1, const Point2D &_pnt2) :
 			pnt1(_pnt1),
 			pnt2(_pnt2)
 		{}
 
-		union
+		// pnt1, pnt2;
+		//
+		// The end points. The x1/y1/x2/y2 members that shared their storage through an anonymous union are
+		// ---- gone: reading the other member of a union is not allowed in a constant expression. getX1() ..
+		//      getY2() and setX1() .. setY2() take their place.
+		Point2D
+			pnt1,
+			pnt2;
+
+		constexpr double getX1() const
 		{
-			struct { Point2D pnt1, pnt2;  };
-			struct { double x1, y1, x2, y2; };
-		};
+			return pnt1.x;
+		}
+		constexpr void setX1(double value)
+		{
+			pnt1.x = value;
+		}
+		constexpr double getY1() const
+		{
+			return pnt1.y;
+		}
+		constexpr void setY1(double value)
+		{
+			pnt1.y = value;
+		}
+		constexpr double getX2() const
+		{
+			return pnt2.x;
+		}
+		constexpr void setX2(double value)
+		{
+			pnt2.x = value;
+		}
+		constexpr double getY2() const
+		{
+			return pnt2.y;
+		}
+		constexpr void setY2(double value)
+		{
+			pnt2.y = value;
+		}
 
 		Point2D versor() const
 		{
@@ -402,43 +473,48 @@ namespace CIVIL::MATH::GA2D
 			pnt2 = pnt1 + versor() * value;
 		}
 
-		Vector2D transform(const Matrix2D &mat) const
+		constexpr Vector2D transform(const Matrix2D &mat) const
 		{
-			Vector2D
-				vtr = *this;
-
-			vtr.pnt1 = vtr.pnt1.transform(mat);
-			vtr.pnt2 = vtr.pnt2.transform(mat);
-
-			return vtr;
+			return Vector2D(pnt1.transform(mat), pnt2.transform(mat));
 		}
 
 		double distPoint(const Point2D &pnt) const;
+
+		// perpendicular;
+		//
+		// Returns the vector that starts at the foot of the perpendicular through "ref" and points to "ref",
+		// ---- resized to the length of this vector. "module" is not used; it is kept for existing callers.
 		Vector2D perpendicular(const Point2D &ref, double module = 0) const;
 
-		Vector2D reverse() const
+		// footVector;
+		//
+		// Returns the vector that goes from the foot of the perpendicular through "ref" to "ref" itself. When
+		// ---- "module" is given the result is resized to it, keeping the side of "ref"; see SegmentRecord.
+		Vector2D footVector(const Point2D &ref, double module = 0) const;
+
+		constexpr Vector2D reverse() const
 		{
-			return Vector2D(x2, y2, x1, y1);
+			return Vector2D(pnt2, pnt1);
 		}
 
-		Point2D midPoint() const
+		constexpr Point2D midPoint() const
 		{
 			return (pnt2 + pnt1) / 2;
 		}
 
-		SideEnum side(const Point2D &pnt) const
+		constexpr SideEnum side(const Point2D &pnt) const
 		{
 			return (SideEnum) sign((pnt2 - pnt1).vectorProduct(pnt - pnt1));
 		}
 
-		Vector2D moveTo(const Point2D &pnt)
+		constexpr Vector2D moveTo(const Point2D &pnt) const
 		{
 			Point2D
 				p = pnt - pnt1;
 
 			return transform(Matrix2D::translation(p.x, p.y));
 		}
-		Vector2D moveTo(double x, double y)
+		constexpr Vector2D moveTo(double x, double y) const
 		{
 			Point2D
 				p(x - pnt1.x, y - pnt1.y);
@@ -450,55 +526,48 @@ namespace CIVIL::MATH::GA2D
 		//
 		// Checks whether the perpendicular projection of a point is delimited by the extreme points of the vector.
 		// ----
-		bool innerLimits(const Point2D &pnt) const
+		constexpr bool innerLimits(const Point2D &pnt) const
 		{
-			Matrix2D
-				mat = Matrix2D::translation(-x1, -y1) * Matrix2D::rotation(-(pnt2 - pnt1).angleAxeX());
-			Vector2D
-				vtr = transform(mat);
-			Point2D
-				p = pnt.transform(mat);
+			double
+				dx = pnt2.x - pnt1.x,
+				dy = pnt2.y - pnt1.y,
+				dblDot = (pnt.x - pnt1.x) * dx + (pnt.y - pnt1.y) * dy;
 
-			return (p.x >= vtr.x1) && (p.x <= vtr.x2);
+			return (dblDot >= 0) && (dblDot <= dx * dx + dy * dy);
 		}
 
 		// checkParallel;
 		//
 		// Checks whether two vectors are parallel.
 		// ----
-		bool checkParallel(const Vector2D &vtr) const
+		constexpr bool checkParallel(const Vector2D &vtr) const
 		{
 			return (vtr.pnt2 - vtr.pnt1).vectorProduct(pnt2 - pnt1) == 0;
 		}
 
 		bool intersection(const Vector2D &vtr, bool aparent, Point2D &pnt) const;
 
-		bool intercept(const Vector2D &vtr) const
+		constexpr bool intercept(const Vector2D &vtr) const
 		{
 			return side(vtr.pnt1) != side(vtr.pnt2) && vtr.side(pnt1) != vtr.side(pnt2);
 		}
 
-		friend Vector2D operator+(const Vector2D &vtr1, const Vector2D &vtr2)
+		friend constexpr Vector2D operator+(const Vector2D &vtr1, const Vector2D &vtr2)
 		{
-			Vector2D
-				v = vtr2;
-
-			v.moveTo(vtr1.pnt2);
-
-			return Vector2D(vtr1.pnt1, v.pnt2);
+			return Vector2D(vtr1.pnt1, vtr2.moveTo(vtr1.pnt2).pnt2);
 		}
-		Vector2D &operator+=(const Vector2D &vtr)
+		constexpr Vector2D &operator+=(const Vector2D &vtr)
 		{
 			*this = *this + vtr;
 
 			return *this;
 		}
 
-		friend Vector2D operator-(const Vector2D &vtr1, const Vector2D &vtr2)
+		friend constexpr Vector2D operator-(const Vector2D &vtr1, const Vector2D &vtr2)
 		{
 			return Vector2D(vtr2.pnt2, vtr1.pnt2);
 		}
-		Vector2D &operator-=(const Vector2D &vtr)
+		constexpr Vector2D &operator-=(const Vector2D &vtr)
 		{
 			*this = *this - vtr;
 
@@ -507,69 +576,167 @@ namespace CIVIL::MATH::GA2D
 
 	}; /* Vector2D */
 
+	// SegmentRecord;
+	//
+	// Precomputed form of a Vector2D for repeated queries against the same segment. The single sqrt is paid
+	// ---- when the record is built; afterwards every query costs one or two dot products. The parameter t
+	//      of a point is its projection along the segment, 0 at pnt1 and 1 at pnt2.
+	struct SegmentRecord
+	{
+	public:
+
+		SegmentRecord() = default;
+		SegmentRecord(const Vector2D &vtr);
+
+		Point2D
+			origin,
+			direction,
+			normal;
+		double
+			invLength = 0,
+			invLength2 = 0;
+
+		double project(const Point2D &pnt) const
+		{
+			return ((pnt.x - origin.x) * direction.x + (pnt.y - origin.y) * direction.y) * invLength2;
+		}
+
+		bool innerLimits(const Point2D &pnt) const
+		{
+			double
+				t = project(pnt);
+
+			return (t >= 0) && (t <= 1);
+		}
+
+		Point2D pointAt(double t) const
+		{
+			return Point2D(origin.x + direction.x * t, origin.y + direction.y * t);
+		}
+
+		// offset;
+		//
+		// Signed distance from a point to the supporting line, positive on the left side (see Vector2D::side).
+		// ----
+		double offset(const Point2D &pnt) const
+		{
+			return (pnt.x - origin.x) * normal.x + (pnt.y - origin.y) * normal.y;
+		}
+
+		double distPoint(const Point2D &pnt) const
+		{
+			return abs(offset(pnt));
+		}
+
+		Point2D closestPoint(const Point2D &pnt) const
+		{
+			double
+				t = project(pnt);
+
+			return pointAt(t < 0 ? 0 : (t > 1 ? 1 : t));
+		}
+
+		// distSegment;
+		//
+		// Distance from a point to the nearest point of the segment (not of the supporting line).
+		// ----
+		double distSegment(const Point2D &pnt) const
+		{
+			return pnt.dist(closestPoint(pnt));
+		}
+
+		Vector2D perpendicular(const Point2D &ref, double module = 0) const;
+
+	}; /* SegmentRecord */
+
 	struct Rectangle2D
 	{
 	public:
 
-		Rectangle2D() = default;
-		Rectangle2D(double _left, double _bottom, double _right, double _top) :
+		constexpr Rectangle2D() = default;
+		constexpr Rectangle2D(double _left, double _bottom, double _right, double _top) :
 			left(_left),
 			bottom(_bottom),
 			right(_right),
 			top(_top)
 		{}
 
-		union
+		// left, bottom, right, top;
+		//
+		// The sides. The bottomLeft/topRight members that shared their storage through an anonymous union are
+		// ---- gone, for the same reason as Vector2D's x1/y1/x2/y2: getBottomLeft()/setBottomLeft() and
+		//      getTopRight()/setTopRight() take their place.
+		double
+			left = 0,
+			bottom = 0,
+			right = 0,
+			top = 0;
+
+		constexpr Point2D getBottomLeft() const
 		{
-			struct { double left, bottom, right, top;  };
-			struct { Point2D bottomLeft, topRight; };
-		};
+			return Point2D(left, bottom);
+		}
+		constexpr void setBottomLeft(const Point2D &pnt)
+		{
+			left = pnt.x;
+			bottom = pnt.y;
+		}
 
-		Point2D getTopLeft() const
+		constexpr Point2D getTopLeft() const
 		{
 			return Point2D(left, top);
 		}
 
-		Point2D getBottomRight() const
+		constexpr Point2D getTopRight() const
+		{
+			return Point2D(right, top);
+		}
+		constexpr void setTopRight(const Point2D &pnt)
+		{
+			right = pnt.x;
+			top = pnt.y;
+		}
+
+		constexpr Point2D getBottomRight() const
 		{
 			return Point2D(right, bottom);
 		}
 
-		double getWidth() const
+		constexpr double getWidth() const
 		{
-			return abs(right - left);
+			return right >= left ? right - left : left - right;
 		}
-		void setWidth(double value)
+		constexpr void setWidth(double value)
 		{
 			right = left + value;
 		}
-		double getHeight() const
+		constexpr double getHeight() const
 		{
-			return abs(top - bottom);
+			return top >= bottom ? top - bottom : bottom - top;
 		}
-		void setHeight(double value)
+		constexpr void setHeight(double value)
 		{
 			top = bottom + value;
 		}
 
-		double area() const
+		constexpr double area() const
 		{
 			return getWidth() * getHeight();
 		}
-		double perimeter() const
+		constexpr double perimeter() const
 		{
 			return 2 * (getWidth() + getHeight());
 		}
-		Point2D center() const
+		constexpr Point2D center() const
 		{
-			return (bottomLeft + topRight) / 2;
+			return Point2D((left + right) / 2, (bottom + top) / 2);
 		}
 
-		Rectangle2D offset(double x, double y) const
+		constexpr Rectangle2D offset(double x, double y) const
 		{
 			return Rectangle2D(left + x, bottom + y, right + x, top + y);
 		}
-		Rectangle2D inflate(double x, double y) const
+		constexpr Rectangle2D inflate(double x, double y) const
 		{
 			Point2D
 				pnt = center();
@@ -580,7 +747,7 @@ namespace CIVIL::MATH::GA2D
 			return Rectangle2D(pnt.x - dblX - x, pnt.y - dblY - y, pnt.x + dblX + x, pnt.y + dblY + y);
 		}
 
-		static Rectangle2D combine(const Rectangle2D &rect1, const Rectangle2D &rect2)
+		static constexpr Rectangle2D combine(const Rectangle2D &rect1, const Rectangle2D &rect2)
 		{
 			return Rectangle2D(min(rect1.left, rect2.left), min(rect1.bottom, rect2.bottom), max(rect1.right, rect2.right), max(rect1.top, rect2.top));
 		}
@@ -601,7 +768,8 @@ namespace CIVIL::MATH::GA2D
 	{
 		iNone,
 		iTangent,
-		iTwoPoints
+		iTwoPoints,
+		iOnePoint
 	};
 
 	struct Circle2D
@@ -624,7 +792,7 @@ namespace CIVIL::MATH::GA2D
 
 	public:
 
-		double getRadius()
+		double getRadius() const
 		{
 			return m_dblRadius;
 		};
@@ -654,6 +822,10 @@ namespace CIVIL::MATH::GA2D
 		double perimeter() const;
 		double area() const;
 
+		// inertiaX;
+		//
+		// Moment of inertia about the axis through "ref" parallel to X (inertiaY: parallel to Y), pi r^4 / 4
+		// ---- about the center plus the parallel-axis term. See SectionProperties for general sections.
 		double inertiaX(const Point2D &ref = NULL_POINT) const;
 		double inertiaY(const Point2D &ref = NULL_POINT) const;
 
@@ -664,9 +836,17 @@ namespace CIVIL::MATH::GA2D
 	public:
 
 		bool intercept(const Rectangle2D &rect);
-		IntersectionEnum intercept(const Vector2D &vector, Vector2D &res);
 
-		bool contains(const Point2D &pnt);
+		// intercept;
+		//
+		// Intersects the circle with a vector. When "aparent" is true the vector is taken as an infinite line,
+		// ---- otherwise only the points between its extremes are considered. The points found are returned in
+		//      "res", ordered along the direction of the vector; for iTangent and iOnePoint both extremes of
+		//      "res" hold the same point.
+		// *************************************************************************
+		IntersectionEnum intercept(const Vector2D &vector, Vector2D &res, bool aparent = false) const;
+
+		bool contains(const Point2D &pnt) const;
 
 	}; /* Circle2D */
 
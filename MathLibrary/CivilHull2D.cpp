@@ -0,0 +1,314 @@
+#include "CivilHull2D.h"
+#include "CivilPredicates.h"
+
+#include <algorithm>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+static const size_t
+	HULL_GRAIN = 1 << 16;
+
+/*
+ * Monotone chain.
+ */
+
+// Lexicographic order by x, then y, then index, so that equal points are adjacent and the first of them
+// has the smallest index.
+struct HullLess
+{
+public:
+
+	const double
+		*x,
+		*y;
+
+	bool operator()(size_t a, size_t b) const
+	{
+		if (x[a] != x[b])
+			return x[a] < x[b];
+		if (y[a] != y[b])
+			return y[a] < y[b];
+		return a < b;
+	}
+
+}; /* HullLess */
+
+// Drops all but the first of each run of equal points of the sorted "idx".
+static void
+removeDuplicates(const PointBuffer &pnts, std::vector<size_t> &idx)
+{
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+
+	idx.erase(std::unique(idx.begin(), idx.end(), [x, y](size_t a, size_t b) {
+		return x[a] == x[b] && y[a] == y[b];
+	}), idx.end());
+}
+
+// The vertices of a hull in HullLess order, in linear time: the lower chain runs from the first vertex
+// to the greatest one and the upper chain comes back.
+static void
+sortedVertices(const std::vector<size_t> &hull, const HullLess &less, std::vector<size_t> &sorted)
+{
+	size_t
+		m = 0;
+
+	if (hull.empty())
+	{
+		sorted.clear();
+		return;
+	}
+
+	while (m + 1 < hull.size() && less(hull[m], hull[m + 1]))
+		m++;
+
+	sorted.resize(hull.size());
+	std::merge(hull.begin(), hull.begin() + m + 1, hull.rbegin(), hull.rend() - m - 1, sorted.begin(), less);
+}
+
+// Hull of the points of "idx", which is sorted and free of duplicates.
+static void
+monotoneChain(const PointBuffer &pnts, const std::vector<size_t> &idx, std::vector<size_t> &hull)
+{
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+	size_t
+		n = idx.size(),
+		k = 0;
+
+	hull.resize(n < 2 ? n : 2 * n);
+
+	if (n < 2)
+	{
+		if (n == 1)
+			hull[0] = idx[0];
+
+		return;
+	}
+
+	auto turnsLeft = [&](size_t a, size_t b, size_t c) {
+		return orient2d(x[a], y[a], x[b], y[b], x[c], y[c]) > 0;
+	};
+
+	// Lower chain, left to right, then upper chain back; each keeps only strict left turns.
+	for (size_t i = 0; i < n; i++)
+	{
+		while (k >= 2 && !turnsLeft(hull[k - 2], hull[k - 1], idx[i]))
+			k--;
+
+		hull[k++] = idx[i];
+	}
+
+	for (size_t i = n - 1, t = k + 1; i-- > 0; )
+	{
+		while (k >= t && !turnsLeft(hull[k - 2], hull[k - 1], idx[i]))
+			k--;
+
+		hull[k++] = idx[i];
+	}
+
+	// The last point repeats the first.
+	hull.resize(k - 1);
+}
+
+/*
+ * Akl-Toussaint filter.
+ */
+
+// Extreme points in the eight directions, counterclockwise from -x: min x, min x + y, min y, max x - y,
+// max x, max x + y, max y, min x - y.
+struct HullExtremes
+{
+public:
+
+	size_t
+		items[8];
+
+}; /* HullExtremes */
+
+static HullExtremes
+findExtremes(const PointBuffer &pnts, size_t first, size_t last)
+{
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+	HullExtremes
+		ext;
+
+	std::fill(ext.items, ext.items + 8, first);
+
+	for (size_t i = first + 1; i < last; i++)
+	{
+		if (x[i] < x[ext.items[0]])
+			ext.items[0] = i;
+		if (x[i] + y[i] < x[ext.items[1]] + y[ext.items[1]])
+			ext.items[1] = i;
+		if (y[i] < y[ext.items[2]])
+			ext.items[2] = i;
+		if (x[i] - y[i] > x[ext.items[3]] - y[ext.items[3]])
+			ext.items[3] = i;
+		if (x[i] > x[ext.items[4]])
+			ext.items[4] = i;
+		if (x[i] + y[i] > x[ext.items[5]] + y[ext.items[5]])
+			ext.items[5] = i;
+		if (y[i] > y[ext.items[6]])
+			ext.items[6] = i;
+		if (x[i] - y[i] < x[ext.items[7]] - y[ext.items[7]])
+			ext.items[7] = i;
+	}
+
+	return ext;
+}
+
+static HullExtremes
+joinExtremes(const PointBuffer &pnts, const HullExtremes &a, const HullExtremes &b)
+{
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+	HullExtremes
+		ext = a;
+
+	auto keyOf = [x, y](int dir, size_t i) {
+		static const double
+			WX[8] = {-1, -1, 0, 1, 1, 1, 0, -1},
+			WY[8] = {0, -1, -1, -1, 0, 1, 1, 1};
+
+		return WX[dir] * x[i] + WY[dir] * y[i];
+	};
+
+	for (int d = 0; d < 8; d++)
+		if (keyOf(d, b.items[d]) > keyOf(d, a.items[d]))
+			ext.items[d] = b.items[d];
+
+	return ext;
+}
+
+// Convex polygon of the extremes, counterclockwise, with repeated points removed. Points strictly inside
+// are strictly inside the hull and cannot be part of the result.
+struct HullFilter
+{
+public:
+
+	double
+		x[8], y[8];
+	int
+		count = 0;
+
+	HullFilter(const PointBuffer &pnts, const HullExtremes &ext)
+	{
+		for (int d = 0; d < 8; d++)
+		{
+			double
+				dblX = pnts.x[ext.items[d]],
+				dblY = pnts.y[ext.items[d]];
+
+			if (count > 0 && x[count - 1] == dblX && y[count - 1] == dblY)
+				continue;
+
+			x[count] = dblX;
+			y[count] = dblY;
+			count++;
+		}
+
+		while (count > 1 && x[count - 1] == x[0] && y[count - 1] == y[0])
+			count--;
+	}
+
+	bool isInside(double px, double py) const
+	{
+		if (count < 3)
+			return false;
+
+		for (int i = 0, j = count - 1; i < count; j = i++)
+			if (orient2d(x[j], y[j], x[i], y[i], px, py) <= 0)
+				return false;
+
+		return true;
+	}
+
+}; /* HullFilter */
+
+/*
+ * convexHull.
+ */
+
+void
+convexHull(const PointBuffer &pnts, std::vector<size_t> &hull, bool parallel)
+{
+	size_t
+		n = pnts.size();
+
+	hull.clear();
+
+	if (n == 0)
+		return;
+
+	HullExtremes
+		ext = parallel ?
+			parallelReduce(0, n, HULL_GRAIN, findExtremes(pnts, 0, 1),
+				[&](size_t first, size_t last) { return findExtremes(pnts, first, last); },
+				[&](const HullExtremes &a, const HullExtremes &b) { return joinExtremes(pnts, a, b); }) :
+			findExtremes(pnts, 0, n);
+	HullFilter
+		filter(pnts, ext);
+	HullLess
+		less = {pnts.x.data(), pnts.y.data()};
+
+	// Hull of one piece of the buffer.
+	auto pieceHull = [&](size_t first, size_t last) {
+		std::vector<size_t>
+			aIdx,
+			aHull;
+
+		for (size_t i = first; i < last; i++)
+			if (!filter.isInside(pnts.x[i], pnts.y[i]))
+				aIdx.push_back(i);
+
+		std::sort(aIdx.begin(), aIdx.end(), less);
+		removeDuplicates(pnts, aIdx);
+		monotoneChain(pnts, aIdx, aHull);
+
+		return aHull;
+	};
+
+	// Hull of two hulls: the chain over the union of their vertices, which are merged rather than sorted.
+	// A piece whose points all fall inside the filter has an empty hull, and then the other one is the result.
+	auto joinHulls = [&](const std::vector<size_t> &a, const std::vector<size_t> &b) {
+		std::vector<size_t>
+			aA,
+			aB,
+			aIdx,
+			aHull;
+
+		if (a.empty())
+			return b;
+		if (b.empty())
+			return a;
+
+		sortedVertices(a, less, aA);
+		sortedVertices(b, less, aB);
+
+		aIdx.resize(aA.size() + aB.size());
+		std::merge(aA.begin(), aA.end(), aB.begin(), aB.end(), aIdx.begin(), less);
+
+		removeDuplicates(pnts, aIdx);
+		monotoneChain(pnts, aIdx, aHull);
+
+		return aHull;
+	};
+
+	if (parallel)
+		hull = parallelReduce(0, n, HULL_GRAIN, std::vector<size_t>(), pieceHull, joinHulls);
+	else
+		hull = pieceHull(0, n);
+}
+
+} // namespace CIVIL::MATH::GA2D
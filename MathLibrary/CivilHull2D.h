@@ -0,0 +1,54 @@
+/***
+ * CivilHull2D.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_HULL_2D
+#define __CIVIL_HULL_2D
+
+#include <vector>
+
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilBuffer2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// convexHull;
+	//
+	// Writes to "hull" the indexes into "pnts" of the vertices of their convex hull, counterclockwise and
+	// ---- starting at the lowest of the leftmost points. Orientation is decided by orient2d, so points that
+	//      lie on a hull edge are always left out and of coincident points only the one with the smallest
+	//      index is kept; the result is the same with and without "parallel" and for any number of threads.
+	//      One point gives one index, collinear points give the two ends and an empty buffer gives nothing.
+	//
+	//      Points strictly inside the polygon of the extremes in x, y, x + y and x - y are discarded first
+	//      (Akl-Toussaint); the rest go through Andrew's monotone chain. With "parallel" the buffer is split
+	//      in pieces whose hulls are found on the shared pool and merged pairwise.
+	void convexHull(const PointBuffer &pnts, std::vector<size_t> &hull, bool parallel = true);
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_HULL_2D
@@ -0,0 +1,1232 @@
+#include "CivilKernels2D.h"
+
+#if CIVIL_X86
+#include <immintrin.h>
+#endif // if CIVIL_X86
+
+namespace CIVIL::MATH::GA2D
+{
+
+/*
+ * Scalar.
+ */
+
+static void
+transformScalar(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY, size_t count)
+{
+	double
+		m00 = mat.items[0][0], m01 = mat.items[0][1], m02 = mat.items[0][2],
+		m10 = mat.items[1][0], m11 = mat.items[1][1], m12 = mat.items[1][2];
+
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			px = x[i],
+			py = y[i];
+
+		resX[i] = m00 * px + m01 * py + m02;
+		resY[i] = m10 * px + m11 * py + m12;
+	}
+}
+
+static void
+projectiveScalar(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY, size_t count)
+{
+	double
+		m00 = mat.items[0][0], m01 = mat.items[0][1], m02 = mat.items[0][2],
+		m10 = mat.items[1][0], m11 = mat.items[1][1], m12 = mat.items[1][2],
+		m20 = mat.items[2][0], m21 = mat.items[2][1], m22 = mat.items[2][2];
+
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			px = x[i],
+			py = y[i],
+			w = m20 * px + m21 * py + m22;
+
+		resX[i] = (m00 * px + m01 * py + m02) / w;
+		resY[i] = (m10 * px + m11 * py + m12) / w;
+	}
+}
+
+static void
+distScalar(const double *x1, const double *y1, const double *x2, const double *y2, double *res, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			dx = x2[i] - x1[i],
+			dy = y2[i] - y1[i];
+
+		res[i] = sqrt(dx * dx + dy * dy);
+	}
+}
+
+static void
+distRefScalar(const double *x, const double *y, double xRef, double yRef, double *res, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			dx = x[i] - xRef,
+			dy = y[i] - yRef;
+
+		res[i] = sqrt(dx * dx + dy * dy);
+	}
+}
+
+static void
+rectangleTestScalar(const double *left, const double *bottom, const double *right, const double *top, size_t count,
+	const double lo[4], const double hi[4], uint64_t *mask)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		uint64_t
+			bit = (uint64_t) (left[i] >= lo[0] && left[i] <= hi[0] && bottom[i] >= lo[1] && bottom[i] <= hi[1] &&
+				right[i] >= lo[2] && right[i] <= hi[2] && top[i] >= lo[3] && top[i] <= hi[3]) << (i % 64);
+
+		if (i % 64 == 0)
+			mask[i / 64] = bit;
+		else
+			mask[i / 64] |= bit;
+	}
+}
+
+static void
+boundsScalar(const double *x1, const double *y1, const double *x2, const double *y2, const double *r, size_t count,
+	double bounds[4])
+{
+	// An item with any side NaN is left out whole; the vector variants blend its sides to the empty bounds.
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			ri = r ? r[i] : 0,
+			l = x1[i] - ri,
+			b = y1[i] - ri,
+			rt = x2[i] + ri,
+			t = y2[i] + ri;
+
+		if (isnan(l) || isnan(b) || isnan(rt) || isnan(t))
+			continue;
+
+		if (l < bounds[0])
+			bounds[0] = l;
+		if (b < bounds[1])
+			bounds[1] = b;
+		if (rt > bounds[2])
+			bounds[2] = rt;
+		if (t > bounds[3])
+			bounds[3] = t;
+	}
+}
+
+static void
+clipScalar(const Rectangle2D &window, const double *x1, const double *y1, const double *x2, const double *y2,
+	double *resX1, double *resY1, double *resX2, double *resY2, unsigned char *visible, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			ax = x1[i],
+			ay = y1[i],
+			bx = x2[i],
+			by = y2[i],
+			dx = bx - ax,
+			dy = by - ay,
+			p[4] = { -dx, dx, -dy, dy },
+			q[4] = { ax - window.left, window.right - ax, ay - window.bottom, window.top - ay },
+			t0 = 0,
+			t1 = 1;
+		bool
+			blnVisible = true;
+
+		// p < 0 enters the window through boundary k at q / p, p > 0 leaves it; p = 0 runs parallel to the
+		// boundary and is out when q < 0. NaN coordinates fall in the last case.
+		for (int k = 0; k < 4; k++)
+		{
+			double
+				r = q[k] / p[k];
+
+			if (p[k] < 0)
+			{
+				if (r > t0)
+					t0 = r;
+			}
+			else if (p[k] > 0)
+			{
+				if (r < t1)
+					t1 = r;
+			}
+			else if (!(q[k] >= 0))
+				blnVisible = false;
+		}
+
+		if (blnVisible && t0 <= t1)
+		{
+			double
+				cx1 = ax + t0 * dx,
+				cy1 = ay + t0 * dy,
+				cx2 = t1 == 1 ? bx : ax + t1 * dx,
+				cy2 = t1 == 1 ? by : ay + t1 * dy;
+
+			resX1[i] = cx1 < window.left ? window.left : (cx1 > window.right ? window.right : cx1);
+			resY1[i] = cy1 < window.bottom ? window.bottom : (cy1 > window.top ? window.top : cy1);
+			resX2[i] = cx2 < window.left ? window.left : (cx2 > window.right ? window.right : cx2);
+			resY2[i] = cy2 < window.bottom ? window.bottom : (cy2 > window.top ? window.top : cy2);
+			visible[i] = 1;
+		}
+		else
+		{
+			resX1[i] = ax;
+			resY1[i] = ay;
+			resX2[i] = bx;
+			resY2[i] = by;
+			visible[i] = 0;
+		}
+	}
+}
+
+// Circle intersection. The per-item body has no calls or early exits and classifies with selects, so
+// every item runs the same instruction sequence; the vector variants follow it lane by lane.
+
+static inline void
+interceptItem(double fx, double fy, double dx, double dy, double r, bool aparent, unsigned char &kind, double &t1, double &t2)
+{
+	double
+		a = dx * dx + dy * dy,
+		b = fx * dx + fy * dy,
+		c = fx * fx + fy * fy - r * r,
+		dblDelta = b * b - a * c,
+		dblRoot = sqrt(dblDelta > 0 ? dblDelta : 0),
+		q = -(b + (b < 0 ? -dblRoot : dblRoot)),
+		ta = q / a,
+		tb = q != 0 ? c / q : ta,
+		tMin = ta < tb ? ta : tb,
+		tMax = ta < tb ? tb : ta;
+	bool
+		blnMin = (tMin >= 0) && (tMin <= 1),
+		blnMax = (tMax >= 0) && (tMax <= 1),
+		blnTangent = dblDelta == 0,
+		blnHit = (a != 0) && (dblDelta >= 0);
+	unsigned char
+		kindLine = blnTangent ? iTangent : iTwoPoints,
+		kindSeg = blnTangent ? (blnMin ? iTangent : iNone) : (blnMin ? (blnMax ? iTwoPoints : iOnePoint) : (blnMax ? iOnePoint : iNone));
+
+	kind = blnHit ? (aparent ? kindLine : kindSeg) : (unsigned char) iNone;
+
+	// A single crossing is reported at the root that lies on the segment.
+	t1 = (!aparent && !blnMin && blnMax) ? tMax : tMin;
+	t2 = (!aparent && blnMin && !blnMax) ? tMin : tMax;
+}
+
+static void
+interceptCirclesScalar(double px, double py, double dx, double dy, const double *cx, const double *cy, const double *r,
+	bool aparent, unsigned char *kind, double *t1, double *t2, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		interceptItem(px - cx[i], py - cy[i], dx, dy, r[i], aparent, kind[i], t1[i], t2[i]);
+}
+
+static void
+interceptVectorsScalar(double cx, double cy, double r, const double *x1, const double *y1, const double *x2, const double *y2,
+	bool aparent, unsigned char *kind, double *t1, double *t2, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		interceptItem(x1[i] - cx, y1[i] - cy, x2[i] - x1[i], y2[i] - y1[i], r, aparent, kind[i], t1[i], t2[i]);
+}
+
+static long long
+nearestInterceptScalar(double px, double py, double dx, double dy, const double *cx, const double *cy, const double *r,
+	size_t count, double &t)
+{
+	double
+		a = dx * dx + dy * dy;
+	long long
+		intRes = -1;
+
+	t = 1;
+
+	if (a == 0)
+		return -1;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			fx = px - cx[i],
+			fy = py - cy[i],
+			b = fx * dx + fy * dy,
+			c = fx * fx + fy * fy - r[i] * r[i],
+			dblDelta = b * b - a * c;
+
+		// Tests written so that NaN circles fail them.
+		if (!(dblDelta >= 0))
+			continue;
+
+		double
+			dblRoot = sqrt(dblDelta),
+			tEnter = (-b - dblRoot) / a,
+			tLeave = (-b + dblRoot) / a;
+
+		// The segment overlaps the disc when [tEnter, tLeave] meets [0, 1].
+		if (!(tLeave >= 0 && tEnter <= 1))
+			continue;
+
+		if (tEnter < 0)
+			tEnter = 0;
+
+		if (intRes < 0 || tEnter < t)
+		{
+			t = tEnter;
+			intRes = (long long) i;
+		}
+	}
+
+	return intRes;
+}
+
+#if CIVIL_X86
+
+/*
+ * SSE2.
+ */
+
+// The vector loops stop at the last full register; the scalar variants finish the tail.
+
+CIVIL_TARGET("sse2") static void
+transformSSE2(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY, size_t count)
+{
+	__m128d
+		m00 = _mm_set1_pd(mat.items[0][0]), m01 = _mm_set1_pd(mat.items[0][1]), m02 = _mm_set1_pd(mat.items[0][2]),
+		m10 = _mm_set1_pd(mat.items[1][0]), m11 = _mm_set1_pd(mat.items[1][1]), m12 = _mm_set1_pd(mat.items[1][2]);
+	size_t
+		i = 0;
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d
+			px = _mm_loadu_pd(x + i),
+			py = _mm_loadu_pd(y + i);
+
+		_mm_storeu_pd(resX + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m00, px), _mm_mul_pd(m01, py)), m02));
+		_mm_storeu_pd(resY + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m10, px), _mm_mul_pd(m11, py)), m12));
+	}
+
+	transformScalar(mat, x + i, y + i, resX + i, resY + i, count - i);
+}
+
+CIVIL_TARGET("sse2") static void
+projectiveSSE2(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY, size_t count)
+{
+	__m128d
+		m00 = _mm_set1_pd(mat.items[0][0]), m01 = _mm_set1_pd(mat.items[0][1]), m02 = _mm_set1_pd(mat.items[0][2]),
+		m10 = _mm_set1_pd(mat.items[1][0]), m11 = _mm_set1_pd(mat.items[1][1]), m12 = _mm_set1_pd(mat.items[1][2]),
+		m20 = _mm_set1_pd(mat.items[2][0]), m21 = _mm_set1_pd(mat.items[2][1]), m22 = _mm_set1_pd(mat.items[2][2]);
+	size_t
+		i = 0;
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d
+			px = _mm_loadu_pd(x + i),
+			py = _mm_loadu_pd(y + i),
+			w = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m20, px), _mm_mul_pd(m21, py)), m22);
+
+		_mm_storeu_pd(resX + i, _mm_div_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(m00, px), _mm_mul_pd(m01, py)), m02), w));
+		_mm_storeu_pd(resY + i, _mm_div_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(m10, px), _mm_mul_pd(m11, py)), m12), w));
+	}
+
+	projectiveScalar(mat, x + i, y + i, resX + i, resY + i, count - i);
+}
+
+CIVIL_TARGET("sse2") static void
+distSSE2(const double *x1, const double *y1, const double *x2, const double *y2, double *res, size_t count)
+{
+	size_t
+		i = 0;
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d
+			dx = _mm_sub_pd(_mm_loadu_pd(x2 + i), _mm_loadu_pd(x1 + i)),
+			dy = _mm_sub_pd(_mm_loadu_pd(y2 + i), _mm_loadu_pd(y1 + i));
+
+		_mm_storeu_pd(res + i, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy))));
+	}
+
+	distScalar(x1 + i, y1 + i, x2 + i, y2 + i, res + i, count - i);
+}
+
+CIVIL_TARGET("sse2") static void
+distRefSSE2(const double *x, const double *y, double xRef, double yRef, double *res, size_t count)
+{
+	__m128d
+		rx = _mm_set1_pd(xRef),
+		ry = _mm_set1_pd(yRef);
+	size_t
+		i = 0;
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d
+			dx = _mm_sub_pd(_mm_loadu_pd(x + i), rx),
+			dy = _mm_sub_pd(_mm_loadu_pd(y + i), ry);
+
+		_mm_storeu_pd(res + i, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy))));
+	}
+
+	distRefScalar(x + i, y + i, xRef, yRef, res + i, count - i);
+}
+
+CIVIL_TARGET("sse2") static inline __m128d
+betweenSSE2(__m128d v, __m128d lo, __m128d hi)
+{
+	return _mm_and_pd(_mm_cmpge_pd(v, lo), _mm_cmple_pd(v, hi));
+}
+
+CIVIL_TARGET("sse2") static void
+rectangleTestSSE2(const double *left, const double *bottom, const double *right, const double *top, size_t count,
+	const double lo[4], const double hi[4], uint64_t *mask)
+{
+	__m128d
+		lo0 = _mm_set1_pd(lo[0]), lo1 = _mm_set1_pd(lo[1]), lo2 = _mm_set1_pd(lo[2]), lo3 = _mm_set1_pd(lo[3]),
+		hi0 = _mm_set1_pd(hi[0]), hi1 = _mm_set1_pd(hi[1]), hi2 = _mm_set1_pd(hi[2]), hi3 = _mm_set1_pd(hi[3]);
+	size_t
+		i = 0;
+
+	// Whole mask words only.
+	for (; i + 64 <= count; i += 64)
+	{
+		uint64_t
+			bits = 0;
+
+		for (size_t j = i; j < i + 64; j += 2)
+		{
+			__m128d
+				in = _mm_and_pd(
+					_mm_and_pd(betweenSSE2(_mm_loadu_pd(left + j), lo0, hi0), betweenSSE2(_mm_loadu_pd(bottom + j), lo1, hi1)),
+					_mm_and_pd(betweenSSE2(_mm_loadu_pd(right + j), lo2, hi2), betweenSSE2(_mm_loadu_pd(top + j), lo3, hi3)));
+
+			bits |= (uint64_t) _mm_movemask_pd(in) << (j - i);
+		}
+
+		mask[i / 64] = bits;
+	}
+
+	rectangleTestScalar(left + i, bottom + i, right + i, top + i, count - i, lo, hi, mask + i / 64);
+}
+
+CIVIL_TARGET("sse2") static void
+boundsSSE2(const double *x1, const double *y1, const double *x2, const double *y2, const double *r, size_t count,
+	double bounds[4])
+{
+	__m128d
+		vLeft = _mm_set1_pd(bounds[0]), vBottom = _mm_set1_pd(bounds[1]),
+		vRight = _mm_set1_pd(bounds[2]), vTop = _mm_set1_pd(bounds[3]),
+		vInf = _mm_set1_pd(INFINITY), vMinusInf = _mm_set1_pd(-INFINITY);
+	size_t
+		i = 0;
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d
+			vR = r ? _mm_loadu_pd(r + i) : _mm_setzero_pd(),
+			vL = _mm_sub_pd(_mm_loadu_pd(x1 + i), vR),
+			vB = _mm_sub_pd(_mm_loadu_pd(y1 + i), vR),
+			vRt = _mm_add_pd(_mm_loadu_pd(x2 + i), vR),
+			vT = _mm_add_pd(_mm_loadu_pd(y2 + i), vR),
+			vValid = _mm_and_pd(_mm_cmpord_pd(vL, vB), _mm_cmpord_pd(vRt, vT));
+
+		vLeft = _mm_min_pd(_mm_or_pd(_mm_and_pd(vValid, vL), _mm_andnot_pd(vValid, vInf)), vLeft);
+		vBottom = _mm_min_pd(_mm_or_pd(_mm_and_pd(vValid, vB), _mm_andnot_pd(vValid, vInf)), vBottom);
+		vRight = _mm_max_pd(_mm_or_pd(_mm_and_pd(vValid, vRt), _mm_andnot_pd(vValid, vMinusInf)), vRight);
+		vTop = _mm_max_pd(_mm_or_pd(_mm_and_pd(vValid, vT), _mm_andnot_pd(vValid, vMinusInf)), vTop);
+	}
+
+	double
+		aLeft[2], aBottom[2], aRight[2], aTop[2];
+
+	_mm_storeu_pd(aLeft, vLeft);
+	_mm_storeu_pd(aBottom, vBottom);
+	_mm_storeu_pd(aRight, vRight);
+	_mm_storeu_pd(aTop, vTop);
+	boundsScalar(aLeft, aBottom, aRight, aTop, nullptr, 2, bounds);
+	boundsScalar(x1 + i, y1 + i, x2 + i, y2 + i, r ? r + i : nullptr, count - i, bounds);
+}
+
+/*
+ * AVX2 + FMA.
+ */
+
+CIVIL_TARGET("avx2,fma") static void
+transformAVX2(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY, size_t count)
+{
+	__m256d
+		m00 = _mm256_set1_pd(mat.items[0][0]), m01 = _mm256_set1_pd(mat.items[0][1]), m02 = _mm256_set1_pd(mat.items[0][2]),
+		m10 = _mm256_set1_pd(mat.items[1][0]), m11 = _mm256_set1_pd(mat.items[1][1]), m12 = _mm256_set1_pd(mat.items[1][2]);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			px = _mm256_loadu_pd(x + i),
+			py = _mm256_loadu_pd(y + i);
+
+		_mm256_storeu_pd(resX + i, _mm256_fmadd_pd(m00, px, _mm256_fmadd_pd(m01, py, m02)));
+		_mm256_storeu_pd(resY + i, _mm256_fmadd_pd(m10, px, _mm256_fmadd_pd(m11, py, m12)));
+	}
+
+	transformScalar(mat, x + i, y + i, resX + i, resY + i, count - i);
+}
+
+CIVIL_TARGET("avx2,fma") static void
+projectiveAVX2(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY, size_t count)
+{
+	__m256d
+		m00 = _mm256_set1_pd(mat.items[0][0]), m01 = _mm256_set1_pd(mat.items[0][1]), m02 = _mm256_set1_pd(mat.items[0][2]),
+		m10 = _mm256_set1_pd(mat.items[1][0]), m11 = _mm256_set1_pd(mat.items[1][1]), m12 = _mm256_set1_pd(mat.items[1][2]),
+		m20 = _mm256_set1_pd(mat.items[2][0]), m21 = _mm256_set1_pd(mat.items[2][1]), m22 = _mm256_set1_pd(mat.items[2][2]);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			px = _mm256_loadu_pd(x + i),
+			py = _mm256_loadu_pd(y + i),
+			w = _mm256_fmadd_pd(m20, px, _mm256_fmadd_pd(m21, py, m22));
+
+		_mm256_storeu_pd(resX + i, _mm256_div_pd(_mm256_fmadd_pd(m00, px, _mm256_fmadd_pd(m01, py, m02)), w));
+		_mm256_storeu_pd(resY + i, _mm256_div_pd(_mm256_fmadd_pd(m10, px, _mm256_fmadd_pd(m11, py, m12)), w));
+	}
+
+	projectiveScalar(mat, x + i, y + i, resX + i, resY + i, count - i);
+}
+
+CIVIL_TARGET("avx2,fma") static void
+distAVX2(const double *x1, const double *y1, const double *x2, const double *y2, double *res, size_t count)
+{
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			dx = _mm256_sub_pd(_mm256_loadu_pd(x2 + i), _mm256_loadu_pd(x1 + i)),
+			dy = _mm256_sub_pd(_mm256_loadu_pd(y2 + i), _mm256_loadu_pd(y1 + i));
+
+		_mm256_storeu_pd(res + i, _mm256_sqrt_pd(_mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy))));
+	}
+
+	distScalar(x1 + i, y1 + i, x2 + i, y2 + i, res + i, count - i);
+}
+
+CIVIL_TARGET("avx2,fma") static void
+distRefAVX2(const double *x, const double *y, double xRef, double yRef, double *res, size_t count)
+{
+	__m256d
+		rx = _mm256_set1_pd(xRef),
+		ry = _mm256_set1_pd(yRef);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), rx),
+			dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), ry);
+
+		_mm256_storeu_pd(res + i, _mm256_sqrt_pd(_mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy))));
+	}
+
+	distRefScalar(x + i, y + i, xRef, yRef, res + i, count - i);
+}
+
+CIVIL_TARGET("avx2,fma") static inline __m256d
+betweenAVX2(__m256d v, __m256d lo, __m256d hi)
+{
+	return _mm256_and_pd(_mm256_cmp_pd(v, lo, _CMP_GE_OQ), _mm256_cmp_pd(v, hi, _CMP_LE_OQ));
+}
+
+CIVIL_TARGET("avx2,fma") static void
+rectangleTestAVX2(const double *left, const double *bottom, const double *right, const double *top, size_t count,
+	const double lo[4], const double hi[4], uint64_t *mask)
+{
+	__m256d
+		lo0 = _mm256_set1_pd(lo[0]), lo1 = _mm256_set1_pd(lo[1]), lo2 = _mm256_set1_pd(lo[2]), lo3 = _mm256_set1_pd(lo[3]),
+		hi0 = _mm256_set1_pd(hi[0]), hi1 = _mm256_set1_pd(hi[1]), hi2 = _mm256_set1_pd(hi[2]), hi3 = _mm256_set1_pd(hi[3]);
+	size_t
+		i = 0;
+
+	for (; i + 64 <= count; i += 64)
+	{
+		uint64_t
+			bits = 0;
+
+		for (size_t j = i; j < i + 64; j += 4)
+		{
+			__m256d
+				in = _mm256_and_pd(
+					_mm256_and_pd(betweenAVX2(_mm256_loadu_pd(left + j), lo0, hi0), betweenAVX2(_mm256_loadu_pd(bottom + j), lo1, hi1)),
+					_mm256_and_pd(betweenAVX2(_mm256_loadu_pd(right + j), lo2, hi2), betweenAVX2(_mm256_loadu_pd(top + j), lo3, hi3)));
+
+			bits |= (uint64_t) _mm256_movemask_pd(in) << (j - i);
+		}
+
+		mask[i / 64] = bits;
+	}
+
+	rectangleTestScalar(left + i, bottom + i, right + i, top + i, count - i, lo, hi, mask + i / 64);
+}
+
+CIVIL_TARGET("avx2,fma") static void
+boundsAVX2(const double *x1, const double *y1, const double *x2, const double *y2, const double *r, size_t count,
+	double bounds[4])
+{
+	__m256d
+		vLeft = _mm256_set1_pd(bounds[0]), vBottom = _mm256_set1_pd(bounds[1]),
+		vRight = _mm256_set1_pd(bounds[2]), vTop = _mm256_set1_pd(bounds[3]),
+		vInf = _mm256_set1_pd(INFINITY), vMinusInf = _mm256_set1_pd(-INFINITY);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			vR = r ? _mm256_loadu_pd(r + i) : _mm256_setzero_pd(),
+			vL = _mm256_sub_pd(_mm256_loadu_pd(x1 + i), vR),
+			vB = _mm256_sub_pd(_mm256_loadu_pd(y1 + i), vR),
+			vRt = _mm256_add_pd(_mm256_loadu_pd(x2 + i), vR),
+			vT = _mm256_add_pd(_mm256_loadu_pd(y2 + i), vR),
+			vValid = _mm256_and_pd(_mm256_cmp_pd(vL, vB, _CMP_ORD_Q), _mm256_cmp_pd(vRt, vT, _CMP_ORD_Q));
+
+		vLeft = _mm256_min_pd(_mm256_blendv_pd(vInf, vL, vValid), vLeft);
+		vBottom = _mm256_min_pd(_mm256_blendv_pd(vInf, vB, vValid), vBottom);
+		vRight = _mm256_max_pd(_mm256_blendv_pd(vMinusInf, vRt, vValid), vRight);
+		vTop = _mm256_max_pd(_mm256_blendv_pd(vMinusInf, vT, vValid), vTop);
+	}
+
+	double
+		aLeft[4], aBottom[4], aRight[4], aTop[4];
+
+	_mm256_storeu_pd(aLeft, vLeft);
+	_mm256_storeu_pd(aBottom, vBottom);
+	_mm256_storeu_pd(aRight, vRight);
+	_mm256_storeu_pd(aTop, vTop);
+	boundsScalar(aLeft, aBottom, aRight, aTop, nullptr, 4, bounds);
+	boundsScalar(x1 + i, y1 + i, x2 + i, y2 + i, r ? r + i : nullptr, count - i, bounds);
+}
+
+CIVIL_TARGET("avx2,fma") static void
+clipAVX2(const Rectangle2D &window, const double *x1, const double *y1, const double *x2, const double *y2,
+	double *resX1, double *resY1, double *resX2, double *resY2, unsigned char *visible, size_t count)
+{
+	__m256d
+		wl = _mm256_set1_pd(window.left), wb = _mm256_set1_pd(window.bottom),
+		wr = _mm256_set1_pd(window.right), wt = _mm256_set1_pd(window.top),
+		vZero = _mm256_setzero_pd(),
+		vOne = _mm256_set1_pd(1);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			ax = _mm256_loadu_pd(x1 + i), ay = _mm256_loadu_pd(y1 + i),
+			bx = _mm256_loadu_pd(x2 + i), by = _mm256_loadu_pd(y2 + i),
+			dx = _mm256_sub_pd(bx, ax),
+			dy = _mm256_sub_pd(by, ay),
+			p[4] = { _mm256_sub_pd(vZero, dx), dx, _mm256_sub_pd(vZero, dy), dy },
+			q[4] = { _mm256_sub_pd(ax, wl), _mm256_sub_pd(wr, ax), _mm256_sub_pd(ay, wb), _mm256_sub_pd(wt, ay) },
+			t0 = vZero,
+			t1 = vOne,
+			out = vZero;
+
+		// Same cases as clipScalar as selects; min and max take the accumulator last so that NaN ratios drop out.
+		for (int k = 0; k < 4; k++)
+		{
+			__m256d
+				r = _mm256_div_pd(q[k], p[k]);
+
+			t0 = _mm256_blendv_pd(t0, _mm256_max_pd(r, t0), _mm256_cmp_pd(p[k], vZero, _CMP_LT_OQ));
+			t1 = _mm256_blendv_pd(t1, _mm256_min_pd(r, t1), _mm256_cmp_pd(p[k], vZero, _CMP_GT_OQ));
+			out = _mm256_or_pd(out, _mm256_and_pd(
+				_mm256_and_pd(_mm256_cmp_pd(p[k], vZero, _CMP_NLT_UQ), _mm256_cmp_pd(p[k], vZero, _CMP_NGT_UQ)),
+				_mm256_cmp_pd(q[k], vZero, _CMP_NGE_UQ)));
+		}
+
+		__m256d
+			in = _mm256_andnot_pd(out, _mm256_cmp_pd(t0, t1, _CMP_LE_OQ)),
+			end = _mm256_cmp_pd(t1, vOne, _CMP_EQ_OQ),
+			cx1 = _mm256_min_pd(_mm256_max_pd(_mm256_fmadd_pd(t0, dx, ax), wl), wr),
+			cy1 = _mm256_min_pd(_mm256_max_pd(_mm256_fmadd_pd(t0, dy, ay), wb), wt),
+			cx2 = _mm256_min_pd(_mm256_max_pd(_mm256_blendv_pd(_mm256_fmadd_pd(t1, dx, ax), bx, end), wl), wr),
+			cy2 = _mm256_min_pd(_mm256_max_pd(_mm256_blendv_pd(_mm256_fmadd_pd(t1, dy, ay), by, end), wb), wt);
+		int
+			intIn = _mm256_movemask_pd(in);
+
+		_mm256_storeu_pd(resX1 + i, _mm256_blendv_pd(ax, cx1, in));
+		_mm256_storeu_pd(resY1 + i, _mm256_blendv_pd(ay, cy1, in));
+		_mm256_storeu_pd(resX2 + i, _mm256_blendv_pd(bx, cx2, in));
+		_mm256_storeu_pd(resY2 + i, _mm256_blendv_pd(by, cy2, in));
+
+		for (int k = 0; k < 4; k++)
+			visible[i + k] = (unsigned char) ((intIn >> k) & 1);
+	}
+
+	clipScalar(window, x1 + i, y1 + i, x2 + i, y2 + i, resX1 + i, resY1 + i, resX2 + i, resY2 + i, visible + i, count - i);
+}
+
+CIVIL_TARGET("avx2,fma") static inline void
+interceptLanesAVX2(__m256d fx, __m256d fy, __m256d dx, __m256d dy, __m256d r, bool aparent, unsigned char *kind,
+	double *t1, double *t2)
+{
+	// interceptItem on four lanes; the kinds are carried as doubles until the store.
+	__m256d
+		vZero = _mm256_setzero_pd(),
+		vOne = _mm256_set1_pd(1),
+		vSign = _mm256_set1_pd(-0.0),
+		a = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+		b = _mm256_add_pd(_mm256_mul_pd(fx, dx), _mm256_mul_pd(fy, dy)),
+		c = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(fx, fx), _mm256_mul_pd(fy, fy)), _mm256_mul_pd(r, r)),
+		delta = _mm256_sub_pd(_mm256_mul_pd(b, b), _mm256_mul_pd(a, c)),
+		root = _mm256_sqrt_pd(_mm256_max_pd(delta, vZero)),
+		q = _mm256_xor_pd(_mm256_blendv_pd(_mm256_add_pd(b, root), _mm256_sub_pd(b, root), _mm256_cmp_pd(b, vZero, _CMP_LT_OQ)), vSign),
+		ta = _mm256_div_pd(q, a),
+		tb = _mm256_blendv_pd(ta, _mm256_div_pd(c, q), _mm256_cmp_pd(q, vZero, _CMP_NEQ_UQ)),
+		lt = _mm256_cmp_pd(ta, tb, _CMP_LT_OQ),
+		tMin = _mm256_blendv_pd(tb, ta, lt),
+		tMax = _mm256_blendv_pd(ta, tb, lt),
+		inMin = _mm256_and_pd(_mm256_cmp_pd(tMin, vZero, _CMP_GE_OQ), _mm256_cmp_pd(tMin, vOne, _CMP_LE_OQ)),
+		inMax = _mm256_and_pd(_mm256_cmp_pd(tMax, vZero, _CMP_GE_OQ), _mm256_cmp_pd(tMax, vOne, _CMP_LE_OQ)),
+		tangent = _mm256_cmp_pd(delta, vZero, _CMP_EQ_OQ),
+		hit = _mm256_and_pd(_mm256_cmp_pd(a, vZero, _CMP_NEQ_UQ), _mm256_cmp_pd(delta, vZero, _CMP_GE_OQ)),
+		kNone = _mm256_set1_pd(iNone),
+		kTangent = _mm256_set1_pd(iTangent),
+		kOne = _mm256_set1_pd(iOnePoint),
+		kTwo = _mm256_set1_pd(iTwoPoints),
+		k;
+
+	if (aparent)
+	{
+		k = _mm256_blendv_pd(kTwo, kTangent, tangent);
+		_mm256_storeu_pd(t1, tMin);
+		_mm256_storeu_pd(t2, tMax);
+	}
+	else
+	{
+		k = _mm256_blendv_pd(
+			_mm256_blendv_pd(_mm256_blendv_pd(kNone, kOne, inMax), _mm256_blendv_pd(kOne, kTwo, inMax), inMin),
+			_mm256_blendv_pd(kNone, kTangent, inMin), tangent);
+		_mm256_storeu_pd(t1, _mm256_blendv_pd(tMin, tMax, _mm256_andnot_pd(inMin, inMax)));
+		_mm256_storeu_pd(t2, _mm256_blendv_pd(tMax, tMin, _mm256_andnot_pd(inMax, inMin)));
+	}
+
+	int
+		aKind[4];
+
+	_mm_storeu_si128((__m128i *) aKind, _mm256_cvttpd_epi32(_mm256_blendv_pd(kNone, k, hit)));
+
+	for (int j = 0; j < 4; j++)
+		kind[j] = (unsigned char) aKind[j];
+}
+
+CIVIL_TARGET("avx2,fma") static void
+interceptCirclesAVX2(double px, double py, double dx, double dy, const double *cx, const double *cy, const double *r,
+	bool aparent, unsigned char *kind, double *t1, double *t2, size_t count)
+{
+	__m256d
+		vPx = _mm256_set1_pd(px), vPy = _mm256_set1_pd(py),
+		vDx = _mm256_set1_pd(dx), vDy = _mm256_set1_pd(dy);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+		interceptLanesAVX2(_mm256_sub_pd(vPx, _mm256_loadu_pd(cx + i)), _mm256_sub_pd(vPy, _mm256_loadu_pd(cy + i)), vDx, vDy,
+			_mm256_loadu_pd(r + i), aparent, kind + i, t1 + i, t2 + i);
+
+	interceptCirclesScalar(px, py, dx, dy, cx + i, cy + i, r + i, aparent, kind + i, t1 + i, t2 + i, count - i);
+}
+
+CIVIL_TARGET("avx2,fma") static void
+interceptVectorsAVX2(double cx, double cy, double r, const double *x1, const double *y1, const double *x2, const double *y2,
+	bool aparent, unsigned char *kind, double *t1, double *t2, size_t count)
+{
+	__m256d
+		vCx = _mm256_set1_pd(cx), vCy = _mm256_set1_pd(cy),
+		vR = _mm256_set1_pd(r);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			ax = _mm256_loadu_pd(x1 + i),
+			ay = _mm256_loadu_pd(y1 + i);
+
+		interceptLanesAVX2(_mm256_sub_pd(ax, vCx), _mm256_sub_pd(ay, vCy), _mm256_sub_pd(_mm256_loadu_pd(x2 + i), ax),
+			_mm256_sub_pd(_mm256_loadu_pd(y2 + i), ay), vR, aparent, kind + i, t1 + i, t2 + i);
+	}
+
+	interceptVectorsScalar(cx, cy, r, x1 + i, y1 + i, x2 + i, y2 + i, aparent, kind + i, t1 + i, t2 + i, count - i);
+}
+
+CIVIL_TARGET("avx2,fma") static long long
+nearestInterceptAVX2(double px, double py, double dx, double dy, const double *cx, const double *cy, const double *r,
+	size_t count, double &t)
+{
+	double
+		a = dx * dx + dy * dy;
+
+	if (a == 0)
+	{
+		t = 1;
+		return -1;
+	}
+
+	// Each lane keeps its own nearest circle; ties keep the earlier index, as in the scalar loop.
+	__m256d
+		vPx = _mm256_set1_pd(px), vPy = _mm256_set1_pd(py),
+		vDx = _mm256_set1_pd(dx), vDy = _mm256_set1_pd(dy),
+		vA = _mm256_set1_pd(a),
+		vZero = _mm256_setzero_pd(),
+		vOne = _mm256_set1_pd(1),
+		vSign = _mm256_set1_pd(-0.0),
+		vBestT = _mm256_set1_pd(INFINITY),
+		vBestI = _mm256_set1_pd(-1),
+		vIndex = _mm256_setr_pd(0, 1, 2, 3),
+		vStep = _mm256_set1_pd(4);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			fx = _mm256_sub_pd(vPx, _mm256_loadu_pd(cx + i)),
+			fy = _mm256_sub_pd(vPy, _mm256_loadu_pd(cy + i)),
+			vR = _mm256_loadu_pd(r + i),
+			b = _mm256_add_pd(_mm256_mul_pd(fx, vDx), _mm256_mul_pd(fy, vDy)),
+			c = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(fx, fx), _mm256_mul_pd(fy, fy)), _mm256_mul_pd(vR, vR)),
+			delta = _mm256_sub_pd(_mm256_mul_pd(b, b), _mm256_mul_pd(vA, c)),
+			root = _mm256_sqrt_pd(delta),
+			tEnter = _mm256_div_pd(_mm256_sub_pd(_mm256_xor_pd(b, vSign), root), vA),
+			tLeave = _mm256_div_pd(_mm256_add_pd(_mm256_xor_pd(b, vSign), root), vA),
+			hit = _mm256_and_pd(_mm256_cmp_pd(delta, vZero, _CMP_GE_OQ),
+				_mm256_and_pd(_mm256_cmp_pd(tLeave, vZero, _CMP_GE_OQ), _mm256_cmp_pd(tEnter, vOne, _CMP_LE_OQ)));
+
+		tEnter = _mm256_blendv_pd(tEnter, vZero, _mm256_cmp_pd(tEnter, vZero, _CMP_LT_OQ));
+
+		__m256d
+			better = _mm256_and_pd(hit, _mm256_cmp_pd(tEnter, vBestT, _CMP_LT_OQ));
+
+		vBestT = _mm256_blendv_pd(vBestT, tEnter, better);
+		vBestI = _mm256_blendv_pd(vBestI, vIndex, better);
+		vIndex = _mm256_add_pd(vIndex, vStep);
+	}
+
+	double
+		aBestT[4], aBestI[4];
+	long long
+		intRes = -1;
+
+	_mm256_storeu_pd(aBestT, vBestT);
+	_mm256_storeu_pd(aBestI, vBestI);
+	t = 1;
+
+	for (int j = 0; j < 4; j++)
+		if (aBestI[j] >= 0 && (intRes < 0 || aBestT[j] < t || (aBestT[j] == t && (long long) aBestI[j] < intRes)))
+		{
+			t = aBestT[j];
+			intRes = (long long) aBestI[j];
+		}
+
+	double
+		tTail;
+	long long
+		intTail = nearestInterceptScalar(px, py, dx, dy, cx + i, cy + i, r + i, count - i, tTail);
+
+	if (intTail >= 0 && (intRes < 0 || tTail < t))
+	{
+		t = tTail;
+		intRes = intTail + (long long) i;
+	}
+
+	return intRes;
+}
+
+/*
+ * AVX-512.
+ */
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+transformAVX512(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY, size_t count)
+{
+	__m512d
+		m00 = _mm512_set1_pd(mat.items[0][0]), m01 = _mm512_set1_pd(mat.items[0][1]), m02 = _mm512_set1_pd(mat.items[0][2]),
+		m10 = _mm512_set1_pd(mat.items[1][0]), m11 = _mm512_set1_pd(mat.items[1][1]), m12 = _mm512_set1_pd(mat.items[1][2]);
+	size_t
+		i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d
+			px = _mm512_loadu_pd(x + i),
+			py = _mm512_loadu_pd(y + i);
+
+		_mm512_storeu_pd(resX + i, _mm512_fmadd_pd(m00, px, _mm512_fmadd_pd(m01, py, m02)));
+		_mm512_storeu_pd(resY + i, _mm512_fmadd_pd(m10, px, _mm512_fmadd_pd(m11, py, m12)));
+	}
+
+	transformAVX2(mat, x + i, y + i, resX + i, resY + i, count - i);
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+projectiveAVX512(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY, size_t count)
+{
+	__m512d
+		m00 = _mm512_set1_pd(mat.items[0][0]), m01 = _mm512_set1_pd(mat.items[0][1]), m02 = _mm512_set1_pd(mat.items[0][2]),
+		m10 = _mm512_set1_pd(mat.items[1][0]), m11 = _mm512_set1_pd(mat.items[1][1]), m12 = _mm512_set1_pd(mat.items[1][2]),
+		m20 = _mm512_set1_pd(mat.items[2][0]), m21 = _mm512_set1_pd(mat.items[2][1]), m22 = _mm512_set1_pd(mat.items[2][2]);
+	size_t
+		i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d
+			px = _mm512_loadu_pd(x + i),
+			py = _mm512_loadu_pd(y + i),
+			w = _mm512_fmadd_pd(m20, px, _mm512_fmadd_pd(m21, py, m22));
+
+		_mm512_storeu_pd(resX + i, _mm512_div_pd(_mm512_fmadd_pd(m00, px, _mm512_fmadd_pd(m01, py, m02)), w));
+		_mm512_storeu_pd(resY + i, _mm512_div_pd(_mm512_fmadd_pd(m10, px, _mm512_fmadd_pd(m11, py, m12)), w));
+	}
+
+	projectiveAVX2(mat, x + i, y + i, resX + i, resY + i, count - i);
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+distAVX512(const double *x1, const double *y1, const double *x2, const double *y2, double *res, size_t count)
+{
+	size_t
+		i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d
+			dx = _mm512_sub_pd(_mm512_loadu_pd(x2 + i), _mm512_loadu_pd(x1 + i)),
+			dy = _mm512_sub_pd(_mm512_loadu_pd(y2 + i), _mm512_loadu_pd(y1 + i));
+
+		_mm512_storeu_pd(res + i, _mm512_sqrt_pd(_mm512_fmadd_pd(dx, dx, _mm512_mul_pd(dy, dy))));
+	}
+
+	distAVX2(x1 + i, y1 + i, x2 + i, y2 + i, res + i, count - i);
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+distRefAVX512(const double *x, const double *y, double xRef, double yRef, double *res, size_t count)
+{
+	__m512d
+		rx = _mm512_set1_pd(xRef),
+		ry = _mm512_set1_pd(yRef);
+	size_t
+		i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d
+			dx = _mm512_sub_pd(_mm512_loadu_pd(x + i), rx),
+			dy = _mm512_sub_pd(_mm512_loadu_pd(y + i), ry);
+
+		_mm512_storeu_pd(res + i, _mm512_sqrt_pd(_mm512_fmadd_pd(dx, dx, _mm512_mul_pd(dy, dy))));
+	}
+
+	distRefAVX2(x + i, y + i, xRef, yRef, res + i, count - i);
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+rectangleTestAVX512(const double *left, const double *bottom, const double *right, const double *top, size_t count,
+	const double lo[4], const double hi[4], uint64_t *mask)
+{
+	__m512d
+		lo0 = _mm512_set1_pd(lo[0]), lo1 = _mm512_set1_pd(lo[1]), lo2 = _mm512_set1_pd(lo[2]), lo3 = _mm512_set1_pd(lo[3]),
+		hi0 = _mm512_set1_pd(hi[0]), hi1 = _mm512_set1_pd(hi[1]), hi2 = _mm512_set1_pd(hi[2]), hi3 = _mm512_set1_pd(hi[3]);
+	size_t
+		i = 0;
+
+	for (; i + 64 <= count; i += 64)
+	{
+		uint64_t
+			bits = 0;
+
+		for (size_t j = i; j < i + 64; j += 8)
+		{
+			__m512d
+				vLeft = _mm512_loadu_pd(left + j), vBottom = _mm512_loadu_pd(bottom + j),
+				vRight = _mm512_loadu_pd(right + j), vTop = _mm512_loadu_pd(top + j);
+			__mmask8
+				in = _mm512_cmp_pd_mask(vLeft, lo0, _CMP_GE_OQ);
+
+			in = _mm512_mask_cmp_pd_mask(in, vLeft, hi0, _CMP_LE_OQ);
+			in = _mm512_mask_cmp_pd_mask(in, vBottom, lo1, _CMP_GE_OQ);
+			in = _mm512_mask_cmp_pd_mask(in, vBottom, hi1, _CMP_LE_OQ);
+			in = _mm512_mask_cmp_pd_mask(in, vRight, lo2, _CMP_GE_OQ);
+			in = _mm512_mask_cmp_pd_mask(in, vRight, hi2, _CMP_LE_OQ);
+			in = _mm512_mask_cmp_pd_mask(in, vTop, lo3, _CMP_GE_OQ);
+			in = _mm512_mask_cmp_pd_mask(in, vTop, hi3, _CMP_LE_OQ);
+			bits |= (uint64_t) in << (j - i);
+		}
+
+		mask[i / 64] = bits;
+	}
+
+	rectangleTestScalar(left + i, bottom + i, right + i, top + i, count - i, lo, hi, mask + i / 64);
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+boundsAVX512(const double *x1, const double *y1, const double *x2, const double *y2, const double *r, size_t count,
+	double bounds[4])
+{
+	__m512d
+		vLeft = _mm512_set1_pd(bounds[0]), vBottom = _mm512_set1_pd(bounds[1]),
+		vRight = _mm512_set1_pd(bounds[2]), vTop = _mm512_set1_pd(bounds[3]);
+	size_t
+		i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d
+			vR = r ? _mm512_loadu_pd(r + i) : _mm512_setzero_pd(),
+			vL = _mm512_sub_pd(_mm512_loadu_pd(x1 + i), vR),
+			vB = _mm512_sub_pd(_mm512_loadu_pd(y1 + i), vR),
+			vRt = _mm512_add_pd(_mm512_loadu_pd(x2 + i), vR),
+			vT = _mm512_add_pd(_mm512_loadu_pd(y2 + i), vR);
+		__mmask8
+			valid = _mm512_cmp_pd_mask(vL, vB, _CMP_ORD_Q) & _mm512_cmp_pd_mask(vRt, vT, _CMP_ORD_Q);
+
+		vLeft = _mm512_mask_min_pd(vLeft, valid, vL, vLeft);
+		vBottom = _mm512_mask_min_pd(vBottom, valid, vB, vBottom);
+		vRight = _mm512_mask_max_pd(vRight, valid, vRt, vRight);
+		vTop = _mm512_mask_max_pd(vTop, valid, vT, vTop);
+	}
+
+	double
+		aLeft[8], aBottom[8], aRight[8], aTop[8];
+
+	_mm512_storeu_pd(aLeft, vLeft);
+	_mm512_storeu_pd(aBottom, vBottom);
+	_mm512_storeu_pd(aRight, vRight);
+	_mm512_storeu_pd(aTop, vTop);
+	boundsScalar(aLeft, aBottom, aRight, aTop, nullptr, 8, bounds);
+	boundsAVX2(x1 + i, y1 + i, x2 + i, y2 + i, r ? r + i : nullptr, count - i, bounds);
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+clipAVX512(const Rectangle2D &window, const double *x1, const double *y1, const double *x2, const double *y2,
+	double *resX1, double *resY1, double *resX2, double *resY2, unsigned char *visible, size_t count)
+{
+	__m512d
+		wl = _mm512_set1_pd(window.left), wb = _mm512_set1_pd(window.bottom),
+		wr = _mm512_set1_pd(window.right), wt = _mm512_set1_pd(window.top),
+		vZero = _mm512_setzero_pd(),
+		vOne = _mm512_set1_pd(1);
+	size_t
+		i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d
+			ax = _mm512_loadu_pd(x1 + i), ay = _mm512_loadu_pd(y1 + i),
+			bx = _mm512_loadu_pd(x2 + i), by = _mm512_loadu_pd(y2 + i),
+			dx = _mm512_sub_pd(bx, ax),
+			dy = _mm512_sub_pd(by, ay),
+			p[4] = { _mm512_sub_pd(vZero, dx), dx, _mm512_sub_pd(vZero, dy), dy },
+			q[4] = { _mm512_sub_pd(ax, wl), _mm512_sub_pd(wr, ax), _mm512_sub_pd(ay, wb), _mm512_sub_pd(wt, ay) },
+			t0 = vZero,
+			t1 = vOne;
+		__mmask8
+			out = 0;
+
+		for (int k = 0; k < 4; k++)
+		{
+			__m512d
+				r = _mm512_div_pd(q[k], p[k]);
+
+			t0 = _mm512_mask_max_pd(t0, _mm512_cmp_pd_mask(p[k], vZero, _CMP_LT_OQ), r, t0);
+			t1 = _mm512_mask_min_pd(t1, _mm512_cmp_pd_mask(p[k], vZero, _CMP_GT_OQ), r, t1);
+			out |= _mm512_cmp_pd_mask(p[k], vZero, _CMP_NLT_UQ) & _mm512_cmp_pd_mask(p[k], vZero, _CMP_NGT_UQ) &
+				_mm512_cmp_pd_mask(q[k], vZero, _CMP_NGE_UQ);
+		}
+
+		__mmask8
+			in = _mm512_cmp_pd_mask(t0, t1, _CMP_LE_OQ) & (__mmask8) ~out,
+			end = _mm512_cmp_pd_mask(t1, vOne, _CMP_EQ_OQ);
+		__m512d
+			cx1 = _mm512_min_pd(_mm512_max_pd(_mm512_fmadd_pd(t0, dx, ax), wl), wr),
+			cy1 = _mm512_min_pd(_mm512_max_pd(_mm512_fmadd_pd(t0, dy, ay), wb), wt),
+			cx2 = _mm512_min_pd(_mm512_max_pd(_mm512_mask_blend_pd(end, _mm512_fmadd_pd(t1, dx, ax), bx), wl), wr),
+			cy2 = _mm512_min_pd(_mm512_max_pd(_mm512_mask_blend_pd(end, _mm512_fmadd_pd(t1, dy, ay), by), wb), wt);
+
+		_mm512_storeu_pd(resX1 + i, _mm512_mask_blend_pd(in, ax, cx1));
+		_mm512_storeu_pd(resY1 + i, _mm512_mask_blend_pd(in, ay, cy1));
+		_mm512_storeu_pd(resX2 + i, _mm512_mask_blend_pd(in, bx, cx2));
+		_mm512_storeu_pd(resY2 + i, _mm512_mask_blend_pd(in, by, cy2));
+
+		for (int k = 0; k < 8; k++)
+			visible[i + k] = (unsigned char) ((in >> k) & 1);
+	}
+
+	clipAVX2(window, x1 + i, y1 + i, x2 + i, y2 + i, resX1 + i, resY1 + i, resX2 + i, resY2 + i, visible + i, count - i);
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static inline void
+interceptLanesAVX512(__m512d fx, __m512d fy, __m512d dx, __m512d dy, __m512d r, bool aparent, unsigned char *kind,
+	double *t1, double *t2)
+{
+	__m512d
+		vZero = _mm512_setzero_pd(),
+		vOne = _mm512_set1_pd(1),
+		a = _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)),
+		b = _mm512_add_pd(_mm512_mul_pd(fx, dx), _mm512_mul_pd(fy, dy)),
+		c = _mm512_sub_pd(_mm512_add_pd(_mm512_mul_pd(fx, fx), _mm512_mul_pd(fy, fy)), _mm512_mul_pd(r, r)),
+		delta = _mm512_sub_pd(_mm512_mul_pd(b, b), _mm512_mul_pd(a, c)),
+		root = _mm512_sqrt_pd(_mm512_max_pd(delta, vZero)),
+		q = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(b, vZero, _CMP_LT_OQ), _mm512_add_pd(b, root), _mm512_sub_pd(b, root)),
+		ta, tb, tMin, tMax;
+
+	// Negated through the sign bit, as -x in interceptItem (0 - x would turn -0 into +0).
+	q = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(q), _mm512_set1_epi64(INT64_MIN)));
+	ta = _mm512_div_pd(q, a);
+	tb = _mm512_mask_div_pd(ta, _mm512_cmp_pd_mask(q, vZero, _CMP_NEQ_UQ), c, q);
+
+	__mmask8
+		lt = _mm512_cmp_pd_mask(ta, tb, _CMP_LT_OQ);
+
+	tMin = _mm512_mask_blend_pd(lt, tb, ta);
+	tMax = _mm512_mask_blend_pd(lt, ta, tb);
+
+	__mmask8
+		inMin = _mm512_cmp_pd_mask(tMin, vZero, _CMP_GE_OQ) & _mm512_cmp_pd_mask(tMin, vOne, _CMP_LE_OQ),
+		inMax = _mm512_cmp_pd_mask(tMax, vZero, _CMP_GE_OQ) & _mm512_cmp_pd_mask(tMax, vOne, _CMP_LE_OQ),
+		tangent = _mm512_cmp_pd_mask(delta, vZero, _CMP_EQ_OQ),
+		hit = _mm512_cmp_pd_mask(a, vZero, _CMP_NEQ_UQ) & _mm512_cmp_pd_mask(delta, vZero, _CMP_GE_OQ);
+
+	__m512d
+		kNone = _mm512_set1_pd(iNone),
+		kTangent = _mm512_set1_pd(iTangent),
+		kOne = _mm512_set1_pd(iOnePoint),
+		kTwo = _mm512_set1_pd(iTwoPoints),
+		k;
+
+	if (aparent)
+	{
+		k = _mm512_mask_blend_pd(tangent, kTwo, kTangent);
+		_mm512_storeu_pd(t1, tMin);
+		_mm512_storeu_pd(t2, tMax);
+	}
+	else
+	{
+		k = _mm512_mask_blend_pd(tangent,
+			_mm512_mask_blend_pd(inMin, _mm512_mask_blend_pd(inMax, kNone, kOne), _mm512_mask_blend_pd(inMax, kOne, kTwo)),
+			_mm512_mask_blend_pd(inMin, kNone, kTangent));
+		_mm512_storeu_pd(t1, _mm512_mask_blend_pd((__mmask8) (~inMin & inMax), tMin, tMax));
+		_mm512_storeu_pd(t2, _mm512_mask_blend_pd((__mmask8) (inMin & ~inMax), tMax, tMin));
+	}
+
+	int
+		aKind[8];
+
+	_mm256_storeu_si256((__m256i *) aKind, _mm512_cvttpd_epi32(_mm512_mask_blend_pd(hit, kNone, k)));
+
+	for (int j = 0; j < 8; j++)
+		kind[j] = (unsigned char) aKind[j];
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+interceptCirclesAVX512(double px, double py, double dx, double dy, const double *cx, const double *cy, const double *r,
+	bool aparent, unsigned char *kind, double *t1, double *t2, size_t count)
+{
+	__m512d
+		vPx = _mm512_set1_pd(px), vPy = _mm512_set1_pd(py),
+		vDx = _mm512_set1_pd(dx), vDy = _mm512_set1_pd(dy);
+	size_t
+		i = 0;
+
+	for (; i + 8 <= count; i += 8)
+		interceptLanesAVX512(_mm512_sub_pd(vPx, _mm512_loadu_pd(cx + i)), _mm512_sub_pd(vPy, _mm512_loadu_pd(cy + i)), vDx, vDy,
+			_mm512_loadu_pd(r + i), aparent, kind + i, t1 + i, t2 + i);
+
+	interceptCirclesAVX2(px, py, dx, dy, cx + i, cy + i, r + i, aparent, kind + i, t1 + i, t2 + i, count - i);
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+interceptVectorsAVX512(double cx, double cy, double r, const double *x1, const double *y1, const double *x2, const double *y2,
+	bool aparent, unsigned char *kind, double *t1, double *t2, size_t count)
+{
+	__m512d
+		vCx = _mm512_set1_pd(cx), vCy = _mm512_set1_pd(cy),
+		vR = _mm512_set1_pd(r);
+	size_t
+		i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d
+			ax = _mm512_loadu_pd(x1 + i),
+			ay = _mm512_loadu_pd(y1 + i);
+
+		interceptLanesAVX512(_mm512_sub_pd(ax, vCx), _mm512_sub_pd(ay, vCy), _mm512_sub_pd(_mm512_loadu_pd(x2 + i), ax),
+			_mm512_sub_pd(_mm512_loadu_pd(y2 + i), ay), vR, aparent, kind + i, t1 + i, t2 + i);
+	}
+
+	interceptVectorsAVX2(cx, cy, r, x1 + i, y1 + i, x2 + i, y2 + i, aparent, kind + i, t1 + i, t2 + i, count - i);
+}
+
+Dispatch<TransformKernel>
+	transformKernel(transformScalar, transformSSE2, transformAVX2, transformAVX512);
+Dispatch<ProjectiveKernel>
+	projectiveKernel(projectiveScalar, projectiveSSE2, projectiveAVX2, projectiveAVX512);
+Dispatch<DistKernel>
+	distKernel(distScalar, distSSE2, distAVX2, distAVX512);
+Dispatch<DistRefKernel>
+	distRefKernel(distRefScalar, distRefSSE2, distRefAVX2, distRefAVX512);
+Dispatch<RectangleTestKernel>
+	rectangleTestKernel(rectangleTestScalar, rectangleTestSSE2, rectangleTestAVX2, rectangleTestAVX512);
+Dispatch<BoundsKernel>
+	boundsKernel(boundsScalar, boundsSSE2, boundsAVX2, boundsAVX512);
+// No SSE2 clipKernel; the selects need SSE4.1, the scalar variant covers that level.
+Dispatch<ClipKernel>
+	clipKernel(clipScalar, nullptr, clipAVX2, clipAVX512);
+// The intercept kernels need blends as well; the AVX-512 nearest search stays on the AVX2 variant.
+Dispatch<InterceptCirclesKernel>
+	interceptCirclesKernel(interceptCirclesScalar, nullptr, interceptCirclesAVX2, interceptCirclesAVX512);
+Dispatch<InterceptVectorsKernel>
+	interceptVectorsKernel(interceptVectorsScalar, nullptr, interceptVectorsAVX2, interceptVectorsAVX512);
+Dispatch<NearestInterceptKernel>
+	nearestInterceptKernel(nearestInterceptScalar, nullptr, nearestInterceptAVX2);
+
+#else
+
+Dispatch<TransformKernel>
+	transformKernel(transformScalar);
+Dispatch<ProjectiveKernel>
+	projectiveKernel(projectiveScalar);
+Dispatch<DistKernel>
+	distKernel(distScalar);
+Dispatch<DistRefKernel>
+	distRefKernel(distRefScalar);
+Dispatch<RectangleTestKernel>
+	rectangleTestKernel(rectangleTestScalar);
+Dispatch<BoundsKernel>
+	boundsKernel(boundsScalar);
+Dispatch<ClipKernel>
+	clipKernel(clipScalar);
+Dispatch<InterceptCirclesKernel>
+	interceptCirclesKernel(interceptCirclesScalar);
+Dispatch<InterceptVectorsKernel>
+	interceptVectorsKernel(interceptVectorsScalar);
+Dispatch<NearestInterceptKernel>
+	nearestInterceptKernel(nearestInterceptScalar);
+
+#endif // if CIVIL_X86
+
+} // namespace CIVIL::MATH::GA2D
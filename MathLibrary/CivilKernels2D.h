@@ -0,0 +1,103 @@
+/***
+ * CivilKernels2D.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_KERNELS_2D
+#define __CIVIL_KERNELS_2D
+
+#include <stdint.h>
+
+#include "..\UtilsLibrary\CivilDispatch.h"
+#include "..\MathLibrary\CivilGA2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// Column kernels behind the batch functions of CivilBatch2D.h, one variant per instruction set level
+	// bound at run time (see CivilDispatch.h). They take raw columns so that any structure-of-arrays
+	// container can use them; the results may overwrite the inputs.
+
+	// transformKernel; (resX[i], resY[i]) = mat * (x[i], y[i]).
+	typedef void (*TransformKernel)(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY,
+		size_t count);
+	// projectiveKernel; (resX[i], resY[i]) = (u / w, v / w) with (u, v, w) = mat * (x[i], y[i], 1).
+	typedef void (*ProjectiveKernel)(const Matrix2D &mat, const double *x, const double *y, double *resX, double *resY,
+		size_t count);
+	// distKernel; res[i] = distance from (x1[i], y1[i]) to (x2[i], y2[i]).
+	typedef void (*DistKernel)(const double *x1, const double *y1, const double *x2, const double *y2, double *res,
+		size_t count);
+	// distRefKernel; res[i] = distance from (x[i], y[i]) to (xRef, yRef).
+	typedef void (*DistRefKernel)(const double *x, const double *y, double xRef, double yRef, double *res, size_t count);
+
+	// rectangleTestKernel; bit i % 64 of mask[i / 64] = left[i] in [lo[0], hi[0]], bottom[i] in [lo[1], hi[1]],
+	// right[i] in [lo[2], hi[2]] and top[i] in [lo[3], hi[3]]; the bits past "count" in the last word are 0.
+	// Overlap and containment tests against a rectangle are both such intervals, with infinite ends.
+	typedef void (*RectangleTestKernel)(const double *left, const double *bottom, const double *right, const double *top,
+		size_t count, const double lo[4], const double hi[4], uint64_t *mask);
+	// boundsKernel; widens bounds (left, bottom, right, top) to x1[i] - r[i], y1[i] - r[i], x2[i] + r[i] and
+	// y2[i] + r[i]; "r" may be null for none. Items with any of those NaN leave the bounds as they are.
+	typedef void (*BoundsKernel)(const double *x1, const double *y1, const double *x2, const double *y2, const double *r,
+		size_t count, double bounds[4]);
+	// clipKernel; Liang-Barsky: (resX1[i], resY1[i]) -> (resX2[i], resY2[i]) = the part of (x1[i], y1[i]) ->
+	// (x2[i], y2[i]) inside the closed window and visible[i] = 1, or the vector as given and visible[i] = 0.
+	typedef void (*ClipKernel)(const Rectangle2D &window, const double *x1, const double *y1, const double *x2,
+		const double *y2, double *resX1, double *resY1, double *resX2, double *resY2, unsigned char *visible, size_t count);
+	// interceptCirclesKernel; kind[i], t1[i] and t2[i] = intersection of the vector (px, py) + t * (dx, dy) with
+	// the circle (cx[i], cy[i]) of radius r[i], as Circle2D::intercept (see InterceptBuffer, CivilBatch2D.h).
+	typedef void (*InterceptCirclesKernel)(double px, double py, double dx, double dy, const double *cx, const double *cy,
+		const double *r, bool aparent, unsigned char *kind, double *t1, double *t2, size_t count);
+	// interceptVectorsKernel; the same for the vectors (x1[i], y1[i]) -> (x2[i], y2[i]) against one circle.
+	typedef void (*InterceptVectorsKernel)(double cx, double cy, double r, const double *x1, const double *y1,
+		const double *x2, const double *y2, bool aparent, unsigned char *kind, double *t1, double *t2, size_t count);
+	// nearestInterceptKernel; index of the circle the vector enters first, lowest index on ties, and in "t"
+	// the parameter where it does (0 when (px, py) is inside); -1 and t = 1 when none is hit.
+	typedef long long (*NearestInterceptKernel)(double px, double py, double dx, double dy, const double *cx,
+		const double *cy, const double *r, size_t count, double &t);
+
+	extern Dispatch<TransformKernel>
+		transformKernel;
+	extern Dispatch<ProjectiveKernel>
+		projectiveKernel;
+	extern Dispatch<DistKernel>
+		distKernel;
+	extern Dispatch<DistRefKernel>
+		distRefKernel;
+	extern Dispatch<RectangleTestKernel>
+		rectangleTestKernel;
+	extern Dispatch<BoundsKernel>
+		boundsKernel;
+	extern Dispatch<ClipKernel>
+		clipKernel;
+	extern Dispatch<InterceptCirclesKernel>
+		interceptCirclesKernel;
+	extern Dispatch<InterceptVectorsKernel>
+		interceptVectorsKernel;
+	extern Dispatch<NearestInterceptKernel>
+		nearestInterceptKernel;
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_KERNELS_2D
@@ -1,5 +1,9 @@
 #include "CivilMatrix.h"
 
+#if CIVIL_X86
+#include <immintrin.h>
+#endif // if CIVIL_X86
+
 namespace CIVIL
 {
 
@@ -14,7 +18,133 @@ namespace GA2D
  * ----------------------------------------------------------------------------------------------------------------------------------------------------
  */
 
-template <typename _type, int _rows, int _cols> void
+// Every variant clears a row of the result and then adds mat1[i][k] times row k of mat2 to it, so the
+// innermost loop runs along contiguous rows of mat2 and res.
+
+static void
+multiplyScalar(const double *const *mat1, const double *const *mat2, double *const *res, int rows, int inner, int cols)
+{
+	for (int i = 0; i < rows; i++)
+	{
+		double
+			*r = res[i];
+
+		for (int j = 0; j < cols; j++)
+			r[j] = 0;
+
+		for (int k = 0; k < inner; k++)
+		{
+			double
+				a = mat1[i][k];
+			const double
+				*b = mat2[k];
+
+			for (int j = 0; j < cols; j++)
+				r[j] += a * b[j];
+		}
+	}
+}
+
+#if CIVIL_X86
+
+CIVIL_TARGET("sse2") static void
+multiplySSE2(const double *const *mat1, const double *const *mat2, double *const *res, int rows, int inner, int cols)
+{
+	for (int i = 0; i < rows; i++)
+	{
+		double
+			*r = res[i];
+
+		for (int j = 0; j < cols; j++)
+			r[j] = 0;
+
+		for (int k = 0; k < inner; k++)
+		{
+			__m128d
+				a = _mm_set1_pd(mat1[i][k]);
+			const double
+				*b = mat2[k];
+			int
+				j = 0;
+
+			for (; j + 2 <= cols; j += 2)
+				_mm_storeu_pd(r + j, _mm_add_pd(_mm_loadu_pd(r + j), _mm_mul_pd(a, _mm_loadu_pd(b + j))));
+
+			for (; j < cols; j++)
+				r[j] += mat1[i][k] * b[j];
+		}
+	}
+}
+
+CIVIL_TARGET("avx2,fma") static void
+multiplyAVX2(const double *const *mat1, const double *const *mat2, double *const *res, int rows, int inner, int cols)
+{
+	for (int i = 0; i < rows; i++)
+	{
+		double
+			*r = res[i];
+
+		for (int j = 0; j < cols; j++)
+			r[j] = 0;
+
+		for (int k = 0; k < inner; k++)
+		{
+			__m256d
+				a = _mm256_set1_pd(mat1[i][k]);
+			const double
+				*b = mat2[k];
+			int
+				j = 0;
+
+			for (; j + 4 <= cols; j += 4)
+				_mm256_storeu_pd(r + j, _mm256_fmadd_pd(a, _mm256_loadu_pd(b + j), _mm256_loadu_pd(r + j)));
+
+			for (; j < cols; j++)
+				r[j] += mat1[i][k] * b[j];
+		}
+	}
+}
+
+CIVIL_TARGET("avx512f,avx2,fma") static void
+multiplyAVX512(const double *const *mat1, const double *const *mat2, double *const *res, int rows, int inner, int cols)
+{
+	for (int i = 0; i < rows; i++)
+	{
+		double
+			*r = res[i];
+
+		for (int j = 0; j < cols; j++)
+			r[j] = 0;
+
+		for (int k = 0; k < inner; k++)
+		{
+			__m512d
+				a = _mm512_set1_pd(mat1[i][k]);
+			const double
+				*b = mat2[k];
+
+			// The tail is handled by a masked load/store instead of a scalar loop.
+			for (int j = 0; j < cols; j += 8)
+			{
+				__mmask8
+					mask = cols - j >= 8 ? 0xFF : (__mmask8) ((1u << (cols - j)) - 1);
+
+				_mm512_mask_storeu_pd(r + j, mask,
+					_mm512_fmadd_pd(a, _mm512_maskz_loadu_pd(mask, b + j), _mm512_maskz_loadu_pd(mask, r + j)));
+			}
+		}
+	}
+}
+
+Dispatch<MultiplyKernel>
+	multiplyKernel(multiplyScalar, multiplySSE2, multiplyAVX2, multiplyAVX512);
+
+#else
+
+Dispatch<MultiplyKernel>
+	multiplyKernel(multiplyScalar);
+
+#endif // if CIVIL_X86
 
 } // namespace GA2D
 
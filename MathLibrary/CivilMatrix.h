@@ -29,9 +29,14 @@
 #pragma unmanaged
 #endif // ifdef _MANAGED
 
+#include <math.h>
+#include <type_traits>
+
 #include "..\UtilsLibrary\CivilError.h"
 #include "..\UtilsLibrary\CivilRange.h"
 #include "..\UtilsLibrary\CivilDynArray.h"
+#include "..\UtilsLibrary\CivilDispatch.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
 
 using namespace CIVIL::UTILS;
 
@@ -55,6 +60,18 @@ namespace CIVIL::MATH::GA2D
 		DECLARE_ERROR(meIncompatible, "Matrices incompatible for operation")
 	END_DECLARE_ERROR;
 
+	// multiplyKernel;
+	//
+	// res = mat1 * mat2 for double matrices given by their row pointers, mat1 being rows x inner and mat2
+	// ---- inner x cols. res must not share rows with the operands. Dispatched on the instruction set (see
+	//      CivilDispatch.h); Matrix<double>::operator* goes through it, splitting big products by rows over
+	//      the shared pool.
+	typedef void (*MultiplyKernel)(const double *const *mat1, const double *const *mat2, double *const *res, int rows,
+		int inner, int cols);
+
+	extern Dispatch<MultiplyKernel>
+		multiplyKernel;
+
 	template<typename _type = double>
 	struct Matrix
 	{
@@ -259,8 +276,8 @@ namespace CIVIL::MATH::GA2D
 			Matrix
 				res(mat1.getRowCount(), mat1.getColCount());
 
-			for (int i = 0; i < getRowCount(); i++)
-				for (int j = 0; j < getColCount(); j++)
+			for (int i = 0; i < res.getRowCount(); i++)
+				for (int j = 0; j < res.getColCount(); j++)
 					res.setItem(i, j, mat1.getItem(i, j) + mat2.getItem(i, j));
 
 			return res;
@@ -337,9 +354,31 @@ namespace CIVIL::MATH::GA2D
 
 		friend Matrix operator*(const Matrix &mat1, const Matrix &mat2)
 		{
+			if (mat1.getColCount() != mat2.getRowCount())
+				RAISE(EMatrix, meIncompatible);
+
 			Matrix
 				res(mat1.getRowCount(), mat2.getColCount());
 
+			if constexpr (std::is_same<_type, double>::value)
+			{
+				const double
+					*const *rows1 = mat1.m_aItems.getRows(),
+					*const *rows2 = mat2.m_aItems.getRows();
+				double
+					*const *rowsRes = res.m_aItems.getRows();
+				int
+					intInner = mat1.getColCount(),
+					intCols = res.getColCount();
+
+				// About 16k multiply-adds per task.
+				parallelFor(0, res.getRowCount(), 1 + (1 << 14) / (intInner * intCols), [&](size_t first, size_t last) {
+					multiplyKernel(rows1 + first, rows2, rowsRes + first, (int) (last - first), intInner, intCols);
+				});
+
+				return res;
+			}
+
 			for (int i = 0; i < res.getRowCount(); i++)
 				for (int j = 0; j < res.getColCount(); j++)
 				{
@@ -389,10 +428,10 @@ namespace CIVIL::MATH::GA2D
 		friend Matrix operator/(const Matrix &mat, _type value)
 		{
 			Matrix
-				res(getRowCount(), getColCount());
+				res(mat.getRowCount(), mat.getColCount());
 
-			for (int i = 0; i < getRowCont(); i++)
-				for (int j = 0; j < getColCount(); j++)
+			for (int i = 0; i < res.getRowCount(); i++)
+				for (int j = 0; j < res.getColCount(); j++)
 					res.setItem(i, j, mat.getItem(i, j) / value);
 
 			return res;
@@ -0,0 +1,352 @@
+#include "CivilPolygon2D.h"
+#include "CivilBatch2D.h"
+
+#include <algorithm>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+#if CIVIL_X86
+#include <immintrin.h>
+#endif // if CIVIL_X86
+
+namespace CIVIL::MATH::GA2D
+{
+
+/*
+ * Section kernel.
+ */
+
+static inline void
+accumulateEdge(double xa, double ya, double xb, double yb, double sums[6])
+{
+	double
+		c = xa * yb - xb * ya;
+
+	sums[0] += c;
+	sums[1] += (xa + xb) * c;
+	sums[2] += (ya + yb) * c;
+	sums[3] += (xa * xa + xa * xb + xb * xb) * c;
+	sums[4] += (ya * ya + ya * yb + yb * yb) * c;
+	sums[5] += (xa * yb + 2 * xa * ya + 2 * xb * yb + xb * ya) * c;
+}
+
+static void
+sectionScalar(const double *x, const double *y, size_t count, double x0, double y0, double sums[6])
+{
+	for (size_t i = 0; i + 1 < count; i++)
+		accumulateEdge(x[i] - x0, y[i] - y0, x[i + 1] - x0, y[i + 1] - y0, sums);
+}
+
+#if CIVIL_X86
+
+// Four edges per step: the start points come from x[i..i+3], the end points from x[i+1..i+4].
+CIVIL_TARGET("avx2,fma") static void
+sectionAVX2(const double *x, const double *y, size_t count, double x0, double y0, double sums[6])
+{
+	__m256d
+		ox = _mm256_set1_pd(x0),
+		oy = _mm256_set1_pd(y0),
+		two = _mm256_set1_pd(2),
+		acc[6];
+	size_t
+		i = 0;
+
+	for (int k = 0; k < 6; k++)
+		acc[k] = _mm256_setzero_pd();
+
+	for (; i + 5 <= count; i += 4)
+	{
+		__m256d
+			xa = _mm256_sub_pd(_mm256_loadu_pd(x + i), ox),
+			ya = _mm256_sub_pd(_mm256_loadu_pd(y + i), oy),
+			xb = _mm256_sub_pd(_mm256_loadu_pd(x + i + 1), ox),
+			yb = _mm256_sub_pd(_mm256_loadu_pd(y + i + 1), oy),
+			c = _mm256_fmsub_pd(xa, yb, _mm256_mul_pd(xb, ya)),
+			xx = _mm256_fmadd_pd(xa, xa, _mm256_fmadd_pd(xa, xb, _mm256_mul_pd(xb, xb))),
+			yy = _mm256_fmadd_pd(ya, ya, _mm256_fmadd_pd(ya, yb, _mm256_mul_pd(yb, yb))),
+			xy = _mm256_fmadd_pd(two, _mm256_fmadd_pd(xa, ya, _mm256_mul_pd(xb, yb)),
+				_mm256_fmadd_pd(xa, yb, _mm256_mul_pd(xb, ya)));
+
+		acc[0] = _mm256_add_pd(acc[0], c);
+		acc[1] = _mm256_fmadd_pd(_mm256_add_pd(xa, xb), c, acc[1]);
+		acc[2] = _mm256_fmadd_pd(_mm256_add_pd(ya, yb), c, acc[2]);
+		acc[3] = _mm256_fmadd_pd(xx, c, acc[3]);
+		acc[4] = _mm256_fmadd_pd(yy, c, acc[4]);
+		acc[5] = _mm256_fmadd_pd(xy, c, acc[5]);
+	}
+
+	for (int k = 0; k < 6; k++)
+	{
+		double
+			lanes[4];
+
+		_mm256_storeu_pd(lanes, acc[k]);
+		sums[k] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	}
+
+	sectionScalar(x + i, y + i, count - i, x0, y0, sums);
+}
+
+Dispatch<SectionKernel>
+	sectionKernel(sectionScalar, nullptr, sectionAVX2);
+
+#else
+
+Dispatch<SectionKernel>
+	sectionKernel(sectionScalar);
+
+#endif // if CIVIL_X86
+
+/*
+ * SectionProperties.
+ */
+
+void
+SectionProperties::inertiaAt(const Point2D &ref, double &refIx, double &refIy, double &refIxy) const
+{
+	double
+		dx = centroid.x - ref.x,
+		dy = centroid.y - ref.y;
+
+	refIx = ix + area * dy * dy;
+	refIy = iy + area * dx * dx;
+	refIxy = ixy + area * dx * dy;
+}
+
+void
+SectionProperties::principalAxes(double &i1, double &i2, Angle &ang) const
+{
+	double
+		dblMean = (ix + iy) / 2,
+		dblHalf = (ix - iy) / 2,
+		dblRadius = sqrt(dblHalf * dblHalf + ixy * ixy);
+
+	i1 = dblMean + dblRadius;
+	i2 = dblMean - dblRadius;
+
+	// The moment about an axis at angle t is mean + half * cos(2t) - ixy * sin(2t); its maximum is at
+	// 2t = atan2(-ixy, half).
+	ang = Angle(atan2(-ixy, dblHalf) / 2);
+}
+
+SectionProperties
+SectionProperties::weighted(double factor) const
+{
+	SectionProperties
+		res = *this;
+
+	res.area *= factor;
+	res.ix *= factor;
+	res.iy *= factor;
+	res.ixy *= factor;
+
+	return res;
+}
+
+SectionProperties
+operator+(const SectionProperties &sec1, const SectionProperties &sec2)
+{
+	SectionProperties
+		res;
+
+	res.area = sec1.area + sec2.area;
+	res.centroid = res.area != 0 ?
+		Point2D((sec1.area * sec1.centroid.x + sec2.area * sec2.centroid.x) / res.area,
+			(sec1.area * sec1.centroid.y + sec2.area * sec2.centroid.y) / res.area) :
+		sec1.centroid;
+
+	double
+		ix1, iy1, ixy1,
+		ix2, iy2, ixy2;
+
+	sec1.inertiaAt(res.centroid, ix1, iy1, ixy1);
+	sec2.inertiaAt(res.centroid, ix2, iy2, ixy2);
+
+	res.ix = ix1 + ix2;
+	res.iy = iy1 + iy2;
+	res.ixy = ixy1 + ixy2;
+
+	return res;
+}
+
+/*
+ * Polygon2D.
+ */
+
+static double
+signedArea(const double *x, const double *y, size_t count)
+{
+	double
+		dblSum = 0;
+
+	// Relative to the first point, which keeps the products small for survey coordinates.
+	for (size_t i = 1; i + 1 < count; i++)
+		dblSum += (x[i] - x[0]) * (y[i + 1] - y[0]) - (x[i + 1] - x[0]) * (y[i] - y[0]);
+
+	return dblSum / 2;
+}
+
+void
+Polygon2D::addRing(const std::vector<Point2D> &pnts, bool hole)
+{
+	size_t
+		n = pnts.size();
+
+	if (n < 3)
+		RAISE(EPolygon2D, peInvalidRing);
+
+	double
+		dblArea = 0;
+
+	for (size_t i = 1; i + 1 < n; i++)
+		dblArea += (pnts[i] - pnts[0]).vectorProduct(pnts[i + 1] - pnts[0]);
+
+	rings.push_back(vertices.size());
+	vertices.reserve(vertices.size() + n);
+
+	if ((dblArea < 0) != hole)
+		for (size_t i = n; i > 0; i--)
+			vertices.add(pnts[i - 1]);
+	else
+		for (const Point2D &pnt : pnts)
+			vertices.add(pnt);
+}
+
+double
+Polygon2D::ringArea(size_t ring) const
+{
+	size_t
+		b = ringBegin(ring);
+
+	return signedArea(vertices.x.data() + b, vertices.y.data() + b, ringEnd(ring) - b);
+}
+
+double
+Polygon2D::area() const
+{
+	double
+		dblArea = 0;
+
+	for (size_t r = 0; r < rings.size(); r++)
+		dblArea += ringArea(r);
+
+	return dblArea;
+}
+
+double
+Polygon2D::perimeter() const
+{
+	double
+		dblPerimeter = 0;
+
+	for (size_t r = 0; r < rings.size(); r++)
+	{
+		size_t
+			b = ringBegin(r),
+			e = ringEnd(r);
+
+		for (size_t i = b; i < e; i++)
+		{
+			size_t
+				j = i + 1 < e ? i + 1 : b;
+
+			dblPerimeter += Point2D::dist(vertices.x[i], vertices.y[i], vertices.x[j], vertices.y[j]);
+		}
+	}
+
+	return dblPerimeter;
+}
+
+Rectangle2D
+Polygon2D::boundsRect() const
+{
+	if (vertices.size() == 0)
+		return Rectangle2D();
+
+	auto
+		x = std::minmax_element(vertices.x.begin(), vertices.x.end()),
+		y = std::minmax_element(vertices.y.begin(), vertices.y.end());
+
+	return Rectangle2D(*x.first, *y.first, *x.second, *y.second);
+}
+
+Polygon2D
+Polygon2D::transform(const Matrix2D &mat) const
+{
+	Polygon2D
+		res;
+
+	res.rings = rings;
+	transformBatch(mat, vertices, res.vertices);
+
+	// A reflection turns every ring around; put the orientations back.
+	if (mat.items[0][0] * mat.items[1][1] - mat.items[0][1] * mat.items[1][0] < 0)
+		for (size_t r = 0; r < rings.size(); r++)
+		{
+			std::reverse(res.vertices.x.begin() + ringBegin(r), res.vertices.x.begin() + ringEnd(r));
+			std::reverse(res.vertices.y.begin() + ringBegin(r), res.vertices.y.begin() + ringEnd(r));
+		}
+
+	return res;
+}
+
+SectionProperties
+Polygon2D::sectionProperties() const
+{
+	SectionProperties
+		res;
+
+	if (vertices.size() == 0)
+		return res;
+
+	const double
+		*x = vertices.x.data(),
+		*y = vertices.y.data();
+	double
+		x0 = x[0],
+		y0 = y[0],
+		sums[6] = { 0, 0, 0, 0, 0, 0 };
+	SectionKernel
+		kernel = sectionKernel.get();
+
+	for (size_t r = 0; r < rings.size(); r++)
+	{
+		size_t
+			b = ringBegin(r),
+			e = ringEnd(r);
+
+		kernel(x + b, y + b, e - b, x0, y0, sums);
+		accumulateEdge(x[e - 1] - x0, y[e - 1] - y0, x[b] - x0, y[b] - y0, sums);
+	}
+
+	double
+		dblArea = sums[0] / 2;
+
+	if (dblArea == 0)
+		return res;
+
+	double
+		cx = sums[1] / (6 * dblArea),
+		cy = sums[2] / (6 * dblArea);
+
+	res.area = dblArea;
+	res.centroid = Point2D(x0 + cx, y0 + cy);
+	res.ix = sums[4] / 12 - dblArea * cy * cy;
+	res.iy = sums[3] / 12 - dblArea * cx * cx;
+	res.ixy = sums[5] / 24 - dblArea * cx * cy;
+
+	return res;
+}
+
+void
+sectionPropertiesBatch(const std::vector<Polygon2D> &sections, std::vector<SectionProperties> &res)
+{
+	res.resize(sections.size());
+
+	parallelFor(0, sections.size(), 64, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			res[i] = sections[i].sectionProperties();
+	});
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,192 @@
+/***
+ * CivilPolygon2D.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_POLYGON_2D
+#define __CIVIL_POLYGON_2D
+
+#include <vector>
+
+#include "..\UtilsLibrary\CivilDispatch.h"
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilBuffer2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(peInvalidRing);
+
+	BEGIN_DECLARE_ERROR(EPolygon2D)
+		DECLARE_ERROR(peInvalidRing, "A ring needs at least 3 points")
+	END_DECLARE_ERROR;
+
+	// SectionProperties;
+	//
+	// Geometric properties of a plane section. The moments of inertia are taken about the axes through the
+	// ---- centroid, parallel to X and Y: ix = integral of y^2 dA, iy = integral of x^2 dA, ixy = integral of
+	//      x * y dA.
+	struct SectionProperties
+	{
+	public:
+
+		double
+			area = 0;
+		Point2D
+			centroid;
+		double
+			ix = 0,
+			iy = 0,
+			ixy = 0;
+
+		// inertiaAt;
+		//
+		// Moments about the axes through "ref", parallel to X and Y (parallel-axis theorem).
+		// ----
+		void inertiaAt(const Point2D &ref, double &refIx, double &refIy, double &refIxy) const;
+
+		// principalAxes;
+		//
+		// Principal moments, i1 >= i2, and the angle from the X axis to the axis of i1, in (-pi / 2, pi / 2].
+		// ----
+		void principalAxes(double &i1, double &i2, Angle &ang) const;
+
+		double radiusX() const
+		{
+			return area > 0 ? sqrt(ix / area) : 0;
+		}
+		double radiusY() const
+		{
+			return area > 0 ? sqrt(iy / area) : 0;
+		}
+
+		// weighted;
+		//
+		// The section with its area scaled by "factor", e.g. the modular ratio of a second material in a
+		// ---- transformed section, or -1 for a void cut out of a composite section.
+		SectionProperties weighted(double factor) const;
+
+		// operator+;
+		//
+		// Properties of the union of two parts that do not overlap.
+		// ----
+		friend SectionProperties operator+(const SectionProperties &sec1, const SectionProperties &sec2);
+		SectionProperties &operator+=(const SectionProperties &sec)
+		{
+			*this = *this + sec;
+
+			return *this;
+		}
+
+	}; /* SectionProperties */
+
+	// Polygon2D;
+	//
+	// Plane region bounded by closed rings, each one stored once (the last point is not repeated). The
+	// ---- vertices of every ring sit one after another in "vertices", ring r starting at rings[r]. Solid rings
+	//      are kept counterclockwise and holes clockwise, so any number of solids and holes, a hollow
+	//      section or a composite of separate parts, are summed with their signs.
+	struct Polygon2D
+	{
+	public:
+
+		Polygon2D() = default;
+		Polygon2D(const std::vector<Point2D> &outer)
+		{
+			addRing(outer);
+		}
+
+		PointBuffer
+			vertices;
+		std::vector<size_t>
+			rings;
+
+		// addRing;
+		//
+		// Appends a ring, reversing it if needed so that solids run counterclockwise and holes clockwise.
+		// ---- Raises EPolygon2D for rings of less than 3 points.
+		void addRing(const std::vector<Point2D> &pnts, bool hole = false);
+
+		size_t getRingCount() const
+		{
+			return rings.size();
+		}
+		size_t ringBegin(size_t ring) const
+		{
+			return rings[ring];
+		}
+		size_t ringEnd(size_t ring) const
+		{
+			return ring + 1 < rings.size() ? rings[ring + 1] : vertices.size();
+		}
+
+		Point2D getVertex(size_t index) const
+		{
+			return vertices.getItem(index);
+		}
+
+		// Signed area of one ring, positive for solids.
+		double ringArea(size_t ring) const;
+
+		double area() const;
+		double perimeter() const;
+		Rectangle2D boundsRect() const;
+
+		Polygon2D transform(const Matrix2D &mat) const;
+
+		// sectionProperties;
+		//
+		// Area, centroid and centroidal moments of inertia from Green's theorem, in one pass over the vertex
+		// ---- columns (vectorized, see sectionKernel). Coordinates are taken relative to the first vertex, so
+		//      sections placed at large survey coordinates keep their precision.
+		SectionProperties sectionProperties() const;
+
+	}; /* Polygon2D */
+
+	// sectionPropertiesBatch;
+	//
+	// Properties of many sections at once (e.g. the candidates of an optimization), spread over the shared
+	// ---- thread pool.
+	void sectionPropertiesBatch(const std::vector<Polygon2D> &sections, std::vector<SectionProperties> &res);
+
+	// sectionKernel;
+	//
+	// Green's theorem sums over the open chain of edges i -> i + 1, 0 <= i < count - 1, with the coordinates
+	// ---- taken relative to (x0, y0). For the edge (a, b) with c = xa * yb - xb * ya the sums are:
+	//
+	//        sums[0] += c                                        (2 A)
+	//        sums[1] += (xa + xb) * c                            (6 Sy)
+	//        sums[2] += (ya + yb) * c                            (6 Sx)
+	//        sums[3] += (xa^2 + xa * xb + xb^2) * c              (12 Iy)
+	//        sums[4] += (ya^2 + ya * yb + yb^2) * c              (12 Ix)
+	//        sums[5] += (xa * yb + 2 xa * ya + 2 xb * yb + xb * ya) * c   (24 Ixy)
+	typedef void (*SectionKernel)(const double *x, const double *y, size_t count, double x0, double y0, double sums[6]);
+
+	extern Dispatch<SectionKernel>
+		sectionKernel;
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_POLYGON_2D
@@ -0,0 +1,767 @@
+#include "CivilPolygonBoolean.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <algorithm>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "..\MathLibrary\CivilPredicates.h"
+#include "..\MathLibrary\CivilPreparedPolygon.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+// Average number of search cells an edge may be registered in before the grid is made coarser.
+static const size_t
+	CELLS_PER_EDGE = 8;
+
+static const unsigned int
+	NONE = ~0u;
+
+// An edge of one of the operands (owner 0 or 1), as it runs in its ring.
+struct Edge
+{
+public:
+
+	Point2D
+		a,
+		b;
+	int
+		owner;
+
+}; /* Edge */
+
+// A point where an edge is to be split; "t" orders the points along the edge.
+struct Split
+{
+public:
+
+	size_t
+		edge;
+	double
+		t;
+	Point2D
+		pnt;
+
+}; /* Split */
+
+// A piece of an edge between two vertices of the overlay.
+struct Piece
+{
+public:
+
+	unsigned int
+		from,
+		to;
+	int
+		owner;
+
+}; /* Piece */
+
+static inline bool
+samePoint(const Point2D &p, const Point2D &q)
+{
+	return p.x == q.x && p.y == q.y;
+}
+
+static inline bool
+lessPoint(const Point2D &p, const Point2D &q)
+{
+	return p.x < q.x || (p.x == q.x && p.y < q.y);
+}
+
+// Whether p, known to be on the line of a-b, lies on the segment.
+static inline bool
+inBox(const Point2D &a, const Point2D &b, const Point2D &p)
+{
+	return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= p.y &&
+		p.y <= std::max(a.y, b.y);
+}
+
+static bool
+apply(BooleanOperationEnum op, bool inA, bool inB)
+{
+	switch (op)
+	{
+	case boUnion:
+		return inA || inB;
+	case boIntersection:
+		return inA && inB;
+	case boDifference:
+		return inA && !inB;
+	default:
+		return inA != inB;
+	}
+}
+
+static void
+collectEdges(const Polygon2D &pol, int owner, std::vector<Edge> &edges)
+{
+	for (size_t r = 0; r < pol.getRingCount(); r++)
+		for (size_t a = pol.ringBegin(r), e = pol.ringEnd(r); a < e; a++)
+		{
+			Point2D
+				pa = pol.getVertex(a),
+				pb = pol.getVertex(a + 1 < e ? a + 1 : pol.ringBegin(r));
+
+			if (!samePoint(pa, pb))
+				edges.push_back(Edge{ pa, pb, owner });
+		}
+}
+
+static void
+appendRings(Polygon2D &res, const Polygon2D &pol)
+{
+	for (size_t r = 0; r < pol.getRingCount(); r++)
+	{
+		res.rings.push_back(res.vertices.size());
+
+		for (size_t i = pol.ringBegin(r); i < pol.ringEnd(r); i++)
+			res.vertices.add(pol.getVertex(i));
+	}
+}
+
+/*
+ * Splitting.
+ */
+
+static void
+addSplit(std::vector<Split> &splits, const std::vector<Edge> &edges, size_t edge, const Point2D &pnt)
+{
+	const Edge
+		&e = edges[edge];
+
+	splits.push_back(Split{ edge, (pnt.x - e.a.x) * (e.b.x - e.a.x) + (pnt.y - e.a.y) * (e.b.y - e.a.y), pnt });
+}
+
+// Splits edges i and j where they meet: at the crossing point, or at the end points of one that lie on
+// the other, which also covers collinear overlaps.
+static void
+intersect(const std::vector<Edge> &edges, size_t i, size_t j, std::vector<Split> &splits)
+{
+	const Edge
+		&e = edges[i],
+		&f = edges[j];
+	double
+		o1 = orient2d(e.a, e.b, f.a),
+		o2 = orient2d(e.a, e.b, f.b),
+		o3 = orient2d(f.a, f.b, e.a),
+		o4 = orient2d(f.a, f.b, e.b);
+
+	if ((o1 > 0 && o2 > 0) || (o1 < 0 && o2 < 0) || (o3 > 0 && o4 > 0) || (o3 < 0 && o4 < 0))
+		return;
+
+	if (o1 != 0 && o2 != 0 && o3 != 0 && o4 != 0)
+	{
+		// Both edges get the same rounded point, kept in the boxes of both.
+		double
+			dx1 = e.b.x - e.a.x,
+			dy1 = e.b.y - e.a.y,
+			dx2 = f.b.x - f.a.x,
+			dy2 = f.b.y - f.a.y,
+			t = ((f.a.x - e.a.x) * dy2 - (f.a.y - e.a.y) * dx2) / (dx1 * dy2 - dy1 * dx2);
+
+		t = t > 0 ? (t < 1 ? t : 1) : 0;
+
+		Point2D
+			p(e.a.x + t * dx1, e.a.y + t * dy1);
+
+		p.x = std::min(std::max(p.x, std::max(std::min(e.a.x, e.b.x), std::min(f.a.x, f.b.x))),
+			std::min(std::max(e.a.x, e.b.x), std::max(f.a.x, f.b.x)));
+		p.y = std::min(std::max(p.y, std::max(std::min(e.a.y, e.b.y), std::min(f.a.y, f.b.y))),
+			std::min(std::max(e.a.y, e.b.y), std::max(f.a.y, f.b.y)));
+		addSplit(splits, edges, i, p);
+		addSplit(splits, edges, j, p);
+
+		return;
+	}
+
+	if (o1 == 0 && inBox(e.a, e.b, f.a))
+		addSplit(splits, edges, i, f.a);
+
+	if (o2 == 0 && inBox(e.a, e.b, f.b))
+		addSplit(splits, edges, i, f.b);
+
+	if (o3 == 0 && inBox(f.a, f.b, e.a))
+		addSplit(splits, edges, j, e.a);
+
+	if (o4 == 0 && inBox(f.a, f.b, e.b))
+		addSplit(splits, edges, j, e.b);
+}
+
+// Meeting points of the edges of the first operand, [0, countA), with those of the second. Two edges can
+// only meet inside the common bounds, so the edges of the first one are registered in a grid over them
+// and each edge of the second one looks into the cells of its box.
+static void
+findSplits(const std::vector<Edge> &edges, size_t countA, const Rectangle2D &common, std::vector<Split> &splits)
+{
+	std::vector<size_t>
+		aEdgesA,
+		aEdgesB;
+
+	for (size_t i = 0; i < edges.size(); i++)
+	{
+		const Edge
+			&e = edges[i];
+
+		if (std::max(e.a.x, e.b.x) >= common.left && std::min(e.a.x, e.b.x) <= common.right &&
+			std::max(e.a.y, e.b.y) >= common.bottom && std::min(e.a.y, e.b.y) <= common.top)
+			(i < countA ? aEdgesA : aEdgesB).push_back(i);
+	}
+
+	if (aEdgesA.empty() || aEdgesB.empty())
+		return;
+
+	double
+		dblWidth = common.right - common.left,
+		dblHeight = common.top - common.bottom,
+		dblCells = (double) (aEdgesA.size() + aEdgesB.size());
+	size_t
+		intCols = 1,
+		intRows = 1;
+
+	if (dblWidth > 0 && dblHeight > 0)
+	{
+		intCols = (size_t) std::max(1.0, std::min(dblCells, round(sqrt(dblCells * dblWidth / dblHeight))));
+		intRows = (size_t) std::max(1.0, round(dblCells / intCols));
+	}
+	else if (dblWidth > 0)
+		intCols = (size_t) dblCells;
+	else if (dblHeight > 0)
+		intRows = (size_t) dblCells;
+
+	auto
+		colOf = [&](double x) {
+			return dblWidth > 0 ? std::min(intCols - 1, (size_t) std::max(0.0, (x - common.left) / dblWidth * intCols)) : 0;
+		};
+	auto
+		rowOf = [&](double y) {
+			return dblHeight > 0 ? std::min(intRows - 1, (size_t) std::max(0.0, (y - common.bottom) / dblHeight * intRows)) : 0;
+		};
+
+	// Long edges fill the cells of their boxes; halve the grid until they do not crowd it.
+	for (;;)
+	{
+		size_t
+			intRegistered = 0;
+
+		for (size_t i : aEdgesA)
+		{
+			const Edge
+				&e = edges[i];
+
+			intRegistered += (colOf(std::max(e.a.x, e.b.x)) - colOf(std::min(e.a.x, e.b.x)) + 1) *
+				(rowOf(std::max(e.a.y, e.b.y)) - rowOf(std::min(e.a.y, e.b.y)) + 1);
+		}
+
+		if (intRegistered <= CELLS_PER_EDGE * aEdgesA.size() + intCols * intRows || intCols * intRows == 1)
+			break;
+
+		intCols = (intCols + 1) / 2;
+		intRows = (intRows + 1) / 2;
+	}
+
+	std::vector<size_t>
+		aStart(intCols * intRows + 1, 0),
+		aFill,
+		aCells;
+
+	// Counted, then placed.
+	for (int intPass = 0; intPass < 2; intPass++)
+	{
+		if (intPass == 1)
+		{
+			for (size_t c = 0; c + 1 < aStart.size(); c++)
+				aStart[c + 1] += aStart[c];
+
+			aFill.assign(aStart.begin(), aStart.end() - 1);
+			aCells.resize(aStart.back());
+		}
+
+		for (size_t i : aEdgesA)
+		{
+			const Edge
+				&e = edges[i];
+			size_t
+				c0 = colOf(std::min(e.a.x, e.b.x)),
+				c1 = colOf(std::max(e.a.x, e.b.x)),
+				r0 = rowOf(std::min(e.a.y, e.b.y)),
+				r1 = rowOf(std::max(e.a.y, e.b.y));
+
+			for (size_t r = r0; r <= r1; r++)
+				for (size_t c = c0; c <= c1; c++)
+					if (intPass == 0)
+						aStart[r * intCols + c + 1]++;
+					else
+						aCells[aFill[r * intCols + c]++] = i;
+		}
+	}
+
+	// The last edge of the second operand that was tested against each edge of the first.
+	std::vector<size_t>
+		aTested(countA, SIZE_MAX);
+
+	for (size_t j : aEdgesB)
+	{
+		const Edge
+			&f = edges[j];
+		size_t
+			c0 = colOf(std::min(f.a.x, f.b.x)),
+			c1 = colOf(std::max(f.a.x, f.b.x)),
+			r0 = rowOf(std::min(f.a.y, f.b.y)),
+			r1 = rowOf(std::max(f.a.y, f.b.y));
+
+		for (size_t r = r0; r <= r1; r++)
+			for (size_t c = c0; c <= c1; c++)
+				for (size_t k = aStart[r * intCols + c]; k < aStart[r * intCols + c + 1]; k++)
+				{
+					size_t
+						i = aCells[k];
+
+					if (aTested[i] == j)
+						continue;
+
+					aTested[i] = j;
+
+					const Edge
+						&e = edges[i];
+
+					if (std::max(e.a.x, e.b.x) >= std::min(f.a.x, f.b.x) && std::min(e.a.x, e.b.x) <= std::max(f.a.x, f.b.x) &&
+						std::max(e.a.y, e.b.y) >= std::min(f.a.y, f.b.y) && std::min(e.a.y, e.b.y) <= std::max(f.a.y, f.b.y))
+						intersect(edges, i, j, splits);
+				}
+	}
+}
+
+/*
+ * Rings.
+ */
+
+// Whether the piece p-q, which does not cross the boundary of the prepared polygon, lies inside it.
+static bool
+pieceInside(const PreparedPolygon &pol, const Point2D &p, const Point2D &q)
+{
+	// The rounded middle may fall on an edge that the piece ends on; a quarter of the way is then clear.
+	static const double
+		AT[] = { 0.5, 0.25, 0.75 };
+
+	for (double t : AT)
+	{
+		PointLocationEnum
+			loc = pol.locate(p.x + t * (q.x - p.x), p.y + t * (q.y - p.y));
+
+		if (loc != plBoundary)
+			return loc == plInside;
+	}
+
+	return false;
+}
+
+// Position of the direction v -> w while turning clockwise from v -> u: 0 for less than half a turn, 1
+// for half a turn up to a full one and 2 for the direction of u itself.
+static int
+clockwiseHalf(const Point2D &v, const Point2D &u, const Point2D &w)
+{
+	double
+		o = orient2d(v, u, w);
+
+	if (o < 0)
+		return 0;
+
+	if (o > 0)
+		return 1;
+
+	bool
+		blnSame = (w.x > v.x) == (u.x > v.x) && (w.x < v.x) == (u.x < v.x) && (w.y > v.y) == (u.y > v.y) &&
+			(w.y < v.y) == (u.y < v.y);
+
+	return blnSame ? 2 : 1;
+}
+
+// Whether v -> w1 comes before v -> w2 turning clockwise from v -> u.
+static bool
+turnsBefore(const Point2D &v, const Point2D &u, const Point2D &w1, const Point2D &w2)
+{
+	int
+		h1 = clockwiseHalf(v, u, w1),
+		h2 = clockwiseHalf(v, u, w2);
+
+	return h1 != h2 ? h1 < h2 : orient2d(v, w1, w2) < 0;
+}
+
+// Drops the vertices where a ring goes straight on.
+static void
+dropStraight(std::vector<Point2D> &ring)
+{
+	std::vector<Point2D>
+		aKept;
+	bool
+		blnChanged = true;
+
+	while (blnChanged && ring.size() >= 3)
+	{
+		size_t
+			n = ring.size();
+
+		blnChanged = false;
+		aKept.clear();
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const Point2D
+				&p = aKept.empty() ? ring[n - 1] : aKept.back(),
+				&v = ring[i],
+				&q = ring[(i + 1) % n];
+
+			if (orient2d(p, v, q) == 0 && (v.x - p.x) * (q.x - v.x) + (v.y - p.y) * (q.y - v.y) > 0)
+				blnChanged = true;
+			else
+				aKept.push_back(v);
+		}
+
+		ring.swap(aKept);
+	}
+}
+
+/*
+ * polygonBoolean.
+ */
+
+Polygon2D
+polygonBoolean(const Polygon2D &a, const Polygon2D &b, BooleanOperationEnum op)
+{
+	Polygon2D
+		res;
+	Rectangle2D
+		rctA = a.boundsRect(),
+		rctB = b.boundsRect();
+	bool
+		blnEmptyA = a.vertices.size() == 0,
+		blnEmptyB = b.vertices.size() == 0;
+
+	// Apart: nothing to overlay.
+	if (blnEmptyA || blnEmptyB || rctA.right < rctB.left || rctB.right < rctA.left || rctA.top < rctB.bottom ||
+		rctB.top < rctA.bottom)
+	{
+		if (op != boIntersection)
+			appendRings(res, a);
+
+		if (op == boUnion || op == boXor)
+			appendRings(res, b);
+
+		return res;
+	}
+
+	std::vector<Edge>
+		aEdges;
+	std::vector<Split>
+		aSplits;
+
+	collectEdges(a, 0, aEdges);
+
+	size_t
+		intCountA = aEdges.size();
+
+	collectEdges(b, 1, aEdges);
+	findSplits(aEdges, intCountA, Rectangle2D(std::max(rctA.left, rctB.left), std::max(rctA.bottom, rctB.bottom),
+		std::min(rctA.right, rctB.right), std::min(rctA.top, rctB.top)), aSplits);
+	std::sort(aSplits.begin(), aSplits.end(), [](const Split &s1, const Split &s2) {
+		return s1.edge < s2.edge || (s1.edge == s2.edge && s1.t < s2.t);
+	});
+
+	// Pieces, as pairs of end points; then the end points become vertices.
+	std::vector<Point2D>
+		aEnds,
+		aVertices;
+	std::vector<int>
+		aOwners;
+
+	for (size_t e = 0, s = 0; e < aEdges.size(); e++)
+	{
+		Point2D
+			pnt = aEdges[e].a;
+
+		for (; s < aSplits.size() && aSplits[s].edge == e; s++)
+		{
+			const Point2D
+				&p = aSplits[s].pnt;
+
+			if (samePoint(p, pnt) || samePoint(p, aEdges[e].b))
+				continue;
+
+			aEnds.push_back(pnt);
+			aEnds.push_back(p);
+			aOwners.push_back(aEdges[e].owner);
+			pnt = p;
+		}
+
+		aEnds.push_back(pnt);
+		aEnds.push_back(aEdges[e].b);
+		aOwners.push_back(aEdges[e].owner);
+	}
+
+	aVertices = aEnds;
+	std::sort(aVertices.begin(), aVertices.end(), lessPoint);
+	aVertices.erase(std::unique(aVertices.begin(), aVertices.end(), samePoint), aVertices.end());
+
+	std::vector<Piece>
+		aPieces(aOwners.size());
+
+	for (size_t i = 0; i < aPieces.size(); i++)
+	{
+		aPieces[i].from = (unsigned int) (std::lower_bound(aVertices.begin(), aVertices.end(), aEnds[2 * i], lessPoint) -
+			aVertices.begin());
+		aPieces[i].to = (unsigned int) (std::lower_bound(aVertices.begin(), aVertices.end(), aEnds[2 * i + 1], lessPoint) -
+			aVertices.begin());
+		aPieces[i].owner = aOwners[i];
+	}
+
+	// Pieces on the same two vertices are one; each owner with a piece there knows which side of it is
+	// inside, and the other one is asked where the piece lies.
+	std::sort(aPieces.begin(), aPieces.end(), [](const Piece &p1, const Piece &p2) {
+		unsigned int
+			lo1 = std::min(p1.from, p1.to),
+			lo2 = std::min(p2.from, p2.to),
+			hi1 = std::max(p1.from, p1.to),
+			hi2 = std::max(p2.from, p2.to);
+
+		return lo1 < lo2 || (lo1 == lo2 && hi1 < hi2);
+	});
+
+	PreparedPolygon
+		ppA(a),
+		ppB(b);
+	const PreparedPolygon
+		*aPrepared[2] = { &ppA, &ppB };
+	std::vector<Piece>
+		aKept;
+
+	for (size_t i = 0, j; i < aPieces.size(); i = j)
+	{
+		const Piece
+			&p = aPieces[i];
+		int
+			aDelta[2] = { 0, 0 };
+		bool
+			aHas[2] = { false, false },
+			aLeft[2],
+			aRight[2];
+
+		for (j = i; j < aPieces.size() && std::min(aPieces[j].from, aPieces[j].to) == std::min(p.from, p.to) &&
+			std::max(aPieces[j].from, aPieces[j].to) == std::max(p.from, p.to); j++)
+		{
+			aDelta[aPieces[j].owner] += aPieces[j].from == p.from ? 1 : -1;
+			aHas[aPieces[j].owner] = true;
+		}
+
+		for (int o = 0; o < 2; o++)
+			if (aHas[o])
+			{
+				aLeft[o] = aDelta[o] > 0;
+				aRight[o] = aDelta[o] < 0;
+			}
+			else
+				aLeft[o] = aRight[o] = pieceInside(*aPrepared[o], aVertices[p.from], aVertices[p.to]);
+
+		bool
+			blnLeft = apply(op, aLeft[0], aLeft[1]),
+			blnRight = apply(op, aRight[0], aRight[1]);
+
+		if (blnLeft != blnRight)
+			aKept.push_back(blnLeft ? Piece{ p.from, p.to, 0 } : Piece{ p.to, p.from, 0 });
+	}
+
+	// Linking: from each piece to the next one clockwise from the way back, which keeps the result on the
+	// left and splits rings that touch at a vertex.
+	std::vector<size_t>
+		aOutStart(aVertices.size() + 1, 0);
+	std::vector<unsigned int>
+		aOut(aKept.size());
+	std::vector<char>
+		aUsed(aKept.size(), 0);
+	std::vector<Point2D>
+		aRing;
+
+	for (const Piece &p : aKept)
+		aOutStart[p.from + 1]++;
+
+	for (size_t v = 0; v < aVertices.size(); v++)
+		aOutStart[v + 1] += aOutStart[v];
+
+	{
+		std::vector<size_t>
+			aFill(aOutStart.begin(), aOutStart.end() - 1);
+
+		for (size_t k = 0; k < aKept.size(); k++)
+			aOut[aFill[aKept[k].from]++] = (unsigned int) k;
+	}
+
+	for (size_t k0 = 0; k0 < aKept.size(); k0++)
+	{
+		if (aUsed[k0])
+			continue;
+
+		size_t
+			k = k0;
+
+		aRing.clear();
+
+		for (;;)
+		{
+			aUsed[k] = 1;
+			aRing.push_back(aVertices[aKept[k].from]);
+
+			const Point2D
+				&u = aVertices[aKept[k].from],
+				&v = aVertices[aKept[k].to];
+			unsigned int
+				intNext = NONE;
+
+			for (size_t m = aOutStart[aKept[k].to]; m < aOutStart[aKept[k].to + 1]; m++)
+				if (intNext == NONE || turnsBefore(v, u, aVertices[aKept[aOut[m]].to], aVertices[aKept[intNext].to]))
+					intNext = aOut[m];
+
+			if (intNext == k0)
+				break;
+
+			// Only labels made inconsistent by rounding get here.
+			if (intNext == NONE || aUsed[intNext])
+				RAISE(EPolygonBoolean, pbOpenRing);
+
+			k = intNext;
+		}
+
+		dropStraight(aRing);
+
+		if (aRing.size() < 3)
+			continue;
+
+		double
+			dblArea = 0;
+
+		for (size_t i = 0, n = aRing.size(); i < n; i++)
+			dblArea += aRing[i].x * aRing[(i + 1) % n].y - aRing[(i + 1) % n].x * aRing[i].y;
+
+		if (dblArea == 0)
+			continue;
+
+		res.rings.push_back(res.vertices.size());
+
+		for (const Point2D &p : aRing)
+			res.vertices.add(p);
+	}
+
+	return res;
+}
+
+/*
+ * polygonUnion.
+ */
+
+// The bits of v in the even places of the result.
+static uint64_t
+spreadBits(uint32_t v)
+{
+	uint64_t
+		x = v;
+
+	x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+	x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+	x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	x = (x | (x << 2)) & 0x3333333333333333ULL;
+	x = (x | (x << 1)) & 0x5555555555555555ULL;
+
+	return x;
+}
+
+Polygon2D
+polygonUnion(const std::vector<Polygon2D> &polygons, bool parallel)
+{
+	size_t
+		n = polygons.size();
+
+	if (n == 0)
+		return Polygon2D();
+
+	std::vector<Rectangle2D>
+		aBounds(n);
+	Rectangle2D
+		rctAll;
+	bool
+		blnFirst = true;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		aBounds[i] = polygons[i].boundsRect();
+
+		if (polygons[i].vertices.size() == 0)
+			continue;
+
+		if (blnFirst)
+			rctAll = aBounds[i];
+		else
+		{
+			rctAll.left = std::min(rctAll.left, aBounds[i].left);
+			rctAll.bottom = std::min(rctAll.bottom, aBounds[i].bottom);
+			rctAll.right = std::max(rctAll.right, aBounds[i].right);
+			rctAll.top = std::max(rctAll.top, aBounds[i].top);
+		}
+
+		blnFirst = false;
+	}
+
+	double
+		dblScaleX = rctAll.right > rctAll.left ? 4294967295.0 / (rctAll.right - rctAll.left) : 0,
+		dblScaleY = rctAll.top > rctAll.bottom ? 4294967295.0 / (rctAll.top - rctAll.bottom) : 0;
+	std::vector<std::pair<uint64_t, size_t>>
+		aOrder(n);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		double
+			x = std::min(4294967295.0, std::max(0.0, ((aBounds[i].left + aBounds[i].right) / 2 - rctAll.left) * dblScaleX)),
+			y = std::min(4294967295.0, std::max(0.0, ((aBounds[i].bottom + aBounds[i].top) / 2 - rctAll.bottom) * dblScaleY));
+
+		aOrder[i] = std::make_pair(spreadBits((uint32_t) x) | spreadBits((uint32_t) y) << 1, i);
+	}
+
+	std::sort(aOrder.begin(), aOrder.end());
+
+	// First level from the input, in the order of the curve; then level after level.
+	std::vector<Polygon2D>
+		aLevel((n + 1) / 2),
+		aNext;
+	auto
+		run = [&](size_t count, const auto &step) {
+			if (parallel)
+				parallelFor(0, count, 1, step);
+			else
+				step(0, count);
+		};
+
+	run(aLevel.size(), [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			aLevel[i] = 2 * i + 1 < n ?
+				polygonBoolean(polygons[aOrder[2 * i].second], polygons[aOrder[2 * i + 1].second], boUnion) :
+				polygons[aOrder[2 * i].second];
+	});
+
+	while (aLevel.size() > 1)
+	{
+		aNext.assign((aLevel.size() + 1) / 2, Polygon2D());
+
+		run(aNext.size(), [&](size_t first, size_t last) {
+			for (size_t i = first; i < last; i++)
+				aNext[i] = 2 * i + 1 < aLevel.size() ? polygonBoolean(aLevel[2 * i], aLevel[2 * i + 1], boUnion) :
+					std::move(aLevel[2 * i]);
+		});
+
+		aLevel.swap(aNext);
+	}
+
+	return aLevel[0];
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,82 @@
+/***
+ * CivilPolygonBoolean.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_POLYGON_BOOLEAN
+#define __CIVIL_POLYGON_BOOLEAN
+
+#include <vector>
+
+#include "..\MathLibrary\CivilPolygon2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(pbOpenRing);
+
+	BEGIN_DECLARE_ERROR(EPolygonBoolean)
+		DECLARE_ERROR(pbOpenRing, "A ring of the result could not be closed")
+	END_DECLARE_ERROR;
+
+	enum BooleanOperationEnum
+	{
+		boUnion,
+		boIntersection,
+		// The first polygon less the second.
+		boDifference,
+		boXor
+	};
+
+	// polygonBoolean;
+	//
+	// Union, intersection, difference or symmetric difference of two polygons with any number of solids and
+	// ---- holes. Each operand must be valid on its own: no ring crosses itself or another ring of the same
+	//      polygon, and every edge has the inside of the polygon on its left, as Polygon2D keeps them. The
+	//      operands may overlap, touch or share edges in any way.
+	//
+	//      The edges are split where they meet the other polygon's, found through a grid over the common
+	//      bounds, and every piece is labelled from the side of its own polygon that is inside and from where
+	//      it lies in the other one (see PreparedPolygon). The pieces with the result on one side only are
+	//      linked into rings, turning at each vertex to the next piece clockwise, so the rings of the result
+	//      may touch at a vertex but never cross. Solids come out counterclockwise and holes clockwise, and
+	//      vertices where a ring goes straight on are dropped.
+	//
+	//      Every decision is a sign of orient2d; only the points where two edges cross are rounded to
+	//      doubles. Should that rounding leave a ring of the result that cannot be closed, EPolygonBoolean
+	//      is raised rather than returning the result without it.
+	Polygon2D polygonBoolean(const Polygon2D &a, const Polygon2D &b, BooleanOperationEnum op);
+
+	// polygonUnion;
+	//
+	// Union of many polygons, e.g. the lots of a subdivision into blocks. The polygons are ordered along a
+	// ---- Morton curve of the centres of their bounds and joined in pairs, then the results in pairs and so
+	//      on, so that neighbours meet early and every union stays small. The pairs of each level run on the
+	//      shared pool when "parallel". Raises EPolygonBoolean as polygonBoolean does.
+	Polygon2D polygonUnion(const std::vector<Polygon2D> &polygons, bool parallel = true);
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_POLYGON_BOOLEAN
@@ -0,0 +1,325 @@
+#include "CivilPredicates.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace CIVIL::MATH::GA2D
+{
+
+/*
+ * Expansion arithmetic.
+ */
+
+// An expansion is a sum of doubles that do not overlap, kept in increasing order of magnitude; it
+// represents its sum exactly. See J. R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast
+// Robust Geometric Predicates" (1997).
+
+static inline void
+twoSum(double a, double b, double &x, double &y)
+{
+	x = a + b;
+
+	double
+		bv = x - a,
+		av = x - bv;
+
+	y = (a - av) + (b - bv);
+}
+
+static inline void
+twoProduct(double a, double b, double &x, double &y)
+{
+	x = a * b;
+	y = fma(a, b, -x);
+}
+
+// Adds b to the expansion e[0..count) in place; returns the new length.
+static int
+growExpansion(double *e, int count, double b)
+{
+	double
+		q = b;
+
+	for (int i = 0; i < count; i++)
+		twoSum(q, e[i], q, e[i]);
+
+	e[count] = q;
+
+	return count + 1;
+}
+
+// The following versions drop zero components, which keeps the expansions short when the input is made of
+// small integers or of numbers with few significant bits, the usual degenerate cases.
+
+static inline void
+fastTwoSum(double a, double b, double &x, double &y)
+{
+	x = a + b;
+	y = b - (x - a);
+}
+
+// h = a - b, exactly; returns the length of h (at most 2).
+static int
+diffExpansion(double a, double b, double *h)
+{
+	double
+		x = a - b,
+		bv = a - x,
+		av = x + bv,
+		y = (a - av) + (bv - b);
+	int
+		n = 0;
+
+	if (y != 0)
+		h[n++] = y;
+	if (x != 0 || n == 0)
+		h[n++] = x;
+
+	return n;
+}
+
+// h = e * b; h has room for 2 * count components.
+static int
+scaleExpansion(const double *e, int count, double b, double *h)
+{
+	double
+		q,
+		hh,
+		t1,
+		t0,
+		sum;
+	int
+		n = 0;
+
+	twoProduct(e[0], b, q, hh);
+
+	if (hh != 0)
+		h[n++] = hh;
+
+	for (int i = 1; i < count; i++)
+	{
+		twoProduct(e[i], b, t1, t0);
+		twoSum(q, t0, sum, hh);
+
+		if (hh != 0)
+			h[n++] = hh;
+
+		fastTwoSum(t1, sum, q, hh);
+
+		if (hh != 0)
+			h[n++] = hh;
+	}
+
+	if (q != 0 || n == 0)
+		h[n++] = q;
+
+	return n;
+}
+
+// e += b, in place; e has room for one more component.
+static int
+growExpansionZeroElim(double *e, int count, double b)
+{
+	double
+		q = b,
+		hh;
+	int
+		n = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		twoSum(q, e[i], q, hh);
+
+		if (hh != 0)
+			e[n++] = hh;
+	}
+
+	if (q != 0 || n == 0)
+		e[n++] = q;
+
+	return n;
+}
+
+// Expansions that grow past a few components; the exact paths are rare enough to allocate.
+typedef std::vector<double>
+	Expansion;
+
+static Expansion
+operator+(Expansion e, const Expansion &f)
+{
+	int
+		n = (int) e.size();
+
+	e.resize(e.size() + f.size());
+
+	for (double b : f)
+		n = growExpansionZeroElim(e.data(), n, b);
+
+	e.resize(n);
+
+	return e;
+}
+
+static Expansion
+operator*(const Expansion &e, const Expansion &f)
+{
+	Expansion
+		res(1, 0),
+		aPart(2 * e.size());
+
+	for (double b : f)
+	{
+		aPart.resize(2 * e.size());
+		aPart.resize(scaleExpansion(e.data(), (int) e.size(), b, aPart.data()));
+		res = res + aPart;
+	}
+
+	return res;
+}
+
+static Expansion
+operator-(Expansion e)
+{
+	for (double &c : e)
+		c = -c;
+
+	return e;
+}
+
+static Expansion
+difference(double a, double b)
+{
+	double
+		h[2];
+
+	return Expansion(h, h + diffExpansion(a, b, h));
+}
+
+// Sign of an expansion: that of its largest nonzero component.
+static double
+expansionSign(const double *e, int count)
+{
+	for (int i = count - 1; i >= 0; i--)
+		if (e[i] != 0)
+			return e[i];
+
+	return 0;
+}
+
+/*
+ * orient2d.
+ */
+
+// (3 + 16 eps) eps, Shewchuk's bound for the error of the double evaluation.
+static const double
+	ORIENT_ERROR_BOUND = 3.3306690738754716e-16;
+
+double
+orient2d(double ax, double ay, double bx, double by, double cx, double cy)
+{
+	double
+		dblLeft = (ax - cx) * (by - cy),
+		dblRight = (ay - cy) * (bx - cx),
+		dblDet = dblLeft - dblRight,
+		dblBound = ORIENT_ERROR_BOUND * (abs(dblLeft) + abs(dblRight));
+
+	if (dblDet > dblBound || -dblDet > dblBound)
+		return dblDet;
+
+	// Exact: ax (by - cy) + bx (cy - ay) + cx (ay - by), expanded into six products so that no rounded
+	// difference is involved.
+	double
+		e[13],
+		hi,
+		lo;
+	int
+		n = 0;
+
+	twoProduct(ax, by, hi, lo); n = growExpansion(e, n, lo); n = growExpansion(e, n, hi);
+	twoProduct(-ax, cy, hi, lo); n = growExpansion(e, n, lo); n = growExpansion(e, n, hi);
+	twoProduct(bx, cy, hi, lo); n = growExpansion(e, n, lo); n = growExpansion(e, n, hi);
+	twoProduct(-bx, ay, hi, lo); n = growExpansion(e, n, lo); n = growExpansion(e, n, hi);
+	twoProduct(cx, ay, hi, lo); n = growExpansion(e, n, lo); n = growExpansion(e, n, hi);
+	twoProduct(-cx, by, hi, lo); n = growExpansion(e, n, lo); n = growExpansion(e, n, hi);
+
+	return expansionSign(e, n);
+}
+
+/*
+ * incircle.
+ */
+
+// (10 + 96 eps) eps, Shewchuk's bound for the error of the double evaluation.
+static const double
+	INCIRCLE_ERROR_BOUND = 1.1102230246251577e-15;
+
+double
+incircle(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+{
+	double
+		adx = ax - dx,
+		bdx = bx - dx,
+		cdx = cx - dx,
+		ady = ay - dy,
+		bdy = by - dy,
+		cdy = cy - dy,
+		bdxcdy = bdx * cdy,
+		cdxbdy = cdx * bdy,
+		cdxady = cdx * ady,
+		adxcdy = adx * cdy,
+		adxbdy = adx * bdy,
+		bdxady = bdx * ady,
+		alift = adx * adx + ady * ady,
+		blift = bdx * bdx + bdy * bdy,
+		clift = cdx * cdx + cdy * cdy,
+		dblDet = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady),
+		dblPermanent = (abs(bdxcdy) + abs(cdxbdy)) * alift + (abs(cdxady) + abs(adxcdy)) * blift +
+			(abs(adxbdy) + abs(bdxady)) * clift,
+		dblBound = INCIRCLE_ERROR_BOUND * dblPermanent;
+
+	if (dblDet > dblBound || -dblDet > dblBound)
+		return dblDet;
+
+	// Exact: the differences are split in two components, so every product and sum below is exact.
+	Expansion
+		eAdx = difference(ax, dx),
+		eBdx = difference(bx, dx),
+		eCdx = difference(cx, dx),
+		eAdy = difference(ay, dy),
+		eBdy = difference(by, dy),
+		eCdy = difference(cy, dy),
+		eBC = eBdx * eCdy + -(eCdx * eBdy),
+		eCA = eCdx * eAdy + -(eAdx * eCdy),
+		eAB = eAdx * eBdy + -(eBdx * eAdy),
+		eDet = (eAdx * eAdx + eAdy * eAdy) * eBC + (eBdx * eBdx + eBdy * eBdy) * eCA +
+			(eCdx * eCdx + eCdy * eCdy) * eAB;
+
+	return expansionSign(eDet.data(), (int) eDet.size());
+}
+
+// c, collinear with a and b, within their box.
+static bool
+inBox(const Point2D &a, const Point2D &b, const Point2D &c)
+{
+	return std::min(a.x, b.x) <= c.x && c.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= c.y && c.y <= std::max(a.y, b.y);
+}
+
+bool
+segmentsIntersect(const Point2D &a, const Point2D &b, const Point2D &c, const Point2D &d)
+{
+	double
+		d1 = orient2d(c, d, a),
+		d2 = orient2d(c, d, b),
+		d3 = orient2d(a, b, c),
+		d4 = orient2d(a, b, d);
+
+	if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+		return true;
+
+	return (d1 == 0 && inBox(c, d, a)) || (d2 == 0 && inBox(c, d, b)) || (d3 == 0 && inBox(a, b, c)) ||
+		(d4 == 0 && inBox(a, b, d));
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,82 @@
+/***
+ * CivilPredicates.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_PREDICATES
+#define __CIVIL_PREDICATES
+
+#include "..\MathLibrary\CivilGA2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// Robust geometric predicates. Each one first evaluates the determinant in double precision and
+	// returns it when it is larger than the bound on the rounding error; only the nearly degenerate cases
+	// are recomputed exactly, with floating point expansions. The sign is therefore always right, which
+	// makes the algorithms built on them (hulls, triangulations) consistent on collinear input.
+
+	// orient2d;
+	//
+	// Positive when a, b, c turn counterclockwise (c to the left of a -> b), negative when clockwise and
+	// ---- zero when collinear. Only the sign is exact; the magnitude is an approximation of twice the
+	//      area of the triangle.
+	double orient2d(double ax, double ay, double bx, double by, double cx, double cy);
+
+	inline double orient2d(const Point2D &a, const Point2D &b, const Point2D &c)
+	{
+		return orient2d(a.x, a.y, b.x, b.y, c.x, c.y);
+	}
+
+	// orientation;
+	//
+	// Sign of orient2d as a SideEnum: sLeft, sOver or sRight of the line a -> b.
+	// ----
+	inline SideEnum orientation(const Point2D &a, const Point2D &b, const Point2D &c)
+	{
+		return (SideEnum) sign(orient2d(a, b, c));
+	}
+
+	// segmentsIntersect;
+	//
+	// True when the closed segments a-b and c-d have a point in common, including an end point lying on the
+	// ---- other segment and collinear segments that overlap. Decided on the signs of orient2d alone.
+	bool segmentsIntersect(const Point2D &a, const Point2D &b, const Point2D &c, const Point2D &d);
+
+	// incircle;
+	//
+	// Positive when d lies inside the circle through a, b, c, negative when outside and zero when the four
+	// ---- points are cocircular; a, b, c must turn counterclockwise, otherwise the sign is reversed. Only
+	//      the sign is exact.
+	double incircle(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy);
+
+	inline double incircle(const Point2D &a, const Point2D &b, const Point2D &c, const Point2D &d)
+	{
+		return incircle(a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y);
+	}
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_PREDICATES
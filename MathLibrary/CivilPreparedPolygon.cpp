@@ -0,0 +1,623 @@
+#include "CivilPreparedPolygon.h"
+
+#include <math.h>
+#include <limits.h>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "..\MathLibrary\CivilPredicates.h"
+
+#if CIVIL_X86
+#include <immintrin.h>
+#endif // if CIVIL_X86
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+static const size_t
+	LOCATE_GRAIN = 1 << 12;
+
+// Average number of cells an edge may be indexed in before the grid is made coarser.
+static const double
+	ENTRIES_PER_EDGE = 8;
+
+// Marks the cells whose corner lies on an edge; their points are tested against every edge.
+static const int
+	SLOW_CELL = INT_MIN;
+
+// Margins around the bounds, as fractions of their size, of the successive attempts to build a grid with
+// no corner on an edge.
+static const double
+	MARGINS[] = { 0.0123456789, 0.0172839506, 0.0296296296, 0.0419753086 };
+
+// Same bound as the filter of orient2d.
+static const double
+	ORIENT_ERROR_BOUND = 3.3306690738754716e-16;
+
+// Signed crossing of an edge with a ray, given on which side of the ray's line each end lies ("a" and "b",
+// the far side counted as false) and the orientation of the origin with the edge: +1 when the edge crosses
+// from the near side with the origin to its left, -1 when it crosses back with the origin to its right.
+static inline int
+crossing(bool a, bool b, double o)
+{
+	return a && !b && o > 0 ? 1 : b && !a && o < 0 ? -1 : 0;
+}
+
+/*
+ * Kernels.
+ */
+
+static int
+cellWindingScalar(const double *ax, const double *ay, const double *bx, const double *by, size_t count,
+	double xl, double x, double y, int &flags)
+{
+	int
+		w = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		bool
+			blnBelowA = ay[i] <= y,
+			blnBelowB = by[i] <= y,
+			blnRightA = ax[i] >= xl,
+			blnRightB = bx[i] >= xl,
+			blnInY = std::min(ay[i], by[i]) <= y && y <= std::max(ay[i], by[i]),
+			blnLegInBox = blnInY && std::min(ax[i], bx[i]) <= xl && xl <= std::max(ax[i], bx[i]),
+			blnInBox = blnInY && std::min(ax[i], bx[i]) <= x && x <= std::max(ax[i], bx[i]);
+
+		if (blnRightA != blnRightB || blnBelowA != blnBelowB || blnLegInBox)
+		{
+			double
+				o = orient2d(ax[i], ay[i], bx[i], by[i], xl, y);
+
+			if (o == 0 && blnLegInBox)
+				flags |= wfLegOnEdge;
+
+			w += crossing(blnRightA, blnRightB, o) - crossing(blnBelowA, blnBelowB, o);
+		}
+
+		if (blnBelowA != blnBelowB || blnInBox)
+		{
+			double
+				o = orient2d(ax[i], ay[i], bx[i], by[i], x, y);
+
+			if (o == 0 && blnInBox)
+				flags |= wfPointOnEdge;
+
+			w += crossing(blnBelowA, blnBelowB, o);
+		}
+	}
+
+	return w;
+}
+
+#if CIVIL_X86
+
+// Four edges per register. The orientations that decide a crossing or an edge under the point are
+// filtered as in orient2d; an edge with an uncertain one goes through the scalar kernel as a whole.
+CIVIL_TARGET("avx2,fma") static int
+cellWindingAVX2(const double *ax, const double *ay, const double *bx, const double *by, size_t count,
+	double xl, double x, double y, int &flags)
+{
+	// Most cells hold an edge or two.
+	if (count < 4)
+		return cellWindingScalar(ax, ay, bx, by, count, xl, x, y, flags);
+
+	const __m256d
+		vxl = _mm256_set1_pd(xl),
+		vx = _mm256_set1_pd(x),
+		vy = _mm256_set1_pd(y),
+		vBound = _mm256_set1_pd(ORIENT_ERROR_BOUND),
+		vAbs = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL)),
+		vOne = _mm256_set1_pd(1);
+	__m256d
+		vSum = _mm256_setzero_pd();
+	int
+		w = 0;
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			vax = _mm256_loadu_pd(ax + i),
+			vay = _mm256_loadu_pd(ay + i),
+			vbx = _mm256_loadu_pd(bx + i),
+			vby = _mm256_loadu_pd(by + i),
+			vBelowA = _mm256_cmp_pd(vay, vy, _CMP_LE_OQ),
+			vBelowB = _mm256_cmp_pd(vby, vy, _CMP_LE_OQ),
+			vUp = _mm256_andnot_pd(vBelowB, vBelowA),
+			vDown = _mm256_andnot_pd(vBelowA, vBelowB),
+			vRightA = _mm256_cmp_pd(vax, vxl, _CMP_GE_OQ),
+			vRightB = _mm256_cmp_pd(vbx, vxl, _CMP_GE_OQ),
+			vLeft = _mm256_andnot_pd(vRightB, vRightA),
+			vBack = _mm256_andnot_pd(vRightA, vRightB),
+			vMinX = _mm256_min_pd(vax, vbx),
+			vMaxX = _mm256_max_pd(vax, vbx),
+			vInY = _mm256_and_pd(_mm256_cmp_pd(_mm256_min_pd(vay, vby), vy, _CMP_LE_OQ),
+				_mm256_cmp_pd(vy, _mm256_max_pd(vay, vby), _CMP_LE_OQ)),
+			vLegInBox = _mm256_and_pd(vInY, _mm256_and_pd(_mm256_cmp_pd(vMinX, vxl, _CMP_LE_OQ),
+				_mm256_cmp_pd(vxl, vMaxX, _CMP_LE_OQ))),
+			vInBox = _mm256_and_pd(vInY, _mm256_and_pd(_mm256_cmp_pd(vMinX, vx, _CMP_LE_OQ),
+				_mm256_cmp_pd(vx, vMaxX, _CMP_LE_OQ))),
+			vCross = _mm256_or_pd(vUp, vDown),
+			vdya = _mm256_sub_pd(vay, vy),
+			vdyb = _mm256_sub_pd(vby, vy),
+			// orient2d(a, b, (xl, y)) and orient2d(a, b, (x, y)).
+			vLegL = _mm256_mul_pd(_mm256_sub_pd(vax, vxl), vdyb),
+			vLegR = _mm256_mul_pd(vdya, _mm256_sub_pd(vbx, vxl)),
+			vLegDet = _mm256_sub_pd(vLegL, vLegR),
+			vLegErr = _mm256_mul_pd(vBound, _mm256_add_pd(_mm256_and_pd(vLegL, vAbs), _mm256_and_pd(vLegR, vAbs))),
+			vPntL = _mm256_mul_pd(_mm256_sub_pd(vax, vx), vdyb),
+			vPntR = _mm256_mul_pd(vdya, _mm256_sub_pd(vbx, vx)),
+			vPntDet = _mm256_sub_pd(vPntL, vPntR),
+			vPntErr = _mm256_mul_pd(vBound, _mm256_add_pd(_mm256_and_pd(vPntL, vAbs), _mm256_and_pd(vPntR, vAbs))),
+			vLegPos = _mm256_cmp_pd(vLegDet, vLegErr, _CMP_GT_OQ),
+			vLegNeg = _mm256_cmp_pd(_mm256_sub_pd(_mm256_setzero_pd(), vLegDet), vLegErr, _CMP_GT_OQ),
+			vPntPos = _mm256_cmp_pd(vPntDet, vPntErr, _CMP_GT_OQ),
+			vPntNeg = _mm256_cmp_pd(_mm256_sub_pd(_mm256_setzero_pd(), vPntDet), vPntErr, _CMP_GT_OQ),
+			vLegNeed = _mm256_or_pd(_mm256_or_pd(vLeft, vBack), _mm256_or_pd(vCross, vLegInBox)),
+			vPntNeed = _mm256_or_pd(vCross, vInBox),
+			vUnsure = _mm256_or_pd(_mm256_andnot_pd(_mm256_or_pd(vLegPos, vLegNeg), vLegNeed),
+				_mm256_andnot_pd(_mm256_or_pd(vPntPos, vPntNeg), vPntNeed)),
+			// The terms of each orientation exclude one another, those of the two do not.
+			vLegPlus = _mm256_or_pd(_mm256_and_pd(vLeft, vLegPos), _mm256_and_pd(vDown, vLegNeg)),
+			vLegMinus = _mm256_or_pd(_mm256_and_pd(vBack, vLegNeg), _mm256_and_pd(vUp, vLegPos)),
+			vPntPlus = _mm256_and_pd(vUp, vPntPos),
+			vPntMinus = _mm256_and_pd(vDown, vPntNeg),
+			vTerm = _mm256_add_pd(
+				_mm256_sub_pd(_mm256_and_pd(vLegPlus, vOne), _mm256_and_pd(vLegMinus, vOne)),
+				_mm256_sub_pd(_mm256_and_pd(vPntPlus, vOne), _mm256_and_pd(vPntMinus, vOne)));
+
+		vSum = _mm256_add_pd(vSum, _mm256_andnot_pd(vUnsure, vTerm));
+
+		int
+			intUnsure = _mm256_movemask_pd(vUnsure);
+
+		for (int k = 0; intUnsure; k++, intUnsure >>= 1)
+			if (intUnsure & 1)
+				w += cellWindingScalar(ax + i + k, ay + i + k, bx + i + k, by + i + k, 1, xl, x, y, flags);
+	}
+
+	__m128d
+		vHalf = _mm_add_pd(_mm256_castpd256_pd128(vSum), _mm256_extractf128_pd(vSum, 1));
+
+	w += (int) _mm_cvtsd_f64(_mm_add_sd(vHalf, _mm_unpackhi_pd(vHalf, vHalf)));
+
+	return w + cellWindingScalar(ax + i, ay + i, bx + i, by + i, count - i, xl, x, y, flags);
+}
+
+Dispatch<CellWindingKernel>
+	cellWindingKernel(cellWindingScalar, nullptr, cellWindingAVX2);
+
+#else
+
+Dispatch<CellWindingKernel>
+	cellWindingKernel(cellWindingScalar);
+
+#endif // if CIVIL_X86
+
+/*
+ * Grid.
+ */
+
+// The cell of the grid lines "lines" that holds v, lines[i] <= v < lines[i + 1], for v inside the grid.
+static size_t
+cellOf(const std::vector<double> &lines, double v, double origin, double size)
+{
+	double
+		dblCell = (v - origin) / size;
+	size_t
+		i = dblCell <= 0 ? 0 : std::min(lines.size() - 2, (size_t) dblCell);
+
+	while (i > 0 && v < lines[i])
+		i--;
+
+	while (i + 2 < lines.size() && v >= lines[i + 1])
+		i++;
+
+	return i;
+}
+
+// Calls visit(col, row) for every cell whose closed box the segment a-b touches. The rows of the segment's
+// bounds are scanned over the columns of its part in each row, one more on each side for the rounding;
+// the test itself is exact: a segment inside the bounds misses a box only when the four corners lie
+// strictly on one side of its line.
+template <typename Visit>
+static void
+rasterize(const std::vector<double> &linesX, const std::vector<double> &linesY, double left, double bottom,
+	double width, double height, double ax, double ay, double bx, double by, Visit visit)
+{
+	double
+		dblMinX = std::min(ax, bx),
+		dblMaxX = std::max(ax, bx),
+		dblMinY = std::min(ay, by),
+		dblMaxY = std::max(ay, by);
+	size_t
+		c0 = cellOf(linesX, dblMinX, left, width),
+		c1 = cellOf(linesX, dblMaxX, left, width),
+		r0 = cellOf(linesY, dblMinY, bottom, height),
+		r1 = cellOf(linesY, dblMaxY, bottom, height);
+
+	// A bound on a grid line also touches the cell before it.
+	if (c0 > 0 && linesX[c0] == dblMinX)
+		c0--;
+
+	if (r0 > 0 && linesY[r0] == dblMinY)
+		r0--;
+
+	for (size_t r = r0; r <= r1; r++)
+	{
+		size_t
+			cFirst = c0,
+			cLast = c1;
+
+		if (c1 - c0 > 2 && ay != by)
+		{
+			double
+				dblLow = std::max(linesY[r], dblMinY),
+				dblHigh = std::min(linesY[r + 1], dblMaxY),
+				dblX1 = ax + (bx - ax) * ((dblLow - ay) / (by - ay)),
+				dblX2 = ax + (bx - ax) * ((dblHigh - ay) / (by - ay));
+			size_t
+				cA = cellOf(linesX, std::max(dblMinX, std::min(dblX1, dblX2)), left, width),
+				cB = cellOf(linesX, std::min(dblMaxX, std::max(dblX1, dblX2)), left, width);
+
+			cFirst = std::max(c0, cA > 0 ? cA - 1 : 0);
+			cLast = std::min(c1, cB + 1);
+		}
+
+		for (size_t c = cFirst; c <= cLast; c++)
+		{
+			double
+				o1 = orient2d(ax, ay, bx, by, linesX[c], linesY[r]),
+				o2 = orient2d(ax, ay, bx, by, linesX[c + 1], linesY[r]),
+				o3 = orient2d(ax, ay, bx, by, linesX[c], linesY[r + 1]),
+				o4 = orient2d(ax, ay, bx, by, linesX[c + 1], linesY[r + 1]);
+
+			if ((o1 > 0 && o2 > 0 && o3 > 0 && o4 > 0) || (o1 < 0 && o2 < 0 && o3 < 0 && o4 < 0))
+				continue;
+
+			visit(c, r);
+		}
+	}
+}
+
+/*
+ * PreparedPolygon.
+ */
+
+PreparedPolygon::PreparedPolygon(const Polygon2D &polygon, double cellsPerEdge) :
+	m_polygon(polygon),
+	m_dblLeft(0),
+	m_dblBottom(0),
+	m_dblRight(-1),
+	m_dblTop(-1),
+	m_dblCellWidth(1),
+	m_dblCellHeight(1),
+	m_intCols(0),
+	m_intRows(0)
+{
+	if (polygon.vertices.size() == 0)
+		return;
+
+	// Another margin moves every grid line; the cells still on a corner are left to the slow test.
+	for (int i = 0; !build(cellsPerEdge > 0 ? cellsPerEdge : 2, i) && i + 1 < (int) std::size(MARGINS); i++)
+		;
+}
+
+// Builds the grid with the margin of "attempt"; false when a corner lies on an edge.
+bool
+PreparedPolygon::build(double cellsPerEdge, int attempt)
+{
+	const PointBuffer
+		&v = m_polygon.vertices;
+	Rectangle2D
+		rct = m_polygon.boundsRect();
+	size_t
+		intEdges = v.size();
+	double
+		dblSize = std::max(std::max(rct.right - rct.left, rct.top - rct.bottom),
+			1e-9 * std::max(std::max(fabs(rct.left), fabs(rct.right)), std::max(fabs(rct.bottom), fabs(rct.top)))),
+		dblMargin = dblSize > 0 ? dblSize * MARGINS[attempt] : 1;
+
+	// The outer lines are clear of the polygon, so the winding number is 0 along them.
+	m_dblLeft = rct.left - dblMargin;
+	m_dblBottom = rct.bottom - dblMargin;
+	m_dblRight = rct.right + dblMargin;
+	m_dblTop = rct.top + dblMargin;
+
+	double
+		dblWidth = m_dblRight - m_dblLeft,
+		dblHeight = m_dblTop - m_dblBottom,
+		dblCells = std::max(1.0, std::min((double) MAX_CELLS, intEdges * cellsPerEdge)),
+		dblLength = 0;
+
+	// A long edge goes into every cell it crosses, about sqrt(cells) * (|dx| + |dy|) / sqrt(area) of them;
+	// the grid is made coarser when that would index the edges more than ENTRIES_PER_EDGE times on average.
+	for (size_t r = 0; r < m_polygon.getRingCount(); r++)
+		for (size_t a = m_polygon.ringBegin(r), e = m_polygon.ringEnd(r); a < e; a++)
+		{
+			size_t
+				b = a + 1 < e ? a + 1 : m_polygon.ringBegin(r);
+
+			dblLength += fabs(v.x[b] - v.x[a]) + fabs(v.y[b] - v.y[a]);
+		}
+
+	double
+		dblCrossed = dblLength / sqrt(dblWidth * dblHeight);
+
+	if (dblCrossed > 0)
+		dblCells = std::max(1.0, std::min(dblCells, pow((ENTRIES_PER_EDGE - 1) * intEdges / dblCrossed, 2)));
+
+	m_intCols = (size_t) std::max(1.0, std::min(dblCells, round(sqrt(dblCells * dblWidth / dblHeight))));
+	m_intRows = (size_t) std::max(1.0, round(dblCells / m_intCols));
+	m_dblCellWidth = dblWidth / m_intCols;
+	m_dblCellHeight = dblHeight / m_intRows;
+	m_aLinesX.resize(m_intCols + 1);
+	m_aLinesY.resize(m_intRows + 1);
+
+	for (size_t i = 0; i < m_intCols; i++)
+		m_aLinesX[i] = m_dblLeft + i * m_dblCellWidth;
+
+	for (size_t i = 0; i < m_intRows; i++)
+		m_aLinesY[i] = m_dblBottom + i * m_dblCellHeight;
+
+	m_aLinesX[m_intCols] = m_dblRight;
+	m_aLinesY[m_intRows] = m_dblTop;
+
+	// Edges into cells, counted and then placed.
+	size_t
+		intCells = m_intCols * m_intRows;
+
+	m_aStart.assign(intCells + 1, 0);
+
+	for (size_t r = 0; r < m_polygon.getRingCount(); r++)
+		for (size_t a = m_polygon.ringBegin(r), e = m_polygon.ringEnd(r); a < e; a++)
+		{
+			size_t
+				b = a + 1 < e ? a + 1 : m_polygon.ringBegin(r);
+
+			rasterize(m_aLinesX, m_aLinesY, m_dblLeft, m_dblBottom, m_dblCellWidth, m_dblCellHeight,
+				v.x[a], v.y[a], v.x[b], v.y[b], [&](size_t col, size_t row) {
+					m_aStart[row * m_intCols + col + 1]++;
+				});
+		}
+
+	for (size_t c = 0; c < intCells; c++)
+		m_aStart[c + 1] += m_aStart[c];
+
+	std::vector<size_t>
+		aFill(m_aStart.begin(), m_aStart.end() - 1);
+
+	m_aAX.resize(m_aStart[intCells]);
+	m_aAY.resize(m_aStart[intCells]);
+	m_aBX.resize(m_aStart[intCells]);
+	m_aBY.resize(m_aStart[intCells]);
+
+	for (size_t r = 0; r < m_polygon.getRingCount(); r++)
+		for (size_t a = m_polygon.ringBegin(r), e = m_polygon.ringEnd(r); a < e; a++)
+		{
+			size_t
+				b = a + 1 < e ? a + 1 : m_polygon.ringBegin(r);
+
+			rasterize(m_aLinesX, m_aLinesY, m_dblLeft, m_dblBottom, m_dblCellWidth, m_dblCellHeight,
+				v.x[a], v.y[a], v.x[b], v.y[b], [&](size_t col, size_t row) {
+					size_t
+						k = aFill[row * m_intCols + col]++;
+
+					m_aAX[k] = v.x[a];
+					m_aAY[k] = v.y[a];
+					m_aBX[k] = v.x[b];
+					m_aBY[k] = v.y[b];
+				});
+		}
+
+	// Winding numbers of the corners, row by row from the right, where they are 0: between two corners
+	// of a row they change by the crossings of the edges of the cell above the pair.
+	m_aBase.assign(intCells, 0);
+
+	std::atomic<bool>
+		blnClean(true);
+
+	parallelFor(0, m_intRows, 16, [&](size_t first, size_t last) {
+		for (size_t row = first; row < last; row++)
+		{
+			double
+				y = m_aLinesY[row];
+			int
+				intRight = 0;
+
+			for (size_t col = m_intCols; col-- > 0; )
+			{
+				size_t
+					c = row * m_intCols + col;
+				double
+					xl = m_aLinesX[col],
+					xr = m_aLinesX[col + 1];
+				int
+					intCorner = intRight,
+					intRay = 0;
+				bool
+					blnOnEdge = false;
+
+				for (size_t k = m_aStart[c]; k < m_aStart[c + 1]; k++)
+				{
+					bool
+						blnBelowA = m_aAY[k] <= y,
+						blnBelowB = m_aBY[k] <= y,
+						blnRightA = m_aAX[k] >= xl,
+						blnRightB = m_aBX[k] >= xl;
+					double
+						o = orient2d(m_aAX[k], m_aAY[k], m_aBX[k], m_aBY[k], xl, y);
+
+					if (o == 0 && std::min(m_aAX[k], m_aBX[k]) <= xl && xl <= std::max(m_aAX[k], m_aBX[k]) &&
+						std::min(m_aAY[k], m_aBY[k]) <= y && y <= std::max(m_aAY[k], m_aBY[k]))
+						blnOnEdge = true;
+
+					if (blnBelowA != blnBelowB)
+						intCorner += crossing(blnBelowA, blnBelowB, o) -
+							crossing(blnBelowA, blnBelowB, orient2d(m_aAX[k], m_aAY[k], m_aBX[k], m_aBY[k], xr, y));
+
+					intRay += crossing(blnRightA, blnRightB, o);
+				}
+
+				intRight = intCorner;
+				m_aBase[c] = blnOnEdge ? SLOW_CELL : intCorner - intRay;
+
+				if (blnOnEdge)
+					blnClean = false;
+			}
+		}
+	});
+
+	return blnClean;
+}
+
+PointLocationEnum
+PreparedPolygon::locate(double x, double y) const
+{
+	// Also false for NaN.
+	if (!(x > m_dblLeft && x < m_dblRight && y > m_dblBottom && y < m_dblTop))
+		return plOutside;
+
+	size_t
+		intCol = cellOf(m_aLinesX, x, m_dblLeft, m_dblCellWidth),
+		c = cellOf(m_aLinesY, y, m_dblBottom, m_dblCellHeight) * m_intCols + intCol;
+
+	if (m_aBase[c] == SLOW_CELL)
+		return locateSlow(x, y);
+
+	size_t
+		s = m_aStart[c];
+	int
+		intFlags = 0,
+		w = m_aBase[c] + cellWindingKernel(m_aAX.data() + s, m_aAY.data() + s, m_aBX.data() + s, m_aBY.data() + s,
+			m_aStart[c + 1] - s, m_aLinesX[intCol], x, y, intFlags);
+
+	if (intFlags & wfPointOnEdge)
+		return plBoundary;
+
+	if (intFlags & wfLegOnEdge)
+		return locateAcross(c, x, y);
+
+	return w != 0 ? plInside : plOutside;
+}
+
+// The other path, across the bottom of the cell to (x, yb) and then up; (x, y) is not on an edge.
+PointLocationEnum
+PreparedPolygon::locateAcross(size_t cell, double x, double y) const
+{
+	double
+		xl = m_aLinesX[cell % m_intCols],
+		yb = m_aLinesY[cell / m_intCols];
+	int
+		w = m_aBase[cell];
+
+	for (size_t k = m_aStart[cell]; k < m_aStart[cell + 1]; k++)
+	{
+		double
+			ax = m_aAX[k],
+			ay = m_aAY[k],
+			bx = m_aBX[k],
+			by = m_aBY[k];
+		bool
+			blnBelowA = ay <= yb,
+			blnBelowB = by <= yb,
+			blnRightA = ax >= x,
+			blnRightB = bx >= x;
+
+		// The base holds the winding number of the corner less cv there.
+		if ((ax >= xl) != (bx >= xl))
+			w += crossing(ax >= xl, bx >= xl, orient2d(ax, ay, bx, by, xl, yb));
+
+		// cr(x, yb) - cr(xl, yb) + cv(x, y) - cv(x, yb).
+		if (blnBelowA != blnBelowB || blnRightA != blnRightB ||
+			(std::min(ay, by) <= yb && yb <= std::max(ay, by) && std::min(ax, bx) <= x && x <= std::max(ax, bx)))
+		{
+			double
+				o = orient2d(ax, ay, bx, by, x, yb);
+
+			if (o == 0 && std::min(ay, by) <= yb && yb <= std::max(ay, by) && std::min(ax, bx) <= x &&
+				x <= std::max(ax, bx))
+				return locateSlow(x, y);
+
+			w += crossing(blnBelowA, blnBelowB, o) - crossing(blnRightA, blnRightB, o);
+		}
+
+		if (blnBelowA != blnBelowB)
+			w -= crossing(blnBelowA, blnBelowB, orient2d(ax, ay, bx, by, xl, yb));
+
+		if (blnRightA != blnRightB)
+			w += crossing(blnRightA, blnRightB, orient2d(ax, ay, bx, by, x, y));
+	}
+
+	return w != 0 ? plInside : plOutside;
+}
+
+// The crossings of the ray from (x, y) towards +X with every edge.
+PointLocationEnum
+PreparedPolygon::locateSlow(double x, double y) const
+{
+	const PointBuffer
+		&v = m_polygon.vertices;
+	int
+		w = 0;
+
+	for (size_t r = 0; r < m_polygon.getRingCount(); r++)
+		for (size_t a = m_polygon.ringBegin(r), e = m_polygon.ringEnd(r); a < e; a++)
+		{
+			size_t
+				b = a + 1 < e ? a + 1 : m_polygon.ringBegin(r);
+			bool
+				blnBelowA = v.y[a] <= y,
+				blnBelowB = v.y[b] <= y,
+				blnInBox = std::min(v.y[a], v.y[b]) <= y && y <= std::max(v.y[a], v.y[b]) &&
+					std::min(v.x[a], v.x[b]) <= x && x <= std::max(v.x[a], v.x[b]);
+
+			if (blnBelowA == blnBelowB && !blnInBox)
+				continue;
+
+			double
+				o = orient2d(v.x[a], v.y[a], v.x[b], v.y[b], x, y);
+
+			if (o == 0 && blnInBox)
+				return plBoundary;
+
+			w += crossing(blnBelowA, blnBelowB, o);
+		}
+
+	return w != 0 ? plInside : plOutside;
+}
+
+/*
+ * Batch queries.
+ */
+
+void
+PreparedPolygon::locateBatch(const PointBuffer &pnts, std::vector<PointLocationEnum> &res) const
+{
+	res.resize(pnts.size());
+
+	parallelFor(0, pnts.size(), LOCATE_GRAIN, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			res[i] = locate(pnts.x[i], pnts.y[i]);
+	});
+}
+
+void
+PreparedPolygon::locateBatch(const std::vector<Point2D> &pnts, std::vector<PointLocationEnum> &res) const
+{
+	res.resize(pnts.size());
+
+	parallelFor(0, pnts.size(), LOCATE_GRAIN, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			res[i] = locate(pnts[i].x, pnts[i].y);
+	});
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,165 @@
+/***
+ * CivilPreparedPolygon.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_PREPARED_POLYGON
+#define __CIVIL_PREPARED_POLYGON
+
+#include <vector>
+
+#include "..\UtilsLibrary\CivilDispatch.h"
+#include "..\MathLibrary\CivilPolygon2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	enum PointLocationEnum
+	{
+		plOutside,
+		plInside,
+		// On an edge or a vertex of any ring.
+		plBoundary
+	};
+
+	// PreparedPolygon;
+	//
+	// Point in polygon queries against a Polygon2D whose edges are indexed once in a regular grid. Every
+	// ---- cell lists the edges that touch it and keeps the winding number of its bottom left corner, so a
+	//      point is classified from its own cell alone: the winding number changes from the corner to the
+	//      point only where the path up the left side of the cell and then across to the point crosses one
+	//      of the cell's edges. Points in cells without edges cost a lookup; on average, for points spread
+	//      over the polygon, a query looks at a few edges whatever the size of the polygon.
+	//
+	//      The rule is the nonzero winding number, which with the orientations of Polygon2D means the solids
+	//      less their holes. All the decisions are signs of orient2d, so points on an edge are always found
+	//      and collinear or repeated vertices need no tolerance.
+	//
+	//      The object keeps a reference to the polygon, which must not change while it is in use. Queries
+	//      may be made from any number of threads.
+	struct PreparedPolygon
+	{
+	public:
+
+		// "cellsPerEdge" sets the size of the grid, at most MAX_CELLS cells.
+		PreparedPolygon(const Polygon2D &polygon, double cellsPerEdge = 2);
+
+		static const size_t
+			MAX_CELLS = 1 << 24;
+
+	private:
+
+		const Polygon2D
+			&m_polygon;
+		double
+			m_dblLeft,
+			m_dblBottom,
+			m_dblRight,
+			m_dblTop,
+			m_dblCellWidth,
+			m_dblCellHeight;
+		size_t
+			m_intCols,
+			m_intRows;
+		// Coordinates of the grid lines, m_intCols + 1 and m_intRows + 1; the predicates see these values.
+		std::vector<double>
+			m_aLinesX,
+			m_aLinesY;
+		// The edges a -> b touching cell c are [m_aStart[c], m_aStart[c + 1]) of the four columns.
+		std::vector<size_t>
+			m_aStart;
+		std::vector<double>
+			m_aAX,
+			m_aAY,
+			m_aBX,
+			m_aBY;
+		// Winding number of the corner of each cell less the crossings of the edges of the cell with the
+		// vertical ray from the corner (see cellWindingKernel), or SLOW_CELL.
+		std::vector<int>
+			m_aBase;
+
+		bool build(double cellsPerEdge, int attempt);
+		PointLocationEnum locateAcross(size_t cell, double x, double y) const;
+		PointLocationEnum locateSlow(double x, double y) const;
+
+	public:
+
+		// locate;
+		//
+		// Whether (x, y) is inside, outside or on the boundary of the polygon.
+		// ----
+		PointLocationEnum locate(double x, double y) const;
+		PointLocationEnum locate(const Point2D &pnt) const
+		{
+			return locate(pnt.x, pnt.y);
+		}
+
+		// contains;
+		//
+		// True inside and on the boundary.
+		// ----
+		bool contains(const Point2D &pnt) const
+		{
+			return locate(pnt.x, pnt.y) != plOutside;
+		}
+
+		// locateBatch;
+		//
+		// One result per point, the points split in pieces that run on the shared pool.
+		// ----
+		void locateBatch(const PointBuffer &pnts, std::vector<PointLocationEnum> &res) const;
+		void locateBatch(const std::vector<Point2D> &pnts, std::vector<PointLocationEnum> &res) const;
+
+	}; /* PreparedPolygon */
+
+	enum WindingFlagEnum
+	{
+		wfPointOnEdge = 1,
+		wfLegOnEdge = 2
+	};
+
+	// cellWindingKernel;
+	//
+	// The part of the change of the winding number along the path from a cell corner (xl, yb) up to (xl, y)
+	// ---- and across to (x, y) that depends on the point, over the edges (ax, ay) -> (bx, by) of the cell.
+	//      With cr(p) the signed crossing of an edge with the ray from p towards +X and cv(p) that with the ray
+	//      towards +Y (+1 when the edge passes from right to left of the ray, half open at the end points), it
+	//      returns the sum of
+	//
+	//        cv(xl, y) - cr(xl, y) + cr(x, y)
+	//
+	//      Each one adds up to the winding number over all the edges, and the differences between two points
+	//      on the same line come from the edges between them. "flags" gets wfPointOnEdge when (x, y) lies on
+	//      an edge and wfLegOnEdge when (xl, y) does, in which case the sum is meaningless. The orientations
+	//      are filtered as in orient2d and only the uncertain ones are computed exactly.
+	typedef int (*CellWindingKernel)(const double *ax, const double *ay, const double *bx, const double *by, size_t count,
+		double xl, double x, double y, int &flags);
+
+	extern Dispatch<CellWindingKernel>
+		cellWindingKernel;
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_PREPARED_POLYGON
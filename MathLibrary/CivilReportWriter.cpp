@@ -0,0 +1,134 @@
+/***
+ * CivilReportWriter.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "CivilReportWriter.h"
+
+#include <charconv>
+#include <string.h>
+
+namespace CIVIL::MATH::GA2D
+{
+
+/*
+ * ReportWriter.
+ */
+
+// Room asked for a field; fixed notation of huge values may need more, and then the field is formatted
+// again into a block large enough for any double. Many decimals may need even more: the block is doubled
+// until the field fits, up to FIELD_SIZE_LIMIT.
+static const size_t
+	FIELD_SIZE = 64,
+	FIELD_SIZE_MAX = 400,
+	FIELD_SIZE_LIMIT = 1 << 20;
+
+template <typename FnType> static inline void
+putField(BufferedWriter &writer, const FnType &fn)
+{
+	size_t
+		size = FIELD_SIZE;
+	char
+		*p = writer.reserve(size),
+		*end = fn(p, p + size);
+
+	while (!end)
+	{
+		if (size >= FIELD_SIZE_LIMIT)
+			RAISE(EReportWriter, rweFieldTooLong);
+
+		size = size < FIELD_SIZE_MAX ? FIELD_SIZE_MAX : size * 2;
+		p = writer.reserve(size);
+		end = fn(p, p + size);
+	}
+
+	writer.commit(end);
+}
+
+static inline char *
+toFixed(char *first, char *last, double value, int decimals)
+{
+	std::to_chars_result
+		res = std::to_chars(first, last, value, std::chars_format::fixed, decimals);
+
+	return res.ec == std::errc() ? res.ptr : nullptr;
+}
+
+ReportWriter::ReportWriter(int fd, char separator, size_t capacity) :
+	m_writer(fd, capacity),
+	m_chrSeparator(separator)
+{}
+
+void
+ReportWriter::addText(const char *text, size_t size)
+{
+	separate();
+	m_writer.write(text, size);
+}
+
+void
+ReportWriter::addNumber(double value, int decimals)
+{
+	separate();
+	putField(m_writer, [&](char *first, char *last) { return toFixed(first, last, value, decimals); });
+}
+
+void
+ReportWriter::addPoint(const Point2D &pnt)
+{
+	addNumber(pnt.x, coordDecimals);
+	addNumber(pnt.y, coordDecimals);
+}
+
+void
+ReportWriter::addAngle(const Angle &ang, AngleUnitEnum unit)
+{
+	separate();
+	putField(m_writer, [&](char *first, char *last) { return formatAngle(first, last, ang, unit, angleDecimals); });
+}
+
+void
+ReportWriter::endRecord()
+{
+	m_writer.put('\n');
+	m_blnFirstField = true;
+}
+
+void
+ReportWriter::addRecords(const PointBuffer &pnts, const std::vector<double> &angles, AngleUnitEnum unit)
+{
+	bool
+		blnAngles = !angles.empty();
+
+	for (size_t i = 0; i < pnts.size(); i++)
+	{
+		addNumber(pnts.x[i], coordDecimals);
+		addNumber(pnts.y[i], coordDecimals);
+
+		if (blnAngles && i < angles.size())
+			addAngle(Angle(angles[i]), unit);
+
+		endRecord();
+	}
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,103 @@
+/***
+ * CivilReportWriter.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_REPORT_WRITER
+#define __CIVIL_REPORT_WRITER
+
+#include <vector>
+
+#include "..\UtilsLibrary\CivilBufferedWriter.h"
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilAngleIO.h"
+#include "..\MathLibrary\CivilBuffer2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(rweFieldTooLong);
+
+	BEGIN_DECLARE_ERROR(EReportWriter)
+		DECLARE_ERROR(rweFieldTooLong, "A field needs more than 1 MiB")
+	END_DECLARE_ERROR;
+
+	// ReportWriter;
+	//
+	// Streams delimited text records (stakeout lists, bearing tables) to a file descriptor. Every field is
+	// ---- formatted straight into the buffer of a BufferedWriter, so no string is built per value.
+	struct ReportWriter
+	{
+	public:
+
+		ReportWriter(int fd, char separator = ';', size_t capacity = BufferedWriter::DEFAULT_CAPACITY);
+
+	private:
+
+		BufferedWriter
+			m_writer;
+		char
+			m_chrSeparator;
+		bool
+			m_blnFirstField = true;
+
+		void separate()
+		{
+			if (!m_blnFirstField)
+				m_writer.put(m_chrSeparator);
+
+			m_blnFirstField = false;
+		}
+
+	public:
+
+		int
+			coordDecimals = 3,
+			angleDecimals = 0;
+
+		// Fields are written whatever their length; one needing more than 1 MiB (a number with a million
+		// decimals) raises EReportWriter.
+		void addText(const char *text, size_t size);
+		void addNumber(double value, int decimals);
+		void addPoint(const Point2D &pnt);
+		void addAngle(const Angle &ang, AngleUnitEnum unit);
+		void endRecord();
+
+		// addRecords;
+		//
+		// One record per point: x, y and, when "angles" is not empty, angles[i] (radians) in the given unit.
+		// ----
+		void addRecords(const PointBuffer &pnts, const std::vector<double> &angles, AngleUnitEnum unit);
+
+		void flush()
+		{
+			m_writer.flush();
+		}
+
+	}; /* ReportWriter */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_REPORT_WRITER
@@ -0,0 +1,101 @@
+#include "CivilRotationCache.h"
+
+#include <string.h>
+
+namespace CIVIL::MATH::GA2D
+{
+
+/*
+ * RotationCache.
+ */
+
+size_t
+RotationCache::PivotHash::operator()(const PivotKey &key) const
+{
+	std::hash<unsigned long long>
+		hash;
+	size_t
+		intHash = hash(key.angle);
+
+	intHash ^= hash(key.x) + 0x9E3779B97F4A7C15ull + (intHash << 6) + (intHash >> 2);
+	intHash ^= hash(key.y) + 0x9E3779B97F4A7C15ull + (intHash << 6) + (intHash >> 2);
+
+	return intHash;
+}
+
+unsigned long long
+RotationCache::keyOf(double value)
+{
+	unsigned long long
+		intKey;
+
+	// Adding 0 turns -0 into +0, so both hit the same entry.
+	value += 0.0;
+	memcpy(&intKey, &value, sizeof(intKey));
+
+	return intKey;
+}
+
+const RotationCache::SinCos &
+RotationCache::find(double ang)
+{
+	unsigned long long
+		intKey = keyOf(ang);
+	auto
+		it = m_mapSinCos.find(intKey);
+
+	if (it != m_mapSinCos.end())
+		return it->second;
+
+	if (m_mapSinCos.size() >= m_intCapacity)
+		m_mapSinCos.clear();
+
+	return m_mapSinCos.emplace(intKey, SinCos{ sin(ang), cos(ang) }).first->second;
+}
+
+void
+RotationCache::sinCos(const Angle &ang, double &sinAng, double &cosAng)
+{
+	const SinCos
+		&sc = find((double) ang);
+
+	sinAng = sc.sin;
+	cosAng = sc.cos;
+}
+
+Matrix2D
+RotationCache::rotation(const Angle &ang)
+{
+	const SinCos
+		&sc = find((double) ang);
+
+	return Matrix2D::rotation(sc.sin, sc.cos);
+}
+
+Matrix2D
+RotationCache::rotation(const Angle &ang, double xRef, double yRef)
+{
+	double
+		dblAng = (double) ang;
+	PivotKey
+		key{ keyOf(dblAng), keyOf(xRef), keyOf(yRef) };
+	auto
+		it = m_mapRotations.find(key);
+
+	if (it != m_mapRotations.end())
+		return it->second;
+
+	const SinCos
+		&sc = find(dblAng);
+	Matrix2D
+		mat = Matrix2D::rotation(sc.sin, sc.cos, xRef, yRef);
+
+	if (m_mapRotations.size() >= m_intCapacity)
+		m_mapRotations.clear();
+
+	m_mapRotations.emplace(key, mat);
+
+	return mat;
+}
+
+} // namespace CIVIL::MATH::GA2D
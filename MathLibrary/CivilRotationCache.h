@@ -0,0 +1,119 @@
+/***
+ * CivilRotationCache.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_ROTATION_CACHE
+#define __CIVIL_ROTATION_CACHE
+
+#include <unordered_map>
+
+#include "..\MathLibrary\CivilGA2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// RotationCache;
+	//
+	// Remembers the sine and cosine of the angles already seen and the rotation matrices already composed
+	// ---- about a reference point, for code that rotates many objects by a few repeated angles. Angles are
+	//      matched by their exact value (0 and -0 are the same angle). When "capacity" entries are reached
+	//      the cache is emptied and starts over.
+	//
+	//      The cache is not synchronized: use one per thread.
+	struct RotationCache
+	{
+	public:
+
+		static const size_t
+			DEFAULT_CAPACITY = 4096;
+
+		RotationCache(size_t capacity = DEFAULT_CAPACITY) :
+			m_intCapacity(capacity > 0 ? capacity : DEFAULT_CAPACITY)
+		{}
+
+	private:
+
+		struct SinCos
+		{
+			double
+				sin,
+				cos;
+		};
+
+		struct PivotKey
+		{
+			unsigned long long
+				angle,
+				x,
+				y;
+
+			bool operator==(const PivotKey &key) const
+			{
+				return angle == key.angle && x == key.x && y == key.y;
+			}
+		};
+
+		struct PivotHash
+		{
+			size_t operator()(const PivotKey &key) const;
+		};
+
+		size_t
+			m_intCapacity;
+		std::unordered_map<unsigned long long, SinCos>
+			m_mapSinCos;
+		std::unordered_map<PivotKey, Matrix2D, PivotHash>
+			m_mapRotations;
+
+		static unsigned long long keyOf(double value);
+		const SinCos &find(double ang);
+
+	public:
+
+		void sinCos(const Angle &ang, double &sinAng, double &cosAng);
+
+		// rotation;
+		//
+		// Same as Matrix2D::rotation, served from the cache.
+		// ----
+		Matrix2D rotation(const Angle &ang);
+		Matrix2D rotation(const Angle &ang, double xRef, double yRef);
+
+		size_t size() const
+		{
+			return m_mapSinCos.size() + m_mapRotations.size();
+		}
+		void clear()
+		{
+			m_mapSinCos.clear();
+			m_mapRotations.clear();
+		}
+
+	}; /* RotationCache */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_ROTATION_CACHE
@@ -0,0 +1,791 @@
+#include "CivilSimplify.h"
+
+#include <math.h>
+#include <algorithm>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "..\MathLibrary\CivilPredicates.h"
+
+#if CIVIL_X86
+#include <immintrin.h>
+#endif // if CIVIL_X86
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+// Vertices per piece of the parallel search of a long span.
+static const size_t
+	SPAN_GRAIN = 1 << 16;
+
+// Average number of search cells a segment may be registered in before the grid is made coarser.
+static const size_t
+	CELLS_PER_SEGMENT = 8;
+
+/*
+ * Kernels.
+ */
+
+static size_t
+farthestScalar(const Point2D *pnts, size_t count, double ox, double oy, double dx, double dy, double &cross)
+{
+	size_t
+		intBest = 0;
+	double
+		dblBest = -1;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			c = fabs((pnts[i].x - ox) * dy - (pnts[i].y - oy) * dx);
+
+		if (c > dblBest)
+		{
+			dblBest = c;
+			intBest = i;
+		}
+	}
+
+	cross = dblBest;
+
+	return intBest;
+}
+
+#if CIVIL_X86
+
+// Two points per register, as they lie in memory: (x0, y0, x1, y1) times (dy, dx, dy, dx), then the
+// horizontal differences of two such products give the cross products of points 0, 2, 1 and 3.
+CIVIL_TARGET("avx2,fma") static size_t
+farthestAVX2(const Point2D *pnts, size_t count, double ox, double oy, double dx, double dy, double &cross)
+{
+	const double
+		*p = &pnts->x;
+	__m256d
+		origin = _mm256_setr_pd(ox, oy, ox, oy),
+		dir = _mm256_setr_pd(dy, dx, dy, dx),
+		signMask = _mm256_set1_pd(-0.0),
+		best = _mm256_set1_pd(-1),
+		bestIndex = _mm256_setzero_pd(),
+		index = _mm256_setr_pd(0, 2, 1, 3),
+		step = _mm256_set1_pd(4);
+	size_t
+		i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d
+			m01 = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(p + 2 * i), origin), dir),
+			m23 = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(p + 2 * i + 4), origin), dir),
+			c = _mm256_andnot_pd(signMask, _mm256_hsub_pd(m01, m23)),
+			greater = _mm256_cmp_pd(c, best, _CMP_GT_OQ);
+
+		best = _mm256_blendv_pd(best, c, greater);
+		bestIndex = _mm256_blendv_pd(bestIndex, index, greater);
+		index = _mm256_add_pd(index, step);
+	}
+
+	double
+		aBest[4],
+		aIndex[4],
+		dblBest = -1;
+	size_t
+		intBest = 0;
+
+	_mm256_storeu_pd(aBest, best);
+	_mm256_storeu_pd(aIndex, bestIndex);
+
+	// Each lane kept its first maximum; among the lanes the lowest index wins a tie.
+	for (int k = 0; k < 4; k++)
+		if (aBest[k] > dblBest || (aBest[k] == dblBest && (size_t) aIndex[k] < intBest))
+		{
+			dblBest = aBest[k];
+			intBest = (size_t) aIndex[k];
+		}
+
+	if (i < count)
+	{
+		double
+			dblTail;
+		size_t
+			intTail = i + farthestScalar(pnts + i, count - i, ox, oy, dx, dy, dblTail);
+
+		if (dblTail > dblBest)
+		{
+			dblBest = dblTail;
+			intBest = intTail;
+		}
+	}
+
+	cross = dblBest;
+
+	return intBest;
+}
+
+Dispatch<FarthestKernel>
+	farthestKernel(farthestScalar, nullptr, farthestAVX2);
+
+#else
+
+Dispatch<FarthestKernel>
+	farthestKernel(farthestScalar);
+
+#endif // if CIVIL_X86
+
+/*
+ * Spans.
+ */
+
+struct Farthest
+{
+public:
+
+	size_t
+		index;
+	// Squared distance, times the squared length of the chord when there is one.
+	double
+		dist2;
+
+}; /* Farthest */
+
+// Farthest vertex of (first, last) from the chord pnts[first] - pnts[last], index "count" standing for
+// vertex 0 (the end of a closed line); from pnts[first] itself when the chord has no length.
+static Farthest
+farthestInSpan(const Point2D *pnts, size_t count, size_t first, size_t last, bool parallel, double &len2)
+{
+	const Point2D
+		&a = pnts[first],
+		&b = pnts[last == count ? 0 : last];
+	double
+		dx = b.x - a.x,
+		dy = b.y - a.y;
+	Farthest
+		res{first + 1, -1};
+
+	len2 = dx * dx + dy * dy;
+
+	if (!(len2 > 0))
+	{
+		for (size_t i = first + 1; i < last; i++)
+		{
+			double
+				d2 = (pnts[i].x - a.x) * (pnts[i].x - a.x) + (pnts[i].y - a.y) * (pnts[i].y - a.y);
+
+			if (d2 > res.dist2)
+				res = Farthest{i, d2};
+		}
+
+		return res;
+	}
+
+	auto map = [&](size_t i1, size_t i2) {
+		double
+			c;
+		size_t
+			i = i1 + farthestKernel(pnts + i1, i2 - i1, a.x, a.y, dx, dy, c);
+
+		return Farthest{i, c * c};
+	};
+
+	if (!parallel || last - first < 2 * SPAN_GRAIN)
+		return map(first + 1, last);
+
+	return parallelReduce(first + 1, last, SPAN_GRAIN, res, map, [](const Farthest &f1, const Farthest &f2) {
+		return f2.dist2 > f1.dist2 ? f2 : f1;
+	});
+}
+
+/*
+ * Methods.
+ */
+
+static void
+douglasPeucker(const Point2D *pnts, size_t count, bool closed, double tolerance, bool parallel, std::vector<char> &kept)
+{
+	std::vector<std::pair<size_t, size_t>>
+		aStack;
+	double
+		dblTol2 = tolerance * tolerance,
+		len2;
+
+	if (closed)
+	{
+		// The vertex farthest from the first one splits the ring in two open spans.
+		Farthest
+			f = farthestInSpan(pnts, count, 0, count, parallel, len2);
+
+		kept[f.index] = 1;
+		aStack.push_back(std::make_pair(f.index, count));
+		aStack.push_back(std::make_pair((size_t) 0, f.index));
+	}
+	else
+	{
+		kept[count - 1] = 1;
+		aStack.push_back(std::make_pair((size_t) 0, count - 1));
+	}
+
+	kept[0] = 1;
+
+	while (!aStack.empty())
+	{
+		std::pair<size_t, size_t>
+			span = aStack.back();
+
+		aStack.pop_back();
+
+		if (span.second - span.first < 2)
+			continue;
+
+		Farthest
+			f = farthestInSpan(pnts, count, span.first, span.second, parallel, len2);
+
+		if (f.dist2 > dblTol2 * (len2 > 0 ? len2 : 1))
+		{
+			kept[f.index] = 1;
+			aStack.push_back(std::make_pair(f.index, span.second));
+			aStack.push_back(std::make_pair(span.first, f.index));
+		}
+	}
+
+	if (closed && std::count(kept.begin(), kept.end(), 1) < 3)
+	{
+		// A ring flatter than the tolerance keeps its widest third vertex.
+		size_t
+			intSecond = std::find(kept.begin() + 1, kept.end(), 1) - kept.begin();
+		double
+			len2b;
+		Farthest
+			f1 = farthestInSpan(pnts, count, 0, intSecond, false, len2),
+			f2 = farthestInSpan(pnts, count, intSecond, count, false, len2b);
+
+		kept[f2.dist2 > f1.dist2 && count - intSecond > 1 ? f2.index : f1.index] = 1;
+	}
+}
+
+// Min-heap of vertices keyed by their area (the lower index first on ties) that knows where each vertex is,
+// so a key changes in place. Four children per node and the keys stored with the entries keep the sifts of
+// heaps of millions of vertices within few cache lines.
+struct AreaHeap
+{
+public:
+
+	AreaHeap(size_t count) :
+		m_aPositions(count, NONE)
+	{}
+
+	static constexpr size_t
+		NONE = SIZE_MAX;
+
+private:
+
+	struct Entry
+	{
+	public:
+
+		double
+			area;
+		size_t
+			index;
+
+		bool operator<(const Entry &entry) const
+		{
+			return area < entry.area || (area == entry.area && index < entry.index);
+		}
+
+	}; /* Entry */
+
+	std::vector<Entry>
+		m_aHeap;
+	std::vector<size_t>
+		m_aPositions;
+
+	void place(size_t pos, const Entry &entry)
+	{
+		m_aHeap[pos] = entry;
+		m_aPositions[entry.index] = pos;
+	}
+	void siftUp(size_t pos)
+	{
+		Entry
+			entry = m_aHeap[pos];
+
+		for (; pos > 0 && entry < m_aHeap[(pos - 1) / 4]; pos = (pos - 1) / 4)
+			place(pos, m_aHeap[(pos - 1) / 4]);
+
+		place(pos, entry);
+	}
+	void siftDown(size_t pos)
+	{
+		Entry
+			entry = m_aHeap[pos];
+		size_t
+			n = m_aHeap.size();
+
+		for (;;)
+		{
+			size_t
+				c = 4 * pos + 1,
+				intBest = c;
+
+			if (c >= n)
+				break;
+
+			for (size_t k = c + 1; k < std::min(c + 4, n); k++)
+				if (m_aHeap[k] < m_aHeap[intBest])
+					intBest = k;
+
+			if (!(m_aHeap[intBest] < entry))
+				break;
+
+			place(pos, m_aHeap[intBest]);
+			pos = intBest;
+		}
+
+		place(pos, entry);
+	}
+
+public:
+
+	bool empty() const
+	{
+		return m_aHeap.empty();
+	}
+	size_t top() const
+	{
+		return m_aHeap[0].index;
+	}
+	bool contains(size_t i) const
+	{
+		return m_aPositions[i] != NONE;
+	}
+
+	// Vertices are added with push() and then heapified once with build().
+	void push(size_t i, double area)
+	{
+		m_aPositions[i] = m_aHeap.size();
+		m_aHeap.push_back(Entry{area, i});
+	}
+	void build()
+	{
+		for (size_t pos = m_aHeap.size() / 4 + 1; pos-- > 0;)
+			if (pos < m_aHeap.size())
+				siftDown(pos);
+	}
+	void pop()
+	{
+		m_aPositions[m_aHeap[0].index] = NONE;
+		m_aHeap[0] = m_aHeap.back();
+		m_aHeap.pop_back();
+
+		if (!m_aHeap.empty())
+			siftDown(0);
+	}
+	// Sets the key of i, adding it when it is not in the heap.
+	void update(size_t i, double area)
+	{
+		if (!contains(i))
+		{
+			push(i, area);
+			siftUp(m_aHeap.size() - 1);
+			return;
+		}
+
+		size_t
+			pos = m_aPositions[i];
+
+		m_aHeap[pos].area = area;
+		siftUp(pos);
+		siftDown(m_aPositions[i]);
+	}
+
+}; /* AreaHeap */
+
+static void
+visvalingam(const Point2D *pnts, size_t count, bool closed, double tolerance, std::vector<char> &kept)
+{
+	std::vector<size_t>
+		aPrev(count),
+		aNext(count);
+	std::vector<double>
+		aArea(count, INFINITY);
+	AreaHeap
+		heap(count);
+	size_t
+		intLeft = count;
+	// Doubled areas, as orient2d gives them.
+	double
+		dblLimit = 2 * tolerance;
+	auto area = [&](size_t i) {
+		return fabs(orient2d(pnts[aPrev[i]], pnts[i], pnts[aNext[i]]));
+	};
+
+	for (size_t i = 0; i < count; i++)
+	{
+		aPrev[i] = i > 0 ? i - 1 : count - 1;
+		aNext[i] = i + 1 < count ? i + 1 : 0;
+	}
+
+	// The first vertex, and the last of an open line, are never candidates. Vertices at or above the limit
+	// only join the heap when their area drops below it.
+	for (size_t i = 1; i < (closed ? count : count - 1); i++)
+	{
+		aArea[i] = area(i);
+
+		if (aArea[i] < dblLimit)
+			heap.push(i, aArea[i]);
+	}
+
+	heap.build();
+
+	while (!heap.empty() && intLeft > (closed ? 3 : 2))
+	{
+		size_t
+			i = heap.top(),
+			p = aPrev[i],
+			n = aNext[i];
+		double
+			dblArea = aArea[i];
+
+		// A vertex already in the heap may have grown past the limit.
+		if (!(dblArea < dblLimit))
+			break;
+
+		heap.pop();
+		kept[i] = 0;
+		intLeft--;
+		aNext[p] = n;
+		aPrev[n] = p;
+
+		for (size_t j : {p, n})
+			if (aArea[j] != INFINITY)
+			{
+				aArea[j] = std::max(area(j), dblArea);
+
+				if (aArea[j] < dblLimit || heap.contains(j))
+					heap.update(j, aArea[j]);
+			}
+	}
+}
+
+/*
+ * Self-intersections.
+ */
+
+// Segments s and t of the simplified line, given by their vertices (index "count" standing for vertex 0),
+// conflict when they share a point; consecutive ones only when they fold back over each other.
+static bool
+conflict(const Point2D *pnts, size_t count, const std::vector<size_t> &aIdx, size_t s, size_t t, bool adjacent)
+{
+	auto at = [&](size_t k) -> const Point2D & {
+		return pnts[aIdx[k] == count ? 0 : aIdx[k]];
+	};
+
+	if (adjacent)
+	{
+		// t follows s, or the ring closes from s = k - 1 to t = 0: a - v - c.
+		const Point2D
+			&a = at(s),
+			&v = at(s + 1),
+			&c = at(t + 1);
+
+		return orient2d(a, v, c) == 0 && (a.x - v.x) * (c.x - v.x) + (a.y - v.y) * (c.y - v.y) > 0;
+	}
+
+	return segmentsIntersect(at(s), at(s + 1), at(t), at(t + 1));
+}
+
+// Flags the segments of the simplified line (aIdx, see conflict) that conflict with another one. The
+// segments are registered in a grid over the bounds of the line, with about as many cells as segments in
+// the proportion of the bounds, and each one is tested against those that share a cell with its box; a
+// grid coarser along one axis would make lines that run along the other one (a near-vertical zigzag in a
+// sweep in x) test every pair. The grid is halved while long segments crowd it, as in findSplits.
+static void
+flagConflicts(const Point2D *pnts, size_t count, bool closed, const std::vector<size_t> &aIdx, std::vector<char> &aFlag)
+{
+	size_t
+		k = aIdx.size() - 1;
+	std::vector<Rectangle2D>
+		aBoxes(k);
+	Rectangle2D
+		bounds(INFINITY, INFINITY, -INFINITY, -INFINITY);
+
+	aFlag.assign(k, 0);
+
+	for (size_t s = 0; s < k; s++)
+	{
+		const Point2D
+			&p1 = pnts[aIdx[s]],
+			&p2 = pnts[aIdx[s + 1] == count ? 0 : aIdx[s + 1]];
+
+		aBoxes[s] = Rectangle2D(std::min(p1.x, p2.x), std::min(p1.y, p2.y), std::max(p1.x, p2.x), std::max(p1.y, p2.y));
+		bounds = Rectangle2D(std::min(bounds.left, aBoxes[s].left), std::min(bounds.bottom, aBoxes[s].bottom),
+			std::max(bounds.right, aBoxes[s].right), std::max(bounds.top, aBoxes[s].top));
+	}
+
+	double
+		dblWidth = bounds.right - bounds.left,
+		dblHeight = bounds.top - bounds.bottom,
+		dblCells = (double) k;
+	size_t
+		intCols = 1,
+		intRows = 1;
+
+	// Infinite or NaN coordinates leave that axis in one cell.
+	if (!isfinite(dblWidth))
+		dblWidth = 0;
+	if (!isfinite(dblHeight))
+		dblHeight = 0;
+
+	if (dblWidth > 0 && dblHeight > 0)
+	{
+		intCols = (size_t) std::max(1.0, std::min(dblCells, round(sqrt(dblCells * dblWidth / dblHeight))));
+		intRows = (size_t) std::max(1.0, round(dblCells / intCols));
+	}
+	else if (dblWidth > 0)
+		intCols = (size_t) dblCells;
+	else if (dblHeight > 0)
+		intRows = (size_t) dblCells;
+
+	auto
+		colOf = [&](double x) {
+			return dblWidth > 0 ? std::min(intCols - 1, (size_t) std::max(0.0, (x - bounds.left) / dblWidth * intCols)) : 0;
+		};
+	auto
+		rowOf = [&](double y) {
+			return dblHeight > 0 ? std::min(intRows - 1, (size_t) std::max(0.0, (y - bounds.bottom) / dblHeight * intRows)) : 0;
+		};
+
+	for (;;)
+	{
+		size_t
+			intRegistered = 0;
+
+		for (const Rectangle2D &box : aBoxes)
+			intRegistered += (colOf(box.right) - colOf(box.left) + 1) * (rowOf(box.top) - rowOf(box.bottom) + 1);
+
+		if (intRegistered <= CELLS_PER_SEGMENT * k + intCols * intRows || intCols * intRows == 1)
+			break;
+
+		intCols = (intCols + 1) / 2;
+		intRows = (intRows + 1) / 2;
+	}
+
+	std::vector<size_t>
+		aStart(intCols * intRows + 1, 0),
+		aFill,
+		aCells;
+
+	// Counted, then placed.
+	for (int intPass = 0; intPass < 2; intPass++)
+	{
+		if (intPass == 1)
+		{
+			for (size_t c = 0; c + 1 < aStart.size(); c++)
+				aStart[c + 1] += aStart[c];
+
+			aFill.assign(aStart.begin(), aStart.end() - 1);
+			aCells.resize(aStart.back());
+		}
+
+		for (size_t s = 0; s < k; s++)
+			for (size_t r = rowOf(aBoxes[s].bottom); r <= rowOf(aBoxes[s].top); r++)
+				for (size_t c = colOf(aBoxes[s].left); c <= colOf(aBoxes[s].right); c++)
+					if (intPass == 0)
+						aStart[r * intCols + c + 1]++;
+					else
+						aCells[aFill[r * intCols + c]++] = s;
+	}
+
+	// Each pair is tested once, from its lower segment; the last one that tested each segment is kept so
+	// that a pair sharing several cells is not tested again.
+	std::vector<size_t>
+		aTested(k, SIZE_MAX);
+
+	for (size_t s = 0; s < k; s++)
+	{
+		const Rectangle2D
+			&box = aBoxes[s];
+
+		for (size_t r = rowOf(box.bottom); r <= rowOf(box.top); r++)
+			for (size_t c = colOf(box.left); c <= colOf(box.right); c++)
+				for (size_t i = aStart[r * intCols + c]; i < aStart[r * intCols + c + 1]; i++)
+				{
+					size_t
+						t = aCells[i];
+
+					if (t <= s || aTested[t] == s)
+						continue;
+
+					aTested[t] = s;
+
+					if (box.right < aBoxes[t].left || aBoxes[t].right < box.left || box.top < aBoxes[t].bottom ||
+						aBoxes[t].top < box.bottom)
+						continue;
+
+					size_t
+						s1 = s,
+						s2 = t;
+					bool
+						blnAdjacent = s2 == s1 + 1;
+
+					if (!blnAdjacent && closed && s1 == 0 && s2 == k - 1)
+					{
+						blnAdjacent = true;
+						std::swap(s1, s2);
+					}
+
+					if (conflict(pnts, count, aIdx, s1, s2, blnAdjacent))
+						aFlag[s] = aFlag[t] = 1;
+				}
+	}
+}
+
+// Puts back the farthest dropped vertex of every segment that meets another one, until none does (or
+// those that do have nothing left to put back, being segments of the input).
+static void
+repairIntersections(const Point2D *pnts, size_t count, bool closed, bool parallel, std::vector<char> &kept)
+{
+	std::vector<size_t>
+		aIdx;
+	std::vector<char>
+		aFlag;
+
+	for (;;)
+	{
+		aIdx.clear();
+
+		for (size_t i = 0; i < count; i++)
+			if (kept[i])
+				aIdx.push_back(i);
+
+		if (closed)
+			aIdx.push_back(count);
+
+		flagConflicts(pnts, count, closed, aIdx, aFlag);
+
+		bool
+			blnChanged = false;
+
+		for (size_t s = 0; s + 1 < aIdx.size(); s++)
+			if (aFlag[s] && aIdx[s + 1] - aIdx[s] > 1)
+			{
+				double
+					len2;
+
+				kept[farthestInSpan(pnts, count, aIdx[s], aIdx[s + 1], parallel, len2).index] = 1;
+				blnChanged = true;
+			}
+
+		if (!blnChanged)
+			break;
+	}
+}
+
+/*
+ * Entry points.
+ */
+
+void
+simplifyPolyline(const Point2D *pnts, size_t count, bool closed, const SimplifyOptions &options, std::vector<size_t> &kept)
+{
+	if (!(options.tolerance >= 0) || !isfinite(options.tolerance))
+		RAISE(ESimplify, siInvalidTolerance);
+
+	kept.clear();
+
+	if (count <= (closed ? 3u : 2u))
+	{
+		for (size_t i = 0; i < count; i++)
+			kept.push_back(i);
+
+		return;
+	}
+
+	std::vector<char>
+		aKept(count, options.method == siVisvalingam);
+
+	if (options.method == siVisvalingam)
+		visvalingam(pnts, count, closed, options.tolerance, aKept);
+	else
+		douglasPeucker(pnts, count, closed, options.tolerance, options.parallel, aKept);
+
+	if (options.avoidSelfIntersections)
+		repairIntersections(pnts, count, closed, options.parallel, aKept);
+
+	for (size_t i = 0; i < count; i++)
+		if (aKept[i])
+			kept.push_back(i);
+}
+
+std::vector<Point2D>
+simplifyPolyline(const std::vector<Point2D> &pnts, bool closed, const SimplifyOptions &options)
+{
+	std::vector<size_t>
+		aKept;
+	std::vector<Point2D>
+		res;
+
+	simplifyPolyline(pnts.data(), pnts.size(), closed, options, aKept);
+	res.reserve(aKept.size());
+
+	for (size_t i : aKept)
+		res.push_back(pnts[i]);
+
+	return res;
+}
+
+// Simplifies lines [0, count) in place, lineAt(i, closed) giving the points of line i.
+template <typename LineAt>
+static void
+simplifyMany(size_t count, const SimplifyOptions &options, const LineAt &lineAt)
+{
+	auto run = [&](size_t first, size_t last) {
+		std::vector<size_t>
+			aKept;
+
+		for (size_t l = first; l < last; l++)
+		{
+			bool
+				blnClosed;
+			std::vector<Point2D>
+				&aPoints = lineAt(l, blnClosed);
+
+			simplifyPolyline(aPoints.data(), aPoints.size(), blnClosed, options, aKept);
+
+			for (size_t k = 0; k < aKept.size(); k++)
+				aPoints[k] = aPoints[aKept[k]];
+
+			aPoints.resize(aKept.size());
+		}
+	};
+
+	if (options.parallel)
+		parallelFor(0, count, 1, run);
+	else
+		run(0, count);
+}
+
+void
+simplifyPolylines(std::vector<std::vector<Point2D>> &lines, const std::vector<char> &closed, const SimplifyOptions &options)
+{
+	if (!closed.empty() && closed.size() != lines.size())
+		RAISE(ESimplify, siSizeMismatch);
+
+	simplifyMany(lines.size(), options, [&](size_t l, bool &blnClosed) -> std::vector<Point2D> & {
+		blnClosed = !closed.empty() && closed[l];
+
+		return lines[l];
+	});
+}
+
+void
+simplifyPolylines(std::vector<ContourLine> &lines, const SimplifyOptions &options)
+{
+	simplifyMany(lines.size(), options, [&](size_t l, bool &blnClosed) -> std::vector<Point2D> & {
+		blnClosed = lines[l].closed;
+
+		return lines[l].points;
+	});
+}
+
+} // namespace CIVIL::MATH::GA2D
@@ -0,0 +1,114 @@
+/***
+ * CivilSimplify.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_SIMPLIFY
+#define __CIVIL_SIMPLIFY
+
+#include <vector>
+
+#include "..\UtilsLibrary\CivilDispatch.h"
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilContour.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(siInvalidTolerance);
+	DECLARE_ERROR_CODE(siSizeMismatch);
+
+	BEGIN_DECLARE_ERROR(ESimplify)
+		DECLARE_ERROR(siInvalidTolerance, "The tolerance must be finite and not negative")
+		DECLARE_ERROR(siSizeMismatch, "There must be one closed flag per polyline")
+	END_DECLARE_ERROR;
+
+	enum SimplifyMethodEnum
+	{
+		// Keeps the vertex farthest from the chord of a span while it is farther than the tolerance.
+		siDouglasPeucker,
+		// Drops the vertex that makes the smallest triangle with its neighbours while it is smaller than the
+		// tolerance; smoother results on noisy lines such as GPS tracks.
+		siVisvalingam
+	};
+
+	struct SimplifyOptions
+	{
+	public:
+
+		SimplifyMethodEnum
+			method = siDouglasPeucker;
+		// siDouglasPeucker: largest distance of a dropped vertex from the simplified line. siVisvalingam:
+		// smallest area of the triangle a vertex makes with its neighbours for it to stay.
+		double
+			tolerance = 0;
+		// Puts back vertices until no two segments of the simplified line cross or touch, other than
+		// consecutive ones at their common vertex. Crossings already in the input are left as they are.
+		bool
+			avoidSelfIntersections = false,
+			parallel = true;
+
+	}; /* SimplifyOptions */
+
+	// Polyline simplification.
+	//
+	// The end points of an open line and the first point of a closed one (which does not repeat it) are
+	// always kept, and a closed line keeps at least three points. Distances are compared squared and
+	// through the cross product with the chord, so the search of Douglas-Peucker costs two products per
+	// vertex (see farthestKernel), with no division or square root; its spans are kept on an explicit
+	// stack and the farthest vertex of long ones is searched in pieces on the shared pool. Visvalingam-
+	// Whyatt keeps the candidates in a heap and never lets the area of a vertex drop below that of the
+	// vertex removed before it, so the order of removal is consistent.
+
+	// simplifyPolyline;
+	//
+	// Indexes of the vertices kept, in increasing order.
+	// ----
+	void simplifyPolyline(const Point2D *pnts, size_t count, bool closed, const SimplifyOptions &options,
+		std::vector<size_t> &kept);
+	std::vector<Point2D> simplifyPolyline(const std::vector<Point2D> &pnts, bool closed,
+		const SimplifyOptions &options = SimplifyOptions());
+
+	// simplifyPolylines;
+	//
+	// Simplifies every line in place, the lines spread over the shared pool when "parallel". "closed" has
+	// ---- one flag per line, or is empty when all of them are open.
+	void simplifyPolylines(std::vector<std::vector<Point2D>> &lines, const std::vector<char> &closed,
+		const SimplifyOptions &options = SimplifyOptions());
+	void simplifyPolylines(std::vector<ContourLine> &lines, const SimplifyOptions &options = SimplifyOptions());
+
+	// farthestKernel;
+	//
+	// Index of the point of [pnts, pnts + count) farthest from the line through (ox, oy) with direction
+	// ---- (dx, dy), the first one on ties, and in "cross" its |(p - o) x d|, that is the distance times |d|.
+	typedef size_t (*FarthestKernel)(const Point2D *pnts, size_t count, double ox, double oy, double dx, double dy,
+		double &cross);
+
+	extern Dispatch<FarthestKernel>
+		farthestKernel;
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_SIMPLIFY
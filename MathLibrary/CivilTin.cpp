@@ -0,0 +1,1335 @@
+#include "CivilTin.h"
+#include "CivilPredicates.h"
+
+#include <stdint.h>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+// While building, the hull edges are closed by "ghost" triangles that share a vertex at infinity, so
+// that every half-edge has an opposite one and points outside the hull are inserted like the others.
+static const unsigned int
+	GHOST = Tin::NONE;
+
+// Fewest points per strip of the parallel build.
+static const size_t
+	TIN_STRIP = 1 << 18;
+
+/*
+ * Insertion order.
+ */
+
+static inline bool
+lessPoint(const double *x, const double *y, unsigned int a, unsigned int b)
+{
+	if (x[a] != x[b])
+		return x[a] < x[b];
+	if (y[a] != y[b])
+		return y[a] < y[b];
+	return a < b;
+}
+
+// Position of (x, y), 16 bits each, along the Hilbert curve that fills the square.
+static uint32_t
+hilbertIndex(uint32_t x, uint32_t y)
+{
+	uint32_t
+		d = 0;
+
+	for (uint32_t s = 1 << 15; s > 0; s >>= 1)
+	{
+		uint32_t
+			rx = (x & s) != 0,
+			ry = (y & s) != 0;
+
+		d += s * s * ((3 * rx) ^ ry);
+
+		if (ry == 0)
+		{
+			if (rx == 1)
+			{
+				x = 0xFFFF - x;
+				y = 0xFFFF - y;
+			}
+
+			std::swap(x, y);
+		}
+	}
+
+	return d;
+}
+
+static inline uint64_t
+mixBits(uint64_t v)
+{
+	v += 0x9E3779B97F4A7C15ull;
+	v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ull;
+	v = (v ^ (v >> 27)) * 0x94D049BB133111EBull;
+
+	return v ^ (v >> 31);
+}
+
+// Reorders "idx" for insertion (BRIO): each point goes to the last round with probability 1/2, to the
+// one before with 1/4 and so on, and the rounds are sorted along the Hilbert curve. The coin flips come
+// from a hash of the index, so the order is the same on every run.
+static void
+insertionOrder(const PointBuffer &pnts, std::vector<unsigned int> &idx)
+{
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+	size_t
+		n = idx.size();
+
+	if (n < 3)
+		return;
+
+	double
+		dblMinX = x[idx[0]],
+		dblMinY = y[idx[0]],
+		dblMaxX = dblMinX,
+		dblMaxY = dblMinY;
+
+	for (unsigned int i : idx)
+	{
+		dblMinX = std::min(dblMinX, x[i]);
+		dblMaxX = std::max(dblMaxX, x[i]);
+		dblMinY = std::min(dblMinY, y[i]);
+		dblMaxY = std::max(dblMaxY, y[i]);
+	}
+
+	double
+		dblScale = 65535.0 / std::max(std::max(dblMaxX - dblMinX, dblMaxY - dblMinY), 1e-300);
+	int
+		intRounds = 1;
+
+	while (intRounds < 32 && ((size_t) 1 << intRounds) < n)
+		intRounds++;
+
+	std::vector<std::pair<uint64_t, unsigned int>>
+		aKeys(n);
+
+	for (size_t k = 0; k < n; k++)
+	{
+		unsigned int
+			i = idx[k];
+		uint64_t
+			h = mixBits(i) | ((uint64_t) 1 << 63);
+		int
+			intZeros = 0;
+
+		while (!(h & 1) && intZeros < intRounds - 1)
+		{
+			h >>= 1;
+			intZeros++;
+		}
+
+		uint64_t
+			intRound = (uint64_t) (intRounds - 1 - intZeros);
+
+		aKeys[k].first = intRound << 32 | hilbertIndex((uint32_t) ((x[i] - dblMinX) * dblScale),
+			(uint32_t) ((y[i] - dblMinY) * dblScale));
+		aKeys[k].second = i;
+	}
+
+	std::sort(aKeys.begin(), aKeys.end());
+
+	for (size_t k = 0; k < n; k++)
+		idx[k] = aKeys[k].second;
+}
+
+/*
+ * TinMesh.
+ */
+
+// Triangulation under construction, closed by ghost triangles. The same layout as Tin: three vertexes per
+// triangle, counterclockwise, and the opposite of each half-edge.
+struct TinMesh
+{
+public:
+
+	enum LocateEnum
+	{
+		lInside,
+		lOnEdge,
+		lOnVertex,
+		lOutside
+	};
+
+	TinMesh(const PointBuffer &pnts) :
+		x(pnts.x.data()),
+		y(pnts.y.data())
+	{}
+
+	const double
+		*x,
+		*y;
+	std::vector<unsigned int>
+		tri,
+		adj;
+	// A real triangle next to the last insertion, where the next walk starts.
+	unsigned int
+		last = 0,
+		walkSeed = 0;
+	std::vector<unsigned int>
+		stack;
+
+	double orient(unsigned int a, unsigned int b, unsigned int c) const
+	{
+		return orient2d(x[a], y[a], x[b], y[b], x[c], y[c]);
+	}
+
+	bool isGhost(unsigned int t) const
+	{
+		return tri[3 * t] == GHOST || tri[3 * t + 1] == GHOST || tri[3 * t + 2] == GHOST;
+	}
+
+	// The half-edge of a ghost triangle between its two real vertexes.
+	unsigned int ghostEdge(unsigned int t) const
+	{
+		unsigned int
+			e = 3 * t;
+
+		while (tri[e] == GHOST || tri[Tin::nextEdge(e)] == GHOST)
+			e++;
+
+		return e;
+	}
+
+	void link(unsigned int a, unsigned int b)
+	{
+		adj[a] = b;
+		adj[b] = a;
+	}
+
+	unsigned int addTriangle(unsigned int a, unsigned int b, unsigned int c)
+	{
+		unsigned int
+			t = (unsigned int) (tri.size() / 3);
+
+		tri.push_back(a);
+		tri.push_back(b);
+		tri.push_back(c);
+		adj.resize(tri.size(), Tin::NONE);
+
+		return t;
+	}
+
+	void setTriangle(unsigned int t, unsigned int a, unsigned int b, unsigned int c)
+	{
+		tri[3 * t] = a;
+		tri[3 * t + 1] = b;
+		tri[3 * t + 2] = c;
+	}
+
+	bool triangulate(const std::vector<unsigned int> &order);
+	void insert(unsigned int p);
+	LocateEnum locate(unsigned int p, unsigned int &edge);
+	bool inConflict(unsigned int t, unsigned int p) const;
+	void flip(unsigned int e);
+	void legalize(unsigned int p);
+	void lawson();
+
+}; /* TinMesh */
+
+// Triangulates the points of "order", which has no duplicates, in that order. Returns false when they
+// are all collinear.
+bool
+TinMesh::triangulate(const std::vector<unsigned int> &order)
+{
+	size_t
+		n = order.size(),
+		intThird = 2;
+
+	tri.clear();
+	adj.clear();
+
+	if (n < 3)
+		return false;
+
+	while (intThird < n && orient(order[0], order[1], order[intThird]) == 0)
+		intThird++;
+
+	if (intThird == n)
+		return false;
+
+	tri.reserve(6 * n + 6);
+	adj.reserve(6 * n + 6);
+
+	unsigned int
+		a = order[0],
+		b = order[1],
+		c = order[intThird];
+
+	if (orient(a, b, c) < 0)
+		std::swap(a, b);
+
+	unsigned int
+		t = addTriangle(a, b, c),
+		g1 = addTriangle(b, a, GHOST),
+		g2 = addTriangle(c, b, GHOST),
+		g3 = addTriangle(a, c, GHOST);
+
+	link(3 * t, 3 * g1);
+	link(3 * t + 1, 3 * g2);
+	link(3 * t + 2, 3 * g3);
+	link(3 * g1 + 1, 3 * g3 + 2);
+	link(3 * g2 + 1, 3 * g1 + 2);
+	link(3 * g3 + 1, 3 * g2 + 2);
+
+	last = t;
+
+	for (size_t i = 2; i < n; i++)
+		if (i != intThird)
+			insert(order[i]);
+
+	return true;
+}
+
+// Visibility walk from the last triangle. The first edge tried changes from one triangle to the next,
+// which keeps the walk from cycling even where the mesh is not Delaunay.
+TinMesh::LocateEnum
+TinMesh::locate(unsigned int p, unsigned int &edge)
+{
+	unsigned int
+		t = last;
+
+	for (;;)
+	{
+		unsigned int
+			intStart = (walkSeed = walkSeed * 1103515245 + 12345) >> 16,
+			intZeros = 0;
+		bool
+			blnMoved = false;
+
+		for (unsigned int k = 0; k < 3; k++)
+		{
+			unsigned int
+				e = 3 * t + (intStart + k) % 3;
+			double
+				o = orient(tri[e], tri[Tin::nextEdge(e)], p);
+
+			if (o < 0)
+			{
+				unsigned int
+					f = adj[e];
+
+				t = f / 3;
+
+				if (isGhost(t))
+				{
+					edge = f;
+					return lOutside;
+				}
+
+				blnMoved = true;
+				break;
+			}
+
+			if (o == 0)
+			{
+				intZeros++;
+				edge = e;
+			}
+		}
+
+		if (!blnMoved)
+		{
+			if (intZeros == 0)
+			{
+				edge = 3 * t;
+				return lInside;
+			}
+
+			return intZeros == 1 ? lOnEdge : lOnVertex;
+		}
+	}
+}
+
+// Whether p is inside the circumcircle of triangle t; for a ghost triangle, whether p is strictly outside
+// its hull edge.
+bool
+TinMesh::inConflict(unsigned int t, unsigned int p) const
+{
+	if (isGhost(t))
+	{
+		unsigned int
+			e = ghostEdge(t);
+
+		return orient(tri[e], tri[Tin::nextEdge(e)], p) > 0;
+	}
+
+	unsigned int
+		a = tri[3 * t],
+		b = tri[3 * t + 1],
+		c = tri[3 * t + 2];
+
+	return incircle(x[a], y[a], x[b], y[b], x[c], y[c], x[p], y[p]) > 0;
+}
+
+// Flips the edge e, a -> b in triangle (a, b, c), opposite to (b, a, d): the triangles become (a, d, c)
+// and (d, b, c), in the same slots, so that c stays at position 2.
+void
+TinMesh::flip(unsigned int e)
+{
+	unsigned int
+		f = adj[e],
+		t = e / 3,
+		u = f / 3,
+		a = tri[e],
+		b = tri[Tin::nextEdge(e)],
+		c = tri[Tin::prevEdge(e)],
+		d = tri[Tin::prevEdge(f)],
+		x1 = adj[Tin::nextEdge(e)],
+		x2 = adj[Tin::prevEdge(e)],
+		y1 = adj[Tin::nextEdge(f)],
+		y2 = adj[Tin::prevEdge(f)];
+
+	setTriangle(t, a, d, c);
+	setTriangle(u, d, b, c);
+
+	link(3 * t, y1);
+	link(3 * t + 1, 3 * u + 2);
+	link(3 * t + 2, x2);
+	link(3 * u, y2);
+	link(3 * u + 1, x1);
+}
+
+// Restores the Delaunay property after the insertion of p: every half-edge on the stack is opposite to p,
+// which is at position 2 of its triangle.
+void
+TinMesh::legalize(unsigned int p)
+{
+	while (!stack.empty())
+	{
+		unsigned int
+			e = stack.back();
+
+		stack.pop_back();
+
+		unsigned int
+			f = adj[e];
+
+		if (inConflict(f / 3, p))
+		{
+			flip(e);
+
+			stack.push_back(e - e % 3);
+			stack.push_back(f - f % 3);
+		}
+	}
+}
+
+// Lawson's flips from the half-edges on the stack until every real edge is locally Delaunay.
+void
+TinMesh::lawson()
+{
+	while (!stack.empty())
+	{
+		unsigned int
+			e = stack.back();
+
+		stack.pop_back();
+
+		unsigned int
+			f = adj[e],
+			t = e / 3,
+			u = f / 3;
+
+		if (isGhost(t) || isGhost(u))
+			continue;
+
+		unsigned int
+			a = tri[e],
+			b = tri[Tin::nextEdge(e)],
+			c = tri[Tin::prevEdge(e)],
+			d = tri[Tin::prevEdge(f)];
+
+		if (incircle(x[a], y[a], x[b], y[b], x[c], y[c], x[d], y[d]) > 0)
+		{
+			flip(e);
+
+			stack.push_back(3 * t);
+			stack.push_back(3 * t + 2);
+			stack.push_back(3 * u);
+			stack.push_back(3 * u + 1);
+		}
+	}
+}
+
+void
+TinMesh::insert(unsigned int p)
+{
+	unsigned int
+		e;
+	LocateEnum
+		lc = locate(p, e);
+
+	if (lc == lOnVertex)
+		return;
+
+	if (lc == lOnEdge)
+	{
+		// Edge v0 -> v1 of (v0, v1, v2), opposite to (v1, v0, w): four triangles around p.
+		unsigned int
+			f = adj[e],
+			t = e / 3,
+			u = f / 3,
+			v0 = tri[e],
+			v1 = tri[Tin::nextEdge(e)],
+			v2 = tri[Tin::prevEdge(e)],
+			w = tri[Tin::prevEdge(f)],
+			x1 = adj[Tin::nextEdge(e)],
+			x2 = adj[Tin::prevEdge(e)],
+			y1 = adj[Tin::nextEdge(f)],
+			y2 = adj[Tin::prevEdge(f)];
+
+		setTriangle(t, v2, v0, p);
+		setTriangle(u, w, v1, p);
+
+		unsigned int
+			tb = addTriangle(v1, v2, p),
+			td = addTriangle(v0, w, p);
+
+		link(3 * t, x2);
+		link(3 * tb, x1);
+		link(3 * u, y2);
+		link(3 * td, y1);
+		link(3 * t + 1, 3 * td + 2);
+		link(3 * t + 2, 3 * tb + 1);
+		link(3 * tb + 2, 3 * u + 1);
+		link(3 * u + 2, 3 * td + 1);
+
+		stack.push_back(3 * t);
+		stack.push_back(3 * tb);
+		stack.push_back(3 * u);
+		stack.push_back(3 * td);
+
+		last = t;
+	}
+	else
+	{
+		// Inside a real triangle or beyond the hull edge of a ghost one: three triangles around p.
+		unsigned int
+			t = e / 3,
+			v0 = tri[3 * t],
+			v1 = tri[3 * t + 1],
+			v2 = tri[3 * t + 2],
+			x0 = adj[3 * t],
+			x1 = adj[3 * t + 1],
+			x2 = adj[3 * t + 2];
+
+		setTriangle(t, v0, v1, p);
+
+		unsigned int
+			t1 = addTriangle(v1, v2, p),
+			t2 = addTriangle(v2, v0, p);
+
+		link(3 * t, x0);
+		link(3 * t1, x1);
+		link(3 * t2, x2);
+		link(3 * t + 1, 3 * t1 + 2);
+		link(3 * t1 + 1, 3 * t2 + 2);
+		link(3 * t2 + 1, 3 * t + 2);
+
+		stack.push_back(3 * t);
+		stack.push_back(3 * t1);
+		stack.push_back(3 * t2);
+
+		last = t;
+	}
+
+	legalize(p);
+
+	// The slot of the last triangle may have turned into a ghost; its hull edge leads back inside.
+	if (isGhost(last))
+		last = adj[ghostEdge(last)] / 3;
+}
+
+/*
+ * Strip merging.
+ */
+
+// The hull of a mesh, counterclockwise, from one of its ghost triangles: ghosts[k] closes the hull edge
+// from hull[k] to hull[k + 1].
+static void
+hullLoop(const TinMesh &mesh, unsigned int ghost, std::vector<unsigned int> &ghosts, std::vector<unsigned int> &hull)
+{
+	unsigned int
+		g = ghost;
+
+	ghosts.clear();
+	hull.clear();
+
+	do
+	{
+		unsigned int
+			e = mesh.ghostEdge(g);
+
+		ghosts.push_back(g);
+		hull.push_back(mesh.tri[Tin::nextEdge(e)]);
+
+		g = mesh.adj[Tin::prevEdge(e)] / 3;
+	}
+	while (g != ghost);
+}
+
+// Whether c lies strictly between a and b, on the segment that joins them; a, b, c are collinear.
+static bool
+isBetween(const TinMesh &mesh, unsigned int a, unsigned int b, unsigned int c)
+{
+	double
+		dblDot = (mesh.x[c] - mesh.x[a]) * (mesh.x[b] - mesh.x[a]) + (mesh.y[c] - mesh.y[a]) * (mesh.y[b] - mesh.y[a]),
+		dblLen = (mesh.x[b] - mesh.x[a]) * (mesh.x[b] - mesh.x[a]) + (mesh.y[b] - mesh.y[a]) * (mesh.y[b] - mesh.y[a]);
+
+	return dblDot > 0 && dblDot < dblLen;
+}
+
+// Joins the triangulation on the left (ghost triangle gl) with the one on the right (gr), whose points
+// all come after in (x, y) order. The gap between the hulls, below the upper and above the lower common
+// tangent, is zipped up with triangles that take the slots of the ghosts they replace; Lawson's flips
+// then make the result Delaunay. Returns a ghost triangle of the result, or GHOST when the hulls could not
+// be zipped (degenerate input, handled by the caller).
+static unsigned int
+mergeMeshes(TinMesh &mesh, unsigned int gl, unsigned int gr)
+{
+	std::vector<unsigned int>
+		aGhostsL,
+		aHullL,
+		aGhostsR,
+		aHullR;
+
+	hullLoop(mesh, gl, aGhostsL, aHullL);
+	hullLoop(mesh, gr, aGhostsR, aHullR);
+
+	size_t
+		nl = aHullL.size(),
+		nr = aHullR.size(),
+		il = 0,
+		ir = 0;
+
+	for (size_t k = 1; k < nl; k++)
+		if (lessPoint(mesh.x, mesh.y, aHullL[il], aHullL[k]))
+			il = k;
+	for (size_t k = 1; k < nr; k++)
+		if (lessPoint(mesh.x, mesh.y, aHullR[k], aHullR[ir]))
+			ir = k;
+
+	size_t
+		iu = il,
+		ju = ir;
+
+	auto prevL = [nl](size_t k) { return (k + nl - 1) % nl; };
+	auto nextL = [nl](size_t k) { return (k + 1) % nl; };
+	auto prevR = [nr](size_t k) { return (k + nr - 1) % nr; };
+	auto nextR = [nr](size_t k) { return (k + 1) % nr; };
+
+	// Whether c is below the line l -> r, or on it between them.
+	auto below = [&](unsigned int l, unsigned int r, unsigned int c) {
+		double
+			o = mesh.orient(l, r, c);
+
+		return o < 0 || (o == 0 && isBetween(mesh, l, r, c));
+	};
+	auto above = [&](unsigned int l, unsigned int r, unsigned int c) {
+		double
+			o = mesh.orient(l, r, c);
+
+		return o > 0 || (o == 0 && isBetween(mesh, l, r, c));
+	};
+
+	for (bool blnMoved = true; blnMoved; )
+	{
+		blnMoved = false;
+
+		while (below(aHullL[il], aHullR[ir], aHullL[prevL(il)]))
+		{
+			il = prevL(il);
+			blnMoved = true;
+		}
+
+		while (below(aHullL[il], aHullR[ir], aHullR[nextR(ir)]))
+		{
+			ir = nextR(ir);
+			blnMoved = true;
+		}
+	}
+
+	for (bool blnMoved = true; blnMoved; )
+	{
+		blnMoved = false;
+
+		while (above(aHullL[iu], aHullR[ju], aHullL[nextL(iu)]))
+		{
+			iu = nextL(iu);
+			blnMoved = true;
+		}
+
+		while (above(aHullL[iu], aHullR[ju], aHullR[prevR(ju)]))
+		{
+			ju = prevR(ju);
+			blnMoved = true;
+		}
+	}
+
+	size_t
+		intEdgesL = (iu + nl - il) % nl,
+		intEdgesR = (ir + nr - ju) % nr;
+
+	if (intEdgesL + intEdgesR == 0 || intEdgesL == nl || intEdgesR == nr)
+		return GHOST;
+
+	// Everything that is read from the ghosts about to be overwritten.
+	std::vector<unsigned int>
+		aSlots,
+		aOuterL(intEdgesL),
+		aOuterR(intEdgesR);
+
+	for (size_t k = 0; k < intEdgesL; k++)
+	{
+		unsigned int
+			g = aGhostsL[(il + k) % nl];
+
+		aSlots.push_back(g);
+		aOuterL[k] = mesh.adj[mesh.ghostEdge(g)];
+	}
+
+	for (size_t k = 0; k < intEdgesR; k++)
+	{
+		unsigned int
+			g = aGhostsR[(ju + k) % nr];
+
+		aSlots.push_back(g);
+		aOuterR[k] = mesh.adj[mesh.ghostEdge(g)];
+	}
+
+	unsigned int
+		intLowerL = Tin::prevEdge(mesh.ghostEdge(aGhostsL[prevL(il)])),
+		intLowerR = Tin::nextEdge(mesh.ghostEdge(aGhostsR[ir])),
+		intUpperR = Tin::prevEdge(mesh.ghostEdge(aGhostsR[prevR(ju)])),
+		intUpperL = Tin::nextEdge(mesh.ghostEdge(aGhostsL[iu])),
+		gLower = mesh.addTriangle(aHullR[ir], aHullL[il], GHOST),
+		gUpper = mesh.addTriangle(aHullL[iu], aHullR[ju], GHOST);
+
+	mesh.link(3 * gLower + 1, intLowerL);
+	mesh.link(3 * gLower + 2, intLowerR);
+	mesh.link(3 * gUpper + 1, intUpperR);
+	mesh.link(3 * gUpper + 2, intUpperL);
+
+	unsigned int
+		intBase = 3 * gLower;
+	size_t
+		l = il,
+		r = ir;
+
+	mesh.stack.clear();
+
+	for (unsigned int s : aSlots)
+	{
+		unsigned int
+			lv = aHullL[l],
+			rv = aHullR[r],
+			ln = aHullL[nextL(l)],
+			rn = aHullR[prevR(r)];
+		bool
+			blnValidL = l != iu && mesh.orient(lv, rv, ln) > 0,
+			blnValidR = r != ju && mesh.orient(lv, rv, rn) > 0;
+
+		if (!blnValidL && !blnValidR)
+			return GHOST;
+
+		bool
+			blnRight = !blnValidL ||
+				(blnValidR && incircle(mesh.x[lv], mesh.y[lv], mesh.x[rv], mesh.y[rv], mesh.x[ln], mesh.y[ln], mesh.x[rn], mesh.y[rn]) > 0);
+
+		mesh.link(3 * s, intBase);
+
+		if (blnRight)
+		{
+			mesh.setTriangle(s, lv, rv, rn);
+			mesh.link(3 * s + 1, aOuterR[(r + nr - 1 - ju) % nr]);
+			intBase = 3 * s + 2;
+			r = prevR(r);
+		}
+		else
+		{
+			mesh.setTriangle(s, lv, rv, ln);
+			mesh.link(3 * s + 2, aOuterL[(l + nl - il) % nl]);
+			intBase = 3 * s + 1;
+			l = nextL(l);
+		}
+
+		mesh.stack.push_back(3 * s);
+		mesh.stack.push_back(3 * s + 1);
+		mesh.stack.push_back(3 * s + 2);
+	}
+
+	mesh.link(3 * gUpper, intBase);
+	mesh.lawson();
+
+	return gLower;
+}
+
+/*
+ * Tin.
+ */
+
+// Copies the real triangles of the mesh to the TIN; the ghosts become NONE adjacencies.
+static void
+compactMesh(const TinMesh &mesh, Tin &tin)
+{
+	size_t
+		intCount = mesh.tri.size() / 3,
+		intBlock = 1 << 16,
+		intBlocks = (intCount + intBlock - 1) / intBlock;
+	std::vector<unsigned int>
+		aIndex(intCount);
+	std::vector<size_t>
+		aFirst(intBlocks + 1, 0);
+
+	parallelFor(0, intBlocks, 1, [&](size_t first, size_t last) {
+		for (size_t b = first; b < last; b++)
+		{
+			size_t
+				intReal = 0;
+
+			for (size_t t = b * intBlock; t < std::min(intCount, (b + 1) * intBlock); t++)
+				intReal += !mesh.isGhost((unsigned int) t);
+
+			aFirst[b + 1] = intReal;
+		}
+	});
+
+	std::partial_sum(aFirst.begin(), aFirst.end(), aFirst.begin());
+
+	tin.triangles.resize(3 * aFirst[intBlocks]);
+	tin.adjacency.resize(3 * aFirst[intBlocks]);
+	tin.constrained.assign(3 * aFirst[intBlocks], 0);
+
+	parallelFor(0, intBlocks, 1, [&](size_t first, size_t last) {
+		for (size_t b = first; b < last; b++)
+		{
+			unsigned int
+				intNext = (unsigned int) aFirst[b];
+
+			for (size_t t = b * intBlock; t < std::min(intCount, (b + 1) * intBlock); t++)
+				if (mesh.isGhost((unsigned int) t))
+					aIndex[t] = Tin::NONE;
+				else
+				{
+					aIndex[t] = intNext;
+
+					for (int k = 0; k < 3; k++)
+						tin.triangles[3 * intNext + k] = mesh.tri[3 * t + k];
+
+					intNext++;
+				}
+		}
+	});
+
+	parallelFor(0, intCount, intBlock, [&](size_t first, size_t last) {
+		for (size_t t = first; t < last; t++)
+			if (aIndex[t] != Tin::NONE)
+				for (int k = 0; k < 3; k++)
+				{
+					unsigned int
+						f = mesh.adj[3 * t + k],
+						u = aIndex[f / 3];
+
+					tin.adjacency[3 * aIndex[t] + k] = u == Tin::NONE ? Tin::NONE : 3 * u + f % 3;
+				}
+	});
+}
+
+// Sorts the strip in (x, y) order and drops coincident points, keeping the smallest index.
+static void
+sortUnique(const PointBuffer &pnts, std::vector<unsigned int> &idx)
+{
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+
+	std::sort(idx.begin(), idx.end(), [x, y](unsigned int a, unsigned int b) { return lessPoint(x, y, a, b); });
+
+	idx.erase(std::unique(idx.begin(), idx.end(), [x, y](unsigned int a, unsigned int b) {
+		return x[a] == x[b] && y[a] == y[b];
+	}), idx.end());
+}
+
+// Parallel build: the points are split in (x, y) order into strips that are triangulated separately and
+// merged from left to right. Returns false when a strip or a merge degenerates.
+static bool
+buildStrips(const PointBuffer &pnts, size_t strips, TinMesh &mesh)
+{
+	const double
+		*x = pnts.x.data(),
+		*y = pnts.y.data();
+	size_t
+		n = pnts.size();
+	std::vector<unsigned int>
+		aAll(n);
+	std::vector<size_t>
+		aBounds {0, n};
+
+	std::iota(aAll.begin(), aAll.end(), 0u);
+
+	// Halves every strip until there are enough of them.
+	while (aBounds.size() - 1 < strips)
+	{
+		std::vector<size_t>
+			aNext(2 * aBounds.size() - 1);
+
+		parallelFor(0, aBounds.size() - 1, 1, [&](size_t first, size_t last) {
+			for (size_t s = first; s < last; s++)
+			{
+				size_t
+					intMiddle = aBounds[s] + (aBounds[s + 1] - aBounds[s]) / 2;
+
+				std::nth_element(aAll.begin() + aBounds[s], aAll.begin() + intMiddle, aAll.begin() + aBounds[s + 1],
+					[x, y](unsigned int a, unsigned int b) { return lessPoint(x, y, a, b); });
+
+				aNext[2 * s] = aBounds[s];
+				aNext[2 * s + 1] = intMiddle;
+			}
+		});
+
+		aNext.back() = n;
+		aBounds.swap(aNext);
+	}
+
+	std::vector<std::vector<unsigned int>>
+		aStrips(strips);
+
+	parallelFor(0, strips, 1, [&](size_t first, size_t last) {
+		for (size_t s = first; s < last; s++)
+		{
+			aStrips[s].assign(aAll.begin() + aBounds[s], aAll.begin() + aBounds[s + 1]);
+			sortUnique(pnts, aStrips[s]);
+		}
+	});
+
+	// Coincident points may straddle a boundary; the first strip keeps them.
+	for (size_t s = 1; s < strips; s++)
+	{
+		unsigned int
+			p = aStrips[s - 1].back();
+		std::vector<unsigned int>::iterator
+			it = aStrips[s].begin();
+
+		while (it != aStrips[s].end() && x[*it] == x[p] && y[*it] == y[p])
+			it++;
+
+		aStrips[s].erase(aStrips[s].begin(), it);
+
+		if (aStrips[s].empty())
+			return false;
+	}
+
+	std::vector<TinMesh>
+		aMeshes(strips, TinMesh(pnts));
+	std::vector<unsigned char>
+		aOk(strips);
+
+	parallelFor(0, strips, 1, [&](size_t first, size_t last) {
+		for (size_t s = first; s < last; s++)
+		{
+			insertionOrder(pnts, aStrips[s]);
+			aOk[s] = aMeshes[s].triangulate(aStrips[s]);
+			std::vector<unsigned int>().swap(aStrips[s]);
+		}
+	});
+
+	if (std::find(aOk.begin(), aOk.end(), 0) != aOk.end())
+		return false;
+
+	// One mesh with every strip, half-edges shifted by the offset of their strip.
+	std::vector<size_t>
+		aOffset(strips + 1, 0);
+
+	for (size_t s = 0; s < strips; s++)
+		aOffset[s + 1] = aOffset[s] + aMeshes[s].tri.size();
+
+	mesh.tri.resize(aOffset[strips]);
+	mesh.adj.resize(aOffset[strips]);
+
+	parallelFor(0, strips, 1, [&](size_t first, size_t last) {
+		for (size_t s = first; s < last; s++)
+		{
+			std::copy(aMeshes[s].tri.begin(), aMeshes[s].tri.end(), mesh.tri.begin() + aOffset[s]);
+
+			for (size_t e = 0; e < aMeshes[s].adj.size(); e++)
+				mesh.adj[aOffset[s] + e] = aMeshes[s].adj[e] + (unsigned int) aOffset[s];
+
+			std::vector<unsigned int>().swap(aMeshes[s].tri);
+			std::vector<unsigned int>().swap(aMeshes[s].adj);
+		}
+	});
+
+	auto firstGhost = [&](size_t s) {
+		unsigned int
+			t = (unsigned int) (aOffset[s] / 3);
+
+		while (!mesh.isGhost(t))
+			t++;
+
+		return t;
+	};
+
+	unsigned int
+		g = firstGhost(0);
+
+	for (size_t s = 1; s < strips && g != GHOST; s++)
+		g = mergeMeshes(mesh, g, firstGhost(s));
+
+	return g != GHOST;
+}
+
+void
+Tin::build(const PointBuffer &pnts, bool parallel)
+{
+	size_t
+		n = pnts.size();
+
+	if (n >= UINT_MAX / 8)
+		RAISE(ETin, teTooManyPoints);
+
+	vertices = pnts;
+	elevations.clear();
+	triangles.clear();
+	adjacency.clear();
+	constrained.clear();
+
+	TinMesh
+		mesh(vertices);
+	size_t
+		intStrips = 1;
+
+	if (parallel)
+		while (2 * intStrips <= sharedPool().getConcurrency() && n / (2 * intStrips) >= TIN_STRIP)
+			intStrips *= 2;
+
+	if (intStrips == 1 || !buildStrips(vertices, intStrips, mesh))
+	{
+		std::vector<unsigned int>
+			aOrder(n);
+
+		std::iota(aOrder.begin(), aOrder.end(), 0u);
+
+		sortUnique(vertices, aOrder);
+		insertionOrder(vertices, aOrder);
+
+		if (!mesh.triangulate(aOrder))
+			return;
+	}
+
+	compactMesh(mesh, *this);
+}
+
+void
+Tin::build(const PointBuffer &pnts, const std::vector<double> &z, bool parallel)
+{
+	build(pnts, parallel);
+	elevations = z;
+}
+
+/*
+ * Constraints.
+ */
+
+// Edits of a TIN while breaklines are forced in: one outgoing half-edge per vertex, to find the triangles
+// around it.
+struct TinEditor
+{
+public:
+
+	TinEditor(Tin &tin) :
+		tin(tin),
+		vertexEdge(tin.vertices.size(), Tin::NONE)
+	{
+		for (size_t e = 0; e < tin.triangles.size(); e++)
+			vertexEdge[tin.triangles[e]] = (unsigned int) e;
+	}
+
+	Tin
+		&tin;
+	std::vector<unsigned int>
+		vertexEdge;
+
+	double orient(unsigned int a, unsigned int b, unsigned int c) const
+	{
+		const PointBuffer
+			&pnts = tin.vertices;
+
+		return orient2d(pnts.x[a], pnts.y[a], pnts.x[b], pnts.y[b], pnts.x[c], pnts.y[c]);
+	}
+
+	void link(unsigned int a, unsigned int b)
+	{
+		tin.adjacency[a] = b;
+
+		if (b != Tin::NONE)
+			tin.adjacency[b] = a;
+	}
+
+	void markEdge(unsigned int e)
+	{
+		tin.constrained[e] = 1;
+
+		if (tin.adjacency[e] != Tin::NONE)
+			tin.constrained[tin.adjacency[e]] = 1;
+	}
+
+	unsigned int insertPart(unsigned int a, unsigned int b);
+	void triangulateCavity(unsigned int a, unsigned int b, const std::vector<unsigned int> &chain,
+		std::vector<unsigned int> &out) const;
+
+}; /* TinEditor */
+
+// Constrained Delaunay triangulation of the pseudo-polygon left of a -> b whose other vertexes are "chain",
+// in order from a to b: the apex on a -> b is the chain vertex whose circle holds no other one; the two
+// sides are done the same way.
+void
+TinEditor::triangulateCavity(unsigned int a, unsigned int b, const std::vector<unsigned int> &chain,
+	std::vector<unsigned int> &out) const
+{
+	struct Part
+	{
+		unsigned int
+			a,
+			b;
+		size_t
+			first,
+			last;
+	};
+
+	const PointBuffer
+		&pnts = tin.vertices;
+	std::vector<Part>
+		aParts {{a, b, 0, chain.size()}};
+
+	while (!aParts.empty())
+	{
+		Part
+			prt = aParts.back();
+
+		aParts.pop_back();
+
+		if (prt.first == prt.last)
+			continue;
+
+		size_t
+			c = prt.first;
+
+		for (size_t i = prt.first + 1; i < prt.last; i++)
+			if (incircle(pnts.x[prt.a], pnts.y[prt.a], pnts.x[prt.b], pnts.y[prt.b], pnts.x[chain[c]], pnts.y[chain[c]],
+				pnts.x[chain[i]], pnts.y[chain[i]]) > 0)
+				c = i;
+
+		out.push_back(prt.a);
+		out.push_back(prt.b);
+		out.push_back(chain[c]);
+
+		aParts.push_back({prt.a, chain[c], prt.first, c});
+		aParts.push_back({chain[c], prt.b, c + 1, prt.last});
+	}
+}
+
+// Forces the part of a -> b up to the first vertex on the segment; returns that vertex.
+unsigned int
+TinEditor::insertPart(unsigned int a, unsigned int b)
+{
+	std::vector<unsigned int>
+		&tri = tin.triangles,
+		&adj = tin.adjacency;
+	const PointBuffer
+		&pnts = tin.vertices;
+
+	// The outgoing half-edges of a, from the most clockwise one on the hull, if any.
+	unsigned int
+		intStart = vertexEdge[a];
+
+	for (unsigned int e = intStart; adj[e] != Tin::NONE; )
+	{
+		e = Tin::nextEdge(adj[e]);
+
+		if (e == vertexEdge[a])
+			break;
+
+		intStart = e;
+	}
+
+	unsigned int
+		intCross = Tin::NONE,
+		e = intStart;
+
+	do
+	{
+		unsigned int
+			v = tri[Tin::nextEdge(e)],
+			w = tri[Tin::prevEdge(e)];
+
+		if (v == b || (orient(a, b, v) == 0 &&
+			(pnts.x[v] - pnts.x[a]) * (pnts.x[b] - pnts.x[a]) + (pnts.y[v] - pnts.y[a]) * (pnts.y[b] - pnts.y[a]) > 0))
+		{
+			markEdge(e);
+			return v;
+		}
+
+		if (orient(a, v, b) > 0 && orient(a, w, b) < 0)
+			intCross = Tin::nextEdge(e);
+
+		unsigned int
+			f = adj[Tin::prevEdge(e)];
+
+		e = f;
+	}
+	while (e != Tin::NONE && e != intStart && intCross == Tin::NONE);
+
+	if (intCross == Tin::NONE)
+		RAISE(ETin, teInvalidVertex);
+
+	// Walks along the segment, collecting the crossed triangles and the vertexes on each side.
+	std::vector<unsigned int>
+		aRemoved {intCross / 3},
+		aLeft {tri[Tin::nextEdge(intCross)]},
+		aRight {tri[intCross]};
+	unsigned int
+		intEnd = b;
+
+	for (unsigned int h = intCross; ; )
+	{
+		if (tin.constrained[h])
+			RAISE(ETin, teCrossingConstraints);
+
+		unsigned int
+			f = adj[h],
+			z = tri[Tin::prevEdge(f)];
+
+		aRemoved.push_back(f / 3);
+
+		if (z == b)
+			break;
+
+		double
+			o = orient(a, b, z);
+
+		if (o == 0)
+		{
+			intEnd = z;
+			break;
+		}
+
+		if (o > 0)
+		{
+			aLeft.push_back(z);
+			h = Tin::nextEdge(f);
+		}
+		else
+		{
+			aRight.push_back(z);
+			h = Tin::prevEdge(f);
+		}
+	}
+
+	// The cavity is bounded by the half-edges of the removed triangles whose opposite ones stay.
+	auto keyOf = [](unsigned int from, unsigned int to) {
+		return (uint64_t) from << 32 | to;
+	};
+
+	std::sort(aRemoved.begin(), aRemoved.end());
+
+	std::unordered_map<uint64_t, std::pair<unsigned int, unsigned char>>
+		aBoundary;
+
+	for (unsigned int t : aRemoved)
+		for (unsigned int e = 3 * t; e < 3 * t + 3; e++)
+			if (adj[e] == Tin::NONE || !std::binary_search(aRemoved.begin(), aRemoved.end(), adj[e] / 3))
+				aBoundary[keyOf(tri[e], tri[Tin::nextEdge(e)])] = {adj[e], tin.constrained[e]};
+
+	std::vector<unsigned int>
+		aNew;
+
+	triangulateCavity(a, intEnd, aLeft, aNew);
+	std::reverse(aRight.begin(), aRight.end());
+	triangulateCavity(intEnd, a, aRight, aNew);
+
+	// Same number of triangles as removed: the new ones take their slots.
+	std::unordered_map<uint64_t, unsigned int>
+		aOpen;
+
+	for (size_t i = 0; i < aRemoved.size(); i++)
+	{
+		unsigned int
+			t = aRemoved[i];
+
+		for (unsigned int k = 0; k < 3; k++)
+			tri[3 * t + k] = aNew[3 * i + k];
+
+		for (unsigned int e = 3 * t; e < 3 * t + 3; e++)
+		{
+			unsigned int
+				from = tri[e],
+				to = tri[Tin::nextEdge(e)];
+
+			vertexEdge[from] = e;
+
+			auto itBoundary = aBoundary.find(keyOf(from, to));
+
+			if (itBoundary != aBoundary.end())
+			{
+				link(e, itBoundary->second.first);
+				tin.constrained[e] = itBoundary->second.second;
+				continue;
+			}
+
+			tin.constrained[e] = 0;
+
+			auto itOpen = aOpen.find(keyOf(to, from));
+
+			if (itOpen != aOpen.end())
+			{
+				link(e, itOpen->second);
+				aOpen.erase(itOpen);
+			}
+			else
+				aOpen[keyOf(from, to)] = e;
+
+			if ((from == a && to == intEnd) || (from == intEnd && to == a))
+				tin.constrained[e] = 1;
+		}
+	}
+
+	return intEnd;
+}
+
+void
+Tin::addConstraints(const std::vector<unsigned int> &segments)
+{
+	if (segments.empty())
+		return;
+
+	TinEditor
+		edt(*this);
+
+	for (size_t i = 0; i + 1 < segments.size(); i += 2)
+	{
+		unsigned int
+			a = segments[i],
+			b = segments[i + 1];
+
+		if (a >= vertices.size() || b >= vertices.size() || edt.vertexEdge[a] == NONE || edt.vertexEdge[b] == NONE)
+			RAISE(ETin, teInvalidVertex);
+
+		while (a != b)
+			a = edt.insertPart(a, b);
+	}
+}
+
+} // namespace CIVIL::MATH::GA2D
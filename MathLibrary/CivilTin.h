@@ -0,0 +1,132 @@
+/***
+ * CivilTin.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_TIN
+#define __CIVIL_TIN
+
+#include <limits.h>
+#include <vector>
+
+#include "..\UtilsLibrary\CivilError.h"
+#include "..\MathLibrary\CivilGA2D.h"
+#include "..\MathLibrary\CivilBuffer2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(teTooManyPoints);
+	DECLARE_ERROR_CODE(teInvalidVertex);
+	DECLARE_ERROR_CODE(teCrossingConstraints);
+	DECLARE_ERROR_CODE(teNoElevations);
+
+	BEGIN_DECLARE_ERROR(ETin)
+		DECLARE_ERROR(teTooManyPoints, "Too many points for a TIN")
+		DECLARE_ERROR(teInvalidVertex, "The vertex is not part of the triangulation")
+		DECLARE_ERROR(teCrossingConstraints, "A constrained edge crosses another one")
+		DECLARE_ERROR(teNoElevations, "The TIN has no elevations")
+	END_DECLARE_ERROR;
+
+	// Tin;
+	//
+	// Triangulated irregular network: the Delaunay triangulation of a set of points, optionally constrained
+	// ---- by breaklines. The mesh is stored in flat index arrays, without one allocation per triangle:
+	//
+	//        triangles   three vertex indexes per triangle, counterclockwise. Half-edge e belongs to the
+	//                    triangle e / 3 and goes from triangles[e] to triangles[nextEdge(e)].
+	//        adjacency   the opposite half-edge of e in the neighbouring triangle, or NONE on the hull.
+	//        constrained nonzero for both half-edges of a breakline.
+	//
+	//      Vertex indexes are those of the input. Of coincident points only the one with the smallest index
+	//      is used; the others belong to no triangle. When every point is collinear there are no triangles.
+	struct Tin
+	{
+	public:
+
+		static constexpr unsigned int
+			NONE = UINT_MAX;
+
+		PointBuffer
+			vertices;
+		// Optional, one per vertex; empty when the TIN was built from plane points only.
+		std::vector<double>
+			elevations;
+		std::vector<unsigned int>
+			triangles,
+			adjacency;
+		std::vector<unsigned char>
+			constrained;
+
+		// build;
+		//
+		// Triangulates "pnts" incrementally, inserting them in a biased randomized order (BRIO) that follows a
+		// ---- Hilbert curve within each round, so that each insertion starts next to the previous one. With
+		//      "parallel" large inputs are split in vertical strips that are triangulated on the shared pool
+		//      and then merged. Cocircular points may be triangulated differently depending on the number of
+		//      strips; the result is always a Delaunay triangulation. Previous contents and constraints are
+		//      discarded.
+		void build(const PointBuffer &pnts, bool parallel = true);
+		void build(const PointBuffer &pnts, const std::vector<double> &z, bool parallel = true);
+
+		// addConstraints;
+		//
+		// Forces the segments between the vertex pairs (segments[2 * i], segments[2 * i + 1]) into the mesh as
+		// ---- constrained edges, retriangulating the triangles they cross (constrained Delaunay). A segment
+		//      that passes over a vertex is split there. Raises ETin when a vertex is not in the mesh or when
+		//      a segment crosses an edge constrained before.
+		void addConstraints(const std::vector<unsigned int> &segments);
+		void addConstraint(unsigned int v1, unsigned int v2)
+		{
+			addConstraints(std::vector<unsigned int> {v1, v2});
+		}
+
+		size_t getTriangleCount() const
+		{
+			return triangles.size() / 3;
+		}
+		Point2D getVertex(unsigned int index) const
+		{
+			return vertices.getItem(index);
+		}
+		bool isConstrained(unsigned int edge) const
+		{
+			return constrained[edge] != 0;
+		}
+
+		static unsigned int nextEdge(unsigned int edge)
+		{
+			return edge % 3 == 2 ? edge - 2 : edge + 1;
+		}
+		static unsigned int prevEdge(unsigned int edge)
+		{
+			return edge % 3 == 0 ? edge + 2 : edge - 1;
+		}
+
+	}; /* Tin */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_TIN
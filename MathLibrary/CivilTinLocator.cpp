@@ -0,0 +1,330 @@
+#include "CivilTinLocator.h"
+#include "CivilPredicates.h"
+
+#include <math.h>
+#include <atomic>
+#include <limits>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+using namespace CIVIL::UTILS;
+
+static const size_t
+	LOCATE_GRAIN = 1 << 12;
+
+static std::atomic<uint64_t>
+	s_intNextId(1);
+
+// The last triangle found by the thread and the locator it belongs to.
+struct WalkCache
+{
+public:
+
+	uint64_t
+		owner = 0;
+	unsigned int
+		triangle = Tin::NONE;
+
+}; /* WalkCache */
+
+static thread_local WalkCache
+	t_walkCache;
+
+/*
+ * Walk.
+ */
+
+// Visibility walk from triangle t: crosses an edge that has (x, y) on its outer side until there is none.
+// The first edge tried changes from one triangle to the next, so the walk also ends on constrained meshes,
+// which need not be Delaunay. The hull is convex, so leaving it means that the point is outside.
+static unsigned int
+walk(const Tin &tin, double x, double y, unsigned int t)
+{
+	const double
+		*vx = tin.vertices.x.data(),
+		*vy = tin.vertices.y.data();
+	const unsigned int
+		*tri = tin.triangles.data(),
+		*adj = tin.adjacency.data();
+	unsigned int
+		intSeed = t;
+
+	for (;;)
+	{
+		unsigned int
+			intStart = (intSeed = intSeed * 1103515245 + 12345) >> 16;
+		bool
+			blnMoved = false;
+
+		for (unsigned int k = 0; k < 3; k++)
+		{
+			unsigned int
+				e = 3 * t + (intStart + k) % 3,
+				a = tri[e],
+				b = tri[Tin::nextEdge(e)];
+
+			if (orient2d(vx[a], vy[a], vx[b], vy[b], x, y) < 0)
+			{
+				if (adj[e] == Tin::NONE)
+					return Tin::NONE;
+
+				t = adj[e] / 3;
+				blnMoved = true;
+				break;
+			}
+		}
+
+		if (!blnMoved)
+			return t;
+	}
+}
+
+/*
+ * TinLocator.
+ */
+
+TinLocator::TinLocator(const Tin &tin, double density) :
+	m_tin(tin),
+	m_intId(s_intNextId++),
+	m_dblLeft(0),
+	m_dblBottom(0),
+	m_dblRight(-1),
+	m_dblTop(-1),
+	m_dblCellWidth(1),
+	m_dblCellHeight(1),
+	m_intCols(0),
+	m_intRows(0)
+{
+	size_t
+		intCount = tin.getTriangleCount();
+
+	if (intCount == 0)
+		return;
+
+	const double
+		*x = tin.vertices.x.data(),
+		*y = tin.vertices.y.data();
+	m_dblLeft = m_dblRight = x[tin.triangles[0]];
+	m_dblBottom = m_dblTop = y[tin.triangles[0]];
+
+	for (unsigned int v : tin.triangles)
+	{
+		m_dblLeft = std::min(m_dblLeft, x[v]);
+		m_dblBottom = std::min(m_dblBottom, y[v]);
+		m_dblRight = std::max(m_dblRight, x[v]);
+		m_dblTop = std::max(m_dblTop, y[v]);
+	}
+
+	double
+		dblWidth = std::max(m_dblRight - m_dblLeft, std::numeric_limits<double>::min()),
+		dblHeight = std::max(m_dblTop - m_dblBottom, std::numeric_limits<double>::min()),
+		dblCells = std::max(1.0, intCount / (density > 0 ? density : 2));
+
+	m_intCols = (size_t) std::max(1.0, std::min(dblCells, round(sqrt(dblCells * dblWidth / dblHeight))));
+	m_intRows = (size_t) std::max(1.0, round(dblCells / m_intCols));
+	m_dblCellWidth = dblWidth / m_intCols;
+	m_dblCellHeight = dblHeight / m_intRows;
+	m_aCells.assign(m_intCols * m_intRows, Tin::NONE);
+
+	// One triangle per cell, the last one with its centroid there; empty cells borrow from a neighbour
+	// in row order.
+	for (size_t t = 0; t < intCount; t++)
+	{
+		const unsigned int
+			*v = &tin.triangles[3 * t];
+		double
+			dblX = (x[v[0]] + x[v[1]] + x[v[2]]) / 3,
+			dblY = (y[v[0]] + y[v[1]] + y[v[2]]) / 3;
+		size_t
+			intCol = std::min(m_intCols - 1, (size_t) std::max(0.0, (dblX - m_dblLeft) / m_dblCellWidth)),
+			intRow = std::min(m_intRows - 1, (size_t) std::max(0.0, (dblY - m_dblBottom) / m_dblCellHeight));
+
+		m_aCells[intRow * m_intCols + intCol] = (unsigned int) t;
+	}
+
+	unsigned int
+		intLast = Tin::NONE;
+
+	for (unsigned int &c : m_aCells)
+		if (c == Tin::NONE)
+			c = intLast;
+		else
+			intLast = c;
+
+	for (size_t i = m_aCells.size(); i-- > 0; )
+		if (m_aCells[i] == Tin::NONE)
+			m_aCells[i] = intLast;
+		else
+			intLast = m_aCells[i];
+}
+
+// The grid cell's triangle, or "hint" when its first vertex is nearer to (x, y).
+unsigned int
+TinLocator::jumpStart(double x, double y, unsigned int hint) const
+{
+	double
+		dblCol = (x - m_dblLeft) / m_dblCellWidth,
+		dblRow = (y - m_dblBottom) / m_dblCellHeight;
+	size_t
+		intCol = dblCol <= 0 ? 0 : std::min(m_intCols - 1, (size_t) dblCol),
+		intRow = dblRow <= 0 ? 0 : std::min(m_intRows - 1, (size_t) dblRow);
+	unsigned int
+		t = m_aCells[intRow * m_intCols + intCol];
+
+	if (hint == Tin::NONE)
+		return t;
+
+	const PointBuffer
+		&pnts = m_tin.vertices;
+	unsigned int
+		a = m_tin.triangles[3 * t],
+		b = m_tin.triangles[3 * hint];
+	double
+		dblGrid = (pnts.x[a] - x) * (pnts.x[a] - x) + (pnts.y[a] - y) * (pnts.y[a] - y),
+		dblHint = (pnts.x[b] - x) * (pnts.x[b] - x) + (pnts.y[b] - y) * (pnts.y[b] - y);
+
+	return dblHint <= dblGrid ? hint : t;
+}
+
+unsigned int
+TinLocator::locate(double x, double y, unsigned int hint) const
+{
+	// Also false for NaN.
+	if (!(x >= m_dblLeft && x <= m_dblRight && y >= m_dblBottom && y <= m_dblTop))
+		return Tin::NONE;
+
+	return walk(m_tin, x, y, jumpStart(x, y, hint));
+}
+
+unsigned int
+TinLocator::locate(double x, double y) const
+{
+	WalkCache
+		&wc = t_walkCache;
+	unsigned int
+		t = locate(x, y, wc.owner == m_intId ? wc.triangle : Tin::NONE);
+
+	if (t != Tin::NONE)
+	{
+		wc.owner = m_intId;
+		wc.triangle = t;
+	}
+
+	return t;
+}
+
+void
+TinLocator::barycentric(unsigned int triangle, double x, double y, double &w0, double &w1, double &w2) const
+{
+	const PointBuffer
+		&pnts = m_tin.vertices;
+	const unsigned int
+		*v = &m_tin.triangles[3 * triangle];
+	double
+		ax = pnts.x[v[0]],
+		ay = pnts.y[v[0]],
+		bx = pnts.x[v[1]],
+		by = pnts.y[v[1]],
+		cx = pnts.x[v[2]],
+		cy = pnts.y[v[2]],
+		dblArea = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+
+	w0 = ((bx - x) * (cy - y) - (by - y) * (cx - x)) / dblArea;
+	w1 = ((cx - x) * (ay - y) - (cy - y) * (ax - x)) / dblArea;
+	w2 = 1 - w0 - w1;
+}
+
+bool
+TinLocator::interpolate(double x, double y, double &z) const
+{
+	if (m_tin.elevations.size() != m_tin.vertices.size())
+		RAISE(ETin, teNoElevations);
+
+	unsigned int
+		t = locate(x, y);
+
+	if (t == Tin::NONE)
+		return false;
+
+	double
+		w0,
+		w1,
+		w2;
+	const unsigned int
+		*v = &m_tin.triangles[3 * t];
+
+	barycentric(t, x, y, w0, w1, w2);
+	z = w0 * m_tin.elevations[v[0]] + w1 * m_tin.elevations[v[1]] + w2 * m_tin.elevations[v[2]];
+
+	return true;
+}
+
+/*
+ * Batch queries.
+ */
+
+void
+TinLocator::locateBatch(const PointBuffer &pnts, std::vector<unsigned int> &triangles) const
+{
+	triangles.resize(pnts.size());
+
+	parallelFor(0, pnts.size(), LOCATE_GRAIN, [&](size_t first, size_t last) {
+		unsigned int
+			intHint = Tin::NONE;
+
+		for (size_t i = first; i < last; i++)
+		{
+			unsigned int
+				t = locate(pnts.x[i], pnts.y[i], intHint);
+
+			triangles[i] = t;
+
+			if (t != Tin::NONE)
+				intHint = t;
+		}
+	});
+}
+
+void
+TinLocator::interpolateBatch(const PointBuffer &pnts, std::vector<double> &z) const
+{
+	if (m_tin.elevations.size() != m_tin.vertices.size())
+		RAISE(ETin, teNoElevations);
+
+	z.resize(pnts.size());
+
+	parallelFor(0, pnts.size(), LOCATE_GRAIN, [&](size_t first, size_t last) {
+		const double
+			*elv = m_tin.elevations.data();
+		unsigned int
+			intHint = Tin::NONE;
+
+		for (size_t i = first; i < last; i++)
+		{
+			unsigned int
+				t = locate(pnts.x[i], pnts.y[i], intHint);
+
+			if (t == Tin::NONE)
+			{
+				z[i] = std::numeric_limits<double>::quiet_NaN();
+				continue;
+			}
+
+			double
+				w0,
+				w1,
+				w2;
+			const unsigned int
+				*v = &m_tin.triangles[3 * t];
+
+			barycentric(t, pnts.x[i], pnts.y[i], w0, w1, w2);
+			z[i] = w0 * elv[v[0]] + w1 * elv[v[1]] + w2 * elv[v[2]];
+			intHint = t;
+		}
+	});
+}
+
+} // namespace CIVIL::MATH::GA2D
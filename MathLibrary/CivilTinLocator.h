@@ -0,0 +1,111 @@
+/***
+ * CivilTinLocator.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_TIN_LOCATOR
+#define __CIVIL_TIN_LOCATOR
+
+#include <stdint.h>
+#include <vector>
+
+#include "..\MathLibrary\CivilTin.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	// TinLocator;
+	//
+	// Finds the triangle of a TIN under a point and interpolates the elevation there. A query jumps to the
+	// ---- triangle recorded for its cell of a regular grid, or starts from the triangle of the previous query
+	//      of the same thread when that one is closer, and then walks across the triangles towards the point.
+	//      Coherent streams of queries therefore cost a few steps each.
+	//
+	//      The locator keeps a reference to the TIN, which must not change while it is in use. Queries may be
+	//      made from any number of threads.
+	struct TinLocator
+	{
+	public:
+
+		// "density" is the number of triangles per grid cell.
+		TinLocator(const Tin &tin, double density = 2);
+
+	private:
+
+		const Tin
+			&m_tin;
+		// Identifies the locator in the per-thread caches.
+		uint64_t
+			m_intId;
+		double
+			m_dblLeft,
+			m_dblBottom,
+			m_dblRight,
+			m_dblTop,
+			m_dblCellWidth,
+			m_dblCellHeight;
+		size_t
+			m_intCols,
+			m_intRows;
+		std::vector<unsigned int>
+			m_aCells;
+
+		unsigned int jumpStart(double x, double y, unsigned int hint) const;
+
+	public:
+
+		// locate;
+		//
+		// The triangle that contains (x, y), or Tin::NONE outside the TIN; on an edge or a vertex any of the
+		// ---- triangles around it. The second form starts walking from "hint" when it is closer than the grid
+		//      cell (Tin::NONE for none) and leaves nothing in the cache.
+		unsigned int locate(double x, double y) const;
+		unsigned int locate(double x, double y, unsigned int hint) const;
+
+		// barycentric;
+		//
+		// Weights of the three vertexes of "triangle" at (x, y), in the order of Tin::triangles; they add up to
+		// ---- 1 and are all in [0, 1] inside the triangle.
+		void barycentric(unsigned int triangle, double x, double y, double &w0, double &w1, double &w2) const;
+
+		// interpolate;
+		//
+		// Linear elevation of the TIN at (x, y); false outside. Raises ETin when the TIN has no elevations.
+		// ----
+		bool interpolate(double x, double y, double &z) const;
+
+		// Batch queries.
+		//
+		// One result per point of "pnts": the triangle (Tin::NONE outside), or the elevation (NaN outside).
+		// The points are split in pieces that run on the shared pool; each piece walks from the triangle of
+		// its previous point, so spatially ordered buffers are the fastest.
+		void locateBatch(const PointBuffer &pnts, std::vector<unsigned int> &triangles) const;
+		void interpolateBatch(const PointBuffer &pnts, std::vector<double> &z) const;
+
+	}; /* TinLocator */
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_TIN_LOCATOR
@@ -0,0 +1,476 @@
+#include "CivilTransformFit.h"
+
+#include <math.h>
+#include <algorithm>
+
+namespace CIVIL::MATH::GA2D
+{
+
+// Parameters of each model.
+static const int
+	MODEL_PARAMETERS[3] = {4, 6, 8};
+
+/*
+ * Helpers.
+ */
+
+// Solves a x = b in place by Gaussian elimination with partial pivoting, "a" holding n rows of n + 1
+// columns (b last); false when a pivot vanishes against the largest one.
+static bool
+solveLinear(double a[8][9], int n, double x[8])
+{
+	double
+		dblLargest = 0;
+
+	for (int i = 0; i < n; i++)
+		for (int j = 0; j < n; j++)
+			dblLargest = std::max(dblLargest, fabs(a[i][j]));
+
+	for (int k = 0; k < n; k++)
+	{
+		int
+			p = k;
+
+		for (int i = k + 1; i < n; i++)
+			if (fabs(a[i][k]) > fabs(a[p][k]))
+				p = i;
+
+		if (!(fabs(a[p][k]) > 1e-13 * dblLargest))
+			return false;
+
+		if (p != k)
+			for (int j = k; j <= n; j++)
+				std::swap(a[k][j], a[p][j]);
+
+		for (int i = k + 1; i < n; i++)
+		{
+			double
+				f = a[i][k] / a[k][k];
+
+			for (int j = k; j <= n; j++)
+				a[i][j] -= f * a[k][j];
+		}
+	}
+
+	for (int k = n - 1; k >= 0; k--)
+	{
+		double
+			dblSum = a[k][n];
+
+		for (int j = k + 1; j < n; j++)
+			dblSum -= a[k][j] * x[j];
+
+		x[k] = dblSum / a[k][k];
+	}
+
+	return true;
+}
+
+Point2D
+projectiveTransform(const Matrix2D &mat, const Point2D &pnt)
+{
+	double
+		w = mat.items[2][0] * pnt.x + mat.items[2][1] * pnt.y + mat.items[2][2];
+
+	return Point2D((mat.items[0][0] * pnt.x + mat.items[0][1] * pnt.y + mat.items[0][2]) / w,
+		(mat.items[1][0] * pnt.x + mat.items[1][1] * pnt.y + mat.items[1][2]) / w);
+}
+
+// Moves a set to its weighted centroid and scales it to a mean distance of sqrt(2): p' = s (p - c).
+static void
+normalizePoints(const std::vector<Point2D> &pnts, const std::vector<double> &weights, std::vector<Point2D> &res,
+	Point2D &center, double &scale)
+{
+	double
+		dblWeight = 0;
+
+	center = NULL_POINT;
+
+	for (size_t i = 0; i < pnts.size(); i++)
+	{
+		center += pnts[i] * weights[i];
+		dblWeight += weights[i];
+	}
+
+	center /= dblWeight;
+
+	double
+		dblDist = 0;
+
+	for (size_t i = 0; i < pnts.size(); i++)
+		dblDist += weights[i] * (pnts[i] - center).dist();
+
+	dblDist /= dblWeight;
+	scale = dblDist > 0 ? M_SQRT2 / dblDist : 1;
+	res.resize(pnts.size());
+
+	for (size_t i = 0; i < pnts.size(); i++)
+		res[i] = (pnts[i] - center) * scale;
+}
+
+/*
+ * Models, on normalized points.
+ */
+
+static bool
+fitSimilarity(const std::vector<Point2D> &src, const std::vector<Point2D> &dst, const std::vector<double> &w,
+	Matrix2D &mat)
+{
+	// Both sets are centered, so the translation is zero and a = sum (x X + y Y) / sum (x^2 + y^2),
+	// b = sum (x Y - y X) / sum (x^2 + y^2).
+	double
+		a = 0,
+		b = 0,
+		d = 0;
+
+	for (size_t i = 0; i < src.size(); i++)
+	{
+		a += w[i] * (src[i].x * dst[i].x + src[i].y * dst[i].y);
+		b += w[i] * (src[i].x * dst[i].y - src[i].y * dst[i].x);
+		d += w[i] * (src[i].x * src[i].x + src[i].y * src[i].y);
+	}
+
+	if (!(d > 0))
+		return false;
+
+	mat = Matrix2D::M_IDENTITY;
+	mat.items[0][0] = a / d;
+	mat.items[0][1] = -b / d;
+	mat.items[1][0] = b / d;
+	mat.items[1][1] = a / d;
+
+	return true;
+}
+
+static bool
+fitAffine(const std::vector<Point2D> &src, const std::vector<Point2D> &dst, const std::vector<double> &w,
+	Matrix2D &mat)
+{
+	double
+		sxx = 0, sxy = 0, syy = 0,
+		sxX = 0, syX = 0, sxY = 0, syY = 0;
+
+	for (size_t i = 0; i < src.size(); i++)
+	{
+		double
+			x = src[i].x,
+			y = src[i].y;
+
+		sxx += w[i] * x * x;
+		sxy += w[i] * x * y;
+		syy += w[i] * y * y;
+		sxX += w[i] * x * dst[i].x;
+		syX += w[i] * y * dst[i].x;
+		sxY += w[i] * x * dst[i].y;
+		syY += w[i] * y * dst[i].y;
+	}
+
+	double
+		dblDet = sxx * syy - sxy * sxy;
+
+	// The sets are scaled to unit size, so an absolute bound tells collinear points apart.
+	if (!(dblDet > 1e-12 * (sxx + syy) * (sxx + syy)))
+		return false;
+
+	mat = Matrix2D::M_IDENTITY;
+	mat.items[0][0] = (sxX * syy - syX * sxy) / dblDet;
+	mat.items[0][1] = (syX * sxx - sxX * sxy) / dblDet;
+	mat.items[1][0] = (sxY * syy - syY * sxy) / dblDet;
+	mat.items[1][1] = (syY * sxx - sxY * sxy) / dblDet;
+
+	return true;
+}
+
+static bool
+fitProjective(const std::vector<Point2D> &src, const std::vector<Point2D> &dst, const std::vector<double> &w,
+	Matrix2D &mat)
+{
+	double
+		a[8][9] = {},
+		h[8];
+
+	// Linear start with h22 = 1: [x y 1 0 0 0 -Xx -Xy] h = X and [0 0 0 x y 1 -Yx -Yy] h = Y.
+	for (size_t i = 0; i < src.size(); i++)
+	{
+		double
+			x = src[i].x,
+			y = src[i].y,
+			X = dst[i].x,
+			Y = dst[i].y,
+			r1[9] = {x, y, 1, 0, 0, 0, -X * x, -X * y, X},
+			r2[9] = {0, 0, 0, x, y, 1, -Y * x, -Y * y, Y};
+
+		for (int j = 0; j < 8; j++)
+			for (int k = 0; k < 9; k++)
+				a[j][k] += w[i] * (r1[j] * r1[k] + r2[j] * r2[k]);
+	}
+
+	if (!solveLinear(a, 8, h))
+		return false;
+
+	// Gauss-Newton (Levenberg-Marquardt) on the distances in the target plane.
+	auto cost = [&](const double *p) {
+		double
+			dblCost = 0;
+
+		for (size_t i = 0; i < src.size(); i++)
+		{
+			double
+				x = src[i].x,
+				y = src[i].y,
+				q = p[6] * x + p[7] * y + 1,
+				ex = dst[i].x - (p[0] * x + p[1] * y + p[2]) / q,
+				ey = dst[i].y - (p[3] * x + p[4] * y + p[5]) / q;
+
+			dblCost += w[i] * (ex * ex + ey * ey);
+		}
+
+		return dblCost;
+	};
+
+	double
+		dblCost = cost(h),
+		dblLambda = 1e-3;
+
+	for (int intIter = 0; intIter < 50 && dblCost > 0; intIter++)
+	{
+		double
+			n[8][9] = {};
+
+		for (size_t i = 0; i < src.size(); i++)
+		{
+			double
+				x = src[i].x,
+				y = src[i].y,
+				q = h[6] * x + h[7] * y + 1,
+				px = (h[0] * x + h[1] * y + h[2]) / q,
+				py = (h[3] * x + h[4] * y + h[5]) / q,
+				jx[8] = {x / q, y / q, 1 / q, 0, 0, 0, -px * x / q, -px * y / q},
+				jy[8] = {0, 0, 0, x / q, y / q, 1 / q, -py * x / q, -py * y / q},
+				ex = dst[i].x - px,
+				ey = dst[i].y - py;
+
+			for (int j = 0; j < 8; j++)
+			{
+				for (int k = 0; k < 8; k++)
+					n[j][k] += w[i] * (jx[j] * jx[k] + jy[j] * jy[k]);
+
+				n[j][8] += w[i] * (jx[j] * ex + jy[j] * ey);
+			}
+		}
+
+		for (int j = 0; j < 8; j++)
+			n[j][j] *= 1 + dblLambda;
+
+		double
+			dh[8],
+			hNext[8];
+
+		if (!solveLinear(n, 8, dh))
+			break;
+
+		for (int j = 0; j < 8; j++)
+			hNext[j] = h[j] + dh[j];
+
+		double
+			dblNext = cost(hNext);
+
+		if (dblNext < dblCost)
+		{
+			double
+				dblStep = 0;
+
+			for (int j = 0; j < 8; j++)
+				dblStep += fabs(dh[j]);
+
+			std::copy(hNext, hNext + 8, h);
+			dblLambda /= 10;
+
+			if (dblStep < 1e-14 || dblCost - dblNext <= 1e-15 * dblCost)
+				break;
+
+			dblCost = dblNext;
+		}
+		else if ((dblLambda *= 10) > 1e10)
+			break;
+	}
+
+	mat = {{{h[0], h[1], h[2]}, {h[3], h[4], h[5]}, {h[6], h[7], 1}}};
+
+	return true;
+}
+
+/*
+ * fitTransform.
+ */
+
+static double
+robustWeight(RobustLossEnum loss, double u)
+{
+	switch (loss)
+	{
+		case rlHuber:
+			return u <= 1.345 ? 1 : 1.345 / u;
+		case rlTukey:
+		{
+			if (u >= 4.685)
+				return 0;
+
+			double
+				t = u / 4.685;
+
+			return (1 - t * t) * (1 - t * t);
+		}
+		default:
+			return 1;
+	}
+}
+
+TransformFit
+fitTransform(const std::vector<Point2D> &source, const std::vector<Point2D> &target, const TransformFitOptions &options)
+{
+	size_t
+		n = source.size();
+
+	if (target.size() != n || (!options.weights.empty() && options.weights.size() != n))
+		RAISE(ETransformFit, tfSizeMismatch);
+
+	std::vector<double>
+		aGiven = options.weights.empty() ? std::vector<double>(n, 1) : options.weights;
+	size_t
+		intUsed = 0;
+
+	for (double w : aGiven)
+	{
+		if (!(w >= 0) || !isfinite(w))
+			RAISE(ETransformFit, tfInvalidWeight);
+
+		intUsed += w > 0;
+	}
+
+	int
+		intParams = MODEL_PARAMETERS[options.model];
+
+	if ((int) intUsed * 2 < intParams)
+		RAISE(ETransformFit, tfTooFewPoints);
+
+	TransformFit
+		res;
+	std::vector<double>
+		aWeights = aGiven;
+
+	for (int intIter = 0; intIter < std::max(options.maxIterations, 1); intIter++)
+	{
+		std::vector<Point2D>
+			aSrc,
+			aDst;
+		Point2D
+			cs, cd;
+		double
+			ss, sd;
+
+		normalizePoints(source, aWeights, aSrc, cs, ss);
+		normalizePoints(target, aWeights, aDst, cd, sd);
+
+		Matrix2D
+			mat;
+		bool
+			blnOk = options.model == tmSimilarity ? fitSimilarity(aSrc, aDst, aWeights, mat) :
+				options.model == tmAffine ? fitAffine(aSrc, aDst, aWeights, mat) : fitProjective(aSrc, aDst, aWeights, mat);
+
+		if (!blnOk)
+		{
+			// Robust weights that leave too little to fit keep the previous iteration.
+			if (intIter == 0)
+				RAISE(ETransformFit, tfDegenerate);
+
+			break;
+		}
+
+		// Back to the original coordinates: M = D^-1 Mn S.
+		Matrix2D
+			matSource = {{{ss, 0, -ss * cs.x}, {0, ss, -ss * cs.y}, {0, 0, 1}}},
+			matTarget = {{{1 / sd, 0, cd.x}, {0, 1 / sd, cd.y}, {0, 0, 1}}};
+
+		res.matrix = matTarget * mat * matSource;
+
+		if (options.model == tmProjective)
+		{
+			double
+				dblScale = res.matrix.items[2][2];
+
+			for (int i = 0; i < 3; i++)
+				for (int j = 0; j < 3; j++)
+					res.matrix.items[i][j] /= dblScale;
+		}
+
+		res.residuals.resize(n);
+		res.weights = aWeights;
+		res.iterations = intIter + 1;
+
+		for (size_t i = 0; i < n; i++)
+			res.residuals[i] = target[i] - (options.model == tmProjective ? projectiveTransform(res.matrix, source[i]) :
+				source[i].transform(res.matrix));
+
+		if (options.robust == rlNone)
+			break;
+
+		double
+			dblScale = options.robustScale;
+
+		if (!(dblScale > 0))
+		{
+			// For Gaussian errors of deviation s per axis the median length of a residual is 1.1774 s.
+			std::vector<double>
+				aLengths;
+
+			for (size_t i = 0; i < n; i++)
+				if (aGiven[i] > 0)
+					aLengths.push_back(res.residuals[i].dist());
+
+			std::nth_element(aLengths.begin(), aLengths.begin() + aLengths.size() / 2, aLengths.end());
+			dblScale = aLengths[aLengths.size() / 2] / 1.1774;
+		}
+
+		if (!(dblScale > 0))
+			break;
+
+		double
+			dblChange = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			double
+				w = aGiven[i] * robustWeight(options.robust, res.residuals[i].dist() / dblScale);
+
+			dblChange = std::max(dblChange, fabs(w - aWeights[i]));
+			aWeights[i] = w;
+		}
+
+		if (dblChange < 1e-6)
+			break;
+	}
+
+	double
+		dblSum = 0,
+		dblWeighted = 0;
+	size_t
+		intActive = 0;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		double
+			d2 = res.residuals[i].x * res.residuals[i].x + res.residuals[i].y * res.residuals[i].y;
+
+		dblSum += d2;
+		dblWeighted += res.weights[i] * d2;
+		intActive += res.weights[i] > 0;
+	}
+
+	res.rms = n > 0 ? sqrt(dblSum / n) : 0;
+	res.sigma0 = (int) intActive * 2 > intParams ? sqrt(dblWeighted / (2 * intActive - intParams)) : 0;
+
+	return res;
+}
+
+} // namespace CIVIL::MATH::GA2D
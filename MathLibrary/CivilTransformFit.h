@@ -0,0 +1,139 @@
+/***
+ * CivilTransformFit.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_TRANSFORM_FIT
+#define __CIVIL_TRANSFORM_FIT
+
+#include <vector>
+
+#include "..\MathLibrary\CivilGA2D.h"
+
+namespace CIVIL::MATH::GA2D
+{
+
+	DECLARE_ERROR_CODE(tfSizeMismatch);
+	DECLARE_ERROR_CODE(tfTooFewPoints);
+	DECLARE_ERROR_CODE(tfInvalidWeight);
+	DECLARE_ERROR_CODE(tfDegenerate);
+
+	BEGIN_DECLARE_ERROR(ETransformFit)
+		DECLARE_ERROR(tfSizeMismatch, "The point lists and the weights must have the same size")
+		DECLARE_ERROR(tfTooFewPoints, "Not enough control points for the transform")
+		DECLARE_ERROR(tfInvalidWeight, "Weights must be finite and not negative")
+		DECLARE_ERROR(tfDegenerate, "The control points do not determine the transform")
+	END_DECLARE_ERROR;
+
+	enum TransformModelEnum
+	{
+		// Helmert: rotation, uniform scale and translation; 4 parameters, at least 2 points.
+		tmSimilarity,
+		// 6 parameters, at least 3 points.
+		tmAffine,
+		// Plane homography; 8 parameters, at least 4 points.
+		tmProjective
+	};
+
+	// Weight functions of the robust fit, of the residual length over the robust scale.
+	enum RobustLossEnum
+	{
+		rlNone,
+		// 1 up to 1.345, then 1.345 / u.
+		rlHuber,
+		// (1 - (u / 4.685)^2)^2 up to 4.685, then 0.
+		rlTukey
+	};
+
+	struct TransformFitOptions
+	{
+	public:
+
+		TransformModelEnum
+			model = tmAffine;
+		// Weight of each pair, empty for all 1. A weight of 0 leaves a point out of the fit, though it still
+		// gets its residual.
+		std::vector<double>
+			weights;
+		RobustLossEnum
+			robust = rlNone;
+		// Scale of the residuals for the robust weights; 0 estimates it at every iteration from the median
+		// residual length.
+		double
+			robustScale = 0;
+		int
+			maxIterations = 20;
+
+	}; /* TransformFitOptions */
+
+	// TransformFit;
+	//
+	// A fitted transform and how well it fits. The residuals are target - transform(source), pair by pair.
+	// ---- "sigma0" is the standard error of unit weight, sqrt(sum w |r|^2 / (2n - parameters)), with n the
+	//      pairs of nonzero weight; 0 when there is no redundancy.
+	struct TransformFit
+	{
+	public:
+
+		Matrix2D
+			matrix = Matrix2D::M_IDENTITY;
+		std::vector<Point2D>
+			residuals;
+		// The weights of the last iteration, given times robust.
+		std::vector<double>
+			weights;
+		double
+			rms = 0,
+			sigma0 = 0;
+		int
+			iterations = 0;
+
+	}; /* TransformFit */
+
+	// fitTransform;
+	//
+	// Least squares transform taking "source" to "target". Both sets are moved to their centroids and
+	// ---- scaled to a mean distance of sqrt(2) before solving. The similarity and affine cases have closed
+	//      forms; the projective one starts from the linear (DLT) solution and is refined by Gauss-Newton on
+	//      the distances in the target plane. With a robust loss the fit is repeated with the weights of the
+	//      residuals (IRLS) until they settle. Raises ETransformFit for mismatched sizes, invalid weights,
+	//      too few points of nonzero weight or configurations that do not fix the transform (e.g. collinear
+	//      points for the affine case).
+	//
+	//      The matrices of the similarity and affine cases keep (0, 0, 1) as last row and apply with
+	//      Point2D::transform and transformBatch; projective ones need projectiveTransform and
+	//      projectiveBatch (CivilBatch2D.h).
+	TransformFit fitTransform(const std::vector<Point2D> &source, const std::vector<Point2D> &target,
+		const TransformFitOptions &options = TransformFitOptions());
+
+	// projectiveTransform;
+	//
+	// Applies "mat" as a plane projective transform.
+	// ----
+	Point2D projectiveTransform(const Matrix2D &mat, const Point2D &pnt);
+
+} // namespace CIVIL::MATH::GA2D
+
+#endif // ifndef __CIVIL_TRANSFORM_FIT
@@ -0,0 +1,141 @@
+/***
+ * BenchAlignment.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilAlignment.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Projection of many points onto a winding alignment of 400 elements: one at a time without and with the
+// hint, and through projectBatch with the points in alignment order and shuffled. The points are made
+// from known stations and offsets, and the largest station error is reported with the timings.
+
+static const size_t
+	CURVES = 100;
+
+static void
+report(const char *name, double time, size_t n, const std::vector<StationOffset> &res, const std::vector<StationOffset> &exact)
+{
+	double
+		dblErr = 0;
+
+	for (size_t i = 0; i < n; i++)
+		dblErr = std::max(dblErr, std::max(abs(res[i].station - exact[i].station), abs(res[i].offset - exact[i].offset)));
+
+	printf("%-24s %8.1f ns/point  max error %.2e\n", name, time * 1e9 / n, dblErr);
+}
+
+int
+main(int argc, char **argv)
+{
+	size_t
+		n = quickRun(argc, argv) ? 20000 : 2000000;
+	Alignment
+		alg(Point2D(1000, 2000), 0.3, 500);
+
+	// Tangent, spiral, arc and spiral, turning left and right by turns.
+	for (size_t i = 0; i < CURVES; i++)
+	{
+		double
+			dblRadius = i % 2 ? -400 : 400;
+
+		alg.addTangent(200);
+		alg.addSpiral(80, Alignment::STRAIGHT, dblRadius);
+		alg.addArc(150, dblRadius);
+		alg.addSpiral(80, dblRadius, Alignment::STRAIGHT);
+	}
+
+	std::mt19937_64
+		rng(43);
+	std::uniform_real_distribution<double>
+		unit(0, 1),
+		offset(-30, 30);
+	std::vector<StationOffset>
+		exact(n),
+		res(n);
+	PointBuffer
+		pnts(n);
+
+	// Stations in increasing order, kept away from the two ends.
+	for (size_t i = 0; i < n; i++)
+	{
+		exact[i].station = alg.getStartStation() + 1 + (alg.getLength() - 2) * (i + unit(rng)) / n;
+		exact[i].offset = offset(rng);
+	}
+
+	for (size_t i = 0; i < n; i++)
+		pnts.setItem(i, alg.pointAt(exact[i].station, exact[i].offset));
+
+	double
+		t0 = seconds();
+
+	for (size_t i = 0; i < n; i++)
+		alg.project(pnts.getItem(i), res[i]);
+
+	report("project", seconds() - t0, n, res, exact);
+
+	size_t
+		intHint = 0;
+
+	t0 = seconds();
+	for (size_t i = 0; i < n; i++)
+		alg.project(pnts.getItem(i), res[i], intHint);
+
+	report("project with hint", seconds() - t0, n, res, exact);
+
+	t0 = seconds();
+	alg.projectBatch(pnts, res);
+	report("projectBatch", seconds() - t0, n, res, exact);
+
+	// The same points in random order: every projection starts from an unrelated element.
+	std::vector<size_t>
+		aOrder(n);
+	PointBuffer
+		shuffled(n);
+	std::vector<StationOffset>
+		shuffledExact(n);
+
+	for (size_t i = 0; i < n; i++)
+		aOrder[i] = i;
+
+	std::shuffle(aOrder.begin(), aOrder.end(), rng);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		shuffled.setItem(i, pnts.getItem(aOrder[i]));
+		shuffledExact[i] = exact[aOrder[i]];
+	}
+
+	t0 = seconds();
+	alg.projectBatch(shuffled, res);
+	report("projectBatch shuffled", seconds() - t0, n, res, shuffledExact);
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+/***
+ * BenchAngle.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilGA2D.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Angle-heavy loops. Each one runs as the library does it now, the DMS breakdown left undone, and once
+// more asking for it on every angle it produces, which is what each construction used to cost.
+
+static double
+	dblSink = 0;
+
+template <typename Fn>
+static void
+run(const char *name, size_t n, const Fn &fn)
+{
+	double
+		t0 = seconds(),
+		dblLazy = fn(false),
+		t1 = seconds(),
+		dblEager = fn(true),
+		t2 = seconds();
+
+	dblSink += dblLazy + dblEager;
+	printf("%-24s %8.2f ns/item lazy %8.2f ns/item with DMS  (x%.1f)\n", name, (t1 - t0) * 1e9 / n, (t2 - t1) * 1e9 / n,
+		(t2 - t1) / (t1 - t0));
+}
+
+int
+main(int argc, char **argv)
+{
+	size_t
+		n = quickRun(argc, argv) ? 10000 : 10000000;
+	std::mt19937_64
+		rng(29);
+	std::uniform_real_distribution<double>
+		coord(-1000, 1000);
+	std::vector<double>
+		aX(n), aY(n);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		aX[i] = coord(rng);
+		aY[i] = coord(rng);
+	}
+
+	run("Matrix2D::rotation", n, [&](bool blnDMS) {
+		double
+			dblSum = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			Angle
+				ang = Angle(aX[i] * 1e-3) + Angle::ANGLE_45;
+
+			if (blnDMS)
+				dblSum += ang.getSeconds();
+
+			dblSum += Matrix2D::rotation(ang).items[0][1];
+		}
+
+		return dblSum;
+	});
+
+	run("Point2D::angleBetween", n, [&](bool blnDMS) {
+		double
+			dblSum = 0;
+
+		for (size_t i = 1; i < n; i++)
+		{
+			Angle
+				ang = Point2D::angleBetween(aX[i], aY[i], aX[i - 1], aY[i - 1], 0, 0);
+
+			if (blnDMS)
+				dblSum += ang.getSeconds();
+
+			dblSum += ang;
+		}
+
+		return dblSum;
+	});
+
+	run("Angle sum", n, [&](bool blnDMS) {
+		Angle
+			sum;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			sum += Angle(aX[i] * 1e-6);
+
+			if (blnDMS)
+				sum += sum.getSeconds() * 1e-30;
+		}
+
+		return (double) sum;
+	});
+
+	return dblSink == 0 ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/***
+ * BenchHull.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilHull2D.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// convexHull on three distributions: uniform in a square, where the filter discards almost everything;
+// on a circle, where it discards nothing and every point is a vertex; and in a few tight clusters, where
+// whole pieces of the buffer fall inside the filter.
+
+static void
+run(const char *name, const PointBuffer &pnts)
+{
+	std::vector<size_t>
+		serial,
+		parallel;
+	double
+		t0 = seconds();
+
+	convexHull(pnts, serial, false);
+
+	double
+		t1 = seconds();
+
+	convexHull(pnts, parallel, true);
+
+	double
+		t2 = seconds();
+
+	printf("%-10s %9zu vertices %8.2f ns/point serial %8.2f ns/point parallel%s\n", name, parallel.size(),
+		(t1 - t0) * 1e9 / pnts.size(), (t2 - t1) * 1e9 / pnts.size(), serial == parallel ? "" : "  MISMATCH");
+}
+
+int
+main(int argc, char **argv)
+{
+	size_t
+		n = quickRun(argc, argv) ? 200000 : 10000000;
+	std::mt19937_64
+		rng(38);
+	std::uniform_real_distribution<double>
+		unit(0, 1);
+	std::normal_distribution<double>
+		cluster(0, 0.5);
+	PointBuffer
+		pnts(n);
+
+	for (size_t i = 0; i < n; i++)
+		pnts.setItem(i, Point2D(unit(rng) * 1000, unit(rng) * 1000));
+
+	run("uniform", pnts);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		double
+			a = unit(rng) * 2 * M_PI;
+
+		pnts.setItem(i, Point2D(cos(a) * 1000, sin(a) * 1000));
+	}
+
+	run("circular", pnts);
+
+	// Eight clusters, each one filling long runs of the buffer.
+	for (size_t i = 0; i < n; i++)
+	{
+		size_t
+			c = i * 8 / n;
+
+		pnts.setItem(i, Point2D((double) (c % 4) * 250 + cluster(rng), (double) (c / 4) * 500 + cluster(rng)));
+	}
+
+	run("clustered", pnts);
+
+	return 0;
+}
@@ -0,0 +1,111 @@
+/***
+ * CivilTest.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_TEST
+#define __CIVIL_TEST
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "..\UtilsLibrary\CivilDispatch.h"
+
+namespace CIVIL::TESTS
+{
+
+	// Failed checks of the running test program.
+	inline int
+		testFailures = 0;
+
+	// CIVIL_CHECK;
+	//
+	// Reports a failed condition with its place and counts it; the test goes on so that one run shows
+	// ---- every failure.
+	#define CIVIL_CHECK( cond ) \
+		do \
+		{ \
+			if (!(cond)) \
+			{ \
+				if (CIVIL::TESTS::testFailures < 50) \
+					fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+				CIVIL::TESTS::testFailures++; \
+			} \
+		} while (0)
+
+	// testResult;
+	//
+	// Prints the outcome of the program and returns its exit code, 0 when every check passed.
+	// ----
+	inline int testResult(const char *name)
+	{
+		printf("%s: %d failed check(s)\n", name, testFailures);
+
+		return testFailures ? 1 : 0;
+	}
+
+	// forEachIsaLevel;
+	//
+	// Calls fn(level) once per instruction set level the machine supports, with the dispatchers forced to
+	// ---- it, so that every kernel variant is checked on the same machine.
+	template <typename Fn>
+	void forEachIsaLevel(const Fn &fn)
+	{
+		for (int intLevel = CIVIL::UTILS::ilScalar; intLevel <= CIVIL::UTILS::detectedIsaLevel(); intLevel++)
+		{
+			CIVIL::UTILS::forceIsaLevel((CIVIL::UTILS::IsaLevelEnum) intLevel);
+			fn((CIVIL::UTILS::IsaLevelEnum) intLevel);
+		}
+
+		CIVIL::UTILS::resetIsaLevel();
+	}
+
+	inline const char *isaLevelName(CIVIL::UTILS::IsaLevelEnum level)
+	{
+		static const char
+			*NAMES[] = { "scalar", "SSE2", "AVX2", "AVX-512" };
+
+		return level < CIVIL::UTILS::ilCount ? NAMES[level] : "?";
+	}
+
+	// Benchmarks.
+	//
+	// quickRun is true when the program was started with --quick, as ctest does, to run on small sizes
+	// only; seconds() is a monotonic clock.
+
+	inline bool quickRun(int argc, char **argv)
+	{
+		return argc > 1 && strcmp(argv[1], "--quick") == 0;
+	}
+
+	inline double seconds()
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+} // namespace CIVIL::TESTS
+
+#endif // ifndef __CIVIL_TEST
@@ -0,0 +1,488 @@
+/***
+ * TestAdjustment.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilAdjustment.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// SurveyNetwork::adjust against a dense Gauss-Newton solve of the same observation equations: adjusted
+// coordinates, sigma0 and the error ellipses, whose covariances come from the selected inverse of the
+// sparse factor. The approximate coordinates are off by a metre, so the solution takes several
+// iterations.
+
+static const double
+	EAST = 250000,
+	NORTH = 7800000;
+
+static double
+wrapAngle(double ang)
+{
+	return ang - 2 * M_PI * round(ang / (2 * M_PI));
+}
+
+static double
+azimuthOf(const Point2D &from, const Point2D &to)
+{
+	return atan2(to.x - from.x, to.y - from.y);
+}
+
+// Observed minus computed, with the partial derivatives of the computed value by the coordinates of the
+// stations of the observation.
+static double
+linearize(const SurveyNetwork::ObservationRecord &obs, const std::vector<Point2D> &coords, double coefs[3][2])
+{
+	const size_t
+		*s = obs.stations;
+	const Point2D
+		&a = coords[s[0]],
+		&b = coords[s[1]],
+		&c = coords[s[2]];
+
+	switch (obs.type)
+	{
+		case SurveyNetwork::otDistance:
+		{
+			double
+				d = a.dist(b);
+
+			coefs[1][0] = (b.x - a.x) / d;
+			coefs[1][1] = (b.y - a.y) / d;
+			coefs[0][0] = -coefs[1][0];
+			coefs[0][1] = -coefs[1][1];
+
+			return obs.value - d;
+		}
+		case SurveyNetwork::otAzimuth:
+		{
+			double
+				d2 = (b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y);
+
+			coefs[1][0] = (b.y - a.y) / d2;
+			coefs[1][1] = -(b.x - a.x) / d2;
+			coefs[0][0] = -coefs[1][0];
+			coefs[0][1] = -coefs[1][1];
+
+			return wrapAngle(obs.value - azimuthOf(a, b));
+		}
+		case SurveyNetwork::otAngle:
+		{
+			double
+				d2From = (b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y),
+				d2To = (c.x - a.x) * (c.x - a.x) + (c.y - a.y) * (c.y - a.y);
+
+			coefs[2][0] = (c.y - a.y) / d2To;
+			coefs[2][1] = -(c.x - a.x) / d2To;
+			coefs[1][0] = -(b.y - a.y) / d2From;
+			coefs[1][1] = (b.x - a.x) / d2From;
+			coefs[0][0] = -coefs[1][0] - coefs[2][0];
+			coefs[0][1] = -coefs[1][1] - coefs[2][1];
+
+			return wrapAngle(obs.value - (azimuthOf(a, c) - azimuthOf(a, b)));
+		}
+		default:
+		{
+			bool
+				blnY = obs.type == SurveyNetwork::otCoordinateY;
+
+			coefs[0][0] = blnY ? 0 : 1;
+			coefs[0][1] = blnY ? 1 : 0;
+
+			return obs.value - (blnY ? a.y : a.x);
+		}
+	}
+}
+
+static int
+stationsOf(const SurveyNetwork::ObservationRecord &obs)
+{
+	return obs.type == SurveyNetwork::otAngle ? 3 : (obs.type == SurveyNetwork::otDistance || obs.type == SurveyNetwork::otAzimuth ? 2 : 1);
+}
+
+// Dense Cholesky factor of the n x n matrix "a", in place (lower triangle).
+static void
+cholesky(std::vector<double> &a, size_t n)
+{
+	for (size_t j = 0; j < n; j++)
+	{
+		for (size_t k = 0; k < j; k++)
+			a[j * n + j] -= a[j * n + k] * a[j * n + k];
+		a[j * n + j] = sqrt(a[j * n + j]);
+
+		for (size_t i = j + 1; i < n; i++)
+		{
+			for (size_t k = 0; k < j; k++)
+				a[i * n + j] -= a[i * n + k] * a[j * n + k];
+			a[i * n + j] /= a[j * n + j];
+		}
+	}
+}
+
+static void
+choleskySolve(const std::vector<double> &l, size_t n, std::vector<double> &b)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		for (size_t k = 0; k < i; k++)
+			b[i] -= l[i * n + k] * b[k];
+		b[i] /= l[i * n + i];
+	}
+	for (size_t i = n; i-- > 0;)
+	{
+		for (size_t k = i + 1; k < n; k++)
+			b[i] -= l[k * n + i] * b[k];
+		b[i] /= l[i * n + i];
+	}
+}
+
+struct DenseSolution
+{
+public:
+
+	std::vector<Point2D>
+		coordinates;
+	std::vector<double>
+		qxx,
+		qxy,
+		qyy;
+	double
+		sigma0 = 0;
+	int
+		iterations = 0;
+
+}; /* DenseSolution */
+
+// Gauss-Newton with the full normal matrix; the cofactors are those of the last normal equations.
+static DenseSolution
+denseAdjust(const SurveyNetwork &net, double tolerance)
+{
+	size_t
+		intStations = net.getStationCount(),
+		n = 0;
+	std::vector<size_t>
+		aIndex(intStations, SIZE_MAX);
+	DenseSolution
+		sol;
+
+	for (size_t s = 0; s < intStations; s++)
+	{
+		sol.coordinates.push_back(net.getStation(s));
+		if (!net.isFixed(s))
+		{
+			aIndex[s] = n;
+			n += 2;
+		}
+	}
+
+	std::vector<double>
+		aNormal,
+		aRight;
+	double
+		dblMove = INFINITY;
+
+	while (dblMove > tolerance && sol.iterations < 20)
+	{
+		aNormal.assign(n * n, 0);
+		aRight.assign(n, 0);
+
+		for (size_t o = 0; o < net.getObservationCount(); o++)
+		{
+			const SurveyNetwork::ObservationRecord
+				&obs = net.getObservation(o);
+			double
+				coefs[3][2],
+				w = 1 / (obs.sigma * obs.sigma),
+				l = linearize(obs, sol.coordinates, coefs);
+			int
+				k = stationsOf(obs);
+
+			for (int i = 0; i < 2 * k; i++)
+			{
+				size_t
+					row = aIndex[obs.stations[i / 2]];
+
+				if (row == SIZE_MAX)
+					continue;
+
+				aRight[row + i % 2] += w * coefs[i / 2][i % 2] * l;
+
+				for (int j = 0; j < 2 * k; j++)
+				{
+					size_t
+						col = aIndex[obs.stations[j / 2]];
+
+					if (col != SIZE_MAX)
+						aNormal[(row + i % 2) * n + col + j % 2] += w * coefs[i / 2][i % 2] * coefs[j / 2][j % 2];
+				}
+			}
+		}
+
+		cholesky(aNormal, n);
+		choleskySolve(aNormal, n, aRight);
+
+		dblMove = 0;
+		for (size_t s = 0; s < intStations; s++)
+			if (aIndex[s] != SIZE_MAX)
+			{
+				sol.coordinates[s].x += aRight[aIndex[s]];
+				sol.coordinates[s].y += aRight[aIndex[s] + 1];
+				dblMove = std::max(dblMove, std::max(abs(aRight[aIndex[s]]), abs(aRight[aIndex[s] + 1])));
+			}
+
+		sol.iterations++;
+	}
+
+	// The 2 x 2 blocks of the inverse, one unit column at a time.
+	sol.qxx.assign(intStations, 0);
+	sol.qxy.assign(intStations, 0);
+	sol.qyy.assign(intStations, 0);
+
+	for (size_t s = 0; s < intStations; s++)
+		if (aIndex[s] != SIZE_MAX)
+		{
+			std::vector<double>
+				e(n, 0);
+
+			e[aIndex[s]] = 1;
+			choleskySolve(aNormal, n, e);
+			sol.qxx[s] = e[aIndex[s]];
+			sol.qxy[s] = e[aIndex[s] + 1];
+
+			e.assign(n, 0);
+			e[aIndex[s] + 1] = 1;
+			choleskySolve(aNormal, n, e);
+			sol.qyy[s] = e[aIndex[s] + 1];
+		}
+
+	double
+		dblSum = 0,
+		coefs[3][2];
+
+	for (size_t o = 0; o < net.getObservationCount(); o++)
+	{
+		const SurveyNetwork::ObservationRecord
+			&obs = net.getObservation(o);
+		double
+			l = linearize(obs, sol.coordinates, coefs);
+
+		dblSum += l * l / (obs.sigma * obs.sigma);
+	}
+
+	long long
+		intRedundancy = (long long) net.getObservationCount() - (long long) n;
+
+	sol.sigma0 = intRedundancy > 0 ? sqrt(dblSum / intRedundancy) : 0;
+
+	return sol;
+}
+
+// A side x side lattice of stations 400 m apart, slightly irregular, observed with distances to the
+// neighbours, angles at every station, a few azimuths and the two corners fixed. The approximations are
+// the true coordinates moved up to a metre.
+static SurveyNetwork
+lattice(std::mt19937_64 &rng, int side, std::vector<Point2D> &truth)
+{
+	std::uniform_real_distribution<double>
+		jitter(-30, 30),
+		offset(-1, 1);
+	std::normal_distribution<double>
+		distNoise(0, 0.003),
+		angNoise(0, 2e-5);
+	SurveyNetwork
+		net;
+
+	truth.clear();
+	for (int i = 0; i < side; i++)
+		for (int j = 0; j < side; j++)
+		{
+			Point2D
+				pnt(EAST + 400 * j + jitter(rng), NORTH + 400 * i + jitter(rng));
+			bool
+				blnFixed = (i == 0 && j == 0) || (i == side - 1 && j == side - 1);
+
+			truth.push_back(pnt);
+			net.addStation(blnFixed ? pnt : Point2D(pnt.x + offset(rng), pnt.y + offset(rng)), blnFixed);
+		}
+
+	auto
+		at = [side](int i, int j) { return (size_t) (i * side + j); };
+
+	for (int i = 0; i < side; i++)
+		for (int j = 0; j < side; j++)
+		{
+			if (j + 1 < side)
+				net.addDistance(at(i, j), at(i, j + 1), truth[at(i, j)].dist(truth[at(i, j + 1)]) + distNoise(rng), 0.003);
+			if (i + 1 < side)
+				net.addDistance(at(i, j), at(i + 1, j), truth[at(i, j)].dist(truth[at(i + 1, j)]) + distNoise(rng), 0.003);
+			if (i + 1 < side && j + 1 < side)
+			{
+				net.addDistance(at(i, j), at(i + 1, j + 1), truth[at(i, j)].dist(truth[at(i + 1, j + 1)]) + distNoise(rng), 0.004);
+				net.addAngle(at(i, j), at(i, j + 1), at(i + 1, j), Angle(wrapAngle(azimuthOf(truth[at(i, j)], truth[at(i + 1, j)]) -
+					azimuthOf(truth[at(i, j)], truth[at(i, j + 1)])) + angNoise(rng)), 2e-5);
+			}
+		}
+
+	net.addAzimuth(at(0, 0), at(0, 1), Angle(azimuthOf(truth[at(0, 0)], truth[at(0, 1)]) + angNoise(rng)), 2e-5);
+
+	return net;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	std::mt19937_64
+		rng(46);
+	std::vector<Point2D>
+		aTruth;
+
+	for (int intSide : { 4, 12 })
+	{
+		SurveyNetwork
+			net = lattice(rng, intSide, aTruth);
+
+		// A free station tied by a coordinate observation only, besides its distances.
+		size_t
+			intTied = net.addStation(Point2D(EAST - 399.5, NORTH + 0.7));
+
+		aTruth.push_back(Point2D(EAST - 400, NORTH));
+		net.addCoordinate(intTied, Point2D(EAST - 400 + 0.004, NORTH - 0.01), 0.01, 0.02);
+		net.addDistance(intTied, 0, aTruth[intTied].dist(aTruth[0]) + 0.002, 0.003);
+
+		AdjustmentOptions
+			options;
+
+		options.tolerance = 1e-7;
+
+		DenseSolution
+			dense = denseAdjust(net, 1e-7);
+
+		for (bool blnParallel : { false, true })
+		{
+			options.parallel = blnParallel;
+
+			NetworkAdjustment
+				adj = net.adjust(options);
+
+			CIVIL_CHECK(adj.converged && adj.iterations > 1 && dense.iterations > 1);
+			CIVIL_CHECK(adj.coordinates.size() == net.getStationCount() && adj.ellipses.size() == net.getStationCount());
+			CIVIL_CHECK(adj.residuals.size() == net.getObservationCount());
+			CIVIL_CHECK(adj.redundancy == (long long) net.getObservationCount() - 2 * ((long long) net.getStationCount() - 2));
+			CIVIL_CHECK(abs(adj.sigma0 - dense.sigma0) <= 1e-6 * dense.sigma0 && adj.sigma0 > 0.3 && adj.sigma0 < 3);
+
+			double
+				dblCoords = 0,
+				dblTruth = 0,
+				dblEllipse = 0;
+
+			for (size_t s = 0; s < net.getStationCount(); s++)
+			{
+				dblCoords = std::max(dblCoords, adj.coordinates[s].dist(dense.coordinates[s]));
+				dblTruth = std::max(dblTruth, adj.coordinates[s].dist(aTruth[s]));
+
+				if (net.isFixed(s))
+				{
+					CIVIL_CHECK(adj.coordinates[s].x == aTruth[s].x && adj.ellipses[s].major == 0 && adj.ellipses[s].minor == 0);
+					continue;
+				}
+
+				// The ellipse of the dense cofactors, scaled a posteriori.
+				double
+					v = dense.sigma0 * dense.sigma0,
+					qxx = v * dense.qxx[s],
+					qxy = v * dense.qxy[s],
+					qyy = v * dense.qyy[s],
+					dblMean = (qxx + qyy) / 2,
+					dblRadius = hypot((qxx - qyy) / 2, qxy),
+					dblMajor = sqrt(dblMean + dblRadius),
+					dblMinor = sqrt(dblMean - dblRadius);
+				const ErrorEllipse
+					&ell = adj.ellipses[s];
+
+				dblEllipse = std::max(dblEllipse, std::max(abs(ell.major - dblMajor) / dblMajor, abs(ell.minor - dblMinor) / dblMinor));
+				CIVIL_CHECK((double) ell.azimuth >= 0 && (double) ell.azimuth < M_PI && ell.major >= ell.minor);
+
+				// The major axis is the direction of the largest variance.
+				double
+					t = (double) ell.azimuth,
+					dblAlong = qxx * sin(t) * sin(t) + 2 * qxy * sin(t) * cos(t) + qyy * cos(t) * cos(t);
+
+				CIVIL_CHECK(abs(dblAlong - dblMajor * dblMajor) <= 1e-6 * dblMajor * dblMajor);
+			}
+
+			printf("%zu stations, %s: %d iterations, sigma0 %.4f, coordinates within %.1e of the dense solve, "
+				"ellipse axes within %.1e\n", net.getStationCount(), blnParallel ? "parallel" : "serial", adj.iterations,
+				adj.sigma0, dblCoords, dblEllipse);
+			CIVIL_CHECK(dblCoords < 1e-6 && dblEllipse < 1e-6 && dblTruth < 0.05);
+		}
+	}
+
+	// Without redundancy sigma0 is 0 and the ellipses follow the given standard deviations: one station
+	// placed by a distance (1 cm along the line) and an azimuth (0.5 cm across it) from a fixed one.
+	SurveyNetwork
+		polar;
+
+	polar.addStation(Point2D(EAST, NORTH), true);
+	polar.addStation(Point2D(EAST + 70, NORTH + 70));
+	polar.addDistance(0, 1, 100, 0.01);
+	polar.addAzimuth(0, 1, Angle(M_PI / 4), 5e-5);
+
+	NetworkAdjustment
+		adj = polar.adjust();
+
+	CIVIL_CHECK(adj.redundancy == 0 && adj.sigma0 == 0 && adj.converged);
+	CIVIL_CHECK(abs(adj.coordinates[1].x - (EAST + 100 * M_SQRT1_2)) < 1e-6 && abs(adj.coordinates[1].y - (NORTH + 100 * M_SQRT1_2)) < 1e-6);
+	CIVIL_CHECK(abs(adj.ellipses[1].major - 0.01) < 1e-9 && abs(adj.ellipses[1].minor - 0.005) < 1e-9);
+	CIVIL_CHECK(abs((double) adj.ellipses[1].azimuth - M_PI / 4) < 1e-6);
+
+	// Without a datum the normal equations are singular.
+	SurveyNetwork
+		free;
+	bool
+		blnRaised = false;
+
+	free.addStation(Point2D(0, 0));
+	free.addStation(Point2D(100, 0));
+	free.addDistance(0, 1, 100, 0.01);
+
+	try
+	{
+		free.adjust();
+	}
+	catch (const EAdjustment &)
+	{
+		blnRaised = true;
+	}
+	CIVIL_CHECK(blnRaised);
+
+	return testResult("TestAdjustment");
+}
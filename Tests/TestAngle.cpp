@@ -0,0 +1,86 @@
+/***
+ * TestAngle.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <atomic>
+
+#include "..\MathLibrary\CivilAngle.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// Angle keeps the radians only; the degrees/minutes/seconds are stored when given and derived otherwise.
+
+static_assert(sizeof(Angle) == 16, "an Angle is one double and its DMS components");
+
+int
+main()
+{
+	// Whole DMS values survive the trip through the radians.
+	for (int d = -359; d < 360; d += 7)
+		for (int m = 0; m < 60; m += 11)
+			for (int s = 0; s < 60; s += 13)
+			{
+				Angle
+					ang(0, d, m, s),
+					derived((double) ang);
+
+				CIVIL_CHECK(ang.getDegrees() == d && ang.getMinutes() == m && ang.getSeconds() == s);
+				CIVIL_CHECK(derived.getDegrees() == d && derived.getMinutes() == m && derived.getSeconds() == s);
+			}
+
+	// Setters start from the components derived from the radians.
+	Angle
+		ang = Angle(0, 10, 20, 30) + Angle(0, 1, 0, 0);
+
+	CIVIL_CHECK(ang.getDegrees() == 11 && ang.getMinutes() == 20 && ang.getSeconds() == 30);
+	ang.setMinutes(45);
+	CIVIL_CHECK(ang.getDegrees() == 11 && ang.getMinutes() == 45 && ang.getSeconds() == 30);
+	CIVIL_CHECK(abs((double) ang - (11 + 45 / 60.0 + 30 / 3600.0) * M_PI / 180) < 1e-15);
+	ang.setTurns(1);
+	CIVIL_CHECK(ang.getTurns() == 1 && abs((double) ang - (371 + 45 / 60.0 + 30 / 3600.0) * M_PI / 180) < 1e-14);
+
+	// Arithmetic results carry the radians only.
+	CIVIL_CHECK((Angle::ANGLE_90 + Angle::ANGLE_45).getDegrees() == 135);
+	CIVIL_CHECK((Angle::ANGLE_360 + Angle::ANGLE_45).getTurns() == 1);
+
+	// A shared angle is read from every thread of the pool; const members never write, so all agree.
+	const Angle
+		shared = Angle(0, 123, 45, 6) - Angle(0, 0, 0, 1);
+	std::atomic<int>
+		intWrong(0);
+
+	parallelFor(0, 1 << 20, 1 << 10, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			if (shared.getDegrees() != 123 || shared.getMinutes() != 45 || shared.getSeconds() != 5)
+				intWrong++;
+	});
+
+	CIVIL_CHECK(intWrong == 0);
+
+	return testResult("TestAngle");
+}
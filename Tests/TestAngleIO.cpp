@@ -0,0 +1,94 @@
+/***
+ * TestAngleIO.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "..\MathLibrary\CivilAngleIO.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Parses "text" with every thread count from 1 to 16 and checks the line count and the value of each line.
+static void
+checkLines(const std::string &text, const std::vector<double> &degrees)
+{
+	for (unsigned int threads = 1; threads <= 16; threads++)
+	{
+		std::vector<Angle>
+			angles;
+		std::vector<AngleParseEnum>
+			results;
+		size_t
+			n = parseAngleLines(text.data(), text.size(), angles, results, threads);
+
+		CIVIL_CHECK(n == degrees.size() && angles.size() == n && results.size() == n);
+		if (n != degrees.size())
+			continue;
+
+		for (size_t i = 0; i < n; i++)
+			CIVIL_CHECK(results[i] == apOk && abs((double) angles[i] - degrees[i] * M_PI / 180) < 1e-12);
+	}
+}
+
+int
+main()
+{
+	// Short buffers without the final newline, parsed in the calling thread.
+	checkLines("45", { 45 });
+	checkLines("10\n20\n30", { 10, 20, 30 });
+	checkLines("10\r\n20\r\n30", { 10, 20, 30 });
+
+	// A buffer past the parallel threshold whose unterminated last line covers most of it: the bounds of
+	// ---- the later chunks all fall on the end of the buffer, and the chunk that parses the last line is not
+	//      the last one.
+	std::string
+		text = "10\n20\n30\n";
+
+	text.append(100000, ' ');
+	text += "45";
+	checkLines(text, { 10, 20, 30, 45 });
+
+	// The same line terminated, which must not count twice.
+	checkLines(text + "\n", { 10, 20, 30, 45 });
+
+	// Many short lines, with and without the final newline.
+	std::vector<double>
+		degrees;
+
+	text.clear();
+	for (int i = 0; i < 50000; i++)
+	{
+		degrees.push_back(i % 360);
+		text += std::to_string(i % 360) + "\n";
+	}
+
+	checkLines(text, degrees);
+	text.pop_back();
+	checkLines(text, degrees);
+
+	return testResult("TestAngleIO");
+}
@@ -0,0 +1,173 @@
+/***
+ * TestAtan2Accuracy.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilBatch2D.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Accuracy report of the atan2 tiers (CivilBatch2D.h): largest error against the libm atan2 in radians,
+// arc-seconds and units in the last place of the exact result, over uniform and nearly axial directions.
+
+static const double
+	TWO_PI = 2 * M_PI,
+	RAD_TO_SEC = 180 * 3600 / M_PI;
+
+struct ErrorReport
+{
+public:
+
+	double
+		maxRad = 0,
+		maxUlp = 0;
+
+	void add(double value, double exact)
+	{
+		double
+			dblErr = abs(value - exact),
+			dblUlp = nextafter(abs(exact), INFINITY) - abs(exact);
+
+		if (dblErr > maxRad)
+			maxRad = dblErr;
+		if (dblErr / dblUlp > maxUlp)
+			maxUlp = dblErr / dblUlp;
+	}
+
+}; /* ErrorReport */
+
+// Difference of two azimuths in [0, 2 pi], across the 0 / 2 pi seam.
+static double
+azimuthError(double a, double b)
+{
+	double
+		d = abs(a - b);
+
+	return d < TWO_PI - d ? d : TWO_PI - d;
+}
+
+int
+main()
+{
+	std::mt19937_64
+		rng(28);
+	std::uniform_real_distribution<double>
+		angle(-M_PI, M_PI),
+		scale(-300, 300),
+		unit(-1, 1);
+	std::vector<double>
+		aX, aY;
+
+	for (int i = 0; i < 2000000; i++)
+	{
+		double
+			a = angle(rng),
+			r = pow(10, scale(rng) / 10);
+
+		aX.push_back(r * cos(a));
+		aY.push_back(r * sin(a));
+	}
+
+	// Nearly axial directions, where the reductions of the argument lose the most.
+	for (int i = 0; i < 400000; i++)
+	{
+		double
+			dblSmall = unit(rng) * pow(10, -scale(rng) / 20 - 16),
+			dblLarge = unit(rng) < 0 ? -1 : 1;
+
+		aX.push_back(i % 2 ? dblSmall : dblLarge);
+		aY.push_back(i % 2 ? dblLarge : dblSmall);
+	}
+
+	aX.push_back(0);
+	aY.push_back(0);
+	aX.push_back(-1);
+	aY.push_back(-0.0);
+
+	const AccuracyEnum
+		TIERS[] = { acExact, acHigh, acFast };
+	const char
+		*NAMES[] = { "acExact", "acHigh", "acFast" };
+	const double
+		BOUNDS[] = { 0, 1e-12, 1e-7 };
+
+	printf("%-8s %12s %12s %12s\n", "tier", "max rad", "max arc-sec", "max ulp");
+
+	for (int k = 0; k < 3; k++)
+	{
+		ErrorReport
+			report;
+
+		for (size_t i = 0; i < aX.size(); i++)
+			report.add(fastAtan2(aY[i], aX[i], TIERS[k]), atan2(aY[i], aX[i]));
+
+		printf("%-8s %12.3g %12.3g %12.3g\n", NAMES[k], report.maxRad, report.maxRad * RAD_TO_SEC, report.maxUlp);
+		CIVIL_CHECK(report.maxRad <= BOUNDS[k]);
+
+		// The batch forms give azimuths in [0, 2 pi) within the same bound.
+		PointBuffer
+			from(aX.size()),
+			to(aX.size());
+		std::vector<double>
+			aRef,
+			aPair;
+
+		for (size_t i = 0; i < aX.size(); i++)
+		{
+			from.x[i] = 10;
+			from.y[i] = -20;
+			to.x[i] = aX[i] + 10;
+			to.y[i] = aY[i] - 20;
+		}
+
+		angleAxeXBatch(to, Point2D(10, -20), TIERS[k], aRef);
+		angleAxeXBatch(from, to, TIERS[k], aPair);
+
+		double
+			dblWorst = 0;
+		bool
+			blnRange = true;
+
+		for (size_t i = 0; i < aX.size(); i++)
+		{
+			double
+				dx = to.x[i] - 10,
+				dy = to.y[i] + 20,
+				exact = atan2(dy, dx);
+
+			exact = exact < 0 ? exact + TWO_PI : exact;
+			dblWorst = fmax(dblWorst, fmax(azimuthError(aRef[i], exact), azimuthError(aPair[i], exact)));
+			blnRange = blnRange && aRef[i] >= 0 && aRef[i] < TWO_PI && aPair[i] >= 0 && aPair[i] < TWO_PI;
+		}
+
+		CIVIL_CHECK(blnRange);
+		CIVIL_CHECK(dblWorst <= BOUNDS[k] + 4e-15);
+	}
+
+	return testResult("TestAtan2Accuracy");
+}
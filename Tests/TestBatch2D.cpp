@@ -0,0 +1,334 @@
+/***
+ * TestBatch2D.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilBatch2D.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// The rectangle queries against a scalar loop, down to the unused bits of the last mask word, boundsOf with
+// NaN items mixed in, and clipBatch against points sampled along every vector; each at every instruction
+// set level.
+
+static const double
+	EAST = 612345.5,
+	NORTH = 7212345.25,
+	NaN = std::numeric_limits<double>::quiet_NaN();
+
+static bool
+overlaps(const Rectangle2D &query, const Rectangle2D &rect)
+{
+	return rect.left <= query.right && rect.right >= query.left && rect.bottom <= query.top && rect.top >= query.bottom;
+}
+
+static bool
+within(const Rectangle2D &query, const Rectangle2D &rect)
+{
+	return rect.left >= query.left && rect.right <= query.right && rect.bottom >= query.bottom && rect.top <= query.top;
+}
+
+static bool
+inWindow(const Rectangle2D &window, double x, double y)
+{
+	return x >= window.left && x <= window.right && y >= window.bottom && y <= window.top;
+}
+
+// The mask has one bit per rectangle, set as "test" says, and nothing past the last one.
+template <typename Test>
+static bool
+sameMask(const Rectangle2D &query, const RectangleBuffer &rects, const std::vector<uint64_t> &mask,
+	const std::vector<size_t> &indexes, const Test &test)
+{
+	size_t
+		n = rects.size(),
+		intNext = 0;
+
+	if (mask.size() != (n + 63) / 64)
+		return false;
+
+	for (size_t i = 0; i < 64 * mask.size(); i++)
+	{
+		bool
+			blnBit = (mask[i / 64] >> (i % 64)) & 1;
+
+		if (blnBit != (i < n && test(query, rects.getItem(i))))
+			return false;
+
+		if (blnBit && (intNext >= indexes.size() || indexes[intNext++] != i))
+			return false;
+	}
+
+	return intNext == indexes.size();
+}
+
+static bool
+sameRect(const Rectangle2D &a, const Rectangle2D &b)
+{
+	return a.left == b.left && a.bottom == b.bottom && a.right == b.right && a.top == b.top;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	forEachIsaLevel([](CIVIL::UTILS::IsaLevelEnum level)
+	{
+		std::mt19937_64
+			rng(50);
+		std::uniform_real_distribution<double>
+			coord(-500, 500),
+			size(0, 80);
+
+		// Counts around the word and vector widths, and one large enough to be split on the pool.
+		for (size_t n : { 0, 1, 7, 63, 64, 65, 127, 129, 1000, 200003 })
+		{
+			RectangleBuffer
+				rects;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				double
+					x = EAST + coord(rng),
+					y = NORTH + coord(rng);
+
+				// Some NaN rectangles, which pass no test, and some sharing a side with the query.
+				if (i % 97 == 13)
+					rects.add(Rectangle2D(NaN, y, x + 1, y + 1));
+				else if (i % 89 == 5)
+					rects.add(Rectangle2D(EAST + 200, y, EAST + 200 + size(rng), y + size(rng)));
+				else
+					rects.add(Rectangle2D(x, y, x + size(rng), y + size(rng)));
+			}
+
+			const Rectangle2D
+				QUERY(EAST - 100, NORTH - 150, EAST + 200, NORTH + 250),
+				EVERYTHING(-INFINITY, -INFINITY, INFINITY, INFINITY);
+			std::vector<uint64_t>
+				aMask(3, ~0ull),
+				aOther;
+			std::vector<size_t>
+				aIndexes{ 42 };
+
+			overlapsMask(QUERY, rects, aMask);
+			overlapsIndexes(QUERY, rects, aIndexes);
+			CIVIL_CHECK(sameMask(QUERY, rects, aMask, aIndexes, overlaps));
+
+			containsMask(QUERY, rects, aOther);
+			containsIndexes(QUERY, rects, aIndexes);
+			CIVIL_CHECK(sameMask(QUERY, rects, aOther, aIndexes, within));
+
+			// Every mask listed by maskIndexes, and masks combined before listing.
+			std::vector<size_t>
+				aListed;
+
+			maskIndexes(aOther, aListed);
+			CIVIL_CHECK(aListed == aIndexes);
+
+			for (size_t w = 0; w < aMask.size(); w++)
+				aMask[w] &= ~aOther[w];
+			maskIndexes(aMask, aListed);
+			CIVIL_CHECK(sameMask(QUERY, rects, aMask, aListed, [](const Rectangle2D &q, const Rectangle2D &r) {
+				return overlaps(q, r) && !within(q, r);
+			}));
+
+			// A query holding everything sets every bit up to the last rectangle, but not the NaN ones, and
+			// none after it.
+			overlapsMask(EVERYTHING, rects, aMask);
+			overlapsIndexes(EVERYTHING, rects, aIndexes);
+			CIVIL_CHECK(sameMask(EVERYTHING, rects, aMask, aIndexes, overlaps));
+			CIVIL_CHECK(n % 64 == 0 || (aMask.back() >> (n % 64)) == 0);
+		}
+
+		// boundsOf skips the items with a NaN coordinate.
+		std::vector<Point2D>
+			aPnts;
+		std::vector<Rectangle2D>
+			aRects;
+		std::vector<Circle2D>
+			aCircles;
+		Rectangle2D
+			rectPnts(INFINITY, INFINITY, -INFINITY, -INFINITY),
+			rectRects = rectPnts,
+			rectCircles = rectPnts;
+
+		for (int i = 0; i < 10007; i++)
+		{
+			double
+				x = EAST + coord(rng),
+				y = NORTH + coord(rng),
+				r = size(rng);
+			bool
+				blnNaN = i % 10 == 3;
+
+			aPnts.push_back(blnNaN ? Point2D(i % 20 == 3 ? NaN : EAST + 9999, i % 20 == 3 ? NORTH + 9999 : NaN) : Point2D(x, y));
+			aRects.push_back(blnNaN ? Rectangle2D(x, y, NaN, y + r) : Rectangle2D(x, y, x + r, y + r));
+			aCircles.push_back(Circle2D(blnNaN ? Point2D(NaN, y) : Point2D(x, y), r));
+
+			if (!blnNaN)
+			{
+				rectPnts = Rectangle2D(std::min(rectPnts.left, x), std::min(rectPnts.bottom, y), std::max(rectPnts.right, x), std::max(rectPnts.top, y));
+				rectRects = Rectangle2D(std::min(rectRects.left, x), std::min(rectRects.bottom, y), std::max(rectRects.right, x + r), std::max(rectRects.top, y + r));
+				rectCircles = Rectangle2D(std::min(rectCircles.left, x - r), std::min(rectCircles.bottom, y - r), std::max(rectCircles.right, x + r), std::max(rectCircles.top, y + r));
+			}
+		}
+
+		PointBuffer
+			bufPnts;
+		RectangleBuffer
+			bufRects;
+		CircleBuffer
+			bufCircles;
+
+		for (int i = 0; i < 10007; i++)
+		{
+			bufPnts.add(aPnts[i]);
+			bufRects.add(aRects[i]);
+			bufCircles.add(aCircles[i]);
+		}
+
+		CIVIL_CHECK(sameRect(boundsOf(aPnts), rectPnts) && sameRect(boundsOf(bufPnts), rectPnts));
+		CIVIL_CHECK(sameRect(boundsOf(aRects), rectRects) && sameRect(boundsOf(bufRects), rectRects));
+		CIVIL_CHECK(sameRect(boundsOf(aCircles), rectCircles) && sameRect(boundsOf(bufCircles), rectCircles));
+
+		// Nothing but NaN, or nothing at all, gives Rectangle2D().
+		CIVIL_CHECK(sameRect(boundsOf(std::vector<Point2D>{ Point2D(NaN, 1), Point2D(2, NaN) }), Rectangle2D()));
+		CIVIL_CHECK(sameRect(boundsOf(std::vector<Rectangle2D>()), Rectangle2D()));
+
+		// clipBatch against 2001 points along each vector: every sampled point inside the window lies on
+		// the clipped part, whose end points are inside the window and on the vector.
+		const Rectangle2D
+			WINDOW(EAST - 200, NORTH - 120, EAST + 260, NORTH + 300);
+		SegmentBuffer
+			vectors,
+			clipped;
+		std::vector<unsigned char>
+			aVisible;
+
+		for (int i = 0; i < 3001; i++)
+		{
+			Point2D
+				a(EAST + coord(rng), NORTH + coord(rng)),
+				b(EAST + coord(rng), NORTH + coord(rng));
+
+			// Vectors along the sides of the window and fully inside it, and points.
+			if (i % 50 == 7)
+				a = Point2D(WINDOW.left, a.y), b = Point2D(WINDOW.left, b.y);
+			else if (i % 50 == 9)
+				a = Point2D(EAST, NORTH), b = Point2D(EAST + 10, NORTH - 20);
+			else if (i % 50 == 11)
+				b = a;
+
+			vectors.add(Vector2D(a, b));
+		}
+
+		size_t
+			intVisible = clipBatch(WINDOW, vectors, clipped, aVisible),
+			intCount = 0,
+			intWrong = 0;
+
+		CIVIL_CHECK(clipped.size() == vectors.size() && aVisible.size() == vectors.size());
+
+		for (size_t i = 0; i < vectors.size(); i++)
+		{
+			Vector2D
+				vtr = vectors.getItem(i),
+				res = clipped.getItem(i);
+			double
+				dx = vtr.pnt2.x - vtr.pnt1.x,
+				dy = vtr.pnt2.y - vtr.pnt1.y,
+				dblLength = sqrt(dx * dx + dy * dy);
+			bool
+				blnSampled = false;
+
+			intCount += aVisible[i];
+
+			if (!aVisible[i])
+			{
+				// Given back as is, with no sample inside.
+				intWrong += !(res.pnt1.x == vtr.pnt1.x && res.pnt1.y == vtr.pnt1.y && res.pnt2.x == vtr.pnt2.x && res.pnt2.y == vtr.pnt2.y);
+				for (int k = 0; k <= 2000; k++)
+					intWrong += inWindow(WINDOW, vtr.pnt1.x + dx * k / 2000, vtr.pnt1.y + dy * k / 2000);
+				continue;
+			}
+
+			// End points inside come out unchanged; the clipped ones lie on the window and on the vector.
+			if (inWindow(WINDOW, vtr.pnt1.x, vtr.pnt1.y))
+				intWrong += !(res.pnt1.x == vtr.pnt1.x && res.pnt1.y == vtr.pnt1.y);
+			if (inWindow(WINDOW, vtr.pnt2.x, vtr.pnt2.y))
+				intWrong += !(res.pnt2.x == vtr.pnt2.x && res.pnt2.y == vtr.pnt2.y);
+
+			for (const Point2D &pnt : { res.pnt1, res.pnt2 })
+			{
+				intWrong += !inWindow(Rectangle2D(WINDOW.left - 1e-6, WINDOW.bottom - 1e-6, WINDOW.right + 1e-6, WINDOW.top + 1e-6), pnt.x, pnt.y);
+				intWrong += dblLength > 0 && abs(dx * (pnt.y - vtr.pnt1.y) - dy * (pnt.x - vtr.pnt1.x)) > 1e-6 * dblLength;
+			}
+
+			// Same direction, and every inside sample between the clipped end points.
+			double
+				t1 = dblLength > 0 ? (dx * (res.pnt1.x - vtr.pnt1.x) + dy * (res.pnt1.y - vtr.pnt1.y)) / (dblLength * dblLength) : 0,
+				t2 = dblLength > 0 ? (dx * (res.pnt2.x - vtr.pnt1.x) + dy * (res.pnt2.y - vtr.pnt1.y)) / (dblLength * dblLength) : 0;
+
+			intWrong += t1 > t2 + 1e-12;
+
+			for (int k = 0; k <= 2000; k++)
+			{
+				double
+					t = k / 2000.0;
+
+				if (inWindow(WINDOW, vtr.pnt1.x + dx * t, vtr.pnt1.y + dy * t))
+				{
+					blnSampled = true;
+					intWrong += dblLength > 0 && (t < t1 - 1e-9 || t > t2 + 1e-9);
+				}
+			}
+
+			// Visible parts shorter than the sampling step may be missed by it.
+			intWrong += !blnSampled && (t2 - t1) * dblLength > dblLength / 2000;
+		}
+
+		CIVIL_CHECK(intWrong == 0 && intVisible == intCount && intVisible > 300 && intVisible < vectors.size());
+
+		// In place, with the same results.
+		SegmentBuffer
+			inPlace = vectors;
+		std::vector<unsigned char>
+			aVisible2;
+
+		CIVIL_CHECK(clipBatch(WINDOW, inPlace, inPlace, aVisible2) == intVisible && aVisible2 == aVisible);
+		for (size_t i = 0; i < vectors.size(); i++)
+			CIVIL_CHECK(inPlace.getItem(i).pnt1.x == clipped.getItem(i).pnt1.x && inPlace.getItem(i).pnt2.y == clipped.getItem(i).pnt2.y);
+
+		printf("%-8s %zu of %zu vectors visible in the window\n", isaLevelName(level), intVisible, vectors.size());
+	});
+
+	return testResult("TestBatch2D");
+}
@@ -0,0 +1,111 @@
+/***
+ * TestConstexpr.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "..\MathLibrary\CivilGA2D.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Transform chains built only from constants must fold at compile time; each assertion below fails the
+// build if one of the operations involved stops being constexpr. main repeats a few of them at run time,
+// where the same functions must give the same values.
+
+constexpr Matrix2D
+	MAT_CHAIN = Matrix2D::translation(10, 20) * Matrix2D::rotation(1, 0) * Matrix2D::scale(2, 3),
+	MAT_PIVOT = Matrix2D::rotation(1, 0, 5, 5);
+constexpr Point2D
+	PNT_CHAIN = Point2D(1, 1).transform(MAT_CHAIN),
+	PNT_PIVOT = Point2D(6, 5).transform(MAT_PIVOT);
+constexpr Vector2D
+	VTR_MOVED = Vector2D(0, 0, 4, 0).moveTo(1, 1) + Vector2D(0, 0, 0, 2);
+constexpr Rectangle2D
+	RECT_UNION = Rectangle2D::combine(Rectangle2D(0, 0, 2, 2), Rectangle2D(1, 1, 4, 3)).offset(1, 1);
+
+static_assert(PNT_CHAIN.x == 7 && PNT_CHAIN.y == 22, "translation * rotation * scale");
+static_assert(PNT_PIVOT.x == 5 && PNT_PIVOT.y == 6, "rotation about a point");
+static_assert((Matrix2D::M_IDENTITY * MAT_CHAIN).items[0][2] == 10, "identity");
+static_assert(VTR_MOVED.pnt1.x == 1 && VTR_MOVED.pnt2.x == 5 && VTR_MOVED.pnt2.y == 3, "vector sum");
+static_assert(VTR_MOVED.midPoint().x == 3 && VTR_MOVED.side(Point2D(0, 10)) == sLeft, "vector queries");
+static_assert(RECT_UNION.area() == 12 && RECT_UNION.center().x == 3 && RECT_UNION.getTopRight().y == 4, "rectangle");
+static_assert((Point2D(3, 4) * 2 - 1).quadrant() == 1 && (1 - Point2D(3, 4)).quadrant() == 3, "point arithmetic");
+static_assert(Angle::ANGLE_90 + Angle::ANGLE_90 == Angle::ANGLE_180 && Angle::ANGLE_45 < Angle::ANGLE_90, "angles");
+static_assert(Angle::ANGLE_360 - Angle::ANGLE_180 == Angle::ANGLE_180, "angles");
+
+constexpr Angle
+	ANG_COPY = Angle::ANGLE_90;
+
+static_assert(ANG_COPY == Angle::ANGLE_90, "angle copies");
+
+// The accessors that replace the union members of Vector2D and Rectangle2D.
+static constexpr Vector2D
+reversed(Vector2D vtr)
+{
+	double
+		dblX = vtr.getX1(),
+		dblY = vtr.getY1();
+
+	vtr.setX1(vtr.getX2());
+	vtr.setY1(vtr.getY2());
+	vtr.setX2(dblX);
+	vtr.setY2(dblY);
+
+	return vtr;
+}
+
+static constexpr Rectangle2D
+moved(Rectangle2D rect, const Point2D &pnt)
+{
+	rect.setTopRight(pnt + rect.getTopRight() - rect.getBottomLeft());
+	rect.setBottomLeft(pnt);
+
+	return rect;
+}
+
+constexpr Vector2D
+	VTR_REVERSED = reversed(VTR_MOVED);
+constexpr Rectangle2D
+	RECT_MOVED = moved(RECT_UNION, Point2D(10, 20));
+
+static_assert(VTR_REVERSED.getX1() == 5 && VTR_REVERSED.getY1() == 3 && VTR_REVERSED.getX2() == 1, "vector end points");
+static_assert(RECT_MOVED.left == 10 && RECT_MOVED.getTopRight().x == 14 && RECT_MOVED.getTopRight().y == 23, "rectangle corners");
+
+int
+main()
+{
+	Matrix2D
+		matChain = Matrix2D::translation(10, 20) * Matrix2D::rotation(1, 0) * Matrix2D::scale(2, 3);
+	Point2D
+		pntChain = Point2D(1, 1).transform(matChain);
+	Vector2D
+		vtrReversed = reversed(Vector2D(0, 0, 4, 0).moveTo(1, 1) + Vector2D(0, 0, 0, 2));
+	Rectangle2D
+		rectMoved = moved(RECT_UNION, Point2D(10, 20));
+
+	CIVIL_CHECK(pntChain.x == PNT_CHAIN.x && pntChain.y == PNT_CHAIN.y);
+	CIVIL_CHECK(vtrReversed.getX1() == VTR_REVERSED.getX1() && vtrReversed.getY2() == VTR_REVERSED.getY2());
+	CIVIL_CHECK(rectMoved.getTopRight().x == RECT_MOVED.getTopRight().x && rectMoved.bottom == RECT_MOVED.bottom);
+
+	return testResult("TestConstexpr");
+}
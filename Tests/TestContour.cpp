@@ -0,0 +1,327 @@
+/***
+ * TestContour.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "..\MathLibrary\CivilContour.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// Marching squares: both saddle modes on the ambiguous cell, closed lines around hills and pits and open
+// ones cut by the edge of the grid, the same polylines from the serial and the parallel runs over many
+// tile seams (CONTOUR_TILE rows each), and one callback per finished line.
+
+static const double
+	EAST = 310000,
+	NORTH = 8250000;
+
+static bool
+samePoint(const Point2D &a, const Point2D &b)
+{
+	return a.x == b.x && a.y == b.y;
+}
+
+// The segment, as a pair of end points in either order, is one of "segs".
+static bool
+hasSegment(const std::vector<Vector2D> &segs, const Point2D &a, const Point2D &b)
+{
+	for (const Vector2D &seg : segs)
+		if ((samePoint(seg.pnt1, a) && samePoint(seg.pnt2, b)) || (samePoint(seg.pnt1, b) && samePoint(seg.pnt2, a)))
+			return true;
+
+	return false;
+}
+
+// A closed line starts at its smallest point, so that two runs compare point by point.
+static ContourLine
+canonical(ContourLine line)
+{
+	if (line.closed)
+	{
+		auto
+			it = std::min_element(line.points.begin(), line.points.end(), [](const Point2D &a, const Point2D &b) {
+				return a.x < b.x || (a.x == b.x && a.y < b.y);
+			});
+
+		std::rotate(line.points.begin(), it, line.points.end());
+	}
+
+	return line;
+}
+
+static bool
+lessLine(const ContourLine &a, const ContourLine &b)
+{
+	if (a.level != b.level)
+		return a.level < b.level;
+	if (a.closed != b.closed)
+		return a.closed < b.closed;
+	if (a.points.size() != b.points.size())
+		return a.points.size() < b.points.size();
+
+	for (size_t i = 0; i < a.points.size(); i++)
+		if (!samePoint(a.points[i], b.points[i]))
+			return a.points[i].x < b.points[i].x || (a.points[i].x == b.points[i].x && a.points[i].y < b.points[i].y);
+
+	return false;
+}
+
+static std::vector<ContourLine>
+sorted(const std::vector<ContourLine> &lines)
+{
+	std::vector<ContourLine>
+		aRes;
+
+	for (const ContourLine &line : lines)
+		aRes.push_back(canonical(line));
+
+	std::sort(aRes.begin(), aRes.end(), lessLine);
+
+	return aRes;
+}
+
+static bool
+sameLines(const std::vector<ContourLine> &a, const std::vector<ContourLine> &b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (size_t i = 0; i < a.size(); i++)
+		if (lessLine(a[i], b[i]) || lessLine(b[i], a[i]))
+			return false;
+
+	return true;
+}
+
+static double
+signedArea(const std::vector<Point2D> &pnts)
+{
+	double
+		dblArea = 0;
+
+	for (size_t i = 0; i < pnts.size(); i++)
+	{
+		const Point2D
+			&a = pnts[i],
+			&b = pnts[(i + 1) % pnts.size()];
+
+		dblArea += (a.x - pnts[0].x) * (b.y - pnts[0].y) - (b.x - pnts[0].x) * (a.y - pnts[0].y);
+	}
+
+	return dblArea / 2;
+}
+
+// A hill and a pit over a tilted plane, at survey coordinates.
+static ElevationGrid
+terrain(size_t rows, size_t cols)
+{
+	ElevationGrid
+		grid(rows, cols, Point2D(EAST, NORTH), 2, 2);
+
+	for (size_t r = 0; r < rows; r++)
+		for (size_t c = 0; c < cols; c++)
+		{
+			double
+				dx1 = c - cols * 0.3,
+				dy1 = r - rows * 0.4,
+				dx2 = c - cols * 0.7,
+				dy2 = r - rows * 0.6;
+
+			grid.setItem(r, c, 100 + 0.02 * r + 20 * exp(-(dx1 * dx1 + dy1 * dy1) / 400) - 15 * exp(-(dx2 * dx2 + dy2 * dy2) / 300));
+		}
+
+	return grid;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	// The ambiguous cell: the bottom left and top right corners are above 0.5 and the mean is 0.5.
+	ElevationGrid
+		saddle(2, 2, Point2D(0, 0), 1, 1);
+	std::vector<Vector2D>
+		aSegs;
+	ContourOptions
+		options;
+
+	saddle.setItem(0, 0, 1);
+	saddle.setItem(0, 1, 0);
+	saddle.setItem(1, 0, 0);
+	saddle.setItem(1, 1, 1);
+
+	const Point2D
+		BOTTOM(0.5, 0),
+		LEFT(0, 0.5),
+		TOP(0.5, 1),
+		RIGHT(1, 0.5);
+
+	// smSeparate cuts off each high corner.
+	options.saddleMode = smSeparate;
+	contourSegments(saddle, 0.5, aSegs, options);
+	CIVIL_CHECK(aSegs.size() == 2 && hasSegment(aSegs, BOTTOM, LEFT) && hasSegment(aSegs, TOP, RIGHT));
+
+	// smCenter joins the high corners through the center, which is at the level, and cuts off the low
+	// ones.
+	options.saddleMode = smCenter;
+	contourSegments(saddle, 0.5, aSegs, options);
+	CIVIL_CHECK(aSegs.size() == 2 && hasSegment(aSegs, BOTTOM, RIGHT) && hasSegment(aSegs, LEFT, TOP));
+
+	// With the mean below the level both modes agree.
+	std::vector<Vector2D>
+		aSeparate;
+
+	contourSegments(saddle, 0.6, aSegs, options);
+	options.saddleMode = smSeparate;
+	contourSegments(saddle, 0.6, aSeparate, options);
+	CIVIL_CHECK(aSegs.size() == 2 && hasSegment(aSegs, Point2D(0.4, 0), Point2D(0, 0.4)) && hasSegment(aSeparate, Point2D(0.4, 0), Point2D(0, 0.4)));
+
+	// Higher ground on the left: the high corner is to the left of every segment.
+	for (const Vector2D &seg : aSeparate)
+	{
+		Point2D
+			corner = seg.pnt1.x + seg.pnt2.x < 1 ? Point2D(0, 0) : Point2D(1, 1);
+
+		CIVIL_CHECK((seg.pnt2.x - seg.pnt1.x) * (corner.y - seg.pnt1.y) - (seg.pnt2.y - seg.pnt1.y) * (corner.x - seg.pnt1.x) > 0);
+	}
+
+	// A hill and a pit over 150 rows, several tiles high, under both saddle modes.
+	ElevationGrid
+		grid = terrain(150, 120);
+	std::vector<double>
+		aLevels;
+
+	for (double dbl = 92; dbl <= 125; dbl += 1.5)
+		aLevels.push_back(dbl);
+
+	for (SaddleModeEnum mode : { smSeparate, smCenter })
+	{
+		options.saddleMode = mode;
+		options.parallel = false;
+
+		std::vector<ContourLine>
+			aSerial = contourLines(grid, aLevels, options);
+
+		options.parallel = true;
+
+		std::vector<ContourLine>
+			aParallel = contourLines(grid, aLevels, options);
+
+		CIVIL_CHECK(!aSerial.empty() && sameLines(sorted(aSerial), sorted(aParallel)));
+
+		// The stitched lines use every raw segment once and no other: as many segments as line pieces.
+		size_t
+			intPieces = 0,
+			intRaw = 0;
+
+		for (const ContourLine &line : aSerial)
+			intPieces += line.points.size() - (line.closed ? 0 : 1);
+		for (double dblLevel : aLevels)
+		{
+			contourSegments(grid, dblLevel, aSegs, options);
+			intRaw += aSegs.size();
+		}
+		CIVIL_CHECK(intPieces == intRaw);
+
+		// Closed lines turn counterclockwise around the hill and clockwise around the pit; open lines end
+		// on the border of the grid.
+		Rectangle2D
+			rect = grid.boundsRect();
+		int
+			intHill = 0,
+			intPit = 0;
+
+		for (const ContourLine &line : aSerial)
+			if (line.closed)
+			{
+				double
+					dblArea = signedArea(line.points);
+
+				intHill += dblArea > 0;
+				intPit += dblArea < 0;
+			}
+			else
+				for (const Point2D &pnt : { line.points.front(), line.points.back() })
+					CIVIL_CHECK(pnt.x == rect.left || pnt.x == rect.right || pnt.y == rect.bottom || pnt.y == rect.top);
+
+		CIVIL_CHECK(intHill > 5 && intPit > 5);
+
+		// One call per finished line, every one on the calling thread.
+		std::vector<ContourLine>
+			aCalled;
+		std::thread::id
+			idCaller = std::this_thread::get_id();
+		bool
+			blnSameThread = true;
+
+		contourLines(grid, aLevels, [&](double level, const std::vector<Point2D> &points, bool closed) {
+			ContourLine
+				line;
+
+			line.level = level;
+			line.points = points;
+			line.closed = closed;
+			aCalled.push_back(line);
+			blnSameThread &= std::this_thread::get_id() == idCaller;
+		}, options);
+
+		CIVIL_CHECK(blnSameThread && sameLines(sorted(aCalled), sorted(aSerial)));
+	}
+
+	// A round hill whose center sits on a tile seam gives one closed line per level, joined across it, with
+	// the area of its circle less the slivers cut off by the chords (under one cell).
+	ElevationGrid
+		hill(97, 97, Point2D(EAST, NORTH), 1, 1, 0);
+
+	for (size_t r = 0; r < 97; r++)
+		for (size_t c = 0; c < 97; c++)
+			hill.setItem(r, c, 40 - sqrt((r - 32.0) * (r - 32.0) + (c - 48.0) * (c - 48.0)));
+
+	std::vector<ContourLine>
+		aRings = contourLines(hill, { 10.3, 15.7, 25.1, 35.5 });
+
+	CIVIL_CHECK(aRings.size() == 4);
+	for (const ContourLine &line : aRings)
+		CIVIL_CHECK(line.closed && abs(signedArea(line.points) - M_PI * (40 - line.level) * (40 - line.level)) < 1);
+
+	// A hole of no data splits the rings that pass through it into open lines ending at its border.
+	for (size_t r = 28; r < 37; r++)
+		for (size_t c = 60; c < 80; c++)
+			hill.setItem(r, c, ElevationGrid::NO_DATA);
+
+	aRings = contourLines(hill, { 15.7, 35.5 });
+	CIVIL_CHECK(aRings.size() == 2);
+	for (const ContourLine &line : aRings)
+		CIVIL_CHECK(line.closed == (line.level == 35.5));
+
+	return testResult("TestContour");
+}
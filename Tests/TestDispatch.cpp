@@ -0,0 +1,222 @@
+/***
+ * TestDispatch.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "..\MathLibrary\CivilKernels2D.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// Dispatch binding, and every kernel variant forced in turn against the scalar one on the same data.
+
+typedef int (*LevelFn)();
+
+static int
+levelScalar()
+{
+	return ilScalar;
+}
+
+static int
+levelAVX2()
+{
+	return ilAVX2;
+}
+
+static int
+levelAVX512()
+{
+	return ilAVX512;
+}
+
+// No SSE2 variant: that level falls back to the scalar one.
+static Dispatch<LevelFn>
+	levelDispatch(levelScalar, nullptr, levelAVX2, levelAVX512);
+
+static bool
+near(double a, double b)
+{
+	return a == b || abs(a - b) <= 1e-12 * (1 + abs(b));
+}
+
+static bool
+near(const std::vector<double> &a, const std::vector<double> &b)
+{
+	for (size_t i = 0; i < a.size(); i++)
+		if (!near(a[i], b[i]))
+			return false;
+
+	return true;
+}
+
+// An odd count, so that every variant also runs its tail.
+static const size_t
+	COUNT = 1003;
+
+int
+main()
+{
+	// Each level binds its own variant, or the best one below it.
+	forEachIsaLevel([](IsaLevelEnum level) {
+		CIVIL_CHECK(levelDispatch() == (level == ilSSE2 ? ilScalar : level));
+		CIVIL_CHECK(getIsaLevel() == level && getIsaLevel(isaGeneration()) == level);
+	});
+
+	CIVIL_CHECK(levelDispatch() == (detectedIsaLevel() == ilSSE2 ? ilScalar : detectedIsaLevel()));
+
+	// Pool threads call the dispatcher while another thread keeps changing the level; once it stops, every
+	// ---- thread must see the variant of the last level, never one bound under an older generation.
+	std::atomic<bool>
+		blnStop(false);
+	std::thread
+		toggler([&blnStop]() {
+			for (int i = 0; !blnStop; i++)
+				forceIsaLevel((IsaLevelEnum) (i % (detectedIsaLevel() + 1)));
+		});
+
+	parallelFor(0, 1 << 22, 1 << 12, [](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			levelDispatch();
+	});
+
+	blnStop = true;
+	toggler.join();
+	forceIsaLevel(ilScalar);
+
+	std::atomic<int>
+		intStale(0);
+
+	parallelFor(0, 1 << 16, 1 << 8, [&intStale](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+			if (levelDispatch() != ilScalar)
+				intStale++;
+	});
+
+	CIVIL_CHECK(intStale == 0);
+	resetIsaLevel();
+
+	// The kernels, each level against the scalar variant.
+	std::mt19937_64
+		rng(35);
+	std::uniform_real_distribution<double>
+		coord(-100, 100),
+		radius(0.5, 20);
+	std::vector<double>
+		x1(COUNT), y1(COUNT), x2(COUNT), y2(COUNT), r(COUNT);
+
+	for (size_t i = 0; i < COUNT; i++)
+	{
+		x1[i] = coord(rng);
+		y1[i] = coord(rng);
+		x2[i] = coord(rng);
+		y2[i] = coord(rng);
+		r[i] = radius(rng);
+	}
+
+	const Matrix2D
+		mat = Matrix2D::translation(3, -7) * Matrix2D::rotation(0.6, 0.8) * Matrix2D::scale(2, 0.5);
+	const Rectangle2D
+		window(-40, -30, 50, 60);
+	const double
+		lo[4] = { -50, -INFINITY, -INFINITY, 0 },
+		hi[4] = { INFINITY, 20, 80, INFINITY };
+
+	struct Results
+	{
+	public:
+
+		std::vector<double>
+			x = std::vector<double>(COUNT),
+			y = std::vector<double>(COUNT),
+			dist = std::vector<double>(COUNT),
+			distRef = std::vector<double>(COUNT),
+			clipX1 = std::vector<double>(COUNT),
+			clipY1 = std::vector<double>(COUNT),
+			clipX2 = std::vector<double>(COUNT),
+			clipY2 = std::vector<double>(COUNT),
+			t1 = std::vector<double>(COUNT),
+			t2 = std::vector<double>(COUNT);
+		std::vector<unsigned char>
+			visible = std::vector<unsigned char>(COUNT),
+			kind = std::vector<unsigned char>(COUNT);
+		std::vector<uint64_t>
+			mask = std::vector<uint64_t>((COUNT + 63) / 64);
+		double
+			bounds[4] = { INFINITY, INFINITY, -INFINITY, -INFINITY },
+			nearestT = 0;
+		long long
+			nearest = 0;
+
+	}; /* Results */
+
+	auto
+		run = [&](IsaLevelEnum level) {
+			Results
+				res;
+
+			transformKernel.variant(level)(mat, x1.data(), y1.data(), res.x.data(), res.y.data(), COUNT);
+			distKernel.variant(level)(x1.data(), y1.data(), x2.data(), y2.data(), res.dist.data(), COUNT);
+			distRefKernel.variant(level)(x1.data(), y1.data(), 12, -5, res.distRef.data(), COUNT);
+			rectangleTestKernel.variant(level)(x1.data(), y1.data(), x2.data(), y2.data(), COUNT, lo, hi, res.mask.data());
+			boundsKernel.variant(level)(x1.data(), y1.data(), x2.data(), y2.data(), r.data(), COUNT, res.bounds);
+			clipKernel.variant(level)(window, x1.data(), y1.data(), x2.data(), y2.data(), res.clipX1.data(), res.clipY1.data(),
+				res.clipX2.data(), res.clipY2.data(), res.visible.data(), COUNT);
+			interceptCirclesKernel.variant(level)(-90, -80, 170, 150, x1.data(), y1.data(), r.data(), false, res.kind.data(),
+				res.t1.data(), res.t2.data(), COUNT);
+			res.nearest = nearestInterceptKernel.variant(level)(-90, -80, 170, 150, x1.data(), y1.data(), r.data(), COUNT,
+				res.nearestT);
+
+			return res;
+		};
+
+	Results
+		scalar = run(ilScalar);
+
+	forEachIsaLevel([&](IsaLevelEnum level) {
+		Results
+			res = run(level);
+
+		printf("%s: checked\n", isaLevelName(level));
+
+		CIVIL_CHECK(near(res.x, scalar.x) && near(res.y, scalar.y));
+		CIVIL_CHECK(near(res.dist, scalar.dist) && near(res.distRef, scalar.distRef));
+		CIVIL_CHECK(res.mask == scalar.mask);
+		CIVIL_CHECK(res.bounds[0] == scalar.bounds[0] && res.bounds[1] == scalar.bounds[1] &&
+			res.bounds[2] == scalar.bounds[2] && res.bounds[3] == scalar.bounds[3]);
+		CIVIL_CHECK(res.visible == scalar.visible && near(res.clipX1, scalar.clipX1) && near(res.clipY1, scalar.clipY1) &&
+			near(res.clipX2, scalar.clipX2) && near(res.clipY2, scalar.clipY2));
+		CIVIL_CHECK(res.kind == scalar.kind && near(res.t1, scalar.t1) && near(res.t2, scalar.t2));
+		CIVIL_CHECK(res.nearest == scalar.nearest && near(res.nearestT, scalar.nearestT));
+	});
+
+	return testResult("TestDispatch");
+}
@@ -0,0 +1,257 @@
+/***
+ * TestEarthwork.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilEarthwork.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// Cut and fill between two planes against the closed form, no-data cells against a cell-by-cell sum of the
+// grid method, an update of a region against a full computation (same bits) and both variants of
+// cutFillKernel against each other.
+
+static const double
+	EAST = 720000,
+	NORTH = 9100000;
+
+static bool
+near(double a, double b, double tol)
+{
+	return abs(a - b) <= tol * (1 + abs(b));
+}
+
+// A plane z = z0 + gx * (x - EAST) + gy * (y - NORTH), NaN inside the circle (cx, cy, r) when r > 0.
+static SurfaceSampler
+plane(double z0, double gx, double gy, double cx = 0, double cy = 0, double r = 0)
+{
+	return [=](const double *x, size_t count, double y, double *z) {
+		for (size_t i = 0; i < count; i++)
+			z[i] = (x[i] - cx) * (x[i] - cx) + (y - cy) * (y - cy) < r * r ? ElevationGrid::NO_DATA :
+				z0 + gx * (x[i] - EAST) + gy * (y - NORTH);
+	};
+}
+
+// The grid method, one cell at a time, from the nodes the earthwork sampled.
+static EarthworkVolumes
+bruteVolumes(const Earthwork &ew)
+{
+	const ElevationGrid
+		&grdExisting = ew.getSurface(esExisting),
+		&grdProposed = ew.getSurface(esProposed);
+	double
+		dblArea = grdExisting.getCellWidth() * grdExisting.getCellHeight();
+	EarthworkVolumes
+		vol;
+
+	for (size_t r = 0; r + 1 < grdExisting.getRowCount(); r++)
+		for (size_t c = 0; c + 1 < grdExisting.getColCount(); c++)
+		{
+			double
+				p = 0,
+				n = 0;
+			bool
+				blnValid = true;
+
+			for (size_t k = 0; k < 4; k++)
+			{
+				double
+					d = grdProposed.getItem(r + k / 2, c + k % 2) - grdExisting.getItem(r + k / 2, c + k % 2);
+
+				blnValid &= !isnan(d);
+				if (d > 0)
+					p += d;
+				else
+					n -= d;
+			}
+
+			if (blnValid && p + n > 0)
+			{
+				vol.fill += dblArea / 4 * p * p / (p + n);
+				vol.cut += dblArea / 4 * n * n / (p + n);
+			}
+		}
+
+	return vol;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	// 1000 x 640 m in 5 m cells: 200 x 128 cells, 4 x 2 tiles.
+	const Rectangle2D
+		BOUNDS(EAST, NORTH, EAST + 1000, NORTH + 640);
+
+	forEachIsaLevel([&](CIVIL::UTILS::IsaLevelEnum level)
+	{
+		// A grade line parallel to Y at x = EAST + 382.5 crosses cells, where the grid method is exact for a
+		// slope along X alone: fill = H * g / 2 * (X1 - xm)^2, cut = H * g / 2 * (xm - X0)^2.
+		Earthwork
+			ew(BOUNDS, 5);
+
+		ew.sample(esExisting, plane(100, 0, 0));
+		ew.sample(esProposed, plane(100 - 0.1 * 382.5, 0.1, 0));
+
+		EarthworkVolumes
+			vol = ew.volumes();
+
+		CIVIL_CHECK(ew.getTileCount() == 8);
+		CIVIL_CHECK(near(vol.fill, 640 * 0.05 * 617.5 * 617.5, 1e-9) && near(vol.cut, 640 * 0.05 * 382.5 * 382.5, 1e-9));
+
+		// Any two planes: the net volume is exact, cut and fill follow the grid method.
+		ew.sample(esExisting, plane(50, 0.02, -0.03));
+		ew.sample(esProposed, plane(48, -0.01, 0.015));
+		vol = ew.volumes();
+
+		EarthworkVolumes
+			brute = bruteVolumes(ew);
+		double
+			dblNet = 1000 * 640 * (-2 + (-0.03) * 500 + 0.045 * 320);
+
+		CIVIL_CHECK(near(vol.net(), dblNet, 1e-9) && near(vol.cut, brute.cut, 1e-11) && near(vol.fill, brute.fill, 1e-11));
+		CIVIL_CHECK(vol.cut > 0 && vol.fill > 0);
+
+		// Holes of no data in both surfaces leave their cells out.
+		ew.sample(esExisting, plane(50, 0.02, -0.03, EAST + 300, NORTH + 200, 60));
+		ew.sample(esProposed, plane(48, -0.01, 0.015, EAST + 700, NORTH + 500, 95.5));
+		vol = ew.volumes();
+		brute = bruteVolumes(ew);
+		CIVIL_CHECK(near(vol.cut, brute.cut, 1e-11) && near(vol.fill, brute.fill, 1e-11) && vol.net() > dblNet + 1000);
+
+		// No-data everywhere gives nothing.
+		ew.sample(esExisting, plane(0, 0, 0, EAST, NORTH, 1e9));
+		vol = ew.volumes();
+		CIVIL_CHECK(vol.cut == 0 && vol.fill == 0);
+
+		// Resampling a region and recomputing the tiles it marks gives the same bits as a new earthwork
+		// that computes everything once.
+		Earthwork
+			upd(BOUNDS, 5),
+			full(BOUNDS, 5);
+		const Rectangle2D
+			REGION(EAST + 310, NORTH + 100, EAST + 420, NORTH + 333);
+
+		upd.sample(esExisting, plane(50, 0.02, -0.03, EAST + 300, NORTH + 200, 60));
+		upd.sample(esProposed, plane(48, -0.01, 0.015));
+		upd.volumes();
+		upd.sample(esProposed, plane(55, 0.01, 0.01), REGION);
+
+		full.sample(esExisting, plane(50, 0.02, -0.03, EAST + 300, NORTH + 200, 60), false);
+		full.sample(esProposed, plane(48, -0.01, 0.015), false);
+		full.sample(esProposed, plane(55, 0.01, 0.01), REGION, false);
+
+		EarthworkVolumes
+			volUpd = upd.volumes(),
+			volFull = full.volumes(false);
+
+		CIVIL_CHECK(volUpd.cut == volFull.cut && volUpd.fill == volFull.fill);
+		brute = bruteVolumes(full);
+		CIVIL_CHECK(near(volFull.cut, brute.cut, 1e-11) && near(volFull.fill, brute.fill, 1e-11));
+
+		// The same through editSurface and invalidate.
+		ElevationGrid
+			&grd = upd.editSurface(esExisting);
+
+		for (size_t r = 60; r < 75; r++)
+			for (size_t c = 10; c < 150; c++)
+			{
+				grd.setItem(r, c, grd.getItem(r, c) + 1.25);
+				full.editSurface(esExisting).setItem(r, c, grd.getItem(r, c));
+			}
+
+		upd.invalidate(Rectangle2D(grd.getX(10), grd.getY(60), grd.getX(149), grd.getY(74)));
+
+		Earthwork
+			fresh = full;
+
+		fresh.invalidate(fresh.boundsRect());
+		volUpd = upd.volumes();
+		volFull = fresh.volumes();
+		CIVIL_CHECK(volUpd.cut == volFull.cut && volUpd.fill == volFull.fill);
+
+		printf("%-8s cut %.6f fill %.6f\n", isaLevelName(level), volUpd.cut, volUpd.fill);
+	});
+
+	// Each variant of the kernel against the scalar one, on rows of every length up to a few vector widths,
+	// with NaN corners and flat cells mixed in.
+	std::mt19937_64
+		rng(42);
+	std::uniform_real_distribution<double>
+		depth(-2, 2);
+	CutFillKernel
+		scalar = cutFillKernel.variant(ilScalar);
+
+	for (int intLevel = ilSSE2; intLevel <= detectedIsaLevel(); intLevel++)
+	{
+		CutFillKernel
+			fn = cutFillKernel.variant((IsaLevelEnum) intLevel);
+
+		for (size_t n = 0; n < 40; n++)
+		{
+			std::vector<double>
+				d0(n + 1),
+				d1(n + 1);
+
+			for (size_t i = 0; i <= n; i++)
+			{
+				d0[i] = rng() % 9 == 0 ? ElevationGrid::NO_DATA : (rng() % 7 == 0 ? 0 : depth(rng));
+				d1[i] = rng() % 7 == 0 ? 0 : depth(rng);
+			}
+
+			double
+				aScalar[2] = { 0, 0 },
+				aVector[2] = { 0, 0 };
+
+			scalar(d0.data(), d1.data(), n, aScalar);
+			fn(d0.data(), d1.data(), n, aVector);
+			CIVIL_CHECK(near(aVector[0], aScalar[0], 1e-13) && near(aVector[1], aScalar[1], 1e-13));
+		}
+	}
+
+	// An empty or inverted rectangle, or a cell size that is not positive, raises EEarthwork.
+	int
+		intRaised = 0;
+
+	for (double dblCell : { 0.0, -1.0, 5.0 })
+		try
+		{
+			Earthwork
+				bad(dblCell > 0 ? Rectangle2D(EAST, NORTH, EAST, NORTH + 10) : BOUNDS, dblCell);
+		}
+		catch (const EEarthwork &)
+		{
+			intRaised++;
+		}
+	CIVIL_CHECK(intRaised == 3);
+
+	return testResult("TestEarthwork");
+}
@@ -0,0 +1,330 @@
+/***
+ * TestFit2D.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilFit2D.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// The circle fits (Kasa, Pratt, geometric) on exact points, a noisy full arc and a short arc, the total
+// least squares line, RANSAC with outliers mixed in and the kernels behind them at every instruction set
+// level.
+
+static const Point2D
+	CENTER(512345.678, 7456789.012);
+
+static PointBuffer
+arc(std::mt19937_64 &rng, const Point2D &center, double radius, double from, double sweep, size_t count, double sigma)
+{
+	std::normal_distribution<double>
+		noise(0, sigma > 0 ? sigma : 1);
+	PointBuffer
+		pnts;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		double
+			t = from + sweep * i / (count - 1),
+			r = radius + (sigma > 0 ? noise(rng) : 0);
+
+		pnts.add(Point2D(center.x + r * cos(t), center.y + r * sin(t)));
+	}
+
+	return pnts;
+}
+
+// Sum of the squared distances from the points to the circle.
+static double
+circleCost(const PointBuffer &pnts, const Point2D &center, double radius)
+{
+	double
+		dblSum = 0;
+
+	for (size_t i = 0; i < pnts.size(); i++)
+	{
+		double
+			e = pnts.getItem(i).dist(center) - radius;
+
+		dblSum += e * e;
+	}
+
+	return dblSum;
+}
+
+static double
+circleError(const Circle2D &cir, const Point2D &center, double radius)
+{
+	return std::max(cir.center.dist(center), abs(cir.getRadius() - radius));
+}
+
+// Whether fn raises EFit2D.
+template <typename Fn>
+static bool
+raisesFit(const Fn &fn)
+{
+	try
+	{
+		fn();
+	}
+	catch (const EFit2D &)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+static bool
+near(double a, double b, double tol)
+{
+	return abs(a - b) <= tol * (1 + abs(b));
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	forEachIsaLevel([](CIVIL::UTILS::IsaLevelEnum level)
+	{
+		std::mt19937_64
+			rng(44);
+
+		// Exact points on a circle at survey coordinates: every fit finds it.
+		PointBuffer
+			pnts = arc(rng, CENTER, 25, 0.3, 2 * M_PI * 0.99, 360, 0);
+
+		CIVIL_CHECK(circleError(fitCircleKasa(pnts), CENTER, 25) < 1e-6);
+		CIVIL_CHECK(circleError(fitCirclePratt(pnts), CENTER, 25) < 1e-6);
+		CIVIL_CHECK(circleError(fitCircleGeometric(pnts), CENTER, 25) < 1e-6);
+
+		// A full noisy circle, large enough to be reduced in pieces on the pool.
+		pnts = arc(rng, CENTER, 40, 0, 2 * M_PI, 100000, 0.01);
+
+		Circle2D
+			kasa = fitCircleKasa(pnts),
+			pratt = fitCirclePratt(pnts),
+			geo = fitCircleGeometric(pnts);
+
+		CIVIL_CHECK(circleError(kasa, CENTER, 40) < 1e-3 && circleError(pratt, CENTER, 40) < 1e-3 && circleError(geo, CENTER, 40) < 1e-3);
+
+		// The geometric fit is a minimum of the sum of squared distances.
+		double
+			dblCost = circleCost(pnts, geo.center, geo.getRadius());
+
+		for (double d : { -1e-3, 1e-3 })
+		{
+			CIVIL_CHECK(circleCost(pnts, Point2D(geo.center.x + d, geo.center.y), geo.getRadius()) > dblCost);
+			CIVIL_CHECK(circleCost(pnts, Point2D(geo.center.x, geo.center.y + d), geo.getRadius()) > dblCost);
+			CIVIL_CHECK(circleCost(pnts, geo.center, geo.getRadius() + d) > dblCost);
+		}
+
+		// The moments do not depend on the pieces.
+		PointMoments
+			momSerial = pointMoments(pnts, false),
+			momParallel = pointMoments(pnts, true);
+
+		CIVIL_CHECK(momSerial.count == pnts.size() && momParallel.count == pnts.size());
+		CIVIL_CHECK(near(momSerial.xx, momParallel.xx, 1e-9) && near(momSerial.zz, momParallel.zz, 1e-9) && near(momSerial.yz, momParallel.yz, 1e-6));
+
+		// A 20 degree arc of a 150 m curve with 2 cm noise: Kasa's fit shrinks the circle, Pratt's and the
+		// geometric one stay closer.
+		pnts = arc(rng, CENTER, 150, 1, 20 * M_PI / 180, 400, 0.02);
+		kasa = fitCircleKasa(pnts);
+		pratt = fitCirclePratt(pnts);
+		geo = fitCircleGeometric(pnts);
+
+		CIVIL_CHECK(kasa.getRadius() < 150);
+		CIVIL_CHECK(abs(geo.getRadius() - 150) < abs(kasa.getRadius() - 150) && abs(pratt.getRadius() - 150) < abs(kasa.getRadius() - 150));
+		CIVIL_CHECK(circleError(geo, CENTER, 150) < 3 && circleCost(pnts, geo.center, geo.getRadius()) <= circleCost(pnts, pratt.center, pratt.getRadius()));
+
+		// Starting the geometric fit from Kasa's circle ends at the same minimum.
+		CIVIL_CHECK(circleError(fitCircleGeometric(pnts, kasa), geo.center, geo.getRadius()) < 1e-6);
+
+		// Total least squares line: exact points, then noisy ones, across the direction of the axes.
+		for (double dblDeg : { 0.0, 33.0, 90.0, 157.0 })
+		{
+			double
+				dblAng = dblDeg * M_PI / 180;
+			std::normal_distribution<double>
+				noise(0, 0.05);
+			PointBuffer
+				exact,
+				noisy;
+
+			for (int i = 0; i < 5000; i++)
+			{
+				double
+					t = -100 + 0.04 * i;
+
+				exact.add(Point2D(CENTER.x + t * cos(dblAng), CENTER.y + t * sin(dblAng)));
+				noisy.add(Point2D(CENTER.x + t * cos(dblAng) - noise(rng) * sin(dblAng), CENTER.y + t * sin(dblAng) + noise(rng) * cos(dblAng)));
+			}
+
+			Vector2D
+				line = fitLine(exact);
+
+			// Through the points, spanning them from one end to the other.
+			CIVIL_CHECK(line.distPoint(exact.getItem(0)) < 1e-7 && line.distPoint(exact.getItem(4999)) < 1e-7);
+			CIVIL_CHECK(near(line.getModule(), 199.96, 1e-9));
+
+			line = fitLine(noisy);
+
+			// Parallel to the true direction.
+			CIVIL_CHECK(abs((line.pnt2.x - line.pnt1.x) * sin(dblAng) - (line.pnt2.y - line.pnt1.y) * cos(dblAng)) < 1e-3 * line.getModule());
+			CIVIL_CHECK(line.distPoint(CENTER) < 5e-3);
+		}
+
+		// RANSAC: 60 % of the points on the model, the rest spread over its box.
+		std::uniform_real_distribution<double>
+			spread(-60, 60);
+		PointBuffer
+			mixed;
+		std::vector<size_t>
+			aInliers;
+		RansacOptions
+			options;
+
+		pnts = arc(rng, CENTER, 45, 0, 2 * M_PI, 3000, 0.005);
+		for (size_t i = 0; i < pnts.size(); i++)
+		{
+			mixed.add(pnts.getItem(i));
+			if (i % 3 == 0)
+				mixed.add(Point2D(CENTER.x + spread(rng), CENTER.y + spread(rng)));
+			if (i % 3 == 1)
+				mixed.add(Point2D(CENTER.x + spread(rng), CENTER.y + spread(rng)));
+		}
+
+		options.threshold = 0.03;
+		options.seed = 7;
+
+		Circle2D
+			cir = ransacCircle(mixed, options, aInliers);
+
+		CIVIL_CHECK(circleError(cir, CENTER, 45) < 1e-3);
+		CIVIL_CHECK(aInliers.size() >= pnts.size() && aInliers.size() < pnts.size() + 100);
+
+		// The same seed gives the same model, with or without the pool.
+		std::vector<size_t>
+			aSerial;
+
+		options.parallel = false;
+
+		Circle2D
+			cirSerial = ransacCircle(mixed, options, aSerial);
+
+		CIVIL_CHECK(aSerial == aInliers && cirSerial.center.x == cir.center.x && cirSerial.getRadius() == cir.getRadius());
+
+		mixed.clear();
+		for (int i = 0; i < 2000; i++)
+		{
+			double
+				t = -50 + 0.05 * i;
+
+			mixed.add(Point2D(CENTER.x + t * 0.6, CENTER.y + t * 0.8 + 0.004 * sin(i)));
+			mixed.add(Point2D(CENTER.x + spread(rng), CENTER.y + spread(rng)));
+		}
+
+		options.threshold = 0.02;
+		options.parallel = true;
+
+		Vector2D
+			line = ransacLine(mixed, options, aInliers);
+
+		CIVIL_CHECK(line.distPoint(CENTER) < 1e-3 && line.distPoint(Point2D(CENTER.x + 30, CENTER.y + 40)) < 1e-3);
+		CIVIL_CHECK(aInliers.size() >= 2000 && aInliers.size() < 2100);
+		for (size_t i = 0; i < aInliers.size(); i++)
+			CIVIL_CHECK(line.distPoint(mixed.getItem(aInliers[i])) <= 0.02);
+
+		printf("%-8s short arc radius: Kasa %.3f, Pratt %.3f, geometric %.3f\n", isaLevelName(level), kasa.getRadius(),
+			pratt.getRadius(), geo.getRadius());
+	});
+
+	// Each variant of the kernels against the scalar one, on lengths around the vector widths.
+	std::mt19937_64
+		rng(4);
+	std::uniform_real_distribution<double>
+		coord(-30, 30);
+
+	for (int intLevel = ilSSE2; intLevel <= detectedIsaLevel(); intLevel++)
+		for (size_t n = 0; n < 40; n++)
+		{
+			std::vector<double>
+				x(n),
+				y(n);
+
+			for (size_t i = 0; i < n; i++)
+			{
+				x[i] = CENTER.x + coord(rng);
+				y[i] = CENTER.y + coord(rng);
+			}
+
+			// A point at the center of the step counts with u = v = 0.
+			if (n > 5)
+			{
+				x[5] = CENTER.x;
+				y[5] = CENTER.y;
+			}
+
+			double
+				aScalar[12] = {},
+				aVector[12] = {};
+
+			momentKernel.variant(ilScalar)(x.data(), y.data(), n, CENTER.x, CENTER.y, aScalar);
+			momentKernel.variant((IsaLevelEnum) intLevel)(x.data(), y.data(), n, CENTER.x, CENTER.y, aVector);
+			for (int k = 0; k < 12; k++)
+				CIVIL_CHECK(near(aVector[k], aScalar[k], 1e-12));
+
+			double
+				aStepScalar[9] = {},
+				aStepVector[9] = {};
+
+			circleStepKernel.variant(ilScalar)(x.data(), y.data(), n, CENTER.x, CENTER.y, 20, aStepScalar);
+			circleStepKernel.variant((IsaLevelEnum) intLevel)(x.data(), y.data(), n, CENTER.x, CENTER.y, 20, aStepVector);
+			for (int k = 0; k < 9; k++)
+				CIVIL_CHECK(near(aStepVector[k], aStepScalar[k], 1e-12));
+		}
+
+	// Too few points, coincident or collinear ones raise EFit2D.
+	PointBuffer
+		bad;
+
+	bad.add(CENTER);
+	CIVIL_CHECK(raisesFit([&]() { fitLine(bad); }));
+	bad.add(CENTER);
+	CIVIL_CHECK(raisesFit([&]() { fitLine(bad); }) && raisesFit([&]() { fitCircleKasa(bad); }));
+	for (int i = 1; i < 10; i++)
+		bad.add(Point2D(CENTER.x + i, CENTER.y + 2 * i));
+	CIVIL_CHECK(raisesFit([&]() { fitCirclePratt(bad); }) && raisesFit([&]() { fitCircleGeometric(bad); }));
+
+	return testResult("TestFit2D");
+}
@@ -0,0 +1,176 @@
+/***
+ * TestFixedAngle.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+
+#include "..\MathLibrary\CivilFixedAngle.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// FixedAngle: exact sums, wrapping, rounding from seconds and radians, round trips through Angle and the
+// table sine and cosine against libm.
+
+static const long long
+	TURN = FixedAngle::TENTHS_PER_TURN;
+
+// Largest difference of the table sine and cosine from libm over "count" angles made by "tenthsOf".
+template <typename Fn>
+static double
+sincosError(long long count, const Fn &tenthsOf)
+{
+	double
+		dblErr = 0;
+
+	for (long long i = 0; i < count; i++)
+	{
+		FixedAngle
+			ang = FixedAngle::fromTenths(tenthsOf(i));
+		double
+			s,
+			c;
+
+		double
+			dblRadians = ang.normalized().toRadians();
+
+		// Against libm on the wrapped angle, so the reduction of a large radian argument is not measured.
+		ang.sincos(s, c);
+		dblErr = std::max(dblErr, std::max(abs(s - sin(dblRadians)), abs(c - cos(dblRadians))));
+	}
+
+	return dblErr;
+}
+
+int
+main()
+{
+	// DMS, the sign on the whole angle, and the exact breakdown back.
+	FixedAngle
+		ang = FixedAngle::fromDMS(-12, 30, 15, 5);
+	bool
+		blnNeg;
+	long long
+		intDeg;
+	int
+		intMin,
+		intSec,
+		intTenths;
+
+	CIVIL_CHECK(ang.getTenths() == -(12 * 36000 + 30 * 600 + 15 * 10 + 5));
+	ang.decompose(blnNeg, intDeg, intMin, intSec, intTenths);
+	CIVIL_CHECK(blnNeg && intDeg == 12 && intMin == 30 && intSec == 15 && intTenths == 5);
+	CIVIL_CHECK(FixedAngle::fromDMS(0, 30, 0, 0, true).getTenths() == -18000);
+	CIVIL_CHECK(FixedAngle::fromDMS(-1, 0, 0) == -FixedAngle::fromDMS(1, 0, 0));
+
+	// Sums and differences are exact: a traverse of many bearings adds up to the integer sum, and adding
+	// ---- then removing every bearing gives the start back.
+	std::mt19937_64
+		rng(32);
+	std::uniform_int_distribution<long long>
+		tenths(-5 * TURN, 5 * TURN);
+	FixedAngle
+		sum,
+		start = FixedAngle::fromDMS(123, 4, 5, 6);
+	long long
+		intSum = 0;
+
+	ang = start;
+	for (int i = 0; i < 100000; i++)
+	{
+		long long
+			t = tenths(rng);
+
+		sum += FixedAngle::fromTenths(t);
+		intSum += t;
+		ang = ang + FixedAngle::fromTenths(t) - FixedAngle::fromTenths(t / 2);
+		ang -= FixedAngle::fromTenths(t - t / 2);
+	}
+
+	CIVIL_CHECK(sum.getTenths() == intSum && ang == start);
+	CIVIL_CHECK(FixedAngle::fromTenths(7) * 3 == 3 * FixedAngle::fromTenths(7));
+
+	// normalized() wraps into [0, 360) and normalizedSigned() into [-180, 180), negative values and
+	// ---- multiples of a turn included.
+	for (long long k = -4; k <= 4; k++)
+	{
+		CIVIL_CHECK(FixedAngle::fromTenths(k * TURN).normalized().getTenths() == 0);
+		CIVIL_CHECK(FixedAngle::fromTenths(k * TURN - 1).normalized().getTenths() == TURN - 1);
+		CIVIL_CHECK(FixedAngle::fromTenths(k * TURN + 1).normalized().getTenths() == 1);
+		CIVIL_CHECK(FixedAngle::fromTenths(k * TURN + TURN / 2).normalizedSigned().getTenths() == -TURN / 2);
+		CIVIL_CHECK(FixedAngle::fromTenths(k * TURN + TURN / 2 - 1).normalizedSigned().getTenths() == TURN / 2 - 1);
+		CIVIL_CHECK(FixedAngle::fromTenths(k * TURN - 1).normalizedSigned().getTenths() == -1);
+	}
+
+	for (int i = 0; i < 100000; i++)
+	{
+		long long
+			t = tenths(rng),
+			n = FixedAngle::fromTenths(t).normalized().getTenths(),
+			s = FixedAngle::fromTenths(t).normalizedSigned().getTenths();
+
+		CIVIL_CHECK(n >= 0 && n < TURN && (t - n) % TURN == 0);
+		CIVIL_CHECK(s >= -TURN / 2 && s < TURN / 2 && (t - s) % TURN == 0);
+	}
+
+	// Seconds round to the nearest tenth, halves away from zero.
+	CIVIL_CHECK(FixedAngle::fromSeconds(0.05).getTenths() == 1 && FixedAngle::fromSeconds(-0.05).getTenths() == -1);
+	CIVIL_CHECK(FixedAngle::fromSeconds(0.04).getTenths() == 0 && FixedAngle::fromSeconds(-0.04).getTenths() == 0);
+	CIVIL_CHECK(FixedAngle::fromSeconds(12.25).getTenths() == 123 && FixedAngle::fromSeconds(-12.25).getTenths() == -123);
+	CIVIL_CHECK(FixedAngle::fromSeconds(3599.96).getTenths() == 36000);
+
+	// Radians a little short of and past half a tenth of a second round both ways.
+	const double
+		TENTH = 2 * M_PI / TURN;
+
+	CIVIL_CHECK(FixedAngle::fromRadians(TENTH * 0.49).getTenths() == 0 && FixedAngle::fromRadians(TENTH * 0.51).getTenths() == 1);
+	CIVIL_CHECK(FixedAngle::fromRadians(-TENTH * 0.49).getTenths() == 0 && FixedAngle::fromRadians(-TENTH * 0.51).getTenths() == -1);
+
+	// Round trips through radians and Angle, over several turns both ways.
+	for (int i = 0; i < 100000; i++)
+	{
+		FixedAngle
+			fixed = FixedAngle::fromTenths(tenths(rng));
+
+		CIVIL_CHECK(FixedAngle::fromRadians(fixed.toRadians()) == fixed);
+		CIVIL_CHECK(FixedAngle(fixed.toAngle()) == fixed);
+	}
+
+	// Angle keeps the sign on each component, so only positive DMS agree component for component.
+	for (int d = 0; d < 360; d += 17)
+		for (int m = 0; m < 60; m += 7)
+			for (int s = 0; s < 60; s += 11)
+				CIVIL_CHECK(FixedAngle(Angle(0, d, m, s)) == FixedAngle::fromDMS(d, m, s));
+
+	// Table sine and cosine: every whole second of the first turn, then tenths over several turns.
+	double
+		dblSeconds = sincosError(TURN / 10, [](long long i) { return i * 10; }),
+		dblTenths = sincosError(2000000, [](long long i) { return (i * 64801) % (8 * TURN) - 4 * TURN; });
+
+	printf("sincos against libm: %.2e over whole seconds, %.2e over tenths\n", dblSeconds, dblTenths);
+	CIVIL_CHECK(dblSeconds <= 2e-15 && dblTenths <= 2e-15);
+
+	return testResult("TestFixedAngle");
+}
@@ -0,0 +1,152 @@
+/***
+ * TestHull.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilHull2D.h"
+#include "..\MathLibrary\CivilPredicates.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Pieces hulled apart by the parallel convexHull.
+static const size_t
+	PIECE = 1 << 16;
+
+// True when "hull" is a strictly convex counterclockwise polygon with every point of "pnts" inside it or
+// on its boundary.
+static bool
+isHullOf(const PointBuffer &pnts, const std::vector<size_t> &hull)
+{
+	size_t
+		h = hull.size();
+
+	if (h < 3)
+		return false;
+
+	for (size_t i = 0; i < h; i++)
+	{
+		size_t
+			a = hull[i],
+			b = hull[(i + 1) % h],
+			c = hull[(i + 2) % h];
+
+		if (orient2d(pnts.x[a], pnts.y[a], pnts.x[b], pnts.y[b], pnts.x[c], pnts.y[c]) <= 0)
+			return false;
+
+		for (size_t j = 0; j < pnts.size(); j++)
+			if (orient2d(pnts.x[a], pnts.y[a], pnts.x[b], pnts.y[b], pnts.x[j], pnts.y[j]) < 0)
+				return false;
+	}
+
+	return true;
+}
+
+// Both ways of convexHull, which must agree.
+static std::vector<size_t>
+checkedHull(const PointBuffer &pnts)
+{
+	std::vector<size_t>
+		serial,
+		parallel;
+
+	convexHull(pnts, serial, false);
+	convexHull(pnts, parallel, true);
+	CIVIL_CHECK(serial == parallel);
+
+	return parallel;
+}
+
+int
+main()
+{
+	std::mt19937_64
+		rng(38);
+	std::uniform_real_distribution<double>
+		unit(0, 1),
+		inner(0.1, 0.9);
+	PointBuffer
+		pnts;
+	std::vector<size_t>
+		hull;
+
+	// Three pieces, with the unit square's corners in one of them: the other two have every point strictly
+	// ---- inside the filter polygon and an empty hull of their own.
+	pnts.resize(3 * PIECE);
+	for (size_t i = 0; i < pnts.size(); i++)
+		pnts.setItem(i, Point2D(inner(rng), inner(rng)));
+
+	for (size_t intPiece : { PIECE, (size_t) 0, 2 * PIECE })
+	{
+		for (size_t i = 0; i < pnts.size(); i += PIECE)
+			for (size_t j = 1; j <= 4; j++)
+				pnts.setItem(i + 10 * j, Point2D(0.5, 0.5));
+
+		pnts.setItem(intPiece + 10, Point2D(0, 0));
+		pnts.setItem(intPiece + 20, Point2D(1, 0));
+		pnts.setItem(intPiece + 30, Point2D(1, 1));
+		pnts.setItem(intPiece + 40, Point2D(0, 1));
+
+		hull = checkedHull(pnts);
+		CIVIL_CHECK(hull == std::vector<size_t>({ intPiece + 10, intPiece + 20, intPiece + 30, intPiece + 40 }));
+	}
+
+	// Uniform in a square, uniform in a disk and clustered, over several pieces.
+	for (int intCase = 0; intCase < 3; intCase++)
+	{
+		std::normal_distribution<double>
+			cluster(0, 0.01);
+
+		pnts.resize(5 * PIECE + 123);
+		for (size_t i = 0; i < pnts.size(); i++)
+		{
+			double
+				a = unit(rng) * 2 * M_PI;
+
+			if (intCase == 0)
+				pnts.setItem(i, Point2D(unit(rng), unit(rng)));
+			else if (intCase == 1)
+				pnts.setItem(i, Point2D(cos(a), sin(a)) * sqrt(unit(rng)));
+			else
+				pnts.setItem(i, Point2D((i % 7) + cluster(rng), (i % 5) + cluster(rng)));
+		}
+
+		CIVIL_CHECK(isHullOf(pnts, checkedHull(pnts)));
+	}
+
+	// Small cases: no point, one point, coincident and collinear points.
+	pnts.clear();
+	CIVIL_CHECK(checkedHull(pnts).empty());
+	pnts.add(Point2D(2, 3));
+	CIVIL_CHECK(checkedHull(pnts) == std::vector<size_t>({ 0 }));
+	pnts.add(Point2D(2, 3));
+	pnts.add(Point2D(4, 3));
+	pnts.add(Point2D(3, 3));
+	CIVIL_CHECK(checkedHull(pnts) == std::vector<size_t>({ 0, 2 }));
+
+	return testResult("TestHull");
+}
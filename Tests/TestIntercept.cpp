@@ -0,0 +1,219 @@
+/***
+ * TestIntercept.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilBatch2D.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// Circle2D::intercept on the cases of its contract, and the batch forms against it at every level.
+
+static bool
+near(const Point2D &a, const Point2D &b)
+{
+	return abs(a.x - b.x) <= 1e-9 * (1 + abs(b.x)) && abs(a.y - b.y) <= 1e-9 * (1 + abs(b.y));
+}
+
+// Kind and points of Circle2D::intercept, compared with an expected kind and points.
+static bool
+hits(const Circle2D &circle, const Vector2D &vtr, bool aparent, IntersectionEnum kind, const Point2D &pnt1 = NULL_POINT,
+	const Point2D &pnt2 = NULL_POINT)
+{
+	Vector2D
+		res;
+	IntersectionEnum
+		found = circle.intercept(vtr, res, aparent);
+
+	return found == kind && (kind == iNone || (near(res.pnt1, pnt1) && near(res.pnt2, pnt2)));
+}
+
+// Parameter of "pnt" along "vtr".
+static double
+paramOf(const Vector2D &vtr, const Point2D &pnt)
+{
+	Point2D
+		d = vtr.pnt2 - vtr.pnt1,
+		f = pnt - vtr.pnt1;
+
+	return (f.x * d.x + f.y * d.y) / (d.x * d.x + d.y * d.y);
+}
+
+// Item i of a batch result against Circle2D::intercept of the same pair.
+static bool
+sameAsScalar(const Circle2D &circle, const Vector2D &vtr, bool aparent, const InterceptBuffer &res, size_t i)
+{
+	Vector2D
+		pnts;
+	IntersectionEnum
+		kind = circle.intercept(vtr, pnts, aparent);
+	Point2D
+		d = vtr.pnt2 - vtr.pnt1;
+
+	if (res.getKind(i) != kind)
+		return false;
+
+	return kind == iNone || (near(vtr.pnt1 + d * res.t1[i], pnts.pnt1) && near(vtr.pnt1 + d * res.t2[i], pnts.pnt2));
+}
+
+int
+main()
+{
+	const Circle2D
+		circle(Point2D(0, 0), 5);
+
+	for (bool blnAparent : { false, true })
+	{
+		// Tangent, inside the segment and past its end.
+		CIVIL_CHECK(hits(circle, Vector2D(-10, 5, 10, 5), blnAparent, iTangent, Point2D(0, 5), Point2D(0, 5)));
+		CIVIL_CHECK(hits(circle, Vector2D(20, 5, 30, 5), blnAparent, blnAparent ? iTangent : iNone, Point2D(0, 5),
+			Point2D(0, 5)));
+
+		// Two points, ordered along the vector.
+		CIVIL_CHECK(hits(circle, Vector2D(-10, 0, 10, 0), blnAparent, iTwoPoints, Point2D(-5, 0), Point2D(5, 0)));
+		CIVIL_CHECK(hits(circle, Vector2D(0, 10, 0, -10), blnAparent, iTwoPoints, Point2D(0, 5), Point2D(0, -5)));
+		CIVIL_CHECK(hits(circle, Vector2D(-6, -8, 6, 8), blnAparent, iTwoPoints, Point2D(-3, -4), Point2D(3, 4)));
+
+		// The segment starts inside: one point on the segment, two on the line.
+		CIVIL_CHECK(hits(circle, Vector2D(0, 0, 10, 0), blnAparent, blnAparent ? iTwoPoints : iOnePoint,
+			blnAparent ? Point2D(-5, 0) : Point2D(5, 0), Point2D(5, 0)));
+		CIVIL_CHECK(hits(circle, Vector2D(-10, 0, 3, 0), blnAparent, blnAparent ? iTwoPoints : iOnePoint, Point2D(-5, 0),
+			blnAparent ? Point2D(5, 0) : Point2D(-5, 0)));
+
+		// Wholly inside and short of the circle: nothing on the segment, both points on the line.
+		CIVIL_CHECK(hits(circle, Vector2D(-1, 0, 1, 0), blnAparent, blnAparent ? iTwoPoints : iNone, Point2D(-5, 0),
+			Point2D(5, 0)));
+		CIVIL_CHECK(hits(circle, Vector2D(-10, 0, -6, 0), blnAparent, blnAparent ? iTwoPoints : iNone, Point2D(-5, 0),
+			Point2D(5, 0)));
+
+		// Miss, and a vector of zero length, inside or outside.
+		CIVIL_CHECK(hits(circle, Vector2D(-10, 6, 10, 6), blnAparent, iNone));
+		CIVIL_CHECK(hits(circle, Vector2D(1, 1, 1, 1), blnAparent, iNone));
+		CIVIL_CHECK(hits(circle, Vector2D(5, 0, 5, 0), blnAparent, iNone));
+	}
+
+	// Batches: the cases above plus random circles and vectors, odd counts so that the tails run.
+	std::mt19937_64
+		rng(26);
+	std::uniform_real_distribution<double>
+		coord(-50, 50),
+		radius(0.5, 15);
+	std::vector<Vector2D>
+		aVectors = { Vector2D(-10, 5, 10, 5), Vector2D(20, 5, 30, 5), Vector2D(-10, 0, 10, 0), Vector2D(0, 0, 10, 0),
+			Vector2D(-10, 0, 3, 0), Vector2D(-1, 0, 1, 0), Vector2D(-10, 6, 10, 6), Vector2D(1, 1, 1, 1) };
+	CircleBuffer
+		circles;
+	SegmentBuffer
+		vectors;
+
+	for (size_t i = 0; i < aVectors.size(); i++)
+		circles.add(circle);
+
+	while (aVectors.size() < 2001)
+		aVectors.push_back(Vector2D(coord(rng), coord(rng), coord(rng), coord(rng)));
+	while (circles.size() < 2001)
+		circles.add(Circle2D(Point2D(coord(rng), coord(rng)), radius(rng)));
+
+	for (const Vector2D &vtr : aVectors)
+		vectors.add(vtr);
+
+	forEachIsaLevel([&](IsaLevelEnum level) {
+		InterceptBuffer
+			res;
+		int
+			intWrong = 0;
+
+		for (bool blnAparent : { false, true })
+		{
+			// Every vector against the circle of the same index, through the buffer of vectors...
+			for (size_t i = 0; i < 8; i++)
+			{
+				interceptBatch(circles.getItem(i), vectors, blnAparent, res);
+				intWrong += !sameAsScalar(circle, aVectors[i], blnAparent, res, i);
+			}
+
+			// ...and a few vectors against every circle, and every vector against a few circles.
+			for (size_t j = 0; j < aVectors.size(); j += 97)
+			{
+				interceptBatch(aVectors[j], circles, blnAparent, res);
+				for (size_t i = 0; i < circles.size(); i++)
+					intWrong += !sameAsScalar(circles.getItem(i), aVectors[j], blnAparent, res, i);
+
+				interceptBatch(circles.getItem(j), vectors, blnAparent, res);
+				for (size_t i = 0; i < vectors.size(); i++)
+					intWrong += !sameAsScalar(circles.getItem(j), aVectors[i], blnAparent, res, i);
+			}
+		}
+
+		// The circle entered first along each vector, found one circle at a time.
+		for (size_t j = 8; j < aVectors.size(); j += 41)
+		{
+			const Vector2D
+				&vtr = aVectors[j];
+			long long
+				intBest = -1;
+			double
+				dblBest = 1,
+				t;
+
+			for (size_t i = 0; i < circles.size(); i++)
+			{
+				Circle2D
+					circ = circles.getItem(i);
+				Vector2D
+					pnts;
+				double
+					dblEnter;
+
+				if (vtr.pnt1.dist(circ.center) <= circ.getRadius())
+					dblEnter = 0;
+				else if (circ.intercept(vtr, pnts, false) != iNone)
+					dblEnter = paramOf(vtr, pnts.pnt1);
+				else
+					continue;
+
+				if (intBest < 0 || dblEnter < dblBest)
+				{
+					intBest = (long long) i;
+					dblBest = dblEnter;
+				}
+			}
+
+			long long
+				intFound = nearestIntercept(vtr, circles, t);
+
+			intWrong += intFound != intBest || (intBest >= 0 && abs(t - dblBest) > 1e-9);
+		}
+
+		printf("%s: %d mismatch(es)\n", isaLevelName(level), intWrong);
+		CIVIL_CHECK(intWrong == 0);
+	});
+
+	return testResult("TestIntercept");
+}
@@ -0,0 +1,298 @@
+/***
+ * TestPolygonBoolean.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilPolygonBoolean.h"
+#include "..\MathLibrary\CivilPreparedPolygon.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// polygonBoolean and polygonUnion: the area identities of the four operations, every result classified
+// point by point against its operands, holes, shared edges, identical operands and the union of a rotated
+// grid of lots at survey coordinates.
+
+static const double
+	EAST = 356789.125,
+	NORTH = 7987654.375;
+
+static bool
+near(double a, double b, double tol)
+{
+	return abs(a - b) <= tol * (1 + abs(b));
+}
+
+static std::vector<Point2D>
+box(double x1, double y1, double x2, double y2)
+{
+	return { Point2D(EAST + x1, NORTH + y1), Point2D(EAST + x2, NORTH + y1), Point2D(EAST + x2, NORTH + y2), Point2D(EAST + x1, NORTH + y2) };
+}
+
+static std::vector<Point2D>
+regular(double cx, double cy, double r, int sides, double phase)
+{
+	std::vector<Point2D>
+		aPnts;
+
+	for (int i = 0; i < sides; i++)
+		aPnts.push_back(Point2D(EAST + cx + r * cos(phase + 2 * M_PI * i / sides), NORTH + cy + r * sin(phase + 2 * M_PI * i / sides)));
+
+	return aPnts;
+}
+
+static bool
+expected(bool inA, bool inB, BooleanOperationEnum op)
+{
+	switch (op)
+	{
+	case boUnion:
+		return inA || inB;
+	case boIntersection:
+		return inA && inB;
+	case boDifference:
+		return inA && !inB;
+	default:
+		return inA != inB;
+	}
+}
+
+// The result has solids counterclockwise and holes clockwise, and every random point of the common box
+// away from all boundaries is in it exactly when the operation says so.
+static void
+checkResult(const Polygon2D &a, const Polygon2D &b, const Polygon2D &res, BooleanOperationEnum op, std::mt19937_64 &rng)
+{
+	Rectangle2D
+		rect = Rectangle2D::combine(a.boundsRect(), b.boundsRect());
+	std::uniform_real_distribution<double>
+		x(rect.left, rect.right),
+		y(rect.bottom, rect.top);
+	PreparedPolygon
+		prepA(a),
+		prepB(b),
+		prepRes(res);
+	size_t
+		intWrong = 0;
+
+	for (int i = 0; i < 4000; i++)
+	{
+		Point2D
+			pnt(x(rng), y(rng));
+		PointLocationEnum
+			locA = prepA.locate(pnt),
+			locB = prepB.locate(pnt),
+			locRes = prepRes.locate(pnt);
+
+		if (locA == plBoundary || locB == plBoundary || locRes == plBoundary)
+			continue;
+
+		intWrong += (locRes == plInside) != expected(locA == plInside, locB == plInside, op);
+	}
+
+	CIVIL_CHECK(intWrong == 0);
+
+	// Every vertex of the result lies on the boundary of an operand.
+	for (size_t i = 0; i < res.vertices.size(); i++)
+		if (prepA.locate(res.getVertex(i)) != plBoundary && prepB.locate(res.getVertex(i)) != plBoundary)
+		{
+			// A crossing point, rounded: within a few ulps of both.
+			Point2D
+				pnt = res.getVertex(i);
+			bool
+				blnNear = false;
+
+			for (double dx : { -1e-9, 0.0, 1e-9 })
+				for (double dy : { -1e-9, 0.0, 1e-9 })
+					blnNear |= prepA.locate(pnt.x + dx, pnt.y + dy) != prepA.locate(pnt) || prepB.locate(pnt.x + dx, pnt.y + dy) != prepB.locate(pnt);
+
+			CIVIL_CHECK(blnNear);
+		}
+}
+
+// Area identities over the four operations: |A u B| + |A n B| = |A| + |B|, |A - B| + |A n B| = |A| and
+// |A x B| = |A u B| - |A n B|.
+static void
+checkIdentities(const Polygon2D &a, const Polygon2D &b, std::mt19937_64 &rng)
+{
+	Polygon2D
+		uni = polygonBoolean(a, b, boUnion),
+		inter = polygonBoolean(a, b, boIntersection),
+		diff = polygonBoolean(a, b, boDifference),
+		sym = polygonBoolean(a, b, boXor);
+	double
+		dblScale = a.area() + b.area();
+
+	CIVIL_CHECK(near(uni.area() + inter.area(), a.area() + b.area(), 1e-9));
+	CIVIL_CHECK(abs(diff.area() + inter.area() - a.area()) <= 1e-9 * dblScale);
+	CIVIL_CHECK(abs(sym.area() - (uni.area() - inter.area())) <= 1e-9 * dblScale);
+	CIVIL_CHECK(near(polygonBoolean(b, a, boDifference).area(), uni.area() - a.area(), 1e-9));
+
+	checkResult(a, b, uni, boUnion, rng);
+	checkResult(a, b, inter, boIntersection, rng);
+	checkResult(a, b, diff, boDifference, rng);
+	checkResult(a, b, sym, boXor, rng);
+}
+
+static size_t
+holeCount(const Polygon2D &poly)
+{
+	size_t
+		intHoles = 0;
+
+	for (size_t r = 0; r < poly.getRingCount(); r++)
+		intHoles += poly.ringArea(r) < 0;
+
+	return intHoles;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	std::mt19937_64
+		rng(49);
+
+	// A square with a square hole against a 37-gon with a hexagonal hole, overlapping the hole.
+	Polygon2D
+		a(box(0, 0, 100, 100)),
+		b(regular(90, 60, 45, 37, 0.1));
+
+	a.addRing(box(30, 30, 60, 70), true);
+	b.addRing(regular(95, 55, 15, 6, 0.3), true);
+	checkIdentities(a, b, rng);
+
+	// The union keeps a's hole, partly filled by b, and b's hole less a.
+	Polygon2D
+		uni = polygonBoolean(a, b, boUnion);
+
+	CIVIL_CHECK(holeCount(uni) == 2 && uni.getRingCount() == 3);
+
+	// Two squares sharing part of an edge, and a third touching the first at a corner.
+	Polygon2D
+		left(box(0, 0, 50, 50)),
+		right(box(50, 20, 90, 80)),
+		corner(box(-30, -30, 0, 0));
+
+	checkIdentities(left, right, rng);
+	checkIdentities(left, corner, rng);
+	CIVIL_CHECK(polygonBoolean(left, right, boUnion).getRingCount() == 1 && polygonBoolean(left, right, boIntersection).getRingCount() == 0);
+	CIVIL_CHECK(near(polygonBoolean(left, right, boUnion).area(), 2500 + 2400, 1e-12));
+	CIVIL_CHECK(polygonBoolean(left, corner, boIntersection).area() == 0);
+
+	// Identical operands.
+	Polygon2D
+		same = polygonBoolean(a, a, boUnion);
+
+	CIVIL_CHECK(near(same.area(), a.area(), 1e-12) && same.getRingCount() == 2 && same.vertices.size() == 8);
+	CIVIL_CHECK(near(polygonBoolean(a, a, boIntersection).area(), a.area(), 1e-12));
+	CIVIL_CHECK(polygonBoolean(a, a, boDifference).getRingCount() == 0 && polygonBoolean(a, a, boXor).getRingCount() == 0);
+
+	// A polygon against its hole filled in: the union is the square, the intersection empty.
+	Polygon2D
+		plug(box(30, 30, 60, 70));
+
+	CIVIL_CHECK(polygonBoolean(a, plug, boUnion).getRingCount() == 1 && near(polygonBoolean(a, plug, boUnion).area(), 10000, 1e-12));
+	CIVIL_CHECK(polygonBoolean(a, plug, boIntersection).area() == 0);
+	checkIdentities(a, plug, rng);
+
+	// Random convex shapes across each other.
+	std::uniform_real_distribution<double>
+		pos(-50, 50),
+		size(10, 60);
+
+	for (int i = 0; i < 20; i++)
+		checkIdentities(Polygon2D(regular(pos(rng), pos(rng), size(rng), 3 + i, pos(rng))),
+			Polygon2D(regular(pos(rng), pos(rng), size(rng), 4 + i % 7, pos(rng))), rng);
+
+	// A block of 12 x 8 lots of 15 x 30 m, rotated by 17 degrees at survey coordinates; the lots share the
+	// corners of one lattice, so neighbours share their edges exactly.
+	const int
+		COLS = 12,
+		ROWS = 8;
+	const double
+		ANG = 17 * M_PI / 180;
+	std::vector<Point2D>
+		aCorners;
+
+	for (int i = 0; i <= ROWS; i++)
+		for (int j = 0; j <= COLS; j++)
+		{
+			double
+				u = 15.0 * j,
+				v = 30.0 * i;
+
+			aCorners.push_back(Point2D(EAST + u * cos(ANG) - v * sin(ANG), NORTH + u * sin(ANG) + v * cos(ANG)));
+		}
+
+	auto
+		node = [&](int i, int j) { return aCorners[i * (COLS + 1) + j]; };
+	std::vector<Polygon2D>
+		aLots,
+		aMissing;
+	double
+		dblLots = 0;
+
+	for (int i = 0; i < ROWS; i++)
+		for (int j = 0; j < COLS; j++)
+		{
+			Polygon2D
+				lot({ node(i, j), node(i, j + 1), node(i + 1, j + 1), node(i + 1, j) });
+
+			aLots.push_back(lot);
+			dblLots += lot.area();
+			if (i != 3 || j != 5)
+				aMissing.push_back(lot);
+		}
+
+	for (bool blnParallel : { false, true })
+	{
+		Polygon2D
+			block = polygonUnion(aLots, blnParallel),
+			holed = polygonUnion(aMissing, blnParallel);
+
+		CIVIL_CHECK(block.getRingCount() == 1 && near(block.area(), dblLots, 1e-12) && near(block.area(), 180.0 * 240, 1e-9));
+		CIVIL_CHECK(holed.getRingCount() == 2 && holeCount(holed) == 1 && near(holed.area(), dblLots - aLots[3 * COLS + 5].area(), 1e-12));
+
+		// The outline of the block has its 4 corners and those of the lattice along its sides that are
+		// not exactly in line after the rotation, never more.
+		CIVIL_CHECK(block.vertices.size() >= 4 && block.vertices.size() <= 2 * (COLS + ROWS));
+	}
+
+	// The block against a road crossing it.
+	Polygon2D
+		block = polygonUnion(aLots),
+		road({ Point2D(EAST - 50, NORTH + 100), Point2D(EAST + 250, NORTH + 60), Point2D(EAST + 250, NORTH + 72),
+			Point2D(EAST - 50, NORTH + 112) });
+
+	checkIdentities(block, road, rng);
+	checkIdentities(polygonUnion(aMissing), road, rng);
+
+	return testResult("TestPolygonBoolean");
+}
@@ -0,0 +1,241 @@
+/***
+ * TestPreparedPolygon.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilPreparedPolygon.h"
+#include "..\MathLibrary\CivilPredicates.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// PreparedPolygon against the winding number counted over every edge: a star of many spikes at survey
+// coordinates with holes, random points over its box, its vertices and points along its edges, grids of
+// several densities and the batch form at every instruction set level.
+
+static const double
+	EAST = 487654.25,
+	NORTH = 7123456.5;
+
+// Coordinates on a 1/64 m lattice, so that the midpoints and quarter points of the edges are exact and
+// lie on them.
+static double
+snap(double value)
+{
+	return round(value * 64) / 64;
+}
+
+// Nonzero winding number over all the edges, or plBoundary on one.
+static PointLocationEnum
+bruteLocate(const Polygon2D &poly, const Point2D &pnt)
+{
+	int
+		intWinding = 0;
+
+	for (size_t r = 0; r < poly.getRingCount(); r++)
+		for (size_t i = poly.ringBegin(r); i < poly.ringEnd(r); i++)
+		{
+			Point2D
+				a = poly.getVertex(i),
+				b = poly.getVertex(i + 1 < poly.ringEnd(r) ? i + 1 : poly.ringBegin(r));
+			double
+				o = orient2d(a, b, pnt);
+
+			if (o == 0 && std::min(a.x, b.x) <= pnt.x && pnt.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= pnt.y && pnt.y <= std::max(a.y, b.y))
+				return plBoundary;
+
+			if (a.y <= pnt.y && b.y > pnt.y && o > 0)
+				intWinding++;
+			else if (a.y > pnt.y && b.y <= pnt.y && o < 0)
+				intWinding--;
+		}
+
+	return intWinding != 0 ? plInside : plOutside;
+}
+
+static std::vector<Point2D>
+starRing(std::mt19937_64 &rng, const Point2D &center, double outer, double inner, int spikes)
+{
+	std::uniform_real_distribution<double>
+		vary(0.9, 1.1);
+	std::vector<Point2D>
+		aPnts;
+
+	for (int i = 0; i < 2 * spikes; i++)
+	{
+		double
+			t = M_PI * i / spikes,
+			r = (i % 2 ? inner : outer) * vary(rng);
+
+		aPnts.push_back(Point2D(snap(center.x + r * cos(t)), snap(center.y + r * sin(t))));
+	}
+
+	return aPnts;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	std::mt19937_64
+		rng(48);
+
+	// A star of 1500 spikes, three holes (one of them a smaller star) and a separate island.
+	Polygon2D
+		poly(starRing(rng, Point2D(EAST, NORTH), 1000, 400, 1500));
+
+	poly.addRing(starRing(rng, Point2D(EAST + 100, NORTH - 50), 200, 120, 40), true);
+	poly.addRing({ Point2D(EAST - 300, NORTH - 40), Point2D(EAST - 200, NORTH - 40), Point2D(EAST - 200, NORTH + 60),
+		Point2D(EAST - 300, NORTH + 60) }, true);
+	poly.addRing({ Point2D(EAST - 50, NORTH + 200), Point2D(EAST + 10, NORTH + 320), Point2D(EAST - 110, NORTH + 320) }, true);
+	poly.addRing({ Point2D(EAST + 1200, NORTH + 1200), Point2D(EAST + 1300, NORTH + 1200), Point2D(EAST + 1300, NORTH + 1250) });
+
+	// Queries: random over the box, every vertex, and the midpoint and a quarter point of every edge.
+	std::uniform_real_distribution<double>
+		coord(-1350, 1350);
+	std::vector<Point2D>
+		aQueries;
+	std::vector<PointLocationEnum>
+		aExpected;
+	size_t
+		intRandom = 20000;
+
+	for (size_t i = 0; i < intRandom; i++)
+		aQueries.push_back(Point2D(EAST + coord(rng), NORTH + coord(rng)));
+
+	for (size_t r = 0; r < poly.getRingCount(); r++)
+		for (size_t i = poly.ringBegin(r); i < poly.ringEnd(r); i++)
+		{
+			Point2D
+				a = poly.getVertex(i),
+				b = poly.getVertex(i + 1 < poly.ringEnd(r) ? i + 1 : poly.ringBegin(r));
+
+			aQueries.push_back(a);
+			aQueries.push_back(Point2D((a.x + b.x) / 2, (a.y + b.y) / 2));
+			aQueries.push_back(Point2D(a.x + (b.x - a.x) / 4, a.y + (b.y - a.y) / 4));
+		}
+
+	int
+		aCounts[3] = {};
+
+	for (const Point2D &pnt : aQueries)
+	{
+		aExpected.push_back(bruteLocate(poly, pnt));
+		aCounts[aExpected.back()]++;
+	}
+
+	// Every vertex and edge point is on the boundary; the random ones fall on both sides.
+	for (size_t i = intRandom; i < aQueries.size(); i++)
+		CIVIL_CHECK(aExpected[i] == plBoundary);
+	CIVIL_CHECK(aCounts[plInside] > 2000 && aCounts[plOutside] > 2000);
+
+	forEachIsaLevel([&](CIVIL::UTILS::IsaLevelEnum level)
+	{
+		for (double dblCells : { 0.25, 2.0, 8.0 })
+		{
+			PreparedPolygon
+				prep(poly, dblCells);
+			std::vector<PointLocationEnum>
+				aBatch;
+			size_t
+				intWrong = 0,
+				intBatchWrong = 0;
+
+			prep.locateBatch(aQueries, aBatch);
+			CIVIL_CHECK(aBatch.size() == aQueries.size());
+
+			for (size_t i = 0; i < aQueries.size(); i++)
+			{
+				intWrong += prep.locate(aQueries[i]) != aExpected[i];
+				intBatchWrong += aBatch[i] != aExpected[i];
+			}
+
+			CIVIL_CHECK(intWrong == 0 && intBatchWrong == 0);
+			CIVIL_CHECK(prep.contains(poly.getVertex(0)) && !prep.contains(Point2D(EAST - 250, NORTH)));
+
+			// The PointBuffer form.
+			PointBuffer
+				buf;
+
+			for (size_t i = 0; i < aQueries.size(); i += 3)
+				buf.add(aQueries[i]);
+
+			prep.locateBatch(buf, aBatch);
+			for (size_t i = 0; i < buf.size(); i++)
+				intBatchWrong += aBatch[i] != aExpected[3 * i];
+			CIVIL_CHECK(intBatchWrong == 0);
+		}
+
+		printf("%-8s %zu queries: %d inside, %d outside, %d on the boundary\n", isaLevelName(level), aQueries.size(),
+			aCounts[plInside], aCounts[plOutside], aCounts[plBoundary]);
+	});
+
+	// Each variant of the kernel against the scalar one, on edges from the star and points on their
+	// edges and on the leg from the cell corner.
+	for (int intLevel = ilSSE2; intLevel <= detectedIsaLevel(); intLevel++)
+		for (size_t n = 0; n < 40; n++)
+		{
+			std::vector<double>
+				ax,
+				ay,
+				bx,
+				by;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				Point2D
+					a = poly.getVertex(i),
+					b = poly.getVertex(i + 1);
+
+				ax.push_back(a.x);
+				ay.push_back(a.y);
+				bx.push_back(b.x);
+				by.push_back(b.y);
+			}
+
+			for (int k = 0; k < 20; k++)
+			{
+				Point2D
+					pnt = k < 10 || n == 0 ? Point2D(EAST + coord(rng), NORTH + coord(rng)) :
+						Point2D((ax[k % n] + bx[k % n]) / 2, (ay[k % n] + by[k % n]) / 2);
+				double
+					xl = k % 3 == 0 && n > 0 ? ax[0] : pnt.x - 37.5;
+				int
+					intScalarFlags = 0,
+					intFlags = 0,
+					intScalar = cellWindingKernel.variant(ilScalar)(ax.data(), ay.data(), bx.data(), by.data(), n, xl, pnt.x, pnt.y, intScalarFlags),
+					intVector = cellWindingKernel.variant((IsaLevelEnum) intLevel)(ax.data(), ay.data(), bx.data(), by.data(), n, xl, pnt.x, pnt.y, intFlags);
+
+				CIVIL_CHECK(intFlags == intScalarFlags && (intScalarFlags != 0 || intVector == intScalar));
+			}
+		}
+
+	return testResult("TestPreparedPolygon");
+}
@@ -0,0 +1,100 @@
+/***
+ * TestReportWriter.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <float.h>
+#include <stdio.h>
+#include <string>
+
+#include "..\MathLibrary\CivilReportWriter.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Writes one record through fn to a temporary file and returns the text written.
+template <typename FnType> static std::string
+report(const FnType &fn)
+{
+	FILE
+		*file = tmpfile();
+
+	{
+		ReportWriter
+			writer(fileno(file));
+
+		fn(writer);
+	}
+
+	std::string
+		text;
+	char
+		buffer[4096];
+	size_t
+		n;
+
+	rewind(file);
+	while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		text.append(buffer, n);
+
+	fclose(file);
+
+	return text;
+}
+
+int
+main()
+{
+	CIVIL_CHECK(report([](ReportWriter &w) { w.addNumber(1.5, 2); w.addNumber(-2, 0); w.endRecord(); }) == "1.50;-2\n");
+
+	// Fixed notation of the largest double: 309 digits, past the first room asked for a field.
+	std::string
+		text = report([](ReportWriter &w) { w.addNumber(DBL_MAX, 3); w.endRecord(); });
+
+	CIVIL_CHECK(text.size() == 309 + 4 + 1 && text.compare(0, 6, "179769") == 0 && text.compare(309, 5, ".000\n") == 0);
+
+	// More than the block for any double: the field grows until it fits instead of being dropped.
+	text = report([](ReportWriter &w) { w.addNumber(DBL_MAX, 1000); w.addNumber(0.25, 3000); w.endRecord(); });
+	CIVIL_CHECK(text.size() == 309 + 1 + 1000 + 1 + 2 + 3000 + 1);
+	CIVIL_CHECK(text.compare(309 + 1 + 1000, 7, ";0.2500") == 0 && text.back() == '\n');
+
+	// A field beyond the limit raises, and the fields before it are still written.
+	bool
+		blnRaised = false;
+
+	text = report([&](ReportWriter &w) {
+		try
+		{
+			w.addNumber(7, 0);
+			w.addNumber(1, 2000000);
+		}
+		catch (const EReportWriter &)
+		{
+			blnRaised = true;
+		}
+	});
+
+	CIVIL_CHECK(blnRaised && text == "7;");
+
+	return testResult("TestReportWriter");
+}
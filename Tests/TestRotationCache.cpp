@@ -0,0 +1,153 @@
+/***
+ * TestRotationCache.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilBatch2D.h"
+#include "..\MathLibrary\CivilRotationCache.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// RotationCache against Matrix2D::rotation, and sinCosBatch against libm on both sides of the limit where
+// it falls back to sin and cos.
+
+static bool
+same(const Matrix2D &a, const Matrix2D &b)
+{
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+			if (a.items[i][j] != b.items[i][j])
+				return false;
+
+	return true;
+}
+
+int
+main()
+{
+	std::mt19937_64
+		rng(33);
+	std::uniform_real_distribution<double>
+		angles(-4 * M_PI, 4 * M_PI),
+		coords(-500000, 500000);
+
+	// The cache builds the matrix from the same sine and cosine, so the entries agree bit for bit, first
+	// from a miss and then from a hit.
+	RotationCache
+		cache;
+	std::vector<double>
+		aAngles;
+
+	for (int i = 0; i < 64; i++)
+		aAngles.push_back(angles(rng));
+
+	for (int intPass = 0; intPass < 2; intPass++)
+		for (double dblAng : aAngles)
+		{
+			double
+				x = coords(rng),
+				y = coords(rng),
+				s,
+				c;
+
+			CIVIL_CHECK(same(cache.rotation(Angle(dblAng)), Matrix2D::rotation(Angle(dblAng))));
+			CIVIL_CHECK(same(cache.rotation(Angle(dblAng), x, y), Matrix2D::rotation(Angle(dblAng), x, y)));
+			CIVIL_CHECK(same(cache.rotation(Angle(dblAng), 10, 20), Matrix2D::rotation(Angle(dblAng), 10, 20)));
+
+			cache.sinCos(Angle(dblAng), s, c);
+			CIVIL_CHECK(s == sin(dblAng) && c == cos(dblAng));
+		}
+
+	// 64 sines and cosines, 64 pivots about (10, 20) and 128 about random points.
+	CIVIL_CHECK(cache.size() == 64 + 64 + 128);
+
+	// 0 and -0 are one angle, and one pivot coordinate.
+	cache.clear();
+	CIVIL_CHECK(same(cache.rotation(Angle(0.0)), Matrix2D::rotation(Angle(0.0))));
+	CIVIL_CHECK(same(cache.rotation(Angle(-0.0)), Matrix2D::rotation(Angle(-0.0))));
+	CIVIL_CHECK(cache.size() == 1);
+
+	cache.rotation(Angle(0.0), 0.0, 5);
+	cache.rotation(Angle(-0.0), -0.0, 5);
+	CIVIL_CHECK(cache.size() == 2);
+
+	// At capacity the next new angle empties the cache, and the results stay right across the reset.
+	RotationCache
+		small(4);
+
+	for (int i = 0; i < 4; i++)
+		small.rotation(Angle(i * 0.25));
+
+	CIVIL_CHECK(small.size() == 4);
+	CIVIL_CHECK(same(small.rotation(Angle(0.5)), Matrix2D::rotation(Angle(0.5))) && small.size() == 4);
+	CIVIL_CHECK(same(small.rotation(Angle(2.0)), Matrix2D::rotation(Angle(2.0))) && small.size() == 1);
+	CIVIL_CHECK(same(small.rotation(Angle(0.5)), Matrix2D::rotation(Angle(0.5))) && small.size() == 2);
+
+	// Angles through the polynomial kernel, a few past 1e5 rad that go to libm, and the values around the
+	// limit, in an array whose length is not a multiple of any vector width.
+	std::uniform_real_distribution<double>
+		inside(-1e5, 1e5),
+		outside(1e5, 1e9);
+	std::vector<double>
+		aInput,
+		aSin,
+		aCos;
+
+	for (int i = 0; i < 100003; i++)
+		aInput.push_back(i % 97 == 0 ? (i % 2 ? -1 : 1) * outside(rng) : inside(rng));
+
+	aInput.insert(aInput.end(), { 0.0, -0.0, M_PI_2, M_PI, -M_PI_4, 1e5, -1e5, nextafter(1e5, 2e5), 1e300 });
+
+	forEachIsaLevel([&](CIVIL::UTILS::IsaLevelEnum level)
+	{
+		double
+			dblErr = 0;
+		bool
+			blnFallback = true;
+
+		aSin.assign(3, 7.0);
+		sinCosBatch(aInput, aSin, aCos);
+		CIVIL_CHECK(aSin.size() == aInput.size() && aCos.size() == aInput.size());
+
+		for (size_t i = 0; i < aInput.size(); i++)
+			if (abs(aInput[i]) > 1e5)
+				blnFallback &= aSin[i] == sin(aInput[i]) && aCos[i] == cos(aInput[i]);
+			else
+				dblErr = std::max(dblErr, std::max(abs(aSin[i] - sin(aInput[i])), abs(aCos[i] - cos(aInput[i]))));
+
+		printf("%-8s sinCosBatch against libm: %.2e, fallback %s\n", isaLevelName(level), dblErr, blnFallback ? "exact" : "differs");
+		CIVIL_CHECK(dblErr <= 4.5e-16 && blnFallback);
+	});
+
+	// Empty input gives empty output.
+	aInput.clear();
+	sinCosBatch(aInput, aSin, aCos);
+	CIVIL_CHECK(aSin.empty() && aCos.empty());
+
+	return testResult("TestRotationCache");
+}
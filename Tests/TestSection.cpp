@@ -0,0 +1,180 @@
+/***
+ * TestSection.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <vector>
+
+#include "..\MathLibrary\CivilPolygon2D.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Section properties against closed forms: a hollow rectangle placed at survey coordinates, the principal
+// axes of a rotated rectangle and a fine polygon against Circle2D::inertiaX / inertiaY. Every check runs
+// once per instruction set level, so each variant of sectionKernel is covered.
+
+static const double
+	EAST = 512345.678,
+	NORTH = 7456789.012;
+
+// Vertices at these coordinates are rounded to about 1e-9 m, which moves the properties of a section of
+// a few metres or less by up to some parts in 1e9.
+static const double
+	SURVEY_TOL = 2e-8;
+
+static bool
+near(double a, double b, double tol)
+{
+	return abs(a - b) <= tol * (1 + abs(b));
+}
+
+static std::vector<Point2D>
+rectangle(double x, double y, double width, double height)
+{
+	return { Point2D(x, y), Point2D(x + width, y), Point2D(x + width, y + height), Point2D(x, y + height) };
+}
+
+static Polygon2D
+circle(const Point2D &center, double radius, int count)
+{
+	std::vector<Point2D>
+		aPnts;
+
+	for (int i = 0; i < count; i++)
+		aPnts.push_back(Point2D(center.x + radius * cos(2 * M_PI * i / count), center.y + radius * sin(2 * M_PI * i / count)));
+
+	return Polygon2D(aPnts);
+}
+
+int
+main()
+{
+	forEachIsaLevel([](CIVIL::UTILS::IsaLevelEnum level)
+	{
+		// A 0.4 x 0.8 box with 0.05 and 0.1 walls, its lower left corner at survey coordinates.
+		const double
+			B = 0.4,
+			H = 0.8,
+			b = 0.3,
+			h = 0.6;
+		Polygon2D
+			box(rectangle(EAST, NORTH, B, H));
+
+		box.addRing(rectangle(EAST + 0.05, NORTH + 0.1, b, h), true);
+
+		SectionProperties
+			sec = box.sectionProperties();
+
+		CIVIL_CHECK(near(sec.area, B * H - b * h, SURVEY_TOL));
+		CIVIL_CHECK(near(sec.centroid.x, EAST + B / 2, 1e-15) && near(sec.centroid.y, NORTH + H / 2, 1e-15));
+		CIVIL_CHECK(near(sec.ix, (B * H * H * H - b * h * h * h) / 12, SURVEY_TOL));
+		CIVIL_CHECK(near(sec.iy, (H * B * B * B - h * b * b * b) / 12, SURVEY_TOL));
+		CIVIL_CHECK(abs(sec.ixy) <= SURVEY_TOL * sec.ix);
+
+		// The same section as a solid minus a void.
+		SectionProperties
+			composite = Polygon2D(rectangle(EAST, NORTH, B, H)).sectionProperties() +
+				Polygon2D(rectangle(EAST + 0.05, NORTH + 0.1, b, h)).sectionProperties().weighted(-1);
+
+		CIVIL_CHECK(near(composite.area, sec.area, SURVEY_TOL) && near(composite.ix, sec.ix, SURVEY_TOL) && near(composite.iy, sec.iy, SURVEY_TOL));
+
+		// About the lower left corner, by the parallel-axis theorem.
+		double
+			refIx,
+			refIy,
+			refIxy;
+
+		sec.inertiaAt(Point2D(EAST, NORTH), refIx, refIy, refIxy);
+		CIVIL_CHECK(near(refIx, sec.ix + sec.area * (H / 2) * (H / 2), SURVEY_TOL));
+		CIVIL_CHECK(near(refIy, sec.iy + sec.area * (B / 2) * (B / 2), SURVEY_TOL));
+		CIVIL_CHECK(near(refIxy, sec.area * (B / 2) * (H / 2), SURVEY_TOL));
+
+		// A 2 x 6 rectangle has i1 = 36 about its short axis and i2 = 4; rotated about a survey point the
+		// moments stay and the axis of i1 turns with it. At 90 degrees the axis is +-pi / 2, which rounding
+		// of the tiny ixy decides.
+		for (double dblDeg : { 0.0, 30.0, 75.0, 90.0, -60.0, 135.0 })
+		{
+			double
+				dblAng = dblDeg * M_PI / 180,
+				i1,
+				i2;
+			Angle
+				ang;
+			SectionProperties
+				rot = Polygon2D(rectangle(EAST - 1, NORTH - 3, 2, 6)).transform(Matrix2D::rotation(Angle(dblAng), EAST, NORTH)).sectionProperties();
+
+			rot.principalAxes(i1, i2, ang);
+
+			double
+				dblDiff = remainder((double) ang - dblAng, M_PI);
+
+			CIVIL_CHECK(near(i1, 36, SURVEY_TOL) && near(i2, 4, SURVEY_TOL) && near(rot.area, 12, SURVEY_TOL));
+			CIVIL_CHECK(abs(dblDiff) <= SURVEY_TOL && abs((double) ang) <= M_PI_2);
+			CIVIL_CHECK(near(rot.ix + rot.iy, 40, SURVEY_TOL));
+		}
+
+		// A polygon of many sides tends to the circle; the error of the inscribed polygon is of the order
+		// of (2 pi / n)^2.
+		const Point2D
+			center(EAST + 10, NORTH - 20),
+			ref(EAST, NORTH);
+		const Circle2D
+			cir(center, 3);
+		SectionProperties
+			disk = circle(center, 3, 20000).sectionProperties();
+		double
+			dblIx,
+			dblIy,
+			dblIxy;
+
+		disk.inertiaAt(ref, dblIx, dblIy, dblIxy);
+
+		CIVIL_CHECK(near(disk.area, cir.area(), 1e-7));
+		CIVIL_CHECK(near(disk.ix, cir.inertiaX(center), 1e-7) && near(disk.iy, cir.inertiaY(center), 1e-7));
+		CIVIL_CHECK(near(disk.ix, M_PI * 81 / 4, 1e-7));
+		CIVIL_CHECK(near(dblIx, cir.inertiaX(ref), 1e-7) && near(dblIy, cir.inertiaY(ref), 1e-7));
+
+		// The batch gives the same bits as one section at a time.
+		std::vector<Polygon2D>
+			aSections{ box, circle(center, 3, 999), Polygon2D(rectangle(EAST, NORTH, 2, 6)) };
+		std::vector<SectionProperties>
+			aRes;
+
+		sectionPropertiesBatch(aSections, aRes);
+		CIVIL_CHECK(aRes.size() == aSections.size());
+
+		for (size_t i = 0; i < aRes.size(); i++)
+		{
+			SectionProperties
+				one = aSections[i].sectionProperties();
+
+			CIVIL_CHECK(aRes[i].area == one.area && aRes[i].ix == one.ix && aRes[i].iy == one.iy && aRes[i].ixy == one.ixy);
+		}
+
+		printf("%-8s hollow box ix %.12g (closed form %.12g)\n", isaLevelName(level), sec.ix, (B * H * H * H - b * h * h * h) / 12);
+	});
+
+	return testResult("TestSection");
+}
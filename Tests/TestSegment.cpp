@@ -0,0 +1,153 @@
+/***
+ * TestSegment.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilBatch2D.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// SegmentRecord against the Vector2D queries it speeds up, the batch forms against SegmentRecord, and the
+// contracts of Vector2D::perpendicular and footVector.
+
+static bool
+near(double a, double b)
+{
+	return abs(a - b) <= 1e-9 * (1 + abs(b));
+}
+
+static bool
+near(const Point2D &a, const Point2D &b)
+{
+	return near(a.x, b.x) && near(a.y, b.y);
+}
+
+// Distance to the nearest point of the segment, by cases.
+static double
+segmentDistance(const Vector2D &vtr, const Point2D &pnt, double t)
+{
+	return t < 0 ? pnt.dist(vtr.pnt1) : (t > 1 ? pnt.dist(vtr.pnt2) : vtr.distPoint(pnt));
+}
+
+int
+main()
+{
+	// Before, on and past a horizontal segment, on the line and to both sides.
+	const Vector2D
+		vtr(0, 0, 10, 0);
+	const SegmentRecord
+		rec(vtr);
+
+	CIVIL_CHECK(rec.project(Point2D(-5, 3)) == -0.5 && !rec.innerLimits(Point2D(-5, 3)));
+	CIVIL_CHECK(rec.project(Point2D(5, 3)) == 0.5 && rec.innerLimits(Point2D(5, 3)));
+	CIVIL_CHECK(rec.project(Point2D(15, -3)) == 1.5 && !rec.innerLimits(Point2D(15, -3)));
+	CIVIL_CHECK(rec.innerLimits(Point2D(0, 7)) && rec.innerLimits(Point2D(10, -7)));
+
+	CIVIL_CHECK(rec.offset(Point2D(5, 3)) == 3 && vtr.side(Point2D(5, 3)) == sLeft);
+	CIVIL_CHECK(rec.offset(Point2D(5, -3)) == -3 && vtr.side(Point2D(5, -3)) == sRight);
+	CIVIL_CHECK(rec.offset(Point2D(20, 0)) == 0 && vtr.side(Point2D(20, 0)) == sOver);
+
+	CIVIL_CHECK(rec.distSegment(Point2D(-3, 4)) == 5 && rec.distPoint(Point2D(-3, 4)) == 4);
+	CIVIL_CHECK(rec.distSegment(Point2D(5, -4)) == 4);
+	CIVIL_CHECK(rec.distSegment(Point2D(13, -4)) == 5 && rec.distPoint(Point2D(13, -4)) == 4);
+	CIVIL_CHECK(rec.distSegment(Point2D(7, 0)) < 1e-12 && rec.distSegment(Point2D(12, 0)) == 2);
+
+	// Random segments and points spread before, along and past them.
+	std::mt19937_64
+		rng(27);
+	std::uniform_real_distribution<double>
+		coord(-1000, 1000),
+		along(-1, 2),
+		across(-50, 50);
+
+	for (int intCase = 0; intCase < 200; intCase++)
+	{
+		Vector2D
+			seg(coord(rng), coord(rng), coord(rng), coord(rng));
+		SegmentRecord
+			segRec(seg);
+		Point2D
+			dir = seg.versor(),
+			nrm(-dir.y, dir.x);
+		PointBuffer
+			pnts;
+		std::vector<double>
+			aT,
+			aOffset,
+			aDist;
+
+		for (int i = 0; i < 101; i++)
+		{
+			double
+				t = along(rng),
+				dblOffset = i % 10 == 0 ? 0 : across(rng);
+
+			aT.push_back(t);
+			pnts.add(seg.pnt1 + (seg.pnt2 - seg.pnt1) * t + nrm * dblOffset);
+		}
+
+		offsetBatch(segRec, pnts, aOffset);
+		distSegmentBatch(segRec, pnts, aDist);
+
+		for (size_t i = 0; i < pnts.size(); i++)
+		{
+			Point2D
+				pnt = pnts.getItem(i);
+			double
+				dblOffset = segRec.offset(pnt);
+
+			CIVIL_CHECK(near(segRec.project(pnt), aT[i]));
+			CIVIL_CHECK(near(segRec.distPoint(pnt), seg.distPoint(pnt)));
+			CIVIL_CHECK(abs(dblOffset) < 1e-9 || (dblOffset > 0 ? sLeft : sRight) == seg.side(pnt));
+			CIVIL_CHECK(near(segRec.distSegment(pnt), segmentDistance(seg, pnt, aT[i])));
+			CIVIL_CHECK(near(segRec.closestPoint(pnt), segRec.pointAt(aT[i] < 0 ? 0 : (aT[i] > 1 ? 1 : aT[i]))));
+			CIVIL_CHECK(near(aOffset[i], dblOffset) && near(aDist[i], segRec.distSegment(pnt)));
+		}
+
+		// Vector2D::perpendicular: from the foot to the reference, as long as the vector whatever "module"
+		// ---- says. footVector: from the foot to the reference, or "module" long toward its side.
+		Point2D
+			ref = pnts.getItem(1),
+			foot = segRec.pointAt(aT[1]);
+
+		for (double dblModule : { 0.0, 3.5 })
+		{
+			Vector2D
+				perp = seg.perpendicular(ref, dblModule),
+				vtrFoot = seg.footVector(ref, dblModule);
+
+			CIVIL_CHECK(near(perp.pnt1, foot) && near(perp.getModule(), seg.getModule()));
+			CIVIL_CHECK(near(perp.versor(), (ref - foot) / (ref - foot).dist()));
+
+			CIVIL_CHECK(near(vtrFoot.pnt1, foot) && near(vtrFoot.versor(), (ref - foot) / (ref - foot).dist()));
+			CIVIL_CHECK(dblModule == 0 ? near(vtrFoot.pnt2, ref) : near(vtrFoot.getModule(), dblModule));
+		}
+	}
+
+	return testResult("TestSegment");
+}
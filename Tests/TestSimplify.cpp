@@ -0,0 +1,142 @@
+/***
+ * TestSimplify.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilSimplify.h"
+#include "..\MathLibrary\CivilPredicates.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// Whether the simplified line "kept" of "pnts" is free of self-intersections, but for those between two
+// segments of the input, which simplification leaves as they are. Every pair is tested.
+static bool
+noNewIntersections(const std::vector<Point2D> &pnts, bool closed, const std::vector<size_t> &kept)
+{
+	std::vector<size_t>
+		aIdx = kept;
+
+	if (closed)
+		aIdx.push_back(pnts.size());
+
+	size_t
+		k = aIdx.size() - 1;
+
+	auto at = [&](size_t i) -> const Point2D & {
+		return pnts[aIdx[i] == pnts.size() ? 0 : aIdx[i]];
+	};
+	auto isInput = [&](size_t s) {
+		return aIdx[s + 1] - aIdx[s] == 1;
+	};
+
+	for (size_t s = 0; s < k; s++)
+		for (size_t t = s + 1; t < k; t++)
+		{
+			bool
+				blnMeet;
+
+			if (t == s + 1 || (closed && s == 0 && t == k - 1))
+			{
+				// Consecutive segments a - v - c only fold back over each other.
+				size_t
+					s1 = t == s + 1 ? s : t,
+					s2 = t == s + 1 ? t : s;
+				const Point2D
+					&a = at(s1),
+					&v = at(s1 + 1),
+					&c = at(s2 + 1);
+
+				blnMeet = orient2d(a, v, c) == 0 && (a.x - v.x) * (c.x - v.x) + (a.y - v.y) * (c.y - v.y) > 0;
+			}
+			else
+				blnMeet = segmentsIntersect(at(s), at(s + 1), at(t), at(t + 1));
+
+			if (blnMeet && (!isInput(s) || !isInput(t)))
+				return false;
+		}
+
+	return true;
+}
+
+int
+main()
+{
+	std::mt19937_64
+		rng(47);
+	std::normal_distribution<double>
+		step(0, 1);
+	SimplifyOptions
+		options;
+
+	options.avoidSelfIntersections = true;
+
+	// Random walks cross themselves everywhere; the repaired lines only keep the crossings of the input.
+	for (int intCase = 0; intCase < 40; intCase++)
+	{
+		std::vector<Point2D>
+			pnts(1500);
+		bool
+			blnClosed = intCase % 2 == 1;
+
+		for (size_t i = 1; i < pnts.size(); i++)
+			pnts[i] = pnts[i - 1] + Point2D(step(rng), step(rng));
+
+		options.method = intCase % 4 < 2 ? siDouglasPeucker : siVisvalingam;
+		options.tolerance = options.method == siDouglasPeucker ? 3 : 10;
+		options.parallel = intCase % 3 == 0;
+
+		std::vector<size_t>
+			kept;
+
+		simplifyPolyline(pnts.data(), pnts.size(), blnClosed, options, kept);
+		CIVIL_CHECK(kept.size() < pnts.size() && noNewIntersections(pnts, blnClosed, kept));
+	}
+
+	// A near-vertical zigzag of 400,000 points whose segments all share the same x range, which made a
+	// ---- sweep in x test every pair (minutes; now a fraction of a second). Every vertex is needed, so all
+	//      of them stay. Visvalingam, because Douglas-Peucker splits such a line one vertex at a time.
+	std::vector<Point2D>
+		pnts(400000);
+	std::vector<size_t>
+		kept;
+
+	for (size_t i = 0; i < pnts.size(); i++)
+		pnts[i] = Point2D(i % 2 ? 1 : 0, i * 0.5);
+
+	options.method = siVisvalingam;
+	options.tolerance = 0.1;
+
+	double
+		t0 = seconds();
+
+	simplifyPolyline(pnts.data(), pnts.size(), false, options, kept);
+	printf("zigzag: %zu points kept in %.3f s\n", kept.size(), seconds() - t0);
+	CIVIL_CHECK(kept.size() == pnts.size());
+
+	return testResult("TestSimplify");
+}
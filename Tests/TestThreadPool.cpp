@@ -0,0 +1,221 @@
+/***
+ * TestThreadPool.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// Coverage of parallelFor, nesting, exceptions out of a TaskGroup and the deterministic reduction, on the
+// shared pool and on private pools of 0 to 4 workers.
+
+static const unsigned int
+	MAX_WORKERS = 4;
+
+// Every index of [first, last) is visited once, whatever the grain.
+static bool
+coversOnce(ThreadPool &pool, size_t first, size_t last, size_t grain)
+{
+	std::vector<std::atomic<int>>
+		aHits(last);
+
+	parallelFor(first, last, grain, [&](size_t a, size_t b) {
+		for (size_t i = a; i < b; i++)
+			aHits[i].fetch_add(1, std::memory_order_relaxed);
+	}, pool);
+
+	for (size_t i = 0; i < last; i++)
+		if (aHits[i].load() != (i < first ? 0 : 1))
+			return false;
+
+	return true;
+}
+
+static unsigned long long
+bitsOf(double value)
+{
+	unsigned long long
+		intBits;
+
+	memcpy(&intBits, &value, sizeof(intBits));
+
+	return intBits;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ MAX_WORKERS, false, false });
+
+	ThreadPool
+		&pool = sharedPool();
+
+	CIVIL_CHECK(pool.getWorkerCount() == MAX_WORKERS && pool.getConcurrency() == MAX_WORKERS + 1);
+
+	// Once the shared pool is running it can no longer be configured.
+	bool
+		blnRaised = false;
+
+	try
+	{
+		configureSharedPool(PoolOptions{ 2, false, false });
+	}
+	catch (const EThreadPool &)
+	{
+		blnRaised = true;
+	}
+	CIVIL_CHECK(blnRaised);
+
+	// Ranges below, at and well above the grain, with an offset start and odd lengths.
+	CIVIL_CHECK(coversOnce(pool, 0, 1, 1));
+	CIVIL_CHECK(coversOnce(pool, 0, 100, 100));
+	CIVIL_CHECK(coversOnce(pool, 13, 100003, 1));
+	CIVIL_CHECK(coversOnce(pool, 5, 1000001, 64));
+	CIVIL_CHECK(coversOnce(pool, 7, 7, 1));
+
+	// Nested parallelFor: every worker ends up waiting on inner groups while the outer ones are pending.
+	for (int intRun = 0; intRun < 20; intRun++)
+	{
+		std::atomic<size_t>
+			intCount{ 0 };
+
+		parallelFor(0, 64, 1, [&](size_t a, size_t b) {
+			for (size_t i = a; i < b; i++)
+				parallelFor(0, 1000, 1, [&](size_t c, size_t d) {
+					parallelFor(c, d, 1, [&](size_t e, size_t f) {
+						intCount.fetch_add(f - e, std::memory_order_relaxed);
+					}, pool);
+				}, pool);
+		}, pool);
+
+		CIVIL_CHECK(intCount.load() == 64 * 1000);
+	}
+
+	// An exception raised by one task reaches wait(), after the other tasks have run.
+	{
+		TaskGroup
+			group(pool);
+		std::atomic<int>
+			intDone{ 0 };
+		bool
+			blnCaught = false;
+
+		for (int i = 0; i < 100; i++)
+			group.run([&intDone, i]() {
+				if (i == 37)
+					throw std::runtime_error("task 37");
+				intDone++;
+			});
+
+		try
+		{
+			group.wait();
+		}
+		catch (const std::runtime_error &e)
+		{
+			blnCaught = strcmp(e.what(), "task 37") == 0;
+		}
+
+		CIVIL_CHECK(blnCaught && intDone.load() == 99);
+	}
+
+	// And from a nested group, through the piece of a parallelFor that waits on it.
+	blnRaised = false;
+	try
+	{
+		parallelFor(0, 1000, 1, [&](size_t a, size_t b) {
+			TaskGroup
+				group(pool);
+
+			for (size_t i = a; i < b; i++)
+				group.run([i]() {
+					if (i == 999)
+						throw std::runtime_error("nested");
+				});
+			group.wait();
+		}, pool);
+	}
+	catch (const std::runtime_error &)
+	{
+		blnRaised = true;
+	}
+	CIVIL_CHECK(blnRaised);
+
+	// A sum whose rounding depends on the order of the additions gives the same bits for any worker count
+	// in deterministic mode.
+	std::mt19937_64
+		rng(36);
+	std::uniform_real_distribution<double>
+		exponents(-20, 20);
+	std::vector<double>
+		aValues(300007);
+
+	for (double &dbl : aValues)
+		dbl = (rng() & 1 ? 1 : -1) * pow(10, exponents(rng));
+
+	auto
+		sum = [&](ThreadPool &p) {
+			return parallelReduce(0, aValues.size(), 1000, 0.0, [&](size_t a, size_t b) {
+				double
+					s = 0;
+
+				for (size_t i = a; i < b; i++)
+					s += aValues[i];
+
+				return s;
+			}, [](double a, double b) { return a + b; }, p);
+		};
+
+	pool.setDeterministic(true);
+
+	double
+		dblShared = sum(pool);
+
+	pool.setDeterministic(false);
+
+	for (unsigned int intWorkers = 0; intWorkers <= MAX_WORKERS; intWorkers++)
+	{
+		ThreadPool
+			local(PoolOptions{ intWorkers, false, true });
+
+		CIVIL_CHECK(local.getDeterministic() && local.getWorkerCount() == intWorkers);
+		CIVIL_CHECK(coversOnce(local, 3, 50001, 10));
+
+		for (int intRun = 0; intRun < 5; intRun++)
+			CIVIL_CHECK(bitsOf(sum(local)) == bitsOf(dblShared));
+	}
+
+	// An empty range gives the identity.
+	CIVIL_CHECK(parallelReduce(5, 5, 1, -1.0, [](size_t, size_t) { return 1.0; }, [](double a, double b) { return a + b; }, pool) == -1);
+
+	return testResult("TestThreadPool");
+}
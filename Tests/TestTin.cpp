@@ -0,0 +1,308 @@
+/***
+ * TestTin.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilTin.h"
+#include "..\MathLibrary\CivilPredicates.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// Structure of the meshes built by Tin: counterclockwise triangles, adjacency that points back, the Euler
+// count, empty circumcircles (against every vertex on small inputs, edge by edge on large ones) and the
+// breaklines present as constrained edges; on random, lattice, cocircular, collinear and repeated points.
+// Large random inputs are also built in strips on a pool of 4 workers and compared with the serial mesh.
+
+// Checks the mesh and returns the number of vertices in use.
+static size_t
+checkMesh(const Tin &tin, bool brute)
+{
+	size_t
+		intTriangles = tin.getTriangleCount(),
+		intHull = 0,
+		intUsed = 0;
+	std::vector<unsigned char>
+		aUsed(tin.vertices.size(), 0);
+
+	CIVIL_CHECK(tin.triangles.size() % 3 == 0 && tin.adjacency.size() == tin.triangles.size() && tin.constrained.size() == tin.triangles.size());
+
+	for (unsigned int e = 0; e < tin.triangles.size(); e++)
+	{
+		unsigned int
+			a = tin.triangles[e],
+			b = tin.triangles[Tin::nextEdge(e)],
+			opp = tin.adjacency[e];
+
+		aUsed[a] = 1;
+
+		if (e % 3 == 0)
+			CIVIL_CHECK(orient2d(tin.getVertex(a), tin.getVertex(b), tin.getVertex(tin.triangles[e + 2])) > 0);
+
+		if (opp == Tin::NONE)
+		{
+			intHull++;
+			continue;
+		}
+
+		// The opposite half-edge runs the other way and points back.
+		CIVIL_CHECK(tin.adjacency[opp] == e && tin.triangles[opp] == b && tin.triangles[Tin::nextEdge(opp)] == a);
+		CIVIL_CHECK(tin.constrained[opp] == tin.constrained[e]);
+
+		// Locally Delaunay across every edge that is not a breakline.
+		if (!tin.isConstrained(e))
+			CIVIL_CHECK(incircle(tin.getVertex(a), tin.getVertex(b), tin.getVertex(tin.triangles[Tin::prevEdge(e)]),
+				tin.getVertex(tin.triangles[Tin::prevEdge(opp)])) <= 0);
+	}
+
+	for (unsigned char blnUsed : aUsed)
+		intUsed += blnUsed;
+
+	// Euler: a triangulation of v vertices with h edges on the hull has 2 v - 2 - h triangles.
+	if (intTriangles > 0)
+		CIVIL_CHECK(intTriangles == 2 * intUsed - 2 - intHull);
+
+	// A vertex left out coincides with one of smaller index that is in use.
+	for (unsigned int v = 0; v < aUsed.size(); v++)
+		if (!aUsed[v] && intTriangles > 0)
+		{
+			bool
+				blnTwin = false;
+
+			for (unsigned int w = 0; w < v && !blnTwin; w++)
+				blnTwin = aUsed[w] && tin.getVertex(w).x == tin.getVertex(v).x && tin.getVertex(w).y == tin.getVertex(v).y;
+
+			CIVIL_CHECK(blnTwin);
+		}
+
+	if (brute)
+		for (size_t t = 0; t < intTriangles; t++)
+		{
+			Point2D
+				a = tin.getVertex(tin.triangles[3 * t]),
+				b = tin.getVertex(tin.triangles[3 * t + 1]),
+				c = tin.getVertex(tin.triangles[3 * t + 2]);
+
+			for (unsigned int v = 0; v < aUsed.size(); v++)
+				if (aUsed[v] && incircle(a, b, c, tin.getVertex(v)) > 0)
+				{
+					CIVIL_CHECK(false);
+					break;
+				}
+		}
+
+	return intUsed;
+}
+
+// The triangles as sorted triples, each one starting at its smallest vertex, for comparing meshes.
+static std::vector<std::array<unsigned int, 3>>
+canonical(const Tin &tin)
+{
+	std::vector<std::array<unsigned int, 3>>
+		aTris(tin.getTriangleCount());
+
+	for (size_t t = 0; t < aTris.size(); t++)
+	{
+		const unsigned int
+			*v = &tin.triangles[3 * t];
+		int
+			k = v[0] < v[1] ? (v[0] < v[2] ? 0 : 2) : (v[1] < v[2] ? 1 : 2);
+
+		aTris[t] = { v[k], v[(k + 1) % 3], v[(k + 2) % 3] };
+	}
+
+	std::sort(aTris.begin(), aTris.end());
+
+	return aTris;
+}
+
+// True when vertices a and b are joined by a constrained edge.
+static bool
+hasConstrainedEdge(const Tin &tin, unsigned int a, unsigned int b)
+{
+	for (unsigned int e = 0; e < tin.triangles.size(); e++)
+		if (tin.triangles[e] == a && tin.triangles[Tin::nextEdge(e)] == b)
+			return tin.isConstrained(e);
+
+	return false;
+}
+
+static PointBuffer
+randomPoints(std::mt19937_64 &rng, size_t count, double x0, double y0, double size)
+{
+	std::uniform_real_distribution<double>
+		coord(0, size);
+	PointBuffer
+		pnts;
+
+	pnts.reserve(count);
+	for (size_t i = 0; i < count; i++)
+		pnts.add(Point2D(x0 + coord(rng), y0 + coord(rng)));
+
+	return pnts;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	std::mt19937_64
+		rng(39);
+	Tin
+		tin;
+
+	// Random points at survey coordinates, some of them repeated.
+	PointBuffer
+		pnts = randomPoints(rng, 2000, 500000, 7500000, 1000);
+
+	for (size_t i = 0; i < 50; i++)
+		pnts.add(pnts.getItem(i * 7));
+
+	tin.build(pnts);
+	CIVIL_CHECK(checkMesh(tin, true) == 2000);
+
+	// A lattice: every square is cocircular, so only the empty circumcircle (not the choice of diagonal) is
+	// checked.
+	PointBuffer
+		lattice;
+
+	for (int i = 0; i < 40; i++)
+		for (int j = 0; j < 30; j++)
+			lattice.add(Point2D(1000 + 2.5 * i, 2000 + 2.5 * j));
+
+	tin.build(lattice);
+	CIVIL_CHECK(checkMesh(tin, true) == 1200 && tin.getTriangleCount() == 2 * 39 * 29);
+
+	// Breaklines along a lattice row pass over its vertices, so they are split at each one.
+	tin.addConstraints({ 5 * 30 + 10, 30 * 30 + 10, 3 * 30 + 2, 3 * 30 + 25 });
+	checkMesh(tin, false);
+	for (int i = 5; i < 30; i++)
+		CIVIL_CHECK(hasConstrainedEdge(tin, i * 30 + 10, (i + 1) * 30 + 10) || hasConstrainedEdge(tin, (i + 1) * 30 + 10, i * 30 + 10));
+	for (int j = 2; j < 25; j++)
+		CIVIL_CHECK(hasConstrainedEdge(tin, 3 * 30 + j, 3 * 30 + j + 1) || hasConstrainedEdge(tin, 3 * 30 + j + 1, 3 * 30 + j));
+
+	// The lattice points of the circle x^2 + y^2 = 5525, all cocircular, with the center.
+	PointBuffer
+		circle;
+
+	for (int x = -75; x <= 75; x++)
+		for (int y = -75; y <= 75; y++)
+			if (x * x + y * y == 5525)
+				circle.add(Point2D(x, y));
+
+	size_t
+		intOnCircle = circle.size();
+
+	tin.build(circle);
+	CIVIL_CHECK(intOnCircle > 8 && checkMesh(tin, true) == intOnCircle && tin.getTriangleCount() == intOnCircle - 2);
+
+	circle.add(Point2D(0, 0));
+	tin.build(circle);
+	CIVIL_CHECK(checkMesh(tin, true) == intOnCircle + 1 && tin.getTriangleCount() == intOnCircle);
+
+	// Collinear points give no triangles; one point off the line fans them all.
+	PointBuffer
+		line;
+
+	for (int i = 0; i < 100; i++)
+		line.add(Point2D(300000 + 3.0 * i, 200000 + 4.0 * i));
+
+	tin.build(line);
+	CIVIL_CHECK(tin.getTriangleCount() == 0);
+
+	line.add(Point2D(300000, 200010));
+	tin.build(line);
+	CIVIL_CHECK(checkMesh(tin, true) == 101 && tin.getTriangleCount() == 99);
+
+	// Random breaklines between random points: each one is an edge of the mesh, or a chain of edges when
+	// it passes over a vertex, which random points do not.
+	pnts = randomPoints(rng, 5000, 0, 0, 100);
+	tin.build(pnts);
+
+	std::vector<unsigned int>
+		aSegments;
+
+	for (unsigned int i = 0; i < 20; i++)
+	{
+		// Short segments that do not cross each other: one per row of a 20 x 1 grid of bands.
+		unsigned int
+			a = Tin::NONE,
+			b = Tin::NONE;
+
+		for (unsigned int v = 0; v < pnts.size() && b == Tin::NONE; v++)
+		{
+			Point2D
+				pnt = pnts.getItem(v);
+
+			if (pnt.y < 5 * i + 1 || pnt.y > 5 * i + 4)
+				continue;
+			if (a == Tin::NONE && pnt.x < 30)
+				a = v;
+			else if (a != Tin::NONE && pnt.x > 70)
+				b = v;
+		}
+
+		aSegments.push_back(a);
+		aSegments.push_back(b);
+	}
+
+	tin.addConstraints(aSegments);
+	checkMesh(tin, false);
+	for (size_t i = 0; i < aSegments.size(); i += 2)
+		CIVIL_CHECK(hasConstrainedEdge(tin, aSegments[i], aSegments[i + 1]) || hasConstrainedEdge(tin, aSegments[i + 1], aSegments[i]));
+
+	// Enough points for 4 strips on the pool: in general position the Delaunay triangulation is unique, so
+	// the strips and the serial build give the same triangles.
+	PointBuffer
+		large = randomPoints(rng, 1100000, 600000, 7400000, 5000);
+	Tin
+		serial;
+
+	serial.build(large, false);
+	tin.build(large, true);
+
+	CIVIL_CHECK(checkMesh(serial, false) == large.size() && checkMesh(tin, false) == large.size());
+	CIVIL_CHECK(canonical(serial) == canonical(tin));
+
+	// A large lattice in strips is still a valid Delaunay triangulation, whatever diagonals it picks.
+	PointBuffer
+		grid;
+
+	for (int i = 0; i < 1000; i++)
+		for (int j = 0; j < 600; j++)
+			grid.add(Point2D(i, j));
+
+	tin.build(grid, true);
+	CIVIL_CHECK(checkMesh(tin, false) == grid.size() && tin.getTriangleCount() == 2 * 999 * 599);
+
+	return testResult("TestTin");
+}
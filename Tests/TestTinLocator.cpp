@@ -0,0 +1,285 @@
+/***
+ * TestTinLocator.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilTinLocator.h"
+#include "..\MathLibrary\CivilPredicates.h"
+#include "..\UtilsLibrary\CivilThreadPool.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::UTILS;
+using namespace CIVIL::TESTS;
+
+// TinLocator against a scan of every triangle: the triangle found contains the point, points outside the
+// hull give none, points on edges and vertices give one of the triangles around them, the interpolation
+// matches the plane through the triangle and the batch queries agree with the single ones.
+
+// Whether the triangle contains (x, y), boundary included.
+static bool
+contains(const Tin &tin, unsigned int t, double x, double y)
+{
+	Point2D
+		pnt(x, y);
+
+	for (int k = 0; k < 3; k++)
+		if (orient2d(tin.getVertex(tin.triangles[3 * t + k]), tin.getVertex(tin.triangles[3 * t + (k + 1) % 3]), pnt) < 0)
+			return false;
+
+	return true;
+}
+
+static unsigned int
+bruteLocate(const Tin &tin, double x, double y)
+{
+	for (unsigned int t = 0; t < tin.getTriangleCount(); t++)
+		if (contains(tin, t, x, y))
+			return t;
+
+	return Tin::NONE;
+}
+
+// Elevation of the plane through the triangle, solved on its own.
+static double
+planeZ(const Tin &tin, unsigned int t, double x, double y)
+{
+	unsigned int
+		a = tin.triangles[3 * t],
+		b = tin.triangles[3 * t + 1],
+		c = tin.triangles[3 * t + 2];
+	Point2D
+		pa = tin.getVertex(a),
+		pb = tin.getVertex(b),
+		pc = tin.getVertex(c);
+	double
+		dblDet = (pb.x - pa.x) * (pc.y - pa.y) - (pc.x - pa.x) * (pb.y - pa.y),
+		u = ((x - pa.x) * (pc.y - pa.y) - (pc.x - pa.x) * (y - pa.y)) / dblDet,
+		v = ((pb.x - pa.x) * (y - pa.y) - (x - pa.x) * (pb.y - pa.y)) / dblDet;
+
+	return tin.elevations[a] + u * (tin.elevations[b] - tin.elevations[a]) + v * (tin.elevations[c] - tin.elevations[a]);
+}
+
+// Checks one query of the locator against the scan, and returns the triangle found.
+static unsigned int
+checkQuery(const TinLocator &loc, const Tin &tin, double x, double y)
+{
+	unsigned int
+		t = loc.locate(x, y),
+		intBrute = bruteLocate(tin, x, y);
+	double
+		z;
+
+	CIVIL_CHECK((t == Tin::NONE) == (intBrute == Tin::NONE));
+	CIVIL_CHECK(loc.interpolate(x, y, z) == (t != Tin::NONE));
+
+	if (t == Tin::NONE)
+		return t;
+
+	double
+		w0,
+		w1,
+		w2;
+
+	loc.barycentric(t, x, y, w0, w1, w2);
+	CIVIL_CHECK(contains(tin, t, x, y));
+	CIVIL_CHECK(abs(w0 + w1 + w2 - 1) <= 1e-12 && w0 >= -1e-12 && w1 >= -1e-12 && w2 >= -1e-12);
+	CIVIL_CHECK(abs(z - planeZ(tin, intBrute, x, y)) <= 1e-6);
+
+	return t;
+}
+
+int
+main()
+{
+	configureSharedPool(PoolOptions{ 4, false, false });
+
+	std::mt19937_64
+		rng(40);
+	std::uniform_real_distribution<double>
+		coord(0, 1000),
+		wide(-200, 1200),
+		height(100, 140);
+
+	// Random points at survey coordinates on a rough surface.
+	const double
+		EAST = 450000,
+		NORTH = 7350000;
+	PointBuffer
+		pnts;
+	std::vector<double>
+		aZ;
+
+	for (int i = 0; i < 3000; i++)
+	{
+		pnts.add(Point2D(EAST + coord(rng), NORTH + coord(rng)));
+		aZ.push_back(height(rng));
+	}
+
+	Tin
+		tin;
+
+	tin.build(pnts, aZ);
+
+	TinLocator
+		loc(tin);
+	PointBuffer
+		queries;
+	int
+		intOutside = 0;
+
+	// Inside, outside the hull and on both sides of it.
+	for (int i = 0; i < 3000; i++)
+	{
+		double
+			x = EAST + wide(rng),
+			y = NORTH + wide(rng);
+
+		queries.add(Point2D(x, y));
+		intOutside += checkQuery(loc, tin, x, y) == Tin::NONE;
+	}
+	CIVIL_CHECK(intOutside > 1000);
+
+	// Vertices give a triangle with that vertex, and their elevation exactly.
+	for (unsigned int v = 0; v < 3000; v += 7)
+	{
+		Point2D
+			pnt = tin.getVertex(v);
+		unsigned int
+			t = checkQuery(loc, tin, pnt.x, pnt.y);
+		double
+			z;
+
+		CIVIL_CHECK(t != Tin::NONE && (tin.triangles[3 * t] == v || tin.triangles[3 * t + 1] == v || tin.triangles[3 * t + 2] == v));
+		CIVIL_CHECK(loc.interpolate(pnt.x, pnt.y, z) && abs(z - aZ[v]) <= 1e-9);
+		queries.add(pnt);
+	}
+
+	// The batch forms give the same answers as the single queries, in random order and with the queries
+	// that follow the mesh.
+	std::vector<unsigned int>
+		aTris;
+	std::vector<double>
+		aHeights;
+
+	for (int intPass = 0; intPass < 2; intPass++)
+	{
+		loc.locateBatch(queries, aTris);
+		loc.interpolateBatch(queries, aHeights);
+		CIVIL_CHECK(aTris.size() == queries.size() && aHeights.size() == queries.size());
+
+		for (size_t i = 0; i < queries.size(); i++)
+		{
+			Point2D
+				pnt = queries.getItem(i);
+			double
+				z;
+
+			if (!loc.interpolate(pnt.x, pnt.y, z))
+				CIVIL_CHECK(aTris[i] == Tin::NONE && isnan(aHeights[i]));
+			else
+				CIVIL_CHECK(aTris[i] != Tin::NONE && contains(tin, aTris[i], pnt.x, pnt.y) && abs(aHeights[i] - z) <= 1e-9);
+		}
+
+		// Queries along the triangles, centroid after centroid.
+		queries.clear();
+		for (unsigned int t = 0; t < tin.getTriangleCount(); t++)
+		{
+			Point2D
+				a = tin.getVertex(tin.triangles[3 * t]),
+				b = tin.getVertex(tin.triangles[3 * t + 1]),
+				c = tin.getVertex(tin.triangles[3 * t + 2]);
+
+			queries.add(Point2D((a.x + b.x + c.x) / 3, (a.y + b.y + c.y) / 3));
+		}
+	}
+
+	// A lattice, where the midpoints of the edges and of the diagonals are exact and every point of the
+	// hull lies on an edge.
+	PointBuffer
+		lattice;
+
+	aZ.clear();
+	for (int i = 0; i <= 20; i++)
+		for (int j = 0; j <= 20; j++)
+		{
+			lattice.add(Point2D(i, j));
+			aZ.push_back(3 + 0.5 * i - 0.25 * j);
+		}
+
+	tin.build(lattice, aZ);
+
+	TinLocator
+		grid(tin, 0.5);
+
+	for (int i = 0; i <= 40; i++)
+		for (int j = 0; j <= 40; j++)
+		{
+			double
+				x = i / 2.0,
+				y = j / 2.0,
+				z;
+
+			// Every point of the square is in the TIN, and the surface is the plane.
+			CIVIL_CHECK(checkQuery(grid, tin, x, y) != Tin::NONE);
+			CIVIL_CHECK(grid.interpolate(x, y, z) && abs(z - (3 + 0.5 * x - 0.25 * y)) <= 1e-12);
+		}
+
+	// Just outside each side.
+	for (double dbl : { 0.0, 7.5, 20.0 })
+	{
+		CIVIL_CHECK(grid.locate(dbl, -1e-9) == Tin::NONE && grid.locate(-1e-9, dbl) == Tin::NONE);
+		CIVIL_CHECK(grid.locate(dbl, 20 + 1e-9) == Tin::NONE && grid.locate(20 + 1e-9, dbl) == Tin::NONE);
+	}
+
+	// Starting the walk from triangle 0 as the hint.
+	CIVIL_CHECK(contains(tin, grid.locate(19.3, 18.1, 0), 19.3, 18.1));
+
+	// Interpolating without elevations raises ETin.
+	Tin
+		flat;
+	bool
+		blnRaised = false;
+
+	flat.build(lattice);
+
+	TinLocator
+		noZ(flat);
+	double
+		z;
+
+	try
+	{
+		noZ.interpolate(5, 5, z);
+	}
+	catch (const ETin &)
+	{
+		blnRaised = true;
+	}
+	CIVIL_CHECK(blnRaised && noZ.locate(5, 5) != Tin::NONE);
+
+	return testResult("TestTinLocator");
+}
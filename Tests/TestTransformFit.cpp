@@ -0,0 +1,260 @@
+/***
+ * TestTransformFit.cpp;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "..\MathLibrary\CivilTransformFit.h"
+#include "CivilTest.h"
+
+using namespace CIVIL::MATH::GA2D;
+using namespace CIVIL::TESTS;
+
+// fitTransform recovers known similarity, affine and projective transforms from exact control points, with
+// null residuals; noise shows in sigma0; zero weights leave points out; and the robust losses push a gross
+// outlier out of the fit.
+
+static const double
+	EAST = 334455.5,
+	NORTH = 7654321.25;
+
+// Local control points, in a 1 km square, not on a lattice.
+static std::vector<Point2D>
+controlPoints(std::mt19937_64 &rng, size_t count)
+{
+	std::uniform_real_distribution<double>
+		coord(0, 1000);
+	std::vector<Point2D>
+		aPnts;
+
+	for (size_t i = 0; i < count; i++)
+		aPnts.push_back(Point2D(coord(rng), coord(rng)));
+
+	return aPnts;
+}
+
+static std::vector<Point2D>
+apply(const Matrix2D &mat, const std::vector<Point2D> &pnts, bool projective)
+{
+	std::vector<Point2D>
+		aRes;
+
+	for (const Point2D &pnt : pnts)
+		aRes.push_back(projective ? projectiveTransform(mat, pnt) : pnt.transform(mat));
+
+	return aRes;
+}
+
+// The matrices agree entry by entry, with "tol" on the linear part and tol times the coordinates on the
+// translation; projective matrices are compared scaled to items[2][2] = 1.
+static bool
+sameMatrix(const Matrix2D &a, const Matrix2D &b, double tol)
+{
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+		{
+			double
+				x = a.items[i][j] / a.items[2][2],
+				y = b.items[i][j] / b.items[2][2];
+
+			if (abs(x - y) > (j == 2 && i < 2 ? tol * 1e7 : tol))
+				return false;
+		}
+
+	return true;
+}
+
+static double
+maxResidual(const TransformFit &fit)
+{
+	double
+		dblMax = 0;
+
+	for (const Point2D &res : fit.residuals)
+		dblMax = std::max(dblMax, sqrt(res.x * res.x + res.y * res.y));
+
+	return dblMax;
+}
+
+int
+main()
+{
+	std::mt19937_64
+		rng(45);
+	std::vector<Point2D>
+		aSource = controlPoints(rng, 12);
+	TransformFitOptions
+		options;
+
+	// Helmert: scale 1.0004, 37 degrees, to survey coordinates.
+	const double
+		SCALE = 1.0004,
+		ANG = 37 * M_PI / 180;
+	Matrix2D
+		matSimilarity = Matrix2D::translation(EAST, NORTH) * Matrix2D::rotation(SCALE * sin(ANG), SCALE * cos(ANG));
+
+	options.model = tmSimilarity;
+
+	TransformFit
+		fit = fitTransform(aSource, apply(matSimilarity, aSource, false), options);
+
+	CIVIL_CHECK(sameMatrix(fit.matrix, matSimilarity, 1e-12));
+	CIVIL_CHECK(fit.residuals.size() == aSource.size() && maxResidual(fit) < 1e-6 && fit.rms < 1e-6 && fit.sigma0 < 1e-6);
+
+	// Two points fix a similarity exactly, with no redundancy.
+	fit = fitTransform({ aSource[0], aSource[1] }, apply(matSimilarity, { aSource[0], aSource[1] }, false), options);
+	CIVIL_CHECK(sameMatrix(fit.matrix, matSimilarity, 1e-11) && fit.sigma0 == 0);
+
+	// Affine: different scales and shear.
+	Matrix2D
+		matAffine = Matrix2D::M_IDENTITY;
+
+	matAffine.items[0][0] = 0.998;
+	matAffine.items[0][1] = -0.061;
+	matAffine.items[0][2] = EAST;
+	matAffine.items[1][0] = 0.052;
+	matAffine.items[1][1] = 1.003;
+	matAffine.items[1][2] = NORTH;
+
+	options.model = tmAffine;
+	fit = fitTransform(aSource, apply(matAffine, aSource, false), options);
+	CIVIL_CHECK(sameMatrix(fit.matrix, matAffine, 1e-12) && maxResidual(fit) < 1e-6);
+	CIVIL_CHECK(fit.matrix.items[2][0] == 0 && fit.matrix.items[2][1] == 0 && fit.matrix.items[2][2] == 1);
+
+	// Projective: a photo of the square, rectified.
+	Matrix2D
+		matProjective = matAffine;
+
+	matProjective.items[2][0] = 2e-5;
+	matProjective.items[2][1] = -3e-5;
+
+	options.model = tmProjective;
+	fit = fitTransform(aSource, apply(matProjective, aSource, true), options);
+	CIVIL_CHECK(sameMatrix(fit.matrix, matProjective, 1e-10) && maxResidual(fit) < 1e-6);
+
+	// Residuals are target - transform(source) and sigma0 follows the noise: 1 cm on each coordinate.
+	std::normal_distribution<double>
+		noise(0, 0.01);
+	std::vector<Point2D>
+		aMany = controlPoints(rng, 400),
+		aTarget = apply(matAffine, aMany, false);
+
+	for (Point2D &pnt : aTarget)
+		pnt = Point2D(pnt.x + noise(rng), pnt.y + noise(rng));
+
+	options.model = tmAffine;
+	fit = fitTransform(aMany, aTarget, options);
+
+	Point2D
+		pntFit = aMany[7].transform(fit.matrix);
+
+	CIVIL_CHECK(abs(fit.residuals[7].x - (aTarget[7].x - pntFit.x)) < 1e-9 && abs(fit.residuals[7].y - (aTarget[7].y - pntFit.y)) < 1e-9);
+	CIVIL_CHECK(fit.sigma0 > 0.009 && fit.sigma0 < 0.011 && sameMatrix(fit.matrix, matAffine, 1e-5));
+
+	// A point of weight 0 is left out, but gets its residual.
+	aTarget = apply(matAffine, aSource, false);
+	aTarget[3].x += 5;
+	options.weights.assign(aSource.size(), 1);
+	options.weights[3] = 0;
+	fit = fitTransform(aSource, aTarget, options);
+	CIVIL_CHECK(sameMatrix(fit.matrix, matAffine, 1e-12) && abs(fit.residuals[3].x - 5) < 1e-6);
+	options.weights.clear();
+
+	// A gross outlier of 5 m among 40 points with 1 cm noise: plain least squares spreads it over the
+	// others, the robust losses leave it out.
+	std::vector<Point2D>
+		aRobust = controlPoints(rng, 40);
+
+	aTarget = apply(matAffine, aRobust, false);
+	for (Point2D &pnt : aTarget)
+		pnt = Point2D(pnt.x + noise(rng), pnt.y + noise(rng));
+	aTarget[11] = Point2D(aTarget[11].x + 3, aTarget[11].y - 4);
+
+	TransformFit
+		plain = fitTransform(aRobust, aTarget, options);
+
+	for (RobustLossEnum loss : { rlHuber, rlTukey })
+	{
+		options.robust = loss;
+		fit = fitTransform(aRobust, aTarget, options);
+
+		double
+			dblOthers = 0;
+
+		for (size_t i = 0; i < aRobust.size(); i++)
+			if (i != 11)
+			{
+				Point2D
+					pntTrue = aRobust[i].transform(matAffine),
+					pntRobust = aRobust[i].transform(fit.matrix);
+
+				dblOthers = std::max(dblOthers, pntTrue.dist(pntRobust));
+			}
+
+		CIVIL_CHECK(fit.iterations > 1 && fit.weights.size() == aRobust.size());
+		CIVIL_CHECK(abs(sqrt(fit.residuals[11].x * fit.residuals[11].x + fit.residuals[11].y * fit.residuals[11].y) - 5) < 0.05);
+		CIVIL_CHECK(dblOthers < 0.02 && fit.sigma0 < plain.sigma0 / 5);
+		CIVIL_CHECK(fit.weights[11] < 0.05 * fit.weights[0] && (loss != rlTukey || fit.weights[11] == 0));
+	}
+
+	CIVIL_CHECK(plain.sigma0 > 0.3);
+
+	// Sizes, weights and configurations that do not fix the transform raise ETransformFit.
+	std::vector<Point2D>
+		aLine{ Point2D(0, 0), Point2D(1, 1), Point2D(2, 2), Point2D(5, 5) };
+	int
+		intRaised = 0;
+
+	options = TransformFitOptions();
+	for (int intCase = 0; intCase < 4; intCase++)
+		try
+		{
+			switch (intCase)
+			{
+			case 0:
+				fitTransform(aSource, aRobust, options);
+				break;
+			case 1:
+				options.model = tmProjective;
+				fitTransform({ aSource[0], aSource[1], aSource[2] }, { aSource[0], aSource[1], aSource[2] }, options);
+				break;
+			case 2:
+				options.model = tmAffine;
+				options.weights.assign(aSource.size(), -1);
+				fitTransform(aSource, aSource, options);
+				break;
+			default:
+				options.weights.clear();
+				fitTransform(aLine, aLine, options);
+			}
+		}
+		catch (const ETransformFit &)
+		{
+			intRaised++;
+		}
+	CIVIL_CHECK(intRaised == 4);
+
+	return testResult("TestTransformFit");
+}
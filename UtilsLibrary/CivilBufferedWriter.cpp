@@ -0,0 +1,103 @@
+#include "CivilBufferedWriter.h"
+
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif // ifdef _WIN32
+
+namespace CIVIL::UTILS
+{
+
+/*
+ * BufferedWriter.
+ */
+
+BufferedWriter::BufferedWriter(int fd, size_t capacity) :
+	m_intFile(fd),
+	m_aBuffer(capacity > 0 ? capacity : DEFAULT_CAPACITY)
+{}
+
+BufferedWriter::~BufferedWriter()
+{
+	try
+	{
+		flush();
+	}
+	catch (const Error &)
+	{
+		// A destructor must not throw; callers who need to know call flush() themselves.
+	}
+}
+
+char *
+BufferedWriter::reserve(size_t size)
+{
+	if (m_aBuffer.size() - m_intUsed < size)
+	{
+		flush();
+
+		if (m_aBuffer.size() < size)
+			m_aBuffer.resize(size);
+	}
+
+	return m_aBuffer.data() + m_intUsed;
+}
+
+void
+BufferedWriter::write(const char *data, size_t size)
+{
+	if (m_aBuffer.size() - m_intUsed < size)
+	{
+		flush();
+
+		// Blocks at least as big as the buffer go straight to the file.
+		if (size >= m_aBuffer.size())
+		{
+			writeAll(data, size);
+			return;
+		}
+	}
+
+	memcpy(m_aBuffer.data() + m_intUsed, data, size);
+	m_intUsed += size;
+}
+
+void
+BufferedWriter::flush()
+{
+	writeAll(m_aBuffer.data(), m_intUsed);
+	m_intUsed = 0;
+}
+
+void
+BufferedWriter::writeAll(const char *data, size_t size)
+{
+	while (size > 0)
+	{
+#ifdef _WIN32
+		int
+			intRes = _write(m_intFile, data, (unsigned int) (size > INT_MAX ? INT_MAX : size));
+#else
+		ssize_t
+			intRes = ::write(m_intFile, data, size);
+#endif // ifdef _WIN32
+
+		if (intRes < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			RAISE(EBufferedWriter, bweWriteError);
+		}
+
+		data += intRes;
+		size -= (size_t) intRes;
+	}
+}
+
+} // namespace CIVIL::UTILS
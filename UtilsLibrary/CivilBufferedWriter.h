@@ -0,0 +1,102 @@
+/***
+ * CivilBufferedWriter.h
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 - 2018 Eng. Anderson Marques Ribeiro.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_BUFFERED_WRITER
+#define __CIVIL_BUFFERED_WRITER
+
+#include <vector>
+
+#include "CivilError.h"
+
+namespace CIVIL::UTILS
+{
+
+	DECLARE_ERROR_CODE(bweWriteError);
+
+	BEGIN_DECLARE_ERROR(EBufferedWriter)
+		DECLARE_ERROR(bweWriteError, "Error writing to the file")
+	END_DECLARE_ERROR;
+
+	// BufferedWriter;
+	//
+	// Collects text in a large memory block and hands it to the operating system in few, big writes. The
+	// ---- writer does not own the file descriptor; it only flushes on destruction.
+	//
+	//      Callers that format in place ask for room with reserve(), write at most that many bytes at the
+	//      returned position and then call commit() with the end of what they wrote.
+	struct BufferedWriter
+	{
+	public:
+
+		static const size_t
+			DEFAULT_CAPACITY = 1 << 20;
+
+		BufferedWriter(int fd, size_t capacity = DEFAULT_CAPACITY);
+		BufferedWriter(const BufferedWriter &) = delete;
+		~BufferedWriter();
+
+		BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+	private:
+
+		int
+			m_intFile;
+		std::vector<char>
+			m_aBuffer;
+		size_t
+			m_intUsed = 0;
+
+		void writeAll(const char *data, size_t size);
+
+	public:
+
+		char *reserve(size_t size);
+		void commit(char *end)
+		{
+			m_intUsed = end - m_aBuffer.data();
+		}
+
+		void write(const char *data, size_t size);
+		void put(char c)
+		{
+			if (m_intUsed == m_aBuffer.size())
+				flush();
+
+			m_aBuffer[m_intUsed++] = c;
+		}
+
+		// flush;
+		//
+		// Writes everything buffered so far. Raises EBufferedWriter when the system refuses the data.
+		// ----
+		void flush();
+
+	}; /* BufferedWriter */
+
+} // namespace CIVIL::UTILS
+
+#endif // ifndef __CIVIL_BUFFERED_WRITER
@@ -0,0 +1,181 @@
+#include "CivilDispatch.h"
+
+#if CIVIL_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif // ifdef _MSC_VER
+#endif // if CIVIL_X86
+
+namespace CIVIL::UTILS
+{
+
+/*
+ * Detection.
+ */
+
+#if CIVIL_X86
+
+static void
+cpuid(int leaf, int subleaf, unsigned int regs[4])
+{
+#ifdef _MSC_VER
+	__cpuidex((int *) regs, leaf, subleaf);
+#else
+	__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif // ifdef _MSC_VER
+}
+
+// Register state the operating system saves on context switches (XCR0).
+static unsigned long long
+xgetbv()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned int
+		eax,
+		edx;
+
+	__asm__ volatile ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+
+	return ((unsigned long long) edx << 32) | eax;
+#endif // ifdef _MSC_VER
+}
+
+#endif // if CIVIL_X86
+
+static CpuFeatures
+detectFeatures()
+{
+	CpuFeatures
+		res;
+
+#if CIVIL_X86
+	unsigned int
+		regs[4];
+
+	cpuid(0, 0, regs);
+
+	unsigned int
+		intMaxLeaf = regs[0];
+
+	if (intMaxLeaf < 1)
+		return res;
+
+	cpuid(1, 0, regs);
+
+	bool
+		blnOSXSave = (regs[2] >> 27) & 1;
+	unsigned long long
+		intXCR0 = blnOSXSave ? xgetbv() : 0;
+	bool
+		blnYmm = (intXCR0 & 0x06) == 0x06,
+		blnZmm = (intXCR0 & 0xE6) == 0xE6;
+
+	res.sse2 = (regs[3] >> 26) & 1;
+	res.avx = blnYmm && ((regs[2] >> 28) & 1);
+	res.fma = res.avx && ((regs[2] >> 12) & 1);
+
+	if (intMaxLeaf >= 7)
+	{
+		cpuid(7, 0, regs);
+
+		res.avx2 = res.avx && ((regs[1] >> 5) & 1);
+		res.avx512f = blnZmm && res.avx2 && ((regs[1] >> 16) & 1);
+	}
+#endif // if CIVIL_X86
+
+	return res;
+}
+
+const CpuFeatures &
+cpuFeatures()
+{
+	static const CpuFeatures
+		features = detectFeatures();
+
+	return features;
+}
+
+IsaLevelEnum
+detectedIsaLevel()
+{
+	const CpuFeatures
+		&features = cpuFeatures();
+
+	if (features.avx512f && features.fma)
+		return ilAVX512;
+
+	if (features.avx2 && features.fma)
+		return ilAVX2;
+
+	if (features.sse2)
+		return ilSSE2;
+
+	return ilScalar;
+}
+
+/*
+ * Level.
+ */
+
+// The forced level plus 1 (0 while not forced) in the low ISA_LEVEL_BITS bits and a count of the changes
+// above them. One word, so that a reader never pairs a generation with the level of another one. The count
+// starts at 1 so that a dispatcher that never bound (binding 0) always binds on its first call.
+static const unsigned int
+	ISA_LEVEL_BITS = 3,
+	ISA_LEVEL_MASK = (1 << ISA_LEVEL_BITS) - 1;
+
+static std::atomic<unsigned int>
+	g_intIsaState{ 1 << ISA_LEVEL_BITS };
+
+static void
+setForcedLevel(int level)
+{
+	unsigned int
+		intState = g_intIsaState.load(std::memory_order_relaxed);
+
+	while (!g_intIsaState.compare_exchange_weak(intState,
+		(((intState >> ISA_LEVEL_BITS) + 1) << ISA_LEVEL_BITS) | (unsigned int) (level + 1), std::memory_order_relaxed))
+		;
+}
+
+IsaLevelEnum
+getIsaLevel()
+{
+	return getIsaLevel(isaGeneration());
+}
+
+IsaLevelEnum
+getIsaLevel(unsigned int generation)
+{
+	unsigned int
+		intForced = generation & ISA_LEVEL_MASK;
+
+	return intForced == 0 ? detectedIsaLevel() : (IsaLevelEnum) (intForced - 1);
+}
+
+void
+forceIsaLevel(IsaLevelEnum level)
+{
+	if (level < ilScalar || level >= ilCount || level > detectedIsaLevel())
+		RAISE(EDispatch, deLevelNotSupported);
+
+	setForcedLevel(level);
+}
+
+void
+resetIsaLevel()
+{
+	setForcedLevel(-1);
+}
+
+unsigned int
+isaGeneration()
+{
+	return g_intIsaState.load(std::memory_order_relaxed);
+}
+
+} // namespace CIVIL::UTILS
@@ -0,0 +1,202 @@
+/***
+ * CivilDispatch.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_DISPATCH
+#define __CIVIL_DISPATCH
+
+#include <atomic>
+#include <utility>
+
+#include "CivilError.h"
+
+// CIVIL_X86 is 1 when building for x86/x64, the only targets with SIMD variants so far.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CIVIL_X86 1
+#else
+#define CIVIL_X86 0
+#endif // if defined(_M_X64) ...
+
+// CIVIL_TARGET( isa );
+//
+// Lets one function use instructions beyond those enabled for the whole build (GCC and Clang need it to
+// ---- accept the intrinsics; MSVC always does). Such a function may only be called after the dispatcher
+//      has checked that the processor supports the set.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CIVIL_TARGET( isa )
+#else
+#define CIVIL_TARGET( isa ) __attribute__((target(isa)))
+#endif // if defined(_MSC_VER) && !defined(__clang__)
+
+namespace CIVIL::UTILS
+{
+
+	DECLARE_ERROR_CODE(deLevelNotSupported);
+
+	BEGIN_DECLARE_ERROR(EDispatch)
+		DECLARE_ERROR(deLevelNotSupported, "Instruction set not supported by this processor")
+	END_DECLARE_ERROR;
+
+	// Instruction set levels, each one including the previous. ilAVX2 also requires FMA, and ilAVX512
+	// means AVX-512F on top of it.
+	enum IsaLevelEnum
+	{
+		ilScalar,
+		ilSSE2,
+		ilAVX2,
+		ilAVX512,
+		ilCount
+	};
+
+	struct CpuFeatures
+	{
+		bool
+			sse2 = false,
+			avx = false,
+			avx2 = false,
+			fma = false,
+			avx512f = false;
+	};
+
+	// cpuFeatures;
+	//
+	// What the processor and the operating system support, detected on the first call.
+	// ----
+	const CpuFeatures &cpuFeatures();
+
+	// detectedIsaLevel;
+	//
+	// Highest level supported by the machine.
+	// ----
+	IsaLevelEnum detectedIsaLevel();
+
+	// getIsaLevel;
+	//
+	// Level the dispatchers bind to: the detected one unless forceIsaLevel was called.
+	// ----
+	IsaLevelEnum getIsaLevel();
+
+	// getIsaLevel;
+	//
+	// Level in force at "generation", a value returned by isaGeneration(). Both come from one word, so the
+	// ---- level always belongs to the generation, whatever forceIsaLevel calls run meanwhile.
+	IsaLevelEnum getIsaLevel(unsigned int generation);
+
+	// forceIsaLevel;
+	//
+	// Makes every dispatcher use the variants of "level" (or the best one below it), so that tests can run
+	// ---- each implementation on the same machine. Raises EDispatch if the machine does not support it.
+	//      Meant for tests and diagnostics: calls already running keep the variant they started with.
+	void forceIsaLevel(IsaLevelEnum level);
+	void resetIsaLevel();
+
+	// isaGeneration;
+	//
+	// Changes whenever the level changes; dispatchers compare it to rebind. Never 0.
+	// ----
+	unsigned int isaGeneration();
+
+	// Dispatch;
+	//
+	// Holds the variants of one kernel, indexed by IsaLevelEnum (nullptr where there is none), and calls the
+	// ---- best one allowed by the current level. The choice is made on the first call and kept until the
+	//      level changes, so a call costs two relaxed loads and an indirect jump. Instances are constant
+	//      initialized and may be globals.
+	template <typename Fn>
+	struct Dispatch
+	{
+	public:
+
+		constexpr Dispatch(Fn scalar, Fn sse2 = nullptr, Fn avx2 = nullptr, Fn avx512 = nullptr) :
+			m_aVariants{ scalar, sse2, avx2, avx512 }
+		{}
+		Dispatch(const Dispatch &) = delete;
+
+		Dispatch &operator=(const Dispatch &) = delete;
+
+	private:
+
+		Fn
+			m_aVariants[ilCount];
+
+		// The generation the dispatcher bound to, shifted left BINDING_BITS bits, and the index of the bound
+		// variant in the low ones. One word, so that no thread can leave a variant bound under the generation
+		// of another: each store is a whole binding, and the last one wins.
+		static constexpr unsigned int
+			BINDING_BITS = 8;
+
+		mutable std::atomic<unsigned long long>
+			m_intBinding{ 0 };
+
+		int variantIndex(IsaLevelEnum level) const
+		{
+			int
+				i = level;
+
+			while (i > ilScalar && !m_aVariants[i])
+				i--;
+
+			return i;
+		}
+
+	public:
+
+		// variant;
+		//
+		// Best variant for "level", walking down to the scalar one.
+		// ----
+		Fn variant(IsaLevelEnum level) const
+		{
+			return m_aVariants[variantIndex(level)];
+		}
+
+		Fn get() const
+		{
+			unsigned int
+				intGeneration = isaGeneration();
+			unsigned long long
+				intBinding = m_intBinding.load(std::memory_order_relaxed);
+
+			if ((intBinding >> BINDING_BITS) != intGeneration)
+			{
+				intBinding = ((unsigned long long) intGeneration << BINDING_BITS) | (unsigned int) variantIndex(getIsaLevel(intGeneration));
+				m_intBinding.store(intBinding, std::memory_order_relaxed);
+			}
+
+			return m_aVariants[intBinding & ((1 << BINDING_BITS) - 1)];
+		}
+
+		template <typename... Args>
+		auto operator()(Args &&... args) const
+		{
+			return get()(std::forward<Args>(args)...);
+		}
+
+	}; /* Dispatch */
+
+} // namespace CIVIL::UTILS
+
+#endif // ifndef __CIVIL_DISPATCH
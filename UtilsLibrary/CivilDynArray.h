@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <limits>
+#include <limits.h>
+#include <stdlib.h>
 
 #include "CivilRange.h"
 
@@ -117,6 +119,19 @@ namespace UTILS
 			m_intColCount = value;
 		}*/
 
+		// getRows;
+		//
+		// Pointers to the rows, for kernels that work on whole rows at a time.
+		// ----
+		const _type *const *getRows() const
+		{
+			return m_pItems;
+		}
+		_type *const *getRows()
+		{
+			return m_pItems;
+		}
+
 		_type getItem(const IndexType &row, const IndexType &col) const
 		{
 			return m_pItems[row][col];
@@ -20,7 +20,7 @@ END_DECLARE_ERROR;
 	{
 	public:
 
-		Range(Type value = 0) :
+		constexpr Range(Type value = 0) :
 			m_value(value)
 		{}
 
@@ -35,7 +35,7 @@ END_DECLARE_ERROR;
 			min = _min,
 			max = _max;
 
-		operator Type() const
+		constexpr operator Type() const
 		{
 			return m_value;
 		}
@@ -0,0 +1,306 @@
+#include "CivilThreadPool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif // ifdef _WIN32
+
+namespace CIVIL::UTILS
+{
+
+/*
+ * ThreadPool.
+ */
+
+// Pool and queue index of the current thread when it is a worker; the index of the injection queue
+// otherwise.
+static thread_local ThreadPool
+	*t_pPool = nullptr;
+static thread_local unsigned int
+	t_intIndex = 0;
+
+static void
+pinThread(std::thread &thread, unsigned int cpu)
+{
+	unsigned int
+		intCpus = std::thread::hardware_concurrency();
+
+	if (intCpus == 0)
+		return;
+
+	cpu %= intCpus;
+
+#ifdef _WIN32
+	if (cpu < sizeof(DWORD_PTR) * 8)
+		SetThreadAffinityMask((HANDLE) thread.native_handle(), (DWORD_PTR) 1 << cpu);
+#elif defined(__linux__)
+	cpu_set_t
+		set;
+
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+	(void) thread;
+#endif // ifdef _WIN32
+}
+
+ThreadPool::ThreadPool(const PoolOptions &options) :
+	m_blnDeterministic(options.deterministic)
+{
+	unsigned int
+		intWorkers = options.workerCount;
+
+	if (intWorkers == 0)
+	{
+		intWorkers = std::thread::hardware_concurrency();
+		intWorkers = intWorkers > 1 ? intWorkers - 1 : 0;
+	}
+
+	for (unsigned int i = 0; i <= intWorkers; i++)
+		m_aQueues.emplace_back(new Queue());
+
+	m_aThreads.reserve(intWorkers);
+	for (unsigned int i = 0; i < intWorkers; i++)
+	{
+		m_aThreads.emplace_back(&ThreadPool::workerLoop, this, i);
+
+		if (options.pinCores)
+			pinThread(m_aThreads.back(), i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex>
+			lock(m_mtxSleep);
+
+		m_blnStop = true;
+	}
+	m_cvSleep.notify_all();
+
+	for (std::thread &t : m_aThreads)
+		t.join();
+}
+
+void
+ThreadPool::workerLoop(unsigned int index)
+{
+	t_pPool = this;
+	t_intIndex = index;
+
+	while (true)
+	{
+		if (runOne())
+			continue;
+
+		std::unique_lock<std::mutex>
+			lock(m_mtxSleep);
+
+		m_cvSleep.wait(lock, [this]() {
+			return m_blnStop.load() || m_intQueued.load() > 0;
+		});
+
+		if (m_blnStop)
+			return;
+	}
+}
+
+void
+ThreadPool::submit(Task task)
+{
+	unsigned int
+		intIndex = t_pPool == this ? t_intIndex : (unsigned int) m_aQueues.size() - 1;
+	Queue
+		&queue = *m_aQueues[intIndex];
+
+	{
+		std::lock_guard<std::mutex>
+			lock(queue.lock);
+
+		queue.tasks.push_back(std::move(task));
+	}
+
+	m_intQueued.fetch_add(1);
+
+	if (m_aThreads.empty())
+		return;
+
+	// Taking the lock orders the increment before a worker's check of the wait predicate, so the
+	// notification cannot be lost.
+	{
+		std::lock_guard<std::mutex>
+			lock(m_mtxSleep);
+	}
+	m_cvSleep.notify_one();
+}
+
+bool
+ThreadPool::take(Task &task)
+{
+	if (m_intQueued.load() == 0)
+		return false;
+
+	size_t
+		intCount = m_aQueues.size();
+	unsigned int
+		intOwn = t_pPool == this ? t_intIndex : (unsigned int) intCount - 1;
+
+	// Own deque from the back (the newest, smallest piece of a split range), then the others from the
+	// front (the oldest, biggest pieces).
+	{
+		Queue
+			&queue = *m_aQueues[intOwn];
+		std::lock_guard<std::mutex>
+			lock(queue.lock);
+
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			m_intQueued.fetch_sub(1);
+
+			return true;
+		}
+	}
+
+	for (size_t i = 1; i < intCount; i++)
+	{
+		Queue
+			&queue = *m_aQueues[(intOwn + i) % intCount];
+		std::lock_guard<std::mutex>
+			lock(queue.lock);
+
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			m_intQueued.fetch_sub(1);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool
+ThreadPool::runOne()
+{
+	Task
+		task;
+
+	if (!take(task))
+		return false;
+
+	task();
+
+	return true;
+}
+
+/*
+ * Shared pool.
+ */
+
+static std::mutex
+	g_mtxShared;
+static PoolOptions
+	g_sharedOptions;
+static bool
+	g_blnSharedStarted = false;
+
+void
+configureSharedPool(const PoolOptions &options)
+{
+	std::lock_guard<std::mutex>
+		lock(g_mtxShared);
+
+	if (g_blnSharedStarted)
+		RAISE(EThreadPool, tpeAlreadyStarted);
+
+	g_sharedOptions = options;
+}
+
+static PoolOptions
+startSharedPool()
+{
+	std::lock_guard<std::mutex>
+		lock(g_mtxShared);
+
+	g_blnSharedStarted = true;
+
+	return g_sharedOptions;
+}
+
+ThreadPool &
+sharedPool()
+{
+	static ThreadPool
+		pool(startSharedPool());
+
+	return pool;
+}
+
+/*
+ * TaskGroup.
+ */
+
+TaskGroup::~TaskGroup()
+{
+	join();
+}
+
+void
+TaskGroup::run(std::function<void()> fn)
+{
+	m_intPending.fetch_add(1);
+
+	m_pool.submit([this, fn = std::move(fn)]() {
+		try
+		{
+			fn();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex>
+				lock(m_mtxError);
+
+			if (!m_error)
+				m_error = std::current_exception();
+		}
+
+		m_intPending.fetch_sub(1);
+	});
+}
+
+void
+TaskGroup::join()
+{
+	while (m_intPending.load() > 0)
+		if (!m_pool.runOne())
+			std::this_thread::yield();
+}
+
+void
+TaskGroup::wait()
+{
+	join();
+
+	std::exception_ptr
+		error;
+
+	{
+		std::lock_guard<std::mutex>
+			lock(m_mtxError);
+
+		std::swap(error, m_error);
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+} // namespace CIVIL::UTILS
@@ -0,0 +1,305 @@
+/***
+ * CivilThreadPool.h;
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Eng. Anderson Marques Ribeiro (anderson.marques.ribeiro@gmail.com).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CIVIL_THREAD_POOL
+#define __CIVIL_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CivilError.h"
+
+namespace CIVIL::UTILS
+{
+
+	DECLARE_ERROR_CODE(tpeAlreadyStarted);
+
+	BEGIN_DECLARE_ERROR(EThreadPool)
+		DECLARE_ERROR(tpeAlreadyStarted, "The shared thread pool is already running")
+	END_DECLARE_ERROR;
+
+	struct PoolOptions
+	{
+		// Background threads; 0 = one less than the hardware threads, since the thread that waits on a task
+		// group works too.
+		unsigned int
+			workerCount = 0;
+		// Binds worker i to logical processor i (Windows and Linux; ignored elsewhere).
+		bool
+			pinCores = false;
+		// See ThreadPool::setDeterministic.
+		bool
+			deterministic = false;
+	};
+
+	struct TaskGroup;
+
+	// ThreadPool;
+	//
+	// Work-stealing scheduler. Every worker owns a deque: it pushes and pops its own tasks at the back and,
+	// ---- when it runs dry, takes the oldest task from the front of the other deques. Tasks submitted from
+	//      outside the pool go to a shared injection deque. Threads waiting on a TaskGroup run pending tasks
+	//      instead of blocking, so groups can be nested freely.
+	//
+	//      Work is submitted through TaskGroup, parallelFor and parallelReduce. The library's parallel code
+	//      uses sharedPool() instead of starting threads of its own.
+	struct ThreadPool
+	{
+	public:
+
+		explicit ThreadPool(const PoolOptions &options = PoolOptions());
+		ThreadPool(const ThreadPool &) = delete;
+		~ThreadPool();
+
+		ThreadPool &operator=(const ThreadPool &) = delete;
+
+	private:
+
+		typedef std::function<void()> Task;
+
+		struct Queue
+		{
+			std::mutex
+				lock;
+			std::deque<Task>
+				tasks;
+		};
+
+		// One queue per worker plus the injection queue, which is the last one.
+		std::vector<std::unique_ptr<Queue>>
+			m_aQueues;
+		std::vector<std::thread>
+			m_aThreads;
+		std::mutex
+			m_mtxSleep;
+		std::condition_variable
+			m_cvSleep;
+		std::atomic<size_t>
+			m_intQueued{ 0 };
+		std::atomic<bool>
+			m_blnStop{ false },
+			m_blnDeterministic{ false };
+
+		void workerLoop(unsigned int index);
+		void submit(Task task);
+		bool runOne();
+		bool take(Task &task);
+
+		friend struct TaskGroup;
+
+	public:
+
+		unsigned int getWorkerCount() const
+		{
+			return (unsigned int) m_aThreads.size();
+		}
+		// getConcurrency;
+		//
+		// Threads that take part in a parallel call: the workers and the caller.
+		// ----
+		unsigned int getConcurrency() const
+		{
+			return getWorkerCount() + 1;
+		}
+
+		// setDeterministic;
+		//
+		// When set, parallelReduce splits ranges by the grain alone, never by the number of threads, and
+		// ---- combines the partial results in a fixed order, so that floating point reductions give the same
+		//      bits on every run and every machine.
+		bool getDeterministic() const
+		{
+			return m_blnDeterministic.load(std::memory_order_relaxed);
+		}
+		void setDeterministic(bool value)
+		{
+			m_blnDeterministic.store(value, std::memory_order_relaxed);
+		}
+
+	}; /* ThreadPool */
+
+	// configureSharedPool;
+	//
+	// Options of the pool returned by sharedPool(). Must be called before its first use; raises EThreadPool
+	// ---- otherwise.
+	void configureSharedPool(const PoolOptions &options);
+
+	// sharedPool;
+	//
+	// Process-wide pool, created on the first call.
+	// ----
+	ThreadPool &sharedPool();
+
+	// TaskGroup;
+	//
+	// Set of tasks that are waited for together. wait() runs pending tasks of the pool while the group is
+	// ---- not finished and rethrows the first exception raised by one of its tasks. The destructor waits too,
+	//      but swallows the exception.
+	struct TaskGroup
+	{
+	public:
+
+		explicit TaskGroup(ThreadPool &pool = sharedPool()) :
+			m_pool(pool)
+		{}
+		TaskGroup(const TaskGroup &) = delete;
+		~TaskGroup();
+
+		TaskGroup &operator=(const TaskGroup &) = delete;
+
+	private:
+
+		ThreadPool
+			&m_pool;
+		std::atomic<size_t>
+			m_intPending{ 0 };
+		std::mutex
+			m_mtxError;
+		std::exception_ptr
+			m_error;
+
+		void join();
+
+	public:
+
+		ThreadPool &getPool() const
+		{
+			return m_pool;
+		}
+
+		void run(std::function<void()> fn);
+		void wait();
+
+	}; /* TaskGroup */
+
+	// Splits [first, last) in halves until a piece is at most "grain" long, handing one half to the group
+	// and going on with the other.
+	template <typename Fn>
+	void splitRange(TaskGroup &group, size_t first, size_t last, size_t grain, const Fn &fn)
+	{
+		while (last - first > grain)
+		{
+			size_t
+				middle = first + (last - first) / 2;
+
+			group.run([&group, middle, last, grain, &fn]() {
+				splitRange(group, middle, last, grain, fn);
+			});
+			last = middle;
+		}
+
+		fn(first, last);
+	}
+
+	// parallelFor;
+	//
+	// Calls fn(first, last) over pieces of [first, last) of at least "grain" items (more when the range is
+	// ---- large compared to the pool), possibly in parallel, and returns when all are done. The pieces do not
+	//      overlap and cover the range.
+	template <typename Fn>
+	void parallelFor(size_t first, size_t last, size_t grain, const Fn &fn, ThreadPool &pool = sharedPool())
+	{
+		if (last <= first)
+			return;
+
+		size_t
+			n = last - first,
+			intMinGrain = (n + 4 * pool.getConcurrency() - 1) / (4 * pool.getConcurrency());
+
+		if (grain < intMinGrain)
+			grain = intMinGrain;
+		if (grain < 1)
+			grain = 1;
+
+		if (n <= grain || pool.getWorkerCount() == 0)
+		{
+			fn(first, last);
+			return;
+		}
+
+		TaskGroup
+			group(pool);
+
+		splitRange(group, first, last, grain, fn);
+		group.wait();
+	}
+
+	// parallelReduce;
+	//
+	// Reduces [first, last): map(first, last) gives the value of one piece, combine(a, b) joins the values
+	// ---- of two consecutive pieces (a before b) and "identity" is the result of an empty range. Partial
+	//      values are combined pairwise in range order, so only the piece boundaries can change the result;
+	//      in deterministic mode those depend on "grain" alone.
+	template <typename Type, typename Map, typename Combine>
+	Type parallelReduce(size_t first, size_t last, size_t grain, const Type &identity, const Map &map,
+		const Combine &combine, ThreadPool &pool = sharedPool())
+	{
+		if (last <= first)
+			return identity;
+
+		size_t
+			n = last - first;
+
+		if (grain < 1)
+			grain = 1;
+
+		if (!pool.getDeterministic())
+		{
+			size_t
+				intMinGrain = (n + 4 * pool.getConcurrency() - 1) / (4 * pool.getConcurrency());
+
+			if (grain < intMinGrain)
+				grain = intMinGrain;
+		}
+
+		size_t
+			intPieces = (n + grain - 1) / grain;
+		std::vector<Type>
+			aPartial(intPieces, identity);
+
+		parallelFor(0, intPieces, 1, [&](size_t a, size_t b) {
+			for (size_t i = a; i < b; i++)
+				aPartial[i] = map(first + i * grain, i + 1 == intPieces ? last : first + (i + 1) * grain);
+		}, pool);
+
+		for (size_t intStep = 1; intStep < intPieces; intStep *= 2)
+			for (size_t i = 0; i + intStep < intPieces; i += 2 * intStep)
+				aPartial[i] = combine(aPartial[i], aPartial[i + intStep]);
+
+		return aPartial[0];
+	}
+
+} // namespace CIVIL::UTILS
+
+#endif // ifndef __CIVIL_THREAD_POOL